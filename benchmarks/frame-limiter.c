@@ -0,0 +1,188 @@
+/**
+ * \file            frame-limiter.c
+ * \brief           Benchmark comparing frame pacing and CPU cost of frame limiters
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn.h" // IWYU pragma: keep
+
+#include <stdio.h>
+#include <time.h>
+
+/* Frame rate both limiters are asked to hold */
+#define BENCH_TARGET_FPS 300
+
+/* Frames measured per limiter */
+#define BENCH_FRAME_COUNT 1500
+
+/**
+ * \brief           Results of one benchmark run
+ */
+typedef struct bench_result_t {
+    double mean_ms;   /*!< Average frame interval */
+    double jitter_ms; /*!< Standard deviation of the frame interval */
+    double worst_ms;  /*!< Largest deviation from the target interval */
+    double cpu_usage; /*!< Process CPU time divided by wall time */
+} bench_result_t;
+
+/**
+ * \brief           Wait for a deadline the way mvn_end_drawing used to
+ * \note            Sleeps in whole milliseconds, then busy-waits the last 1.5 ms
+ * \param[in]       frame_start: Performance counter value at the start of the frame
+ * \param[in]       frame_time: Target frame time in seconds
+ */
+static void legacy_wait(uint64_t frame_start, double frame_time)
+{
+    double   frequency = (double)SDL_GetPerformanceFrequency();
+    double   elapsed   = (double)(SDL_GetPerformanceCounter() - frame_start) / frequency;
+    uint64_t target    = frame_start + (uint64_t)(frame_time * frequency);
+
+    if (elapsed >= frame_time) {
+        return;
+    }
+
+    double time_to_wait = frame_time - elapsed;
+    if (time_to_wait > 0.0015) {
+        uint32_t delay_ms = (uint32_t)((time_to_wait - 0.0015) * 1000.0);
+        if (delay_ms > 0) {
+            SDL_Delay(delay_ms);
+        }
+    }
+    while (SDL_GetPerformanceCounter() < target) {
+    }
+}
+
+/**
+ * \brief           Render frames and measure their pacing
+ * \param[in]       legacy: true to pace with legacy_wait, false to use the built-in limiter
+ * \return          Measured results
+ */
+static bench_result_t run_frames(bool legacy)
+{
+    bench_result_t result      = { 0.0, 0.0, 0.0, 0.0 };
+    double         frequency   = (double)SDL_GetPerformanceFrequency();
+    double         target_ms   = 1000.0 / BENCH_TARGET_FPS;
+    double         sum         = 0.0;
+    double         sum_squares = 0.0;
+
+    mvn_set_target_fps(legacy ? 0 : BENCH_TARGET_FPS);
+
+    /* Settle the limiter calibration before measuring */
+    for (int i = 0; i < BENCH_TARGET_FPS / 2; i++) {
+        uint64_t frame_start = SDL_GetPerformanceCounter();
+        mvn_begin_drawing();
+        mvn_clear_background(MVN_BLACK);
+        mvn_end_drawing();
+        if (legacy) {
+            legacy_wait(frame_start, 1.0 / BENCH_TARGET_FPS);
+        }
+    }
+
+    clock_t  cpu_start  = clock();
+    uint64_t wall_start = SDL_GetPerformanceCounter();
+    uint64_t previous   = wall_start;
+
+    for (int i = 0; i < BENCH_FRAME_COUNT; i++) {
+        uint64_t frame_start = SDL_GetPerformanceCounter();
+        mvn_begin_drawing();
+        mvn_clear_background(MVN_BLACK);
+        mvn_end_drawing();
+        if (legacy) {
+            legacy_wait(frame_start, 1.0 / BENCH_TARGET_FPS);
+        }
+
+        uint64_t now      = SDL_GetPerformanceCounter();
+        double   interval = (double)(now - previous) * 1000.0 / frequency;
+        double   error    = SDL_fabs(interval - target_ms);
+        previous          = now;
+
+        sum += interval;
+        sum_squares += interval * interval;
+        result.worst_ms = SDL_max(result.worst_ms, error);
+    }
+
+    double wall_seconds = (double)(SDL_GetPerformanceCounter() - wall_start) / frequency;
+    double cpu_seconds  = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    result.mean_ms   = sum / BENCH_FRAME_COUNT;
+    result.jitter_ms = SDL_sqrt(
+        SDL_max(0.0, sum_squares / BENCH_FRAME_COUNT - result.mean_ms * result.mean_ms));
+    result.cpu_usage = cpu_seconds / wall_seconds;
+    return result;
+}
+
+/**
+ * \brief           Print the results of one run
+ * \param[in]       name: Name of the limiter
+ * \param[in]       result: Measured results
+ */
+static void print_result(const char *name, bench_result_t result)
+{
+    printf("%-10s mean %7.3f ms  jitter %6.3f ms  worst %6.3f ms  cpu %5.1f%%\n",
+           name,
+           result.mean_ms,
+           result.jitter_ms,
+           result.worst_ms,
+           result.cpu_usage * 100.0);
+}
+
+/**
+ * \brief           Main application entry point
+ */
+int main(void)
+{
+    /* The dummy driver keeps the numbers independent of display sync */
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+
+    if (!mvn_init(320, 240, "MVN Frame Limiter Benchmark", 0)) {
+        printf("Failed to initialize: %s\n", mvn_get_error());
+        return 1;
+    }
+
+    printf("Target: %d FPS (%.3f ms), %d frames per run\n\n",
+           BENCH_TARGET_FPS,
+           1000.0 / BENCH_TARGET_FPS,
+           BENCH_FRAME_COUNT);
+
+    bench_result_t legacy   = run_frames(true);
+    bench_result_t adaptive = run_frames(false);
+
+    print_result("legacy", legacy);
+    print_result("adaptive", adaptive);
+
+    mvn_frame_limiter_stats_t stats = mvn_get_frame_limiter_stats();
+    printf("\nadaptive limiter: spin margin %.3f ms, %.1f%% of waiting spent spinning\n",
+           stats.spin_margin * 1000.0,
+           stats.total_wait_time > 0.0 ? stats.total_spin_time / stats.total_wait_time * 100.0
+                                       : 0.0);
+
+    mvn_quit();
+    return 0;
+}
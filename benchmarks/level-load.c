@@ -0,0 +1,269 @@
+/**
+ * \file            level-load.c
+ * \brief           Benchmark comparing cold cache level load times of sequential and batched reads
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+// Needed for posix_fadvise() and fdatasync()
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "mvn/mvn.h" // IWYU pragma: keep
+#include "mvn/mvn-aio.h"
+#include "mvn/mvn-file.h"
+#include "mvn/mvn-job.h"
+
+#include <stdio.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#define BENCH_CAN_EVICT
+#endif
+
+/* Directory holding the generated level */
+#define BENCH_DIR "mvn_level_load_bench"
+
+/* Files of the generated level */
+#define BENCH_FILE_COUNT 400
+
+/* Smallest and largest file of the level, sizes are spread in between */
+#define BENCH_MIN_SIZE (4 * 1024)
+#define BENCH_MAX_SIZE (512 * 1024)
+
+/* Loads measured per method */
+#define BENCH_RUNS 3
+
+/**
+ * \brief           Way of loading the level
+ */
+typedef enum bench_method_t {
+    BENCH_SEQUENTIAL = 0, /*!< mvn_load_file_data() per file, one after the other */
+    BENCH_AIO_JOBS,       /*!< mvn_aio_read_batch() on the job system workers */
+    BENCH_AIO_URING,      /*!< mvn_aio_read_batch() through io_uring */
+} bench_method_t;
+
+/**
+ * \brief           Get the size of a level file
+ * \param[in]       index: Index of the file
+ * \return          Size in bytes
+ */
+static size_t file_size(int index)
+{
+    uint32_t hash = (uint32_t)index * 2654435761u;
+    return BENCH_MIN_SIZE + hash % (BENCH_MAX_SIZE - BENCH_MIN_SIZE);
+}
+
+/**
+ * \brief           Write the files of the level
+ * \param[out]      paths: Receives the path of each file
+ * \return          Total size of the level in bytes, 0 on failure
+ */
+static size_t create_level(char paths[BENCH_FILE_COUNT][64])
+{
+    static uint8_t data[BENCH_MAX_SIZE];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 131u);
+    }
+
+    size_t total = 0;
+    SDL_CreateDirectory(BENCH_DIR);
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        SDL_snprintf(paths[i], 64, BENCH_DIR "/asset%03d.bin", i);
+        SDL_IOStream *file    = SDL_IOFromFile(paths[i], "wb");
+        size_t        size    = file_size(i);
+        bool          written = file != NULL && SDL_WriteIO(file, data, size) == size;
+        if (file == NULL || !SDL_CloseIO(file) || !written) {
+            printf("Failed to write %s: %s\n", paths[i], SDL_GetError());
+            return 0;
+        }
+        total += size;
+    }
+    return total;
+}
+
+/**
+ * \brief           Drop the level from the page cache so the next load reads the device
+ * \param[in]       paths: Path of each file
+ * \return          true if the cache was dropped, false if this platform cannot do it
+ */
+static bool evict_level(char paths[BENCH_FILE_COUNT][64])
+{
+#if defined(BENCH_CAN_EVICT)
+    bool evicted = true;
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        int fd = open(paths[i], O_RDONLY);
+        if (fd < 0) {
+            evicted = false;
+            continue;
+        }
+        // Dirty pages cannot be dropped, write them out first
+        fdatasync(fd);
+        evicted = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0 && evicted;
+        close(fd);
+    }
+    return evicted;
+#else
+    (void)paths;
+    return false;
+#endif
+}
+
+/**
+ * \brief           Load every file of the level once
+ * \param[in]       paths: Path of each file
+ * \param[in]       method: Way of loading
+ * \return          Elapsed time in milliseconds, negative on failure
+ */
+static double load_level(char paths[BENCH_FILE_COUNT][64], bench_method_t method)
+{
+    const char     *files[BENCH_FILE_COUNT];
+    mvn_aio_read_t *reads[BENCH_FILE_COUNT];
+    bool            ok = true;
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        files[i] = paths[i];
+    }
+
+    uint64_t start = SDL_GetPerformanceCounter();
+    if (method == BENCH_SEQUENTIAL) {
+        for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+            void *data = mvn_load_file_data(files[i], NULL);
+            ok         = data != NULL && ok;
+            mvn_unload_file_data(data);
+        }
+    } else {
+        ok = mvn_aio_read_batch(files, BENCH_FILE_COUNT, reads) == BENCH_FILE_COUNT;
+        for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+            mvn_file_view_t view;
+            ok = mvn_aio_wait(reads[i], &view) && ok;
+            mvn_file_unmap(&view);
+            mvn_aio_release(reads[i]);
+        }
+    }
+    uint64_t end = SDL_GetPerformanceCounter();
+
+    if (!ok) {
+        printf("Failed to load the level: %s\n", mvn_get_error());
+        return -1.0;
+    }
+    return (double)(end - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * \brief           Measure one way of loading the level and print the result
+ * \param[in]       paths: Path of each file
+ * \param[in]       method: Way of loading
+ * \param[in]       name: Name of the method
+ * \param[in]       total: Size of the level in bytes
+ * \return          Best time in milliseconds, negative on failure
+ */
+static double
+run_method(char paths[BENCH_FILE_COUNT][64], bench_method_t method, const char *name, size_t total)
+{
+    if (method != BENCH_SEQUENTIAL) {
+        mvn_aio_set_uring_enabled(method == BENCH_AIO_URING);
+        if (method == BENCH_AIO_URING && !mvn_aio_is_using_uring()) {
+            printf("%-10s not available\n", name);
+            return -1.0;
+        }
+    }
+
+    double best = -1.0;
+    double sum  = 0.0;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        evict_level(paths);
+        double elapsed = load_level(paths, method);
+        if (elapsed < 0.0) {
+            return -1.0;
+        }
+        best = best < 0.0 ? elapsed : SDL_min(best, elapsed);
+        sum += elapsed;
+    }
+
+    printf("%-10s best %8.2f ms  mean %8.2f ms  %7.1f MB/s\n",
+           name,
+           best,
+           sum / BENCH_RUNS,
+           (double)total / (1024.0 * 1024.0) / (best / 1000.0));
+    return best;
+}
+
+/**
+ * \brief           Main application entry point
+ */
+int main(void)
+{
+    /* Workers run the fallback reads, no window is needed */
+    if (!mvn_job_system_init(0)) {
+        printf("Failed to start the job system: %s\n", mvn_get_error());
+        return 1;
+    }
+
+    char   paths[BENCH_FILE_COUNT][64];
+    size_t total = create_level(paths);
+    if (total == 0) {
+        mvn_job_system_shutdown();
+        return 1;
+    }
+
+    printf("Level: %d files, %.1f MB, %d workers\n",
+           BENCH_FILE_COUNT,
+           (double)total / (1024.0 * 1024.0),
+           mvn_job_get_worker_count());
+    if (!evict_level(paths)) {
+        printf("The page cache cannot be dropped here, times are for a warm cache\n");
+    }
+    printf("\n");
+
+    double sequential = run_method(paths, BENCH_SEQUENTIAL, "sequential", total);
+    double jobs       = run_method(paths, BENCH_AIO_JOBS, "aio jobs", total);
+    double uring      = run_method(paths, BENCH_AIO_URING, "io_uring", total);
+
+    if (sequential > 0.0) {
+        printf("\n");
+        if (jobs > 0.0) {
+            printf("aio jobs is %.2fx the speed of sequential reads\n", sequential / jobs);
+        }
+        if (uring > 0.0) {
+            printf("io_uring is %.2fx the speed of sequential reads\n", sequential / uring);
+        }
+    }
+
+    for (int i = 0; i < BENCH_FILE_COUNT; i++) {
+        SDL_RemovePath(paths[i]);
+    }
+    SDL_RemovePath(BENCH_DIR);
+
+    mvn_aio_shutdown();
+    mvn_job_system_shutdown();
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * \file            log-level.c
+ * \brief           Benchmark of list churn with debug logging enabled and disabled
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn.h" // IWYU pragma: keep
+#include "mvn/mvn-list.h"
+#include "mvn/mvn-logger.h"
+
+#include <stdio.h>
+
+/* Lists created and freed per run */
+#define BENCH_LIST_COUNT 200000
+
+/* Disabled messages logged per run */
+#define BENCH_MESSAGE_COUNT 2000000
+
+/**
+ * \brief           Log output function that discards messages
+ * \param[in]       userdata: Unused
+ * \param[in]       category: Unused
+ * \param[in]       priority: Unused
+ * \param[in]       message: Unused
+ */
+static void
+discard_output(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    (void)userdata;
+    (void)category;
+    (void)priority;
+    (void)message;
+}
+
+/**
+ * \brief           Get the time since a performance counter value
+ * \param[in]       start: Performance counter value at the start
+ * \return          Elapsed time in nanoseconds
+ */
+static double elapsed_ns(uint64_t start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1e9 /
+           (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * \brief           Create, grow and free lists, which log at debug level
+ * \return          Average time per list in nanoseconds
+ */
+static double run_list_churn(void)
+{
+    uint64_t start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < BENCH_LIST_COUNT; i++) {
+        mvn_list_t *list = mvn_list_init(sizeof(int), 2);
+        for (int value = 0; value < 8; value++) {
+            mvn_list_push(list, &value);
+        }
+        mvn_list_free(list);
+    }
+    return elapsed_ns(start) / BENCH_LIST_COUNT;
+}
+
+/**
+ * \brief           Log disabled debug messages
+ * \param[in]       through_sdl: true to call SDL directly, false to use mvn_log_debug
+ * \return          Average time per message in nanoseconds
+ */
+static double run_disabled_messages(bool through_sdl)
+{
+    uint64_t start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < BENCH_MESSAGE_COUNT; i++) {
+        if (through_sdl) {
+            SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "disabled %d %s", i, "message");
+        } else {
+            mvn_log_debug("disabled %d %s", i, "message");
+        }
+    }
+    return elapsed_ns(start) / BENCH_MESSAGE_COUNT;
+}
+
+/**
+ * \brief           Main application entry point
+ */
+int main(void)
+{
+    if (!SDL_Init(0)) {
+        printf("Failed to initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    mvn_logger_init();
+
+    // Measure the cost of the checks, not of writing to the console
+    SDL_SetLogOutputFunction(discard_output, NULL);
+
+    printf("MVN_LOG_MIN_LEVEL %d, %d lists and %d messages per run\n\n",
+           MVN_LOG_MIN_LEVEL,
+           BENCH_LIST_COUNT,
+           BENCH_MESSAGE_COUNT);
+
+    mvn_logger_set_all_levels(MVN_LOG_DEBUG);
+    double churn_enabled = run_list_churn();
+
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+    double churn_disabled = run_list_churn();
+    double sdl_check      = run_disabled_messages(true);
+    double cached_check   = run_disabled_messages(false);
+
+    printf("list churn, debug enabled   %8.1f ns per list\n", churn_enabled);
+    printf("list churn, debug disabled  %8.1f ns per list\n", churn_disabled);
+    printf("disabled message, SDL check %8.2f ns per call\n", sdl_check);
+    printf("disabled message, MVN check %8.2f ns per call\n", cached_check);
+    printf("\nConfigure with -DMVN_LOG_MIN_LEVEL=INFO to remove the debug calls from the library\n");
+
+    SDL_Quit();
+    return 0;
+}
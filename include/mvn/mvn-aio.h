@@ -0,0 +1,71 @@
+/**
+ * \file            mvn-aio.h
+ * \brief           Asynchronous whole-file reads for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_AIO_H
+#define MVN_AIO_H
+
+#include "mvn/mvn-file.h"
+#include "mvn/mvn-job.h"
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Maximum number of reads the kernel works on at the same time */
+#define MVN_AIO_QUEUE_DEPTH 64
+
+/* Maximum length of the error message kept by a failed read */
+#define MVN_AIO_ERROR_SIZE 128
+
+/**
+ * \brief           Handle of a file read in the background
+ */
+typedef struct mvn_aio_read_t mvn_aio_read_t;
+
+mvn_aio_read_t    *mvn_aio_read(const char *fileName);
+int                mvn_aio_read_batch(const char *const *files, int count, mvn_aio_read_t **reads);
+bool               mvn_aio_is_done(mvn_aio_read_t *read);
+mvn_job_counter_t *mvn_aio_get_counter(mvn_aio_read_t *read);
+bool               mvn_aio_wait(mvn_aio_read_t *read, mvn_file_view_t *view);
+void               mvn_aio_release(mvn_aio_read_t *read);
+void               mvn_aio_set_uring_enabled(bool enabled);
+bool               mvn_aio_is_using_uring(void);
+void               mvn_aio_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_AIO_H */
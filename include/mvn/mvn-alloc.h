@@ -0,0 +1,105 @@
+/**
+ * \file            mvn-alloc.h
+ * \brief           Pluggable allocator and memory accounting for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_ALLOC_H
+#define MVN_ALLOC_H
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Number of size classes in an allocation histogram */
+#define MVN_ALLOC_HISTOGRAM_BUCKETS 16
+
+/**
+ * \brief           Subsystems memory is attributed to
+ */
+typedef enum {
+    MVN_ALLOC_TAG_GENERAL = 0, /*!< Allocations without a more specific owner */
+    MVN_ALLOC_TAG_LIST,        /*!< Dynamic array lists */
+    MVN_ALLOC_TAG_HASHMAP,     /*!< Hashmaps */
+    MVN_ALLOC_TAG_STRING,      /*!< Strings and string builders */
+    MVN_ALLOC_TAG_TEXTURE,     /*!< Image surfaces and textures */
+    MVN_ALLOC_TAG_TEXT,        /*!< Fonts and text rendering */
+    MVN_ALLOC_TAG_FILE,        /*!< File and path helpers */
+    MVN_ALLOC_TAG_ARENA,       /*!< Arena allocator blocks */
+    MVN_ALLOC_TAG_JOB,         /*!< Job system queues and jobs */
+    MVN_ALLOC_TAG_LOGGER,      /*!< Asynchronous log buffer */
+    MVN_ALLOC_TAG_COUNT        /*!< Number of tags */
+} mvn_alloc_tag_t;
+
+/**
+ * \brief           Allocator callbacks used for all framework allocations
+ */
+typedef struct mvn_allocator_t {
+    void *(*malloc_fn)(void *user_data, size_t size);             /*!< Allocate memory */
+    void *(*realloc_fn)(void *user_data, void *ptr, size_t size); /*!< Resize memory */
+    void (*free_fn)(void *user_data, void *ptr);                  /*!< Release memory */
+    void *user_data; /*!< Context passed to every callback */
+} mvn_allocator_t;
+
+/**
+ * \brief           Memory statistics of one allocation tag
+ */
+typedef struct mvn_alloc_stats_t {
+    size_t   live_bytes;       /*!< Bytes currently allocated */
+    size_t   peak_bytes;       /*!< Highest live_bytes seen */
+    size_t   live_count;       /*!< Allocations currently alive */
+    uint64_t allocation_count; /*!< Allocations made since startup */
+    uint64_t histogram[MVN_ALLOC_HISTOGRAM_BUCKETS]; /*!< Allocations per size class, bucket N
+                                                          holds sizes up to 16 << N bytes and the
+                                                          last bucket everything larger */
+} mvn_alloc_stats_t;
+
+bool              mvn_set_allocator(const mvn_allocator_t *allocator);
+mvn_allocator_t   mvn_get_allocator(void);
+mvn_alloc_stats_t mvn_get_alloc_stats(mvn_alloc_tag_t tag);
+const char       *mvn_get_alloc_tag_name(mvn_alloc_tag_t tag);
+void              mvn_alloc_track(mvn_alloc_tag_t tag, size_t size);
+void              mvn_alloc_untrack(mvn_alloc_tag_t tag, size_t size);
+size_t            mvn_alloc_report_leaks(void);
+
+/* Allocation entry points used by the MVN_MALLOC family of macros */
+void *mvn_tagged_malloc(mvn_alloc_tag_t tag, size_t size, const char *file, int line);
+void *
+mvn_tagged_calloc(mvn_alloc_tag_t tag, size_t count, size_t size, const char *file, int line);
+void *mvn_tagged_realloc(mvn_alloc_tag_t tag, void *ptr, size_t size, const char *file, int line);
+void  mvn_tagged_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_ALLOC_H */
@@ -0,0 +1,115 @@
+/**
+ * \file            mvn-arena.h
+ * \brief           Linear arena allocator for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_ARENA_H
+#define MVN_ARENA_H
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Arena memory block, data follows the header directly
+ */
+typedef struct mvn_arena_block_t {
+    struct mvn_arena_block_t *next; /*!< Next block in the chain (blocks are kept oldest first) */
+    size_t                    size; /*!< Usable bytes in the block */
+    size_t                    used; /*!< Bytes handed out from the block */
+} mvn_arena_block_t;
+
+/**
+ * \brief           Arena allocation statistics
+ */
+typedef struct mvn_arena_stats_t {
+    size_t used_bytes;       /*!< Bytes currently handed out, including alignment padding */
+    size_t peak_used_bytes;  /*!< Highest used_bytes since the arena was created */
+    size_t reserved_bytes;   /*!< Bytes currently reserved from the general allocator */
+    size_t block_count;      /*!< Blocks currently owned by the arena */
+    size_t allocation_count; /*!< Allocations served by the arena since it was created */
+    size_t allocated_bytes;  /*!< Bytes requested from the arena since it was created */
+    size_t heap_allocations; /*!< Blocks requested from the general allocator since creation */
+    size_t reset_count;      /*!< Number of times the arena was reset */
+} mvn_arena_stats_t;
+
+/**
+ * \brief           Linear (bump) arena allocator
+ * \note            Allocations are released all at once with mvn_arena_reset or back to a
+ *                  marker with mvn_arena_rewind. Arenas are not thread safe, use one arena per
+ *                  thread (see mvn_get_thread_arena).
+ */
+typedef struct mvn_arena_t {
+    mvn_arena_block_t *first;      /*!< Oldest block */
+    mvn_arena_block_t *current;    /*!< Block allocations are served from */
+    size_t             block_size; /*!< Size of new blocks */
+    mvn_arena_stats_t  stats;      /*!< Allocation statistics */
+} mvn_arena_t;
+
+/**
+ * \brief           Arena position captured by mvn_arena_mark
+ */
+typedef struct mvn_arena_marker_t {
+    mvn_arena_block_t *block; /*!< Block that was current when the marker was taken */
+    size_t             used;  /*!< Used bytes of that block */
+} mvn_arena_marker_t;
+
+mvn_arena_t       *mvn_arena_init(size_t block_size);
+void               mvn_arena_free(mvn_arena_t *arena);
+void              *mvn_arena_alloc(mvn_arena_t *arena, size_t size);
+void              *mvn_arena_alloc_aligned(mvn_arena_t *arena, size_t size, size_t alignment);
+void              *mvn_arena_realloc(mvn_arena_t *arena,
+                                     void        *ptr,
+                                     size_t       old_size,
+                                     size_t       new_size);
+mvn_arena_marker_t mvn_arena_mark(const mvn_arena_t *arena);
+void               mvn_arena_rewind(mvn_arena_t *arena, mvn_arena_marker_t marker);
+void               mvn_arena_reset(mvn_arena_t *arena);
+mvn_arena_stats_t  mvn_arena_get_stats(const mvn_arena_t *arena);
+mvn_arena_t       *mvn_get_thread_arena(void);
+void               mvn_release_thread_arena(void);
+
+/**
+ * \brief           Allocate an object of a specific type from an arena
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       T: Type of the object
+ * \return          Typed pointer to uninitialized memory or NULL on failure
+ * \hideinitializer
+ */
+#define MVN_ARENA_NEW(arena, T) ((T *)mvn_arena_alloc((arena), sizeof(T)))
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_ARENA_H */
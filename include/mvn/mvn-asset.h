@@ -0,0 +1,82 @@
+/**
+ * \file            mvn-asset.h
+ * \brief           Asynchronous asset loading for MVN game framework
+ */
+
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_ASSET_H
+#define MVN_ASSET_H
+
+#include "mvn/mvn-types.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Loading state of an asynchronous asset
+ */
+typedef enum mvn_asset_state_t {
+    MVN_ASSET_PENDING = 0, /*!< Waiting for a worker */
+    MVN_ASSET_DECODING,    /*!< Being read and decoded on a worker */
+    MVN_ASSET_UPLOADING,   /*!< Decoded, waiting for the upload on the main thread */
+    MVN_ASSET_READY,       /*!< Loaded, the result can be taken */
+    MVN_ASSET_FAILED,      /*!< Loading failed */
+    MVN_ASSET_CANCELLED,   /*!< Cancelled before it finished */
+} mvn_asset_state_t;
+
+/**
+ * \brief           Handle of an asset loaded in the background
+ */
+typedef struct mvn_asset_t mvn_asset_t;
+
+mvn_asset_t      *mvn_load_texture_async(const char *filename);
+mvn_asset_t      *mvn_load_font_async(const char *filename, float size);
+mvn_asset_state_t mvn_asset_get_state(const mvn_asset_t *asset);
+bool              mvn_asset_is_done(const mvn_asset_t *asset);
+mvn_texture_t    *mvn_asset_get_texture(mvn_asset_t *asset);
+TTF_Font         *mvn_asset_get_font(mvn_asset_t *asset);
+bool              mvn_asset_cancel(mvn_asset_t *asset);
+void              mvn_asset_release(mvn_asset_t *asset);
+float             mvn_get_asset_load_progress(void);
+int               mvn_get_pending_asset_count(void);
+void              mvn_set_asset_upload_budget(double seconds);
+size_t            mvn_process_asset_uploads(void);
+void              mvn_asset_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_ASSET_H */
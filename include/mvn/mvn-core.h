@@ -34,6 +34,7 @@
 #ifndef MVN_CORE_H
 #define MVN_CORE_H
 
+#include "mvn/mvn-arena.h"
 #include "mvn/mvn-file.h"   // IWYU pragma: keep
 #include "mvn/mvn-logger.h" // IWYU pragma: keep
 #include "mvn/mvn-string.h"
@@ -50,12 +51,86 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/**
+ * \brief           Subsystem startup options, see mvn_set_init_flags()
+ */
+typedef enum mvn_init_flags_t {
+    MVN_INIT_DEFAULT    = 0,      /*!< Start every subsystem in mvn_init() */
+    MVN_INIT_LAZY_AUDIO = 1 << 0, /*!< Start audio on the first mvn_init_audio() call */
+    MVN_INIT_LAZY_TEXT  = 1 << 1, /*!< Start SDL_ttf and the text engine on first use */
+    MVN_INIT_LAZY       = MVN_INIT_LAZY_AUDIO | MVN_INIT_LAZY_TEXT, /*!< Defer all of the above */
+} mvn_init_flags_t;
+
+/**
+ * \brief           Statistics of the frame limiter in mvn_end_drawing
+ */
+typedef struct mvn_frame_limiter_stats_t {
+    double wait_time;       /*!< Time the last frame waited for its deadline in seconds */
+    double spin_time;       /*!< Part of wait_time spent spinning after the last sleep */
+    double total_wait_time; /*!< Sum of wait_time since mvn_init() */
+    double total_spin_time; /*!< Sum of spin_time since mvn_init() */
+    double spin_margin;     /*!< Calibrated time before the deadline at which sleeping stops */
+} mvn_frame_limiter_stats_t;
+
+/* Number of frames kept in the frame time history */
+#ifndef MVN_FRAME_HISTORY_SIZE
+#define MVN_FRAME_HISTORY_SIZE 256
+#endif
+
+/**
+ * \brief           Timing of one frame, all values in seconds
+ */
+typedef struct mvn_frame_sample_t {
+    float total;   /*!< Time between the ends of this and the previous frame */
+    float cpu;     /*!< Time spent outside of presenting and waiting */
+    float present; /*!< Time spent in SDL_RenderPresent */
+    float wait;    /*!< Time spent waiting for the target frame rate */
+} mvn_frame_sample_t;
+
+/**
+ * \brief           Distribution of one frame phase over the frame history, in seconds
+ */
+typedef struct mvn_frame_phase_stats_t {
+    float min; /*!< Shortest duration */
+    float avg; /*!< Average duration */
+    float max; /*!< Longest duration */
+    float p50; /*!< Median duration */
+    float p95; /*!< 95th percentile */
+    float p99; /*!< 99th percentile */
+} mvn_frame_phase_stats_t;
+
+/**
+ * \brief           Statistics over the frame time history
+ */
+typedef struct mvn_frame_stats_t {
+    mvn_frame_phase_stats_t total;              /*!< Whole frame */
+    mvn_frame_phase_stats_t cpu;                /*!< CPU work */
+    mvn_frame_phase_stats_t present;            /*!< Presenting */
+    mvn_frame_phase_stats_t wait;               /*!< Frame limiter waiting */
+    size_t                  sample_count;       /*!< Frames in the history */
+    size_t                  recent_hitch_count; /*!< Hitches among the frames in the history */
+    uint64_t                hitch_count;        /*!< Hitches since mvn_init() */
+} mvn_frame_stats_t;
+
+/**
+ * \brief           Fixed update callback
+ * \param[in]       fixed_delta: Time simulated by the update in seconds
+ * \param[in]       user_data: Pointer passed to mvn_run_fixed_updates
+ */
+typedef void (*mvn_fixed_update_fn)(float fixed_delta, void *user_data);
+
 /* Core functions */
 mvn_string_t      *mvn_get_engine_version(void);
 bool               mvn_init(int width, int height, const char *title, mvn_window_flags_t flags);
+bool               mvn_init_headless(int width, int height);
+bool               mvn_is_headless(void);
+void               mvn_set_init_flags(mvn_init_flags_t flags);
+bool               mvn_init_audio(void);
+bool               mvn_init_text(void);
 void               mvn_quit(void);
 mvn_renderer_t    *mvn_get_renderer(void);
 mvn_text_engine_t *mvn_get_text_engine(void);
+mvn_arena_t       *mvn_get_frame_arena(void);
 bool               mvn_window_should_close(void);
 bool               mvn_begin_drawing(void);
 bool               mvn_clear_background(mvn_color_t color);
@@ -67,6 +142,23 @@ float  mvn_get_frame_time(void);
 double mvn_get_time(void);
 int    mvn_get_fps(void);
 
+mvn_frame_limiter_stats_t mvn_get_frame_limiter_stats(void);
+
+/* Frame statistics functions */
+bool              mvn_set_hitch_threshold(float seconds);
+mvn_frame_stats_t mvn_get_frame_stats(void);
+size_t            mvn_get_frame_history(mvn_frame_sample_t *samples, size_t max_count);
+
+/* Fixed timestep functions */
+bool     mvn_set_fixed_update_rate(double hz);
+double   mvn_get_fixed_update_rate(void);
+void     mvn_set_max_fixed_updates(int count);
+bool     mvn_fixed_update(void);
+int      mvn_run_fixed_updates(mvn_fixed_update_fn update, void *user_data);
+float    mvn_get_fixed_frame_time(void);
+float    mvn_get_fixed_alpha(void);
+uint64_t mvn_get_fixed_tick(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -12,9 +12,40 @@
 extern "C" {
 #endif /* __cplusplus */
 
-bool        mvn_set_error(const char *fmt, ...);
-const char *mvn_get_error(void);
-void        mvn_clear_error(void);
+/* Longest error message returned by mvn_get_error(), longer messages are truncated */
+#define MVN_ERROR_MESSAGE_SIZE 1024
+
+/* Bytes of arguments kept with each error until its message is formatted */
+#define MVN_ERROR_ARGS_SIZE 512
+
+/* Recent errors kept by each thread for diagnostics */
+#define MVN_ERROR_HISTORY_SIZE 8
+
+/**
+ * \brief           Kind of the last error, for callers that handle errors without reading
+ *                  the message
+ */
+typedef enum {
+    MVN_ERROR_NONE = 0,         /*!< No error is set */
+    MVN_ERROR_UNKNOWN,          /*!< Error set with mvn_set_error(), see the message */
+    MVN_ERROR_INVALID_ARGUMENT, /*!< An argument was NULL or out of range */
+    MVN_ERROR_OUT_OF_MEMORY,    /*!< An allocation failed */
+    MVN_ERROR_NOT_FOUND,        /*!< A key, file or resource does not exist */
+    MVN_ERROR_IO,               /*!< Reading or writing a file failed */
+    MVN_ERROR_SDL,              /*!< An SDL function failed */
+    MVN_ERROR_UNSUPPORTED,      /*!< The operation is not available */
+    MVN_ERROR_INVALID_STATE,    /*!< The operation is not allowed right now */
+    MVN_ERROR_COUNT             /*!< Number of error codes */
+} mvn_error_code_t;
+
+bool             mvn_set_error(const char *fmt, ...);
+bool             mvn_set_error_code(mvn_error_code_t code, const char *fmt, ...);
+const char      *mvn_get_error(void);
+mvn_error_code_t mvn_get_error_code(void);
+const char      *mvn_get_error_code_name(mvn_error_code_t code);
+void             mvn_clear_error(void);
+size_t           mvn_get_error_history_count(void);
+mvn_error_code_t mvn_get_recent_error(size_t index, char *message, size_t size);
 
 #ifdef __cplusplus
 }
@@ -42,6 +42,25 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/**
+ * \brief           Read-only view of the contents of a file
+ */
+typedef struct mvn_file_view_t {
+    const void *data;                  /*!< Contents, never NULL for a view that was opened */
+    size_t      size;                  /*!< Size of the contents in bytes */
+    bool        mapped;                /*!< Whether the view mapped data, else it is a heap copy */
+    void       *owner;                 /*!< Holder of data such as an archive, NULL if not shared */
+    void      (*release)(void *owner); /*!< Called for owner when the view is released */
+} mvn_file_view_t;
+
+/**
+ * \brief           Part of a path, pointing into the string it was taken from
+ */
+typedef struct mvn_path_view_t {
+    const char *data;   /*!< First character, not necessarily NUL terminated */
+    size_t      length; /*!< Number of characters */
+} mvn_path_view_t;
+
 bool          mvn_file_exists(const char *fileName);
 bool          mvn_directory_exists(const char *dirPath);
 bool          mvn_is_file_extension(const char *fileName, const char *ext);
@@ -55,6 +74,21 @@ mvn_string_t *mvn_get_application_directory(void);
 bool          mvn_is_path_file(const char *path);
 bool          mvn_is_path_directory(const char *path);
 int64_t       mvn_get_file_mod_time(const char *fileName);
+bool          mvn_file_map(const char *fileName, mvn_file_view_t *view);
+void          mvn_file_unmap(mvn_file_view_t *view);
+SDL_IOStream *mvn_file_open_io(const char *fileName);
+void         *mvn_load_file_data(const char *fileName, size_t *size);
+void          mvn_unload_file_data(void *data);
+char         *mvn_load_file_text(const char *fileName);
+void          mvn_unload_file_text(char *text);
+
+mvn_path_view_t mvn_get_file_extension_view(const char *fileName);
+mvn_path_view_t mvn_get_file_name_view(const char *filePath);
+mvn_path_view_t mvn_get_file_name_without_ext_view(const char *filePath);
+mvn_path_view_t mvn_get_directory_path_view(const char *filePath);
+mvn_path_view_t mvn_get_parent_directory_path_view(const char *dirPath);
+size_t          mvn_normalize_path(const char *path, char *buffer, size_t size);
+size_t          mvn_join_path(const char *directory, const char *name, char *buffer, size_t size);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,78 @@
+/**
+ * \file            mvn-format.h
+ * \brief           Deferred printf-style formatting for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_FORMAT_H
+#define MVN_FORMAT_H
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Most arguments a packed format string may read, counting '*' widths and precisions */
+#define MVN_FORMAT_MAX_ARGS 16
+
+/**
+ * \brief           How a packed argument is read from the variable argument list
+ */
+typedef enum {
+    MVN_FORMAT_ARG_INT,     /*!< int, and char and short promoted to int */
+    MVN_FORMAT_ARG_LONG,    /*!< long */
+    MVN_FORMAT_ARG_LLONG,   /*!< long long */
+    MVN_FORMAT_ARG_SIZE,    /*!< size_t */
+    MVN_FORMAT_ARG_INTMAX,  /*!< intmax_t */
+    MVN_FORMAT_ARG_PTRDIFF, /*!< ptrdiff_t */
+    MVN_FORMAT_ARG_DOUBLE,  /*!< double, and float promoted to double */
+    MVN_FORMAT_ARG_LDOUBLE, /*!< long double, packed as a double */
+    MVN_FORMAT_ARG_POINTER, /*!< void pointer */
+    MVN_FORMAT_ARG_STRING   /*!< Null terminated string, packed as a copy */
+} mvn_format_arg_t;
+
+/*
+ * Arguments are packed as 8 bytes each, strings as a 16-bit length and their characters, in
+ * the byte order of the machine. Formats using %n or wide characters cannot be packed.
+ */
+int    mvn_format_parse(const char *fmt, uint8_t types[MVN_FORMAT_MAX_ARGS]);
+size_t mvn_format_pack(const uint8_t *types, int count, void *out, size_t capacity, va_list args);
+bool   mvn_format_unpack(char           *out,
+                         size_t          size,
+                         const char     *fmt,
+                         const uint8_t **cursor,
+                         const uint8_t  *end);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_FORMAT_H */
@@ -7,6 +7,7 @@
 #define MVN_HASHMAP_H
 
 #include "mvn/mvn-list.h"
+#include "mvn/mvn-string.h"
 
 #include <SDL3/SDL.h>
 
@@ -18,9 +19,11 @@ extern "C" {
  * \brief           Hashmap entry structure (key-value pair)
  */
 typedef struct mvn_hmap_entry_t {
-    char                    *key;   /*!< String key (owned by the hashmap) */
-    void                    *value; /*!< Pointer to value (owned by the hashmap) */
-    struct mvn_hmap_entry_t *next;  /*!< Next entry in collision chain */
+    char                    *key;        /*!< String key (owned by the hashmap) */
+    size_t                   key_length; /*!< Key length (excluding null terminator) */
+    uint64_t                 hash;       /*!< Hash of the key, see mvn_string_hash_bytes */
+    void                    *value;      /*!< Pointer to value (owned by the hashmap) */
+    struct mvn_hmap_entry_t *next;       /*!< Next entry in collision chain */
 } mvn_hmap_entry_t;
 
 /**
@@ -41,6 +44,9 @@ void       *mvn_hmap_get(const mvn_hmap_t *hmap, const char *key);
 bool        mvn_hmap_delete(mvn_hmap_t *hmap, const char *key);
 mvn_list_t *mvn_hmap_keys(const mvn_hmap_t *hmap);
 mvn_list_t *mvn_hmap_values(const mvn_hmap_t *hmap);
+bool        mvn_hmap_set_string(mvn_hmap_t *hmap, const mvn_string_t *key, const void *value);
+void       *mvn_hmap_get_string(const mvn_hmap_t *hmap, const mvn_string_t *key);
+bool        mvn_hmap_delete_string(mvn_hmap_t *hmap, const mvn_string_t *key);
 
 /**
  * \brief           Create a hashmap for a specific type
@@ -0,0 +1,98 @@
+/**
+ * \file            mvn-input.h
+ * \brief           Buffered keyboard, mouse and gamepad input for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_INPUT_H
+#define MVN_INPUT_H
+
+#include "mvn/mvn-types.h"
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Number of gamepads tracked at the same time */
+#ifndef MVN_MAX_GAMEPADS
+#define MVN_MAX_GAMEPADS 4
+#endif
+
+/* Characters of text input buffered between two reads, must be a power of two */
+#ifndef MVN_TEXT_INPUT_RING_SIZE
+#define MVN_TEXT_INPUT_RING_SIZE 64
+#endif
+
+/* Number of mouse buttons tracked, indexed by SDL_BUTTON_* */
+#define MVN_MOUSE_BUTTON_COUNT 8
+
+typedef SDL_Scancode      mvn_key_t;            /*!< Physical keyboard key */
+typedef SDL_GamepadButton mvn_gamepad_button_t; /*!< Gamepad button */
+typedef SDL_GamepadAxis   mvn_gamepad_axis_t;   /*!< Gamepad axis */
+
+/* Frame updates */
+void mvn_update_input(void);
+void mvn_sample_input(void);
+bool mvn_is_quit_requested(void);
+void mvn_input_shutdown(void);
+
+/* Keyboard */
+bool mvn_is_key_down(mvn_key_t key);
+bool mvn_is_key_up(mvn_key_t key);
+bool mvn_is_key_pressed(mvn_key_t key);
+bool mvn_is_key_released(mvn_key_t key);
+
+/* Mouse */
+bool         mvn_is_mouse_button_down(int button);
+bool         mvn_is_mouse_button_pressed(int button);
+bool         mvn_is_mouse_button_released(int button);
+mvn_fpoint_t mvn_get_mouse_position(void);
+mvn_fpoint_t mvn_get_mouse_delta(void);
+mvn_fpoint_t mvn_get_mouse_wheel(void);
+
+/* Gamepads */
+bool  mvn_is_gamepad_available(int gamepad);
+bool  mvn_is_gamepad_button_down(int gamepad, mvn_gamepad_button_t button);
+bool  mvn_is_gamepad_button_pressed(int gamepad, mvn_gamepad_button_t button);
+bool  mvn_is_gamepad_button_released(int gamepad, mvn_gamepad_button_t button);
+float mvn_get_gamepad_axis(int gamepad, mvn_gamepad_axis_t axis);
+
+/* Text input */
+bool     mvn_start_text_input(void);
+bool     mvn_stop_text_input(void);
+uint32_t mvn_get_char_pressed(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_INPUT_H */
@@ -0,0 +1,97 @@
+/**
+ * \file            mvn-job.h
+ * \brief           Work-stealing job system for MVN game framework
+ */
+
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_JOB_H
+#define MVN_JOB_H
+
+#include "mvn/mvn-list.h"
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Job function
+ * \param[in]       user_data: Pointer passed when the job was submitted
+ */
+typedef void (*mvn_job_fn)(void *user_data);
+
+/**
+ * \brief           Range function for mvn_parallel_for
+ * \param[in]       list: List being processed
+ * \param[in]       start: Index of the first item of the range
+ * \param[in]       end: Index one past the last item of the range
+ * \param[in]       user_data: Pointer passed to mvn_parallel_for
+ */
+typedef void (*mvn_parallel_for_fn)(mvn_list_t *list, size_t start, size_t end, void *user_data);
+
+/**
+ * \brief           Number of unfinished jobs, used to wait for jobs and to chain them
+ * \note            Zero-initialize before first use, e.g. mvn_job_counter_t counter = { 0 }.
+ *                  The members are private. A counter must stay alive until it was waited for
+ *                  with mvn_job_wait().
+ */
+typedef struct mvn_job_counter_t {
+    SDL_AtomicInt     pending; /*!< Submitted jobs that have not finished */
+    SDL_SpinLock      lock;    /*!< Guards waiters and the transition to zero */
+    struct mvn_job_t *waiters; /*!< Jobs started when pending reaches zero */
+} mvn_job_counter_t;
+
+bool   mvn_job_system_init(int worker_count);
+void   mvn_job_system_shutdown(void);
+int    mvn_job_get_worker_count(void);
+bool   mvn_job_is_main_thread(void);
+bool   mvn_job_run(mvn_job_fn function, void *user_data, mvn_job_counter_t *counter);
+bool   mvn_job_run_after(mvn_job_counter_t *dependency,
+                         mvn_job_fn         function,
+                         void              *user_data,
+                         mvn_job_counter_t *counter);
+void   mvn_job_counter_add(mvn_job_counter_t *counter);
+void   mvn_job_counter_done(mvn_job_counter_t *counter);
+bool   mvn_job_is_done(mvn_job_counter_t *counter);
+void   mvn_job_wait(mvn_job_counter_t *counter);
+bool   mvn_parallel_for(mvn_list_t         *list,
+                        size_t              batch_size,
+                        mvn_parallel_for_fn function,
+                        void               *user_data);
+bool   mvn_job_run_on_main_thread(mvn_job_fn function, void *user_data);
+size_t mvn_job_run_main_thread_queue(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_JOB_H */
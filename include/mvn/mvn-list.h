@@ -6,6 +6,8 @@
 #ifndef MVN_LIST_H
 #define MVN_LIST_H
 
+#include "mvn/mvn-arena.h"
+
 #include <SDL3/SDL.h>
 
 #ifdef __cplusplus
@@ -16,13 +18,15 @@ extern "C" {
  * \brief           Dynamic array list structure
  */
 typedef struct mvn_list_t {
-    void  *data;      /*!< Pointer to the array of items */
-    size_t item_size; /*!< Size of each item in bytes */
-    size_t length;    /*!< Current number of items */
-    size_t capacity;  /*!< Current allocated capacity */
+    void        *data;      /*!< Pointer to the array of items */
+    size_t       item_size; /*!< Size of each item in bytes */
+    size_t       length;    /*!< Current number of items */
+    size_t       capacity;  /*!< Current allocated capacity */
+    mvn_arena_t *arena;     /*!< Arena owning the list, NULL for heap lists */
 } mvn_list_t;
 
 mvn_list_t *mvn_list_init(size_t item_size, size_t initial_capacity);
+mvn_list_t *mvn_list_init_arena(mvn_arena_t *arena, size_t item_size, size_t initial_capacity);
 void        mvn_list_free(mvn_list_t *list);
 size_t      mvn_list_length(const mvn_list_t *list);
 bool        mvn_list_push(mvn_list_t *list, const void *item);
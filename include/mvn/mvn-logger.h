@@ -66,6 +66,49 @@ typedef enum {
     MVN_LOG_CATEGORY_CUSTOM  = SDL_LOG_CATEGORY_CUSTOM       /*!< Custom category */
 } mvn_log_category_t;
 
+/* Log levels usable in preprocessor conditions, in the order of mvn_log_level_t */
+#define MVN_LOG_LEVEL_VERBOSE  1
+#define MVN_LOG_LEVEL_DEBUG    2
+#define MVN_LOG_LEVEL_INFO     3
+#define MVN_LOG_LEVEL_WARN     4
+#define MVN_LOG_LEVEL_ERROR    5
+#define MVN_LOG_LEVEL_CRITICAL 6
+
+/* Calls to mvn_log_debug() and friends below this level compile to nothing */
+#ifndef MVN_LOG_MIN_LEVEL
+#define MVN_LOG_MIN_LEVEL MVN_LOG_LEVEL_VERBOSE
+#endif
+
+/* Categories whose level is cached for mvn_log_is_enabled(), higher ones ask SDL */
+#define MVN_LOG_CACHED_CATEGORIES 32
+
+/* Longest message formatted without a heap allocation, longer messages are copied to the heap */
+#ifndef MVN_LOG_MESSAGE_SIZE
+#define MVN_LOG_MESSAGE_SIZE 256
+#endif
+
+/* Default rate limit of a call site, see mvn_logger_set_rate_limit() */
+#define MVN_LOG_RATE_LIMIT_BURST       10
+#define MVN_LOG_RATE_LIMIT_INTERVAL_MS 1000
+
+/**
+ * \brief           What the asynchronous logger does when its buffer is full
+ */
+typedef enum {
+    MVN_LOG_OVERFLOW_DROP  = 0, /*!< Discard the message and count it as dropped */
+    MVN_LOG_OVERFLOW_BLOCK = 1  /*!< Wait until the writer thread frees a slot */
+} mvn_log_overflow_t;
+
+/* Bytes of binary messages each thread buffers before writing them to the binary log */
+#ifndef MVN_LOG_BINARY_BUFFER_SIZE
+#define MVN_LOG_BINARY_BUFFER_SIZE 65536
+#endif
+
+/**
+ * \brief           Receives each line decoded by mvn_logger_decode_binary()
+ */
+typedef void (*mvn_log_decode_fn)(const char *line, void *user_data);
+
 bool mvn_logger_init(void);
 void mvn_logger_set_level(mvn_log_category_t category, mvn_log_level_t level);
 void mvn_logger_set_all_levels(mvn_log_level_t level);
@@ -76,6 +119,102 @@ void mvn_log_warn(const char *fmt, ...);
 void mvn_log_error(const char *fmt, ...);
 void mvn_log_critical(const char *fmt, ...);
 
+/* Asynchronous output and sinks */
+bool     mvn_logger_start_async(size_t capacity, mvn_log_overflow_t overflow);
+void     mvn_logger_stop_async(void);
+bool     mvn_logger_is_async(void);
+void     mvn_logger_flush(void);
+bool     mvn_logger_set_file(const char *path);
+uint32_t mvn_logger_get_dropped_count(void);
+void     mvn_logger_shutdown(void);
+
+/* Flood control of repeated messages */
+void     mvn_logger_set_rate_limit(mvn_log_level_t level, uint32_t burst, uint32_t interval_ms);
+void     mvn_logger_set_collapse_repeats(bool enabled);
+uint32_t mvn_logger_get_suppressed_count(void);
+uint32_t mvn_logger_get_collapsed_count(void);
+
+/* Binary logging of mvn_log() messages */
+bool mvn_logger_start_binary(const char *path);
+void mvn_logger_stop_binary(void);
+bool mvn_logger_is_binary(void);
+bool mvn_logger_decode_binary(const char *path, mvn_log_decode_fn callback, void *user_data);
+
+/* Levels set through mvn_logger_set_level(), 0 where SDL's level was never replaced */
+extern int mvn_log_levels[MVN_LOG_CACHED_CATEGORIES];
+
+/**
+ * \brief           Check whether a message would be logged, without calling into SDL
+ * \note            Inline so that disabled messages cost one load and compare before any
+ *                  argument is evaluated. Levels set with SDL_SetLogPriority() directly are only
+ *                  seen where MVN never set the level.
+ * \param[in]       category: Log category
+ * \param[in]       level: Priority of the message
+ * \return          false if the message is filtered out, true if it may be logged
+ */
+static inline bool mvn_log_is_enabled(int category, mvn_log_level_t level)
+{
+    if (category < 0 || category >= MVN_LOG_CACHED_CATEGORIES || mvn_log_levels[category] == 0) {
+        return true;
+    }
+    return (int)level >= mvn_log_levels[category];
+}
+
+/*
+ * The logging functions are wrapped so a disabled level skips the call and the formatting of
+ * its arguments. Levels below MVN_LOG_MIN_LEVEL are removed at compile time, keeping the
+ * call only in an unevaluated sizeof so its arguments still count as used. The wrapped
+ * functions can still be called directly as (mvn_log_debug)(...).
+ */
+#if !defined(MVN_LOGGER_IMPLEMENTATION)
+
+#define mvn_log(category, priority, ...)                                                           \
+    (mvn_log_is_enabled((int)(category), (priority))                                               \
+         ? mvn_log((category), (priority), __VA_ARGS__)                                            \
+         : (void)0)
+
+#if MVN_LOG_MIN_LEVEL <= MVN_LOG_LEVEL_DEBUG
+#define mvn_log_debug(...)                                                                         \
+    (mvn_log_is_enabled(MVN_LOG_CATEGORY_DEFAULT, MVN_LOG_DEBUG) ? mvn_log_debug(__VA_ARGS__)      \
+                                                                 : (void)0)
+#else
+#define mvn_log_debug(...) ((void)sizeof(mvn_log_debug(__VA_ARGS__), 0))
+#endif
+
+#if MVN_LOG_MIN_LEVEL <= MVN_LOG_LEVEL_INFO
+#define mvn_log_info(...)                                                                          \
+    (mvn_log_is_enabled(MVN_LOG_CATEGORY_DEFAULT, MVN_LOG_INFO) ? mvn_log_info(__VA_ARGS__)        \
+                                                                : (void)0)
+#else
+#define mvn_log_info(...) ((void)sizeof(mvn_log_info(__VA_ARGS__), 0))
+#endif
+
+#if MVN_LOG_MIN_LEVEL <= MVN_LOG_LEVEL_WARN
+#define mvn_log_warn(...)                                                                          \
+    (mvn_log_is_enabled(MVN_LOG_CATEGORY_DEFAULT, MVN_LOG_WARN) ? mvn_log_warn(__VA_ARGS__)        \
+                                                                : (void)0)
+#else
+#define mvn_log_warn(...) ((void)sizeof(mvn_log_warn(__VA_ARGS__), 0))
+#endif
+
+#if MVN_LOG_MIN_LEVEL <= MVN_LOG_LEVEL_ERROR
+#define mvn_log_error(...)                                                                         \
+    (mvn_log_is_enabled(MVN_LOG_CATEGORY_ERROR, MVN_LOG_ERROR) ? mvn_log_error(__VA_ARGS__)        \
+                                                               : (void)0)
+#else
+#define mvn_log_error(...) ((void)sizeof(mvn_log_error(__VA_ARGS__), 0))
+#endif
+
+#if MVN_LOG_MIN_LEVEL <= MVN_LOG_LEVEL_CRITICAL
+#define mvn_log_critical(...)                                                                      \
+    (mvn_log_is_enabled(MVN_LOG_CATEGORY_ERROR, MVN_LOG_CRITICAL) ? mvn_log_critical(__VA_ARGS__)  \
+                                                                  : (void)0)
+#else
+#define mvn_log_critical(...) ((void)sizeof(mvn_log_critical(__VA_ARGS__), 0))
+#endif
+
+#endif /* !MVN_LOGGER_IMPLEMENTATION */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,87 @@
+/**
+ * \file            mvn-profile.h
+ * \brief           CPU profiler zones for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_PROFILE_H
+#define MVN_PROFILE_H
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+void mvn_profile_begin(const char *name);
+void mvn_profile_end(void);
+void mvn_profile_set_enabled(bool enabled);
+bool mvn_profile_export(const char *path);
+bool mvn_profile_set_export_on_quit(const char *path);
+void mvn_profile_shutdown(void);
+
+#if defined(MVN_PROFILE_ENABLED)
+
+/**
+ * \brief           Open a profiler zone, must be closed with MVN_PROFILE_END
+ * \param[in]       name: Zone name, must be a string with static lifetime
+ * \hideinitializer
+ */
+#define MVN_PROFILE_BEGIN(name) mvn_profile_begin(name)
+
+/**
+ * \brief           Close the innermost profiler zone of the calling thread
+ * \hideinitializer
+ */
+#define MVN_PROFILE_END() mvn_profile_end()
+
+/**
+ * \brief           Profile the block that follows, e.g. MVN_PROFILE_ZONE("update") { ... }
+ * \note            Leaving the block with return, break or goto skips closing the zone
+ * \param[in]       name: Zone name, must be a string with static lifetime
+ * \hideinitializer
+ */
+#define MVN_PROFILE_ZONE(name)                                                                     \
+    for (int mvn_profile_zone_open_ = (mvn_profile_begin(name), 1); mvn_profile_zone_open_;       \
+         mvn_profile_end(), mvn_profile_zone_open_ = 0)
+
+#else
+
+#define MVN_PROFILE_BEGIN(name) ((void)0)
+#define MVN_PROFILE_END()       ((void)0)
+#define MVN_PROFILE_ZONE(name)
+
+#endif /* MVN_PROFILE_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_PROFILE_H */
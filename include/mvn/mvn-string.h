@@ -34,6 +34,8 @@
 #ifndef MVN_STRING_H
 #define MVN_STRING_H
 
+#include "mvn/mvn-arena.h"
+
 #include <SDL3/SDL.h>
 
 #ifdef __cplusplus
@@ -44,13 +46,18 @@ extern "C" {
  * \brief           Dynamic string structure
  */
 typedef struct mvn_string_t {
-    char  *data;     /*!< String data */
-    size_t length;   /*!< String length (excluding null terminator) */
-    size_t capacity; /*!< Allocated capacity (including null terminator) */
+    char        *data;       /*!< String data */
+    size_t       length;     /*!< String length (excluding null terminator) */
+    size_t       capacity;   /*!< Allocated capacity (including null terminator) */
+    uint64_t     hash;       /*!< Cached hash of the data, see mvn_string_hash */
+    bool         hash_valid; /*!< Whether hash matches the current data */
+    mvn_arena_t *arena;      /*!< Arena owning the string, NULL for heap strings */
 } mvn_string_t;
 
 mvn_string_t *mvn_string_init(size_t initial_capacity);
 mvn_string_t *mvn_string_from_cstr(const char *cstr);
+mvn_string_t *mvn_string_init_arena(mvn_arena_t *arena, size_t initial_capacity);
+mvn_string_t *mvn_string_from_cstr_arena(mvn_arena_t *arena, const char *cstr);
 void          mvn_string_free(mvn_string_t *str);
 size_t        mvn_string_length(const mvn_string_t *str);
 const char   *mvn_string_to_cstr(const mvn_string_t *str);
@@ -74,8 +81,42 @@ mvn_string_t      *mvn_string_trim_end(const mvn_string_t *str);
 mvn_string_t      *mvn_string_trim_start(const mvn_string_t *str);
 mvn_string_t      *mvn_string_substring(const mvn_string_t *str, size_t start, size_t length);
 bool               mvn_string_compare(const mvn_string_t *str1, const mvn_string_t *str2);
+uint64_t           mvn_string_hash(const mvn_string_t *str);
+uint64_t           mvn_string_hash_bytes(const char *data, size_t length);
 size_t             mvn_string_capacity(const mvn_string_t *str);
 void               mvn_string_clear(mvn_string_t *str);
+bool               mvn_string_to_lowercase_inplace(mvn_string_t *str);
+bool               mvn_string_to_uppercase_inplace(mvn_string_t *str);
+bool               mvn_string_trim_inplace(mvn_string_t *str);
+bool               mvn_string_is_valid_utf8(const mvn_string_t *str);
+size_t             mvn_string_utf8_length(const mvn_string_t *str);
+
+/**
+ * \brief           String builder structure
+ * \note            Grows geometrically and keeps its buffer across resets, so a builder that is
+ *                  reused every frame stops allocating once it reaches its working size
+ */
+typedef struct mvn_strbuf_t {
+    char        *data;     /*!< Buffer data (always null terminated) */
+    size_t       length;   /*!< Current length (excluding null terminator) */
+    size_t       capacity; /*!< Allocated capacity (including null terminator) */
+    mvn_arena_t *arena;    /*!< Arena owning the builder, NULL for heap builders */
+} mvn_strbuf_t;
+
+mvn_strbuf_t *mvn_strbuf_init(size_t initial_capacity);
+mvn_strbuf_t *mvn_strbuf_init_arena(mvn_arena_t *arena, size_t initial_capacity);
+void          mvn_strbuf_free(mvn_strbuf_t *buf);
+bool          mvn_strbuf_reserve(mvn_strbuf_t *buf, size_t capacity);
+void          mvn_strbuf_reset(mvn_strbuf_t *buf);
+bool          mvn_strbuf_append(mvn_strbuf_t *buf, const char *cstr);
+bool          mvn_strbuf_append_n(mvn_strbuf_t *buf, const char *data, size_t length);
+bool          mvn_strbuf_append_char(mvn_strbuf_t *buf, char character);
+bool          mvn_strbuf_append_string(mvn_strbuf_t *buf, const mvn_string_t *str);
+bool          mvn_strbuf_appendf(mvn_strbuf_t *buf, const char *fmt, ...);
+bool          mvn_strbuf_appendfv(mvn_strbuf_t *buf, const char *fmt, va_list args);
+size_t        mvn_strbuf_length(const mvn_strbuf_t *buf);
+const char   *mvn_strbuf_to_cstr(const mvn_strbuf_t *buf);
+mvn_string_t *mvn_strbuf_finish(mvn_strbuf_t *buf);
 
 #ifdef __cplusplus
 }
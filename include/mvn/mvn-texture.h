@@ -64,9 +64,12 @@ typedef struct mvn_npatch_info_t {
 } mvn_npatch_info_t;
 
 mvn_image_t   *mvn_load_image(const char *filename);
+mvn_image_t   *mvn_load_image_from_memory(const char *fileType, const void *data, size_t size);
 void           mvn_unload_image(mvn_image_t *surface);
+mvn_image_t   *mvn_load_image_from_screen(mvn_renderer_t *renderer);
 mvn_texture_t *mvn_image_to_texture(mvn_renderer_t *renderer, mvn_image_t *surface);
 mvn_texture_t *mvn_load_texture(mvn_renderer_t *renderer, const char *filename);
+bool           mvn_reload_texture(mvn_texture_t *texture, const char *filename);
 void           mvn_unload_texture(mvn_texture_t *texture);
 void mvn_draw_texture(mvn_texture_t *texture, int32_t posX, int32_t posY, mvn_color_t tint);
 void mvn_draw_texture_v(mvn_texture_t *texture, mvn_fpoint_t position, mvn_color_t tint);
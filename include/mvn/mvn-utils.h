@@ -34,6 +34,7 @@
 #ifndef MVN_UTILS_H
 #define MVN_UTILS_H
 
+#include "mvn/mvn-alloc.h"
 #include "mvn/mvn-list.h"
 
 #include <SDL3/SDL.h>
@@ -57,18 +58,22 @@ extern "C" {
 #endif
 
 // Allow custom memory allocators
-// Defaults use SDL3 memory management functions
+// Defaults route through the allocator installed with mvn_set_allocator (SDL3 memory
+// management functions unless replaced) and account memory to MVN_ALLOC_TAG
+#ifndef MVN_ALLOC_TAG
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_GENERAL
+#endif
 #ifndef MVN_MALLOC
-#define MVN_MALLOC(sz) SDL_malloc(sz)
+#define MVN_MALLOC(sz) mvn_tagged_malloc(MVN_ALLOC_TAG, sz, __FILE__, __LINE__)
 #endif
 #ifndef MVN_CALLOC
-#define MVN_CALLOC(n, sz) SDL_calloc(n, sz)
+#define MVN_CALLOC(n, sz) mvn_tagged_calloc(MVN_ALLOC_TAG, n, sz, __FILE__, __LINE__)
 #endif
 #ifndef MVN_REALLOC
-#define MVN_REALLOC(ptr, sz) SDL_realloc(ptr, sz)
+#define MVN_REALLOC(ptr, sz) mvn_tagged_realloc(MVN_ALLOC_TAG, ptr, sz, __FILE__, __LINE__)
 #endif
 #ifndef MVN_FREE
-#define MVN_FREE(ptr) SDL_free(ptr)
+#define MVN_FREE(ptr) mvn_tagged_free(ptr)
 #endif
 
 void        mvn_set_random_seed(int32_t seed);
@@ -0,0 +1,91 @@
+/**
+ * \file            mvn-vfs.h
+ * \brief           Packed asset archives and virtual file system for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_VFS_H
+#define MVN_VFS_H
+
+#include "mvn/mvn-file.h"
+
+#include <SDL3/SDL.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Maximum number of archives and directories mounted at the same time */
+#define MVN_VFS_MAX_MOUNTS 16
+
+/* Maximum length of a path resolved through the virtual file system */
+#define MVN_VFS_PATH_SIZE 512
+
+/* Extension of packed asset archives */
+#define MVN_PAK_EXTENSION ".mvnpak"
+
+/* Version of the archive format written by mvn_pak_build() */
+#define MVN_PAK_VERSION 1
+
+/* Alignment of the file payloads in an archive */
+#define MVN_PAK_ALIGNMENT 16
+
+/**
+ * \brief           Compression of a file stored in an archive
+ */
+typedef enum mvn_pak_compression_t {
+    MVN_PAK_COMPRESSION_NONE = 0, /*!< Stored as is, read without copying */
+    MVN_PAK_COMPRESSION_LZ4,      /*!< LZ4 block, decompressed when opened */
+} mvn_pak_compression_t;
+
+/**
+ * \brief           Where a path was found by mvn_vfs_resolve()
+ */
+typedef enum mvn_vfs_source_t {
+    MVN_VFS_SOURCE_NONE = 0,  /*!< Not in any mount, the path is used as given */
+    MVN_VFS_SOURCE_ARCHIVE,   /*!< File stored in a mounted archive */
+    MVN_VFS_SOURCE_DIRECTORY, /*!< File in a mounted directory */
+} mvn_vfs_source_t;
+
+bool             mvn_pak_build(const char *directory, const char *output, bool compress);
+bool             mvn_vfs_mount(const char *path);
+bool             mvn_vfs_unmount(const char *path);
+void             mvn_vfs_unmount_all(void);
+int              mvn_vfs_get_mount_count(void);
+mvn_vfs_source_t mvn_vfs_resolve(const char *path, char *native, size_t size, size_t *file_size);
+bool             mvn_vfs_map(const char *path, mvn_file_view_t *view);
+bool             mvn_vfs_open(const char *path, char *native, size_t size, mvn_file_view_t *view,
+                              mvn_vfs_source_t *source);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_VFS_H */
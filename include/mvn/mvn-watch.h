@@ -0,0 +1,75 @@
+/**
+ * \file            mvn-watch.h
+ * \brief           File watching for hot reloading assets in MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#ifndef MVN_WATCH_H
+#define MVN_WATCH_H
+
+#include "mvn/mvn-types.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Maximum number of files watched at the same time */
+#define MVN_WATCH_MAX_FILES 256
+
+/* Quiet time after the last change of a file before it is reported, editors save in steps */
+#define MVN_WATCH_COALESCE_MS 100
+
+/* Default interval between checks of files that cannot be watched by the operating system */
+#define MVN_WATCH_DEFAULT_POLL_MS 500
+
+/**
+ * \brief           Called on the main thread after a watched file changed
+ * \param[in]       path: Path the file was watched with
+ * \param[in]       user_data: User data given to mvn_watch_file()
+ */
+typedef void (*mvn_watch_fn)(const char *path, void *user_data);
+
+uint32_t mvn_watch_file(const char *path, mvn_watch_fn callback, void *user_data);
+uint32_t mvn_watch_texture(mvn_texture_t *texture, const char *fileName);
+uint32_t mvn_watch_font(TTF_Font **font, const char *fileName, float size);
+bool     mvn_unwatch_file(uint32_t id);
+int      mvn_get_watch_count(void);
+void     mvn_watch_set_polling(bool polling, uint32_t interval_ms);
+bool     mvn_watch_is_polling(void);
+void     mvn_watch_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_WATCH_H */
@@ -97,6 +97,10 @@ int32_t          mvn_get_render_width(void);
 int32_t          mvn_get_render_height(void);
 int32_t          mvn_get_monitor_count(void);
 
+/* Cached window state, kept current by the event pump */
+void mvn_refresh_window_state(void);
+void mvn_window_handle_event(const SDL_Event *event);
+
 /* Cursor functions */
 void mvn_show_cursor(void);
 void mvn_hide_cursor(void);
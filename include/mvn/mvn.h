@@ -34,9 +34,13 @@
 #ifndef MVN_H
 #define MVN_H
 
-#include "mvn/mvn-core.h"   // IWYU pragma: keep
-#include "mvn/mvn-error.h"  // IWYU pragma: keep
-#include "mvn/mvn-window.h" // IWYU pragma: keep
+#include "mvn/mvn-asset.h"   // IWYU pragma: keep
+#include "mvn/mvn-core.h"    // IWYU pragma: keep
+#include "mvn/mvn-error.h"   // IWYU pragma: keep
+#include "mvn/mvn-input.h"   // IWYU pragma: keep
+#include "mvn/mvn-job.h"     // IWYU pragma: keep
+#include "mvn/mvn-profile.h" // IWYU pragma: keep
+#include "mvn/mvn-window.h"  // IWYU pragma: keep
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,871 @@
+/**
+ * \file            mvn-aio.c
+ * \brief           Asynchronous whole-file reads for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+// Needed for syscall(), io_uring has no C library wrapper
+#define _DEFAULT_SOURCE
+#endif
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_FILE
+
+#include "mvn/mvn-aio.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-utils.h"
+#include "mvn/mvn-vfs.h"
+
+#include <SDL3/SDL.h>
+#include <stdarg.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup)
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MVN_AIO_URING
+#endif
+#endif
+
+/* Longest single read, longer files are read in several steps */
+#define AIO_MAX_READ (1u << 30)
+
+/**
+ * \brief           State of a read
+ */
+typedef enum mvn_aio_state_t {
+    MVN_AIO_PENDING = 0, /*!< Queued or being read */
+    MVN_AIO_DONE,        /*!< Contents are available */
+    MVN_AIO_FAILED,      /*!< Reading failed, error holds the reason */
+} mvn_aio_state_t;
+
+/**
+ * \brief           Handle of a file read in the background
+ * \note            Owned by the caller and by the reader, freed when both let go
+ */
+struct mvn_aio_read_t {
+    struct mvn_aio_read_t *next;                      /*!< Link in the reader queues */
+    mvn_job_counter_t      counter;                   /*!< Pending until the read finished */
+    SDL_AtomicInt          state;                     /*!< Current mvn_aio_state_t */
+    SDL_AtomicInt          refs;                      /*!< Owners of the handle */
+    mvn_file_view_t        view;                      /*!< Contents of the file */
+    uint8_t               *buffer;                    /*!< Writable view data while reading */
+    bool                   taken;                     /*!< The view was handed to the caller */
+    int                    fd;                        /*!< Open file while reading, -1 if none */
+    size_t                 done;                      /*!< Bytes read so far */
+    mvn_error_code_t       error_code;                /*!< Code of a failed read */
+    char                   error[MVN_AIO_ERROR_SIZE]; /*!< Message of a failed read */
+    char                   native[MVN_VFS_PATH_SIZE]; /*!< Path of the file on disk */
+    char                   path[];                    /*!< Path the read was requested with */
+};
+
+/**
+ * \brief           State of the reader, changed with compare and swap
+ * \note            Starting and stopping run without any lock held. Reads requested meanwhile run
+ *                  on the job system workers instead of waiting.
+ */
+typedef enum mvn_aio_reader_state_t {
+    MVN_AIO_READER_STOPPED,  /*!< Not started, the next read picks how files are read */
+    MVN_AIO_READER_STARTING, /*!< Setting up io_uring */
+    MVN_AIO_READER_JOBS,     /*!< Reads run on the job system workers */
+    MVN_AIO_READER_URING,    /*!< Reads go to the reader thread */
+    MVN_AIO_READER_STOPPING, /*!< Finishing the reads queued for the reader thread */
+} mvn_aio_reader_state_t;
+
+static SDL_AtomicInt g_reader_state;
+
+/* Guards handing reads to the reader thread against it being stopped, and g_uring_enabled */
+static SDL_SpinLock g_handoff_lock;
+static bool         g_uring_enabled = true;
+
+#if defined(MVN_AIO_URING)
+/**
+ * \brief           io_uring instance with its rings mapped
+ */
+typedef struct mvn_aio_ring_t {
+    int                  fd;         /*!< io_uring file descriptor */
+    unsigned             entries;    /*!< Number of submission queue entries */
+    void                *rings;      /*!< Mapping of both rings */
+    size_t               rings_size; /*!< Size of the mapping of the rings */
+    struct io_uring_sqe *sqes;       /*!< Submission queue entries */
+    size_t               sqes_size;  /*!< Size of the mapping of the entries */
+    unsigned            *sq_tail;    /*!< Submission tail, written by the reader thread */
+    unsigned            *sq_mask;    /*!< Mask of submission indices */
+    unsigned            *sq_array;   /*!< Indices of the submitted entries */
+    unsigned            *cq_head;    /*!< Completion head, written by the reader thread */
+    unsigned            *cq_tail;    /*!< Completion tail, written by the kernel */
+    unsigned            *cq_mask;    /*!< Mask of completion indices */
+    struct io_uring_cqe *cqes;       /*!< Completion queue entries */
+} mvn_aio_ring_t;
+
+static mvn_aio_ring_t g_ring = {.fd = -1};
+
+/* Reads waiting for the reader thread, guarded by g_queue_lock */
+static SDL_Mutex      *g_queue_lock = NULL;
+static SDL_Condition  *g_queue_cond = NULL;
+static mvn_aio_read_t *g_queue_head = NULL;
+static mvn_aio_read_t *g_queue_tail = NULL;
+static bool            g_stop       = false;
+
+/* Thread submitting reads and collecting their completions */
+static SDL_Thread *g_reader_thread = NULL;
+#endif /* MVN_AIO_URING */
+
+/**
+ * \brief           Drop one owner of a handle and free it with the last one
+ * \param[in]       read: Handle to release
+ */
+static void release_read(mvn_aio_read_t *read)
+{
+    if (!SDL_AtomicDecRef(&read->refs)) {
+        return;
+    }
+
+    if (!read->taken) {
+        mvn_file_unmap(&read->view);
+    }
+    MVN_FREE(read);
+}
+
+/**
+ * \brief           End the reader's part of a read
+ * \param[in]       read: Handle that finished
+ * \param[in]       state: Final state
+ */
+static void finish_read(mvn_aio_read_t *read, mvn_aio_state_t state)
+{
+    SDL_SetAtomicInt(&read->state, (int)state);
+    mvn_job_counter_done(&read->counter);
+    release_read(read);
+}
+
+/**
+ * \brief           End a read with an error
+ * \note            The message is kept in the handle and set by mvn_aio_wait() on the thread
+ *                  that waits, errors of the reader thread would not be seen there
+ * \param[in]       read: Handle that failed
+ * \param[in]       code: Error code
+ * \param[in]       fmt: Formatting string for the message
+ * \param[in]       ...: Arguments for the format string
+ */
+static void fail_read(mvn_aio_read_t *read, mvn_error_code_t code, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    SDL_vsnprintf(read->error, sizeof(read->error), fmt, args);
+    va_end(args);
+
+    mvn_file_unmap(&read->view);
+    read->buffer     = NULL;
+    read->error_code = code;
+    finish_read(read, MVN_AIO_FAILED);
+}
+
+/**
+ * \brief           Read a whole file with blocking reads
+ * \note            Runs on the job system workers when io_uring is not available. Reads the path
+ *                  create_read() resolved, so mounts are not searched again.
+ * \param[in]       user_data: Handle to read
+ */
+static void read_job(void *user_data)
+{
+    mvn_aio_read_t *read   = (mvn_aio_read_t *)user_data;
+    SDL_IOStream   *stream = SDL_IOFromFile(read->native, "rb");
+    if (stream == NULL) {
+        fail_read(read, MVN_ERROR_IO, "Failed to open '%s': %s", read->path, SDL_GetError());
+        return;
+    }
+
+    int64_t length = SDL_GetIOSize(stream);
+    if (length < 0 || (uint64_t)length >= SIZE_MAX) {
+        SDL_CloseIO(stream);
+        fail_read(read, MVN_ERROR_IO, "Failed to get the size of '%s'", read->path);
+        return;
+    }
+
+    // NUL terminated like mvn_load_file_data(), so text can be used as is
+    uint8_t *data = MVN_MALLOC((size_t)length + 1);
+    if (data == NULL) {
+        SDL_CloseIO(stream);
+        fail_read(read, MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate memory for '%s'", read->path);
+        return;
+    }
+
+    size_t size = SDL_ReadIO(stream, data, (size_t)length);
+    SDL_CloseIO(stream);
+    if (size != (size_t)length) {
+        MVN_FREE(data);
+        fail_read(read, MVN_ERROR_IO, "Failed to read '%s': %s", read->path, SDL_GetError());
+        return;
+    }
+
+    data[size]      = '\0';
+    read->view.data = data;
+    read->view.size = size;
+    finish_read(read, MVN_AIO_DONE);
+}
+
+#if defined(MVN_AIO_URING)
+/**
+ * \brief           Enter the kernel to submit entries and wait for completions
+ * \param[in]       to_submit: Number of entries to submit
+ * \param[in]       min_complete: Number of completions to wait for
+ * \return          Number of entries submitted, -1 on failure with errno set
+ */
+static int ring_enter(unsigned to_submit, unsigned min_complete)
+{
+    return (int)syscall(__NR_io_uring_enter,
+                        g_ring.fd,
+                        to_submit,
+                        min_complete,
+                        IORING_ENTER_GETEVENTS,
+                        NULL,
+                        0);
+}
+
+/**
+ * \brief           Unmap the rings and close the io_uring instance
+ */
+static void ring_close(void)
+{
+    if (g_ring.sqes != NULL) {
+        munmap(g_ring.sqes, g_ring.sqes_size);
+    }
+    if (g_ring.rings != NULL) {
+        munmap(g_ring.rings, g_ring.rings_size);
+    }
+    if (g_ring.fd >= 0) {
+        close(g_ring.fd);
+    }
+    SDL_zero(g_ring);
+    g_ring.fd = -1;
+}
+
+/**
+ * \brief           Create the io_uring instance and map its rings
+ * \return          true on success, false if io_uring is not available
+ */
+static bool ring_setup(void)
+{
+    struct io_uring_params params;
+    SDL_zero(params);
+    g_ring.fd = (int)syscall(__NR_io_uring_setup, MVN_AIO_QUEUE_DEPTH, &params);
+    if (g_ring.fd < 0) {
+        return false;
+    }
+
+    // IORING_OP_READ arrived with the same kernel as IORING_FEAT_CUR_PERSONALITY (5.6)
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+        (params.features & IORING_FEAT_CUR_PERSONALITY) == 0) {
+        ring_close();
+        return false;
+    }
+
+    size_t sq_size    = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cq_size    = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    g_ring.rings_size = SDL_max(sq_size, cq_size);
+    g_ring.rings      = mmap(NULL,
+                        g_ring.rings_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        g_ring.fd,
+                        IORING_OFF_SQ_RING);
+    if (g_ring.rings == MAP_FAILED) {
+        g_ring.rings = NULL;
+        ring_close();
+        return false;
+    }
+
+    g_ring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    g_ring.sqes      = mmap(NULL,
+                       g_ring.sqes_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED,
+                       g_ring.fd,
+                       IORING_OFF_SQES);
+    if (g_ring.sqes == MAP_FAILED) {
+        g_ring.sqes = NULL;
+        ring_close();
+        return false;
+    }
+
+    uint8_t *rings  = g_ring.rings;
+    g_ring.entries  = params.sq_entries;
+    g_ring.sq_tail  = (unsigned *)(rings + params.sq_off.tail);
+    g_ring.sq_mask  = (unsigned *)(rings + params.sq_off.ring_mask);
+    g_ring.sq_array = (unsigned *)(rings + params.sq_off.array);
+    g_ring.cq_head  = (unsigned *)(rings + params.cq_off.head);
+    g_ring.cq_tail  = (unsigned *)(rings + params.cq_off.tail);
+    g_ring.cq_mask  = (unsigned *)(rings + params.cq_off.ring_mask);
+    g_ring.cqes     = (struct io_uring_cqe *)(rings + params.cq_off.cqes);
+    return true;
+}
+
+/**
+ * \brief           Queue the next read of a file in the submission ring
+ * \note            The caller makes sure the ring has a free entry
+ * \param[in]       read: Handle with an open file
+ */
+static void prepare_read(mvn_aio_read_t *read)
+{
+    unsigned             tail  = *g_ring.sq_tail;
+    unsigned             index = tail & *g_ring.sq_mask;
+    struct io_uring_sqe *sqe   = &g_ring.sqes[index];
+
+    SDL_zerop(sqe);
+    sqe->opcode    = IORING_OP_READ;
+    sqe->fd        = read->fd;
+    sqe->addr      = (uint64_t)(uintptr_t)(read->buffer + read->done);
+    sqe->len       = (uint32_t)SDL_min(read->view.size - read->done, (size_t)AIO_MAX_READ);
+    sqe->off       = read->done;
+    sqe->user_data = (uint64_t)(uintptr_t)read;
+
+    g_ring.sq_array[index] = index;
+    __atomic_store_n(g_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * \brief           Open a file and allocate its buffer on the reader thread
+ * \param[in]       read: Handle to open
+ * \return          true if the file has to be read, false if the read already finished
+ */
+static bool open_read(mvn_aio_read_t *read)
+{
+    read->fd = open(read->native, O_RDONLY | O_CLOEXEC);
+    if (read->fd < 0) {
+        fail_read(read,
+                  errno == ENOENT ? MVN_ERROR_NOT_FOUND : MVN_ERROR_IO,
+                  "Failed to open '%s': %s",
+                  read->path,
+                  strerror(errno));
+        return false;
+    }
+
+    // Pipes and devices have no size to read up to, they take the blocking path
+    struct stat info;
+    if (fstat(read->fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+        (uint64_t)info.st_size >= SIZE_MAX) {
+        close(read->fd);
+        read->fd = -1;
+        read_job(read);
+        return false;
+    }
+
+    // NUL terminated like mvn_load_file_data(), so text can be used as is
+    size_t size  = (size_t)info.st_size;
+    read->buffer = MVN_MALLOC(size + 1);
+    if (read->buffer == NULL) {
+        close(read->fd);
+        read->fd = -1;
+        fail_read(read, MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate memory for '%s'", read->path);
+        return false;
+    }
+    read->buffer[size] = '\0';
+    read->view.data    = read->buffer;
+    read->view.size    = size;
+
+    if (size == 0) {
+        close(read->fd);
+        read->fd = -1;
+        finish_read(read, MVN_AIO_DONE);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief           Handle the completion of one read of a file
+ * \param[in]       read: Handle the completion belongs to
+ * \param[in]       result: Bytes read or negative errno
+ * \return          true if the file needs another read, false if the read finished
+ */
+static bool complete_read(mvn_aio_read_t *read, int result)
+{
+    if (result == -EINTR || result == -EAGAIN) {
+        return true;
+    }
+
+    if (result > 0) {
+        read->done += (size_t)result;
+        if (read->done < read->view.size) {
+            return true;
+        }
+    }
+
+    close(read->fd);
+    read->fd = -1;
+    if (result < 0) {
+        fail_read(read, MVN_ERROR_IO, "Failed to read '%s': %s", read->path, strerror(-result));
+    } else if (result == 0) {
+        fail_read(read, MVN_ERROR_IO, "Failed to read '%s': file was truncated", read->path);
+    } else {
+        finish_read(read, MVN_AIO_DONE);
+    }
+    return false;
+}
+
+/**
+ * \brief           Submit queued reads and collect their completions until the reader stops
+ * \note            Opening files stays on this thread. Reading their contents, the part that
+ *                  waits for the device, is what is handed to the kernel in batches.
+ * \param[in]       data: Unused
+ * \return          0
+ */
+static int reader_thread(void *data)
+{
+    (void)data;
+    mvn_aio_read_t *ready_head  = NULL; // Open files waiting for a free ring entry
+    mvn_aio_read_t *ready_tail  = NULL;
+    unsigned        in_flight   = 0;
+    unsigned        unsubmitted = 0;
+
+    for (;;) {
+        SDL_LockMutex(g_queue_lock);
+        while (g_queue_head == NULL && ready_head == NULL && in_flight == 0 && !g_stop) {
+            SDL_WaitCondition(g_queue_cond, g_queue_lock);
+        }
+        mvn_aio_read_t *incoming = g_queue_head;
+        bool            stop     = g_stop;
+        g_queue_head             = NULL;
+        g_queue_tail             = NULL;
+        SDL_UnlockMutex(g_queue_lock);
+
+        // Everything queued before the reader was stopped is finished first
+        if (incoming == NULL && ready_head == NULL && in_flight == 0 && stop) {
+            break;
+        }
+
+        while (incoming != NULL) {
+            mvn_aio_read_t *next = incoming->next;
+            if (open_read(incoming)) {
+                incoming->next = NULL;
+                if (ready_tail != NULL) {
+                    ready_tail->next = incoming;
+                } else {
+                    ready_head = incoming;
+                }
+                ready_tail = incoming;
+            }
+            incoming = next;
+        }
+
+        while (ready_head != NULL && in_flight < g_ring.entries) {
+            mvn_aio_read_t *read = ready_head;
+            ready_head           = read->next;
+            if (ready_head == NULL) {
+                ready_tail = NULL;
+            }
+            prepare_read(read);
+            in_flight++;
+            unsubmitted++;
+        }
+
+        if (in_flight == 0) {
+            continue;
+        }
+
+        int submitted = ring_enter(unsubmitted, 1);
+        if (submitted >= 0) {
+            unsubmitted -= (unsigned)submitted;
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            mvn_log_error("io_uring_enter failed: %s", strerror(errno));
+            SDL_Delay(1);
+        }
+
+        unsigned head = *g_ring.cq_head;
+        unsigned tail = __atomic_load_n(g_ring.cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            const struct io_uring_cqe *cqe  = &g_ring.cqes[head & *g_ring.cq_mask];
+            mvn_aio_read_t            *read = (mvn_aio_read_t *)(uintptr_t)cqe->user_data;
+            in_flight--;
+            if (complete_read(read, cqe->res)) {
+                // Short reads continue ahead of files that were not started yet
+                read->next = ready_head;
+                ready_head = read;
+                if (ready_tail == NULL) {
+                    ready_tail = read;
+                }
+            }
+        }
+        __atomic_store_n(g_ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+
+/**
+ * \brief           Stop the reader thread and release the io_uring instance
+ */
+static void stop_uring(void)
+{
+    if (g_reader_thread != NULL) {
+        SDL_LockMutex(g_queue_lock);
+        g_stop = true;
+        SDL_SignalCondition(g_queue_cond);
+        SDL_UnlockMutex(g_queue_lock);
+        SDL_WaitThread(g_reader_thread, NULL);
+        g_reader_thread = NULL;
+        g_stop          = false;
+    }
+    if (g_queue_cond != NULL) {
+        SDL_DestroyCondition(g_queue_cond);
+        g_queue_cond = NULL;
+    }
+    if (g_queue_lock != NULL) {
+        SDL_DestroyMutex(g_queue_lock);
+        g_queue_lock = NULL;
+    }
+    ring_close();
+}
+
+/**
+ * \brief           Create the io_uring instance and start the reader thread
+ * \return          true on success, false if reads have to use the job system
+ */
+static bool start_uring(void)
+{
+    if (!ring_setup()) {
+        return false;
+    }
+
+    g_queue_lock = SDL_CreateMutex();
+    g_queue_cond = SDL_CreateCondition();
+    if (g_queue_lock != NULL && g_queue_cond != NULL) {
+        g_reader_thread = SDL_CreateThread(reader_thread, "mvn_aio", NULL);
+    }
+    if (g_reader_thread == NULL) {
+        stop_uring();
+        return false;
+    }
+    return true;
+}
+#endif /* MVN_AIO_URING */
+
+/**
+ * \brief           Pick how reads are done, the first time a read is requested
+ * \return          State of the reader, MVN_AIO_READER_STARTING or MVN_AIO_READER_STOPPING while
+ *                  another thread starts or stops it
+ */
+static mvn_aio_reader_state_t start_reader(void)
+{
+    int state = SDL_GetAtomicInt(&g_reader_state);
+    if (state != MVN_AIO_READER_STOPPED ||
+        !SDL_CompareAndSwapAtomicInt(
+            &g_reader_state, MVN_AIO_READER_STOPPED, MVN_AIO_READER_STARTING)) {
+        return (mvn_aio_reader_state_t)SDL_GetAtomicInt(&g_reader_state);
+    }
+
+    SDL_LockSpinlock(&g_handoff_lock);
+    bool enabled = g_uring_enabled;
+    SDL_UnlockSpinlock(&g_handoff_lock);
+
+    bool uring = false;
+#if defined(MVN_AIO_URING)
+    uring = enabled && start_uring();
+#else
+    (void)enabled;
+#endif
+    if (!uring) {
+        mvn_log_debug("io_uring is not available, files are read on the job system workers");
+    }
+    state = uring ? MVN_AIO_READER_URING : MVN_AIO_READER_JOBS;
+    SDL_SetAtomicInt(&g_reader_state, state);
+    return (mvn_aio_reader_state_t)state;
+}
+
+/**
+ * \brief           Wait while another thread starts or stops the reader
+ * \return          State of the reader once it is stopped or running
+ */
+static mvn_aio_reader_state_t wait_for_reader(void)
+{
+    for (;;) {
+        int state = SDL_GetAtomicInt(&g_reader_state);
+        if (state != MVN_AIO_READER_STARTING && state != MVN_AIO_READER_STOPPING) {
+            return (mvn_aio_reader_state_t)state;
+        }
+        SDL_Delay(1);
+    }
+}
+
+/**
+ * \brief           Create a handle owned by the caller and the reader
+ * \note            Files in mounted archives are mapped right away, they need no reading
+ * \param[in]       fileName: Path to the file
+ * \return          Handle or NULL on failure
+ */
+static mvn_aio_read_t *create_read(const char *fileName)
+{
+    if (fileName == NULL) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot read file: NULL filename");
+        return NULL;
+    }
+
+    size_t          length = SDL_strlen(fileName);
+    mvn_aio_read_t *read   = MVN_CALLOC(1, sizeof(mvn_aio_read_t) + length + 1);
+    if (read == NULL) {
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate read handle");
+        return NULL;
+    }
+    SDL_memcpy(read->path, fileName, length + 1);
+    SDL_SetAtomicInt(&read->state, MVN_AIO_PENDING);
+    SDL_SetAtomicInt(&read->refs, 2);
+    read->fd = -1;
+    mvn_job_counter_add(&read->counter);
+
+    mvn_vfs_source_t source = MVN_VFS_SOURCE_NONE;
+    if (!mvn_vfs_open(fileName, read->native, sizeof(read->native), &read->view, &source)) {
+        fail_read(read, mvn_get_error_code(), "%s", mvn_get_error());
+    } else if (source == MVN_VFS_SOURCE_ARCHIVE) {
+        finish_read(read, MVN_AIO_DONE);
+    } else if (source == MVN_VFS_SOURCE_NONE) {
+        SDL_strlcpy(read->native, fileName, sizeof(read->native));
+    }
+    return read;
+}
+
+/**
+ * \brief           Start reading a whole file in the background
+ * \note            See mvn_aio_read_batch()
+ * \param[in]       fileName: Path to the file
+ * \return          Handle to release with mvn_aio_release(), NULL on failure
+ */
+mvn_aio_read_t *mvn_aio_read(const char *fileName)
+{
+    mvn_aio_read_t *read = NULL;
+    mvn_aio_read_batch(&fileName, 1, &read);
+    return read;
+}
+
+/**
+ * \brief           Start reading several whole files in the background
+ * \note            On Linux the reads are handed to the kernel together through io_uring, so the
+ *                  device works on many files at once instead of one after the other. Elsewhere
+ *                  every file is read by a job on the job system workers. Files are resolved
+ *                  through mounted archives and directories like mvn_load_file_data().
+ * \param[in]       files: Paths of the files
+ * \param[in]       count: Number of files
+ * \param[out]      reads: Receives a handle per file, NULL for files that could not be queued.
+ *                  Release each with mvn_aio_release().
+ * \return          Number of handles created
+ */
+int mvn_aio_read_batch(const char *const *files, int count, mvn_aio_read_t **reads)
+{
+    if (files == NULL || reads == NULL || count < 0) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Invalid batch of files to read");
+        return 0;
+    }
+
+    int             created = 0;
+    mvn_aio_read_t *head    = NULL;
+    mvn_aio_read_t *tail    = NULL;
+    for (int i = 0; i < count; i++) {
+        reads[i] = create_read(files[i]);
+        if (reads[i] == NULL) {
+            continue;
+        }
+        created++;
+
+        // Files of archives are done already
+        if (SDL_GetAtomicInt(&reads[i]->state) == MVN_AIO_PENDING) {
+            if (tail != NULL) {
+                tail->next = reads[i];
+            } else {
+                head = reads[i];
+            }
+            tail = reads[i];
+        }
+    }
+
+    bool uring = start_reader() == MVN_AIO_READER_URING;
+#if defined(MVN_AIO_URING)
+    // Queued under the handoff lock, so the reader cannot stop before it took them. Reads
+    // requested while the reader starts or stops run on the workers.
+    SDL_LockSpinlock(&g_handoff_lock);
+    if (uring && head != NULL && SDL_GetAtomicInt(&g_reader_state) == MVN_AIO_READER_URING) {
+        SDL_LockMutex(g_queue_lock);
+        if (g_queue_tail != NULL) {
+            g_queue_tail->next = head;
+        } else {
+            g_queue_head = head;
+        }
+        g_queue_tail = tail;
+        SDL_SignalCondition(g_queue_cond);
+        SDL_UnlockMutex(g_queue_lock);
+        head = NULL;
+    }
+    SDL_UnlockSpinlock(&g_handoff_lock);
+#else
+    (void)uring;
+#endif
+
+    while (head != NULL) {
+        mvn_aio_read_t *next = head->next;
+        if (!mvn_job_run(read_job, head, NULL)) {
+            fail_read(head, MVN_ERROR_INVALID_STATE, "Failed to queue read of '%s'", head->path);
+        }
+        head = next;
+    }
+    return created;
+}
+
+/**
+ * \brief           Check whether a read finished or failed
+ * \param[in]       read: Handle to query
+ * \return          true if the read will not change anymore, false while it is reading
+ */
+bool mvn_aio_is_done(mvn_aio_read_t *read)
+{
+    return read == NULL || SDL_GetAtomicInt(&read->state) != MVN_AIO_PENDING;
+}
+
+/**
+ * \brief           Get the counter of a read, to start jobs once the contents arrived
+ * \note            Pass it to mvn_job_run_after() to chain processing without blocking a worker
+ * \param[in]       read: Handle to query
+ * \return          Counter that reaches zero when the read finished, NULL for a NULL handle
+ */
+mvn_job_counter_t *mvn_aio_get_counter(mvn_aio_read_t *read)
+{
+    return read != NULL ? &read->counter : NULL;
+}
+
+/**
+ * \brief           Wait until a read finished and take its contents
+ * \note            The calling thread runs queued jobs while it waits, see mvn_job_wait()
+ * \param[in]       read: Handle to wait for
+ * \param[out]      view: Receives the contents followed by a NUL byte, release them with
+ *                  mvn_file_unmap(). May be NULL to only wait. The contents can be taken once.
+ * \return          true on success, false on failure
+ */
+bool mvn_aio_wait(mvn_aio_read_t *read, mvn_file_view_t *view)
+{
+    if (view != NULL) {
+        SDL_zerop(view);
+    }
+    if (read == NULL) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot wait for a NULL read");
+    }
+
+    mvn_job_wait(&read->counter);
+    if (SDL_GetAtomicInt(&read->state) == MVN_AIO_FAILED) {
+        return mvn_set_error_code(read->error_code, "%s", read->error);
+    }
+
+    if (view != NULL) {
+        if (read->taken) {
+            return mvn_set_error_code(
+                MVN_ERROR_INVALID_STATE, "Contents of '%s' were already taken", read->path);
+        }
+        *view       = read->view;
+        read->taken = true;
+    }
+    return true;
+}
+
+/**
+ * \brief           Release a handle
+ * \note            A read still running finishes in the background and is then thrown away.
+ *                  Contents that were not taken are released.
+ * \param[in]       read: Handle to release, may be NULL
+ */
+void mvn_aio_release(mvn_aio_read_t *read)
+{
+    if (read != NULL) {
+        release_read(read);
+    }
+}
+
+/**
+ * \brief           Check whether reads go through io_uring
+ * \return          true for io_uring, false if reads run on the job system workers
+ */
+bool mvn_aio_is_using_uring(void)
+{
+    start_reader();
+    return wait_for_reader() == MVN_AIO_READER_URING;
+}
+
+/**
+ * \brief           Allow or forbid reading through io_uring
+ * \note            Finishes the reads in flight, the next read starts the reader with the new
+ *                  setting. Forbidding io_uring is meant for comparing it with the job system
+ *                  and for kernels whose io_uring misbehaves.
+ * \param[in]       enabled: false to read every file on the job system workers
+ */
+void mvn_aio_set_uring_enabled(bool enabled)
+{
+    mvn_aio_shutdown();
+    SDL_LockSpinlock(&g_handoff_lock);
+    g_uring_enabled = enabled;
+    SDL_UnlockSpinlock(&g_handoff_lock);
+}
+
+/**
+ * \brief           Finish the reads in flight and stop the reader
+ * \note            Called by mvn_quit() before the job system stops, so jobs waiting for reads
+ *                  still run. Reads requested afterwards start the reader again.
+ */
+void mvn_aio_shutdown(void)
+{
+    for (;;) {
+        mvn_aio_reader_state_t state = wait_for_reader();
+        if (state == MVN_AIO_READER_STOPPED) {
+            return;
+        }
+        if (state == MVN_AIO_READER_JOBS) {
+            if (SDL_CompareAndSwapAtomicInt(
+                    &g_reader_state, MVN_AIO_READER_JOBS, MVN_AIO_READER_STOPPED)) {
+                return;
+            }
+            continue;
+        }
+
+        // No read is handed to the reader once it is stopping
+        SDL_LockSpinlock(&g_handoff_lock);
+        bool stopping = SDL_CompareAndSwapAtomicInt(
+            &g_reader_state, MVN_AIO_READER_URING, MVN_AIO_READER_STOPPING);
+        SDL_UnlockSpinlock(&g_handoff_lock);
+        if (stopping) {
+#if defined(MVN_AIO_URING)
+            stop_uring();
+#endif
+            SDL_SetAtomicInt(&g_reader_state, MVN_AIO_READER_STOPPED);
+            return;
+        }
+    }
+}
@@ -0,0 +1,516 @@
+/**
+ * \file            mvn-alloc.c
+ * \brief           Pluggable allocator and memory accounting for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn-alloc.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
+
+#include <SDL3/SDL.h>
+
+/* Marker stored in every allocation header to detect foreign or corrupted pointers */
+#define MVN_ALLOC_MAGIC 0x4D564E41u
+
+/* Maximum number of individual leaks logged by mvn_alloc_report_leaks */
+#define MVN_ALLOC_MAX_REPORTED_LEAKS 64
+
+/**
+ * \brief           Header placed in front of every allocation
+ */
+typedef struct mvn_alloc_header_t {
+#if defined(MVN_ALLOC_DEBUG)
+    struct mvn_alloc_header_t *prev; /*!< Previous live allocation */
+    struct mvn_alloc_header_t *next; /*!< Next live allocation */
+    const char                *file; /*!< Source file of the call site */
+    int                        line; /*!< Source line of the call site */
+#endif /* MVN_ALLOC_DEBUG */
+    size_t   size;  /*!< Requested size in bytes */
+    uint32_t tag;   /*!< Owning mvn_alloc_tag_t */
+    uint32_t magic; /*!< MVN_ALLOC_MAGIC while the allocation is alive */
+} mvn_alloc_header_t;
+
+/* Header size rounded up so user pointers keep 16 byte alignment */
+#define MVN_ALLOC_HEADER_SIZE ((sizeof(mvn_alloc_header_t) + 15) & ~(size_t)15)
+
+/* Tag names, indexed by mvn_alloc_tag_t */
+static const char *const g_tag_names[MVN_ALLOC_TAG_COUNT] = {
+    "general", "list", "hashmap", "string", "texture", "text", "file", "arena", "job", "logger",
+};
+
+/* Per-tag statistics, each guarded by its own spinlock */
+static mvn_alloc_stats_t g_stats[MVN_ALLOC_TAG_COUNT];
+static SDL_SpinLock      g_stats_locks[MVN_ALLOC_TAG_COUNT];
+
+#if defined(MVN_ALLOC_DEBUG)
+/* List of live allocations for leak reports */
+static mvn_alloc_header_t g_live_list = { &g_live_list, &g_live_list, NULL, 0, 0, 0, 0 };
+static SDL_SpinLock       g_live_lock;
+#endif /* MVN_ALLOC_DEBUG */
+
+/**
+ * \brief           Default malloc callback
+ */
+static void *default_malloc(void *user_data, size_t size)
+{
+    (void)user_data;
+    return SDL_malloc(size);
+}
+
+/**
+ * \brief           Default realloc callback
+ */
+static void *default_realloc(void *user_data, void *ptr, size_t size)
+{
+    (void)user_data;
+    return SDL_realloc(ptr, size);
+}
+
+/**
+ * \brief           Default free callback
+ */
+static void default_free(void *user_data, void *ptr)
+{
+    (void)user_data;
+    SDL_free(ptr);
+}
+
+/* Active allocator */
+static mvn_allocator_t g_allocator = { default_malloc, default_realloc, default_free, NULL };
+
+/**
+ * \brief           Map an allocation size to its histogram bucket
+ * \param[in]       size: Allocation size in bytes
+ * \return          Bucket index
+ */
+static int histogram_bucket(size_t size)
+{
+    if (size <= 16) {
+        return 0;
+    }
+    if (size > ((size_t)16 << (MVN_ALLOC_HISTOGRAM_BUCKETS - 2))) {
+        return MVN_ALLOC_HISTOGRAM_BUCKETS - 1;
+    }
+    return SDL_MostSignificantBitIndex32((uint32_t)(size - 1)) + 1 - 4;
+}
+
+/**
+ * \brief           Clamp a tag to the valid range
+ * \param[in]       tag: Tag to validate
+ * \return          tag, or MVN_ALLOC_TAG_GENERAL if it is out of range
+ */
+static mvn_alloc_tag_t valid_tag(mvn_alloc_tag_t tag)
+{
+    return ((unsigned)tag < MVN_ALLOC_TAG_COUNT) ? tag : MVN_ALLOC_TAG_GENERAL;
+}
+
+/**
+ * \brief           Account an allocation
+ * \param[in]       tag: Owning tag
+ * \param[in]       size: Allocation size in bytes
+ */
+static void stats_add(mvn_alloc_tag_t tag, size_t size)
+{
+    mvn_alloc_stats_t *stats = &g_stats[tag];
+
+    SDL_LockSpinlock(&g_stats_locks[tag]);
+    stats->live_bytes += size;
+    stats->peak_bytes = SDL_max(stats->peak_bytes, stats->live_bytes);
+    stats->live_count++;
+    stats->allocation_count++;
+    stats->histogram[histogram_bucket(size)]++;
+    SDL_UnlockSpinlock(&g_stats_locks[tag]);
+}
+
+/**
+ * \brief           Account a release
+ * \param[in]       tag: Owning tag
+ * \param[in]       size: Allocation size in bytes
+ */
+static void stats_remove(mvn_alloc_tag_t tag, size_t size)
+{
+    mvn_alloc_stats_t *stats = &g_stats[tag];
+
+    SDL_LockSpinlock(&g_stats_locks[tag]);
+    stats->live_bytes -= SDL_min(stats->live_bytes, size);
+    if (stats->live_count > 0) {
+        stats->live_count--;
+    }
+    SDL_UnlockSpinlock(&g_stats_locks[tag]);
+}
+
+/**
+ * \brief           Account a size change of a live allocation
+ * \param[in]       tag: Owning tag
+ * \param[in]       old_size: Previous size in bytes
+ * \param[in]       new_size: New size in bytes
+ */
+static void stats_resize(mvn_alloc_tag_t tag, size_t old_size, size_t new_size)
+{
+    mvn_alloc_stats_t *stats = &g_stats[tag];
+
+    SDL_LockSpinlock(&g_stats_locks[tag]);
+    stats->live_bytes -= SDL_min(stats->live_bytes, old_size);
+    stats->live_bytes += new_size;
+    stats->peak_bytes = SDL_max(stats->peak_bytes, stats->live_bytes);
+    stats->histogram[histogram_bucket(new_size)]++;
+    SDL_UnlockSpinlock(&g_stats_locks[tag]);
+}
+
+#if defined(MVN_ALLOC_DEBUG)
+/**
+ * \brief           Add an allocation to the live list
+ * \param[in]       header: Header of the allocation
+ */
+static void live_list_insert(mvn_alloc_header_t *header)
+{
+    SDL_LockSpinlock(&g_live_lock);
+    header->prev           = g_live_list.prev;
+    header->next           = &g_live_list;
+    g_live_list.prev->next = header;
+    g_live_list.prev       = header;
+    SDL_UnlockSpinlock(&g_live_lock);
+}
+
+/**
+ * \brief           Remove an allocation from the live list
+ * \param[in]       header: Header of the allocation
+ */
+static void live_list_remove(mvn_alloc_header_t *header)
+{
+    SDL_LockSpinlock(&g_live_lock);
+    header->prev->next = header->next;
+    header->next->prev = header->prev;
+    SDL_UnlockSpinlock(&g_live_lock);
+}
+#endif /* MVN_ALLOC_DEBUG */
+
+/**
+ * \brief           Get the header of a user pointer and validate it
+ * \param[in]       ptr: Pointer returned by one of the mvn_tagged_* functions
+ * \return          Header or NULL if ptr was not allocated by MVN
+ */
+static mvn_alloc_header_t *get_header(void *ptr)
+{
+    mvn_alloc_header_t *header =
+        (mvn_alloc_header_t *)(void *)((unsigned char *)ptr - MVN_ALLOC_HEADER_SIZE);
+    if (header->magic != MVN_ALLOC_MAGIC) {
+        mvn_log_error("Pointer %p was not allocated by MVN or is already freed", ptr);
+        return NULL;
+    }
+    return header;
+}
+
+/**
+ * \brief           Replace the allocator used by the framework
+ * \note            Must be called before the first framework allocation (or after every
+ *                  allocation has been freed), since memory has to be released by the
+ *                  allocator that provided it.
+ * \param[in]       allocator: Allocator callbacks, NULL to restore the SDL allocator
+ * \return          true on success, false on failure
+ */
+bool mvn_set_allocator(const mvn_allocator_t *allocator)
+{
+    if (allocator != NULL &&
+        (allocator->malloc_fn == NULL || allocator->realloc_fn == NULL ||
+         allocator->free_fn == NULL)) {
+        return mvn_set_error("Allocator callbacks must not be NULL");
+    }
+
+    for (int tag = 0; tag < MVN_ALLOC_TAG_COUNT; tag++) {
+        if (g_stats[tag].live_count > 0) {
+            return mvn_set_error("Cannot change allocator while %s allocations are alive",
+                                 g_tag_names[tag]);
+        }
+    }
+
+    if (allocator == NULL) {
+        g_allocator.malloc_fn  = default_malloc;
+        g_allocator.realloc_fn = default_realloc;
+        g_allocator.free_fn    = default_free;
+        g_allocator.user_data  = NULL;
+    } else {
+        g_allocator = *allocator;
+    }
+    return true;
+}
+
+/**
+ * \brief           Get the allocator used by the framework
+ * \return          Active allocator callbacks
+ */
+mvn_allocator_t mvn_get_allocator(void)
+{
+    return g_allocator;
+}
+
+/**
+ * \brief           Get memory statistics of an allocation tag
+ * \param[in]       tag: Tag to query
+ * \return          Snapshot of the statistics, all zero for an invalid tag
+ */
+mvn_alloc_stats_t mvn_get_alloc_stats(mvn_alloc_tag_t tag)
+{
+    mvn_alloc_stats_t stats;
+
+    if ((unsigned)tag >= MVN_ALLOC_TAG_COUNT) {
+        mvn_set_error("Invalid allocation tag %d", (int)tag);
+        SDL_zero(stats);
+        return stats;
+    }
+
+    SDL_LockSpinlock(&g_stats_locks[tag]);
+    stats = g_stats[tag];
+    SDL_UnlockSpinlock(&g_stats_locks[tag]);
+    return stats;
+}
+
+/**
+ * \brief           Get the name of an allocation tag
+ * \param[in]       tag: Tag to query
+ * \return          Tag name, "unknown" for an invalid tag
+ */
+const char *mvn_get_alloc_tag_name(mvn_alloc_tag_t tag)
+{
+    if ((unsigned)tag >= MVN_ALLOC_TAG_COUNT) {
+        return "unknown";
+    }
+    return g_tag_names[tag];
+}
+
+/**
+ * \brief           Account memory that is allocated outside the framework allocator
+ * \note            Used for memory owned by SDL (surfaces, textures, fonts) so it shows up in
+ *                  the statistics of the subsystem that created it
+ * \param[in]       tag: Owning tag
+ * \param[in]       size: Size in bytes
+ */
+void mvn_alloc_track(mvn_alloc_tag_t tag, size_t size)
+{
+    stats_add(valid_tag(tag), size);
+}
+
+/**
+ * \brief           Release memory accounted with mvn_alloc_track
+ * \param[in]       tag: Owning tag
+ * \param[in]       size: Size in bytes, must match the tracked size
+ */
+void mvn_alloc_untrack(mvn_alloc_tag_t tag, size_t size)
+{
+    stats_remove(valid_tag(tag), size);
+}
+
+/**
+ * \brief           Log every allocation that is still alive
+ * \note            Individual call sites are only available in MVN_ALLOC_DEBUG builds, other
+ *                  builds log a summary per tag
+ * \return          Number of live allocations
+ */
+size_t mvn_alloc_report_leaks(void)
+{
+    size_t total = 0;
+
+#if defined(MVN_ALLOC_DEBUG)
+    size_t reported = 0;
+    SDL_LockSpinlock(&g_live_lock);
+    for (mvn_alloc_header_t *header = g_live_list.next; header != &g_live_list;
+         header                     = header->next) {
+        if (reported++ < MVN_ALLOC_MAX_REPORTED_LEAKS) {
+            mvn_log_warn("Leaked %zu bytes (%s) allocated at %s:%d",
+                         header->size,
+                         g_tag_names[header->tag],
+                         header->file,
+                         header->line);
+        }
+    }
+    SDL_UnlockSpinlock(&g_live_lock);
+    if (reported > MVN_ALLOC_MAX_REPORTED_LEAKS) {
+        mvn_log_warn("%zu more leaked allocations not shown",
+                     reported - MVN_ALLOC_MAX_REPORTED_LEAKS);
+    }
+#endif /* MVN_ALLOC_DEBUG */
+
+    for (int tag = 0; tag < MVN_ALLOC_TAG_COUNT; tag++) {
+        mvn_alloc_stats_t stats = mvn_get_alloc_stats((mvn_alloc_tag_t)tag);
+        if (stats.live_count > 0) {
+            mvn_log_warn("%s: %zu allocations (%zu bytes) still alive",
+                         g_tag_names[tag],
+                         stats.live_count,
+                         stats.live_bytes);
+            total += stats.live_count;
+        }
+    }
+
+    return total;
+}
+
+/**
+ * \brief           Allocate memory attributed to a tag
+ * \param[in]       tag: Owning tag
+ * \param[in]       size: Number of bytes
+ * \param[in]       file: Source file of the call site
+ * \param[in]       line: Source line of the call site
+ * \return          Pointer to the memory or NULL on failure
+ */
+void *mvn_tagged_malloc(mvn_alloc_tag_t tag, size_t size, const char *file, int line)
+{
+    if (size > SIZE_MAX - MVN_ALLOC_HEADER_SIZE) {
+        return NULL;
+    }
+
+    mvn_alloc_header_t *header = g_allocator.malloc_fn(g_allocator.user_data,
+                                                       MVN_ALLOC_HEADER_SIZE + size);
+    if (header == NULL) {
+        return NULL;
+    }
+
+    tag           = valid_tag(tag);
+    header->size  = size;
+    header->tag   = (uint32_t)tag;
+    header->magic = MVN_ALLOC_MAGIC;
+#if defined(MVN_ALLOC_DEBUG)
+    header->file = file;
+    header->line = line;
+    live_list_insert(header);
+#else
+    (void)file;
+    (void)line;
+#endif /* MVN_ALLOC_DEBUG */
+
+    stats_add(tag, size);
+    return (unsigned char *)header + MVN_ALLOC_HEADER_SIZE;
+}
+
+/**
+ * \brief           Allocate zeroed memory attributed to a tag
+ * \param[in]       tag: Owning tag
+ * \param[in]       count: Number of elements
+ * \param[in]       size: Size of each element in bytes
+ * \param[in]       file: Source file of the call site
+ * \param[in]       line: Source line of the call site
+ * \return          Pointer to the memory or NULL on failure
+ */
+void *
+mvn_tagged_calloc(mvn_alloc_tag_t tag, size_t count, size_t size, const char *file, int line)
+{
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void *ptr = mvn_tagged_malloc(tag, count * size, file, line);
+    if (ptr != NULL) {
+        SDL_memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+/**
+ * \brief           Resize memory allocated with mvn_tagged_malloc
+ * \note            The allocation keeps the tag it was created with
+ * \param[in]       tag: Tag used if ptr is NULL
+ * \param[in]       ptr: Allocation to resize, NULL to allocate
+ * \param[in]       size: New size in bytes, 0 to free
+ * \param[in]       file: Source file of the call site
+ * \param[in]       line: Source line of the call site
+ * \return          Pointer to the resized memory or NULL on failure
+ */
+void *mvn_tagged_realloc(mvn_alloc_tag_t tag, void *ptr, size_t size, const char *file, int line)
+{
+    if (ptr == NULL) {
+        return mvn_tagged_malloc(tag, size, file, line);
+    }
+
+    if (size == 0) {
+        mvn_tagged_free(ptr);
+        return NULL;
+    }
+
+    if (size > SIZE_MAX - MVN_ALLOC_HEADER_SIZE) {
+        return NULL;
+    }
+
+    mvn_alloc_header_t *header = get_header(ptr);
+    if (header == NULL) {
+        return NULL;
+    }
+
+    size_t old_size = header->size;
+#if defined(MVN_ALLOC_DEBUG)
+    live_list_remove(header);
+#endif /* MVN_ALLOC_DEBUG */
+
+    mvn_alloc_header_t *resized =
+        g_allocator.realloc_fn(g_allocator.user_data, header, MVN_ALLOC_HEADER_SIZE + size);
+    if (resized == NULL) {
+#if defined(MVN_ALLOC_DEBUG)
+        live_list_insert(header);
+#endif /* MVN_ALLOC_DEBUG */
+        return NULL;
+    }
+
+    resized->size = size;
+#if defined(MVN_ALLOC_DEBUG)
+    resized->file = file;
+    resized->line = line;
+    live_list_insert(resized);
+#else
+    (void)file;
+    (void)line;
+#endif /* MVN_ALLOC_DEBUG */
+
+    stats_resize((mvn_alloc_tag_t)resized->tag, old_size, size);
+    return (unsigned char *)resized + MVN_ALLOC_HEADER_SIZE;
+}
+
+/**
+ * \brief           Free memory allocated with one of the mvn_tagged_* functions
+ * \param[in]       ptr: Memory to free, NULL is ignored
+ */
+void mvn_tagged_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    mvn_alloc_header_t *header = get_header(ptr);
+    if (header == NULL) {
+        return;
+    }
+
+#if defined(MVN_ALLOC_DEBUG)
+    live_list_remove(header);
+#endif /* MVN_ALLOC_DEBUG */
+
+    stats_remove((mvn_alloc_tag_t)header->tag, header->size);
+    header->magic = 0;
+    g_allocator.free_fn(g_allocator.user_data, header);
+}
@@ -0,0 +1,467 @@
+/**
+ * \file            mvn-arena.c
+ * \brief           Linear arena allocator for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_ARENA
+
+#include "mvn/mvn-arena.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-utils.h"
+
+#include <SDL3/SDL.h>
+
+/* Default block size if none is specified */
+#define MVN_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/* Alignment used by mvn_arena_alloc, large enough for any scalar and SIMD type */
+#define MVN_ARENA_DEFAULT_ALIGNMENT 16
+
+/* Thread local storage for per-thread arenas */
+static SDL_TLSID thread_arena_tls_id;
+
+/**
+ * \brief           Get the start of a block's data area
+ * \param[in]       block: Block to query
+ * \return          Pointer to the first usable byte
+ */
+static unsigned char *block_data(mvn_arena_block_t *block)
+{
+    return (unsigned char *)(block + 1);
+}
+
+/**
+ * \brief           Compute the padding needed to align the next allocation in a block
+ * \param[in]       block: Block to allocate from
+ * \param[in]       alignment: Required alignment (power of two)
+ * \return          Number of padding bytes
+ */
+static size_t block_padding(mvn_arena_block_t *block, size_t alignment)
+{
+    uintptr_t address = (uintptr_t)(block_data(block) + block->used);
+    return (size_t)((alignment - (address & (alignment - 1))) & (alignment - 1));
+}
+
+/**
+ * \brief           Check whether a block can serve an allocation
+ * \param[in]       block: Block to check
+ * \param[in]       size: Allocation size in bytes
+ * \param[in]       alignment: Required alignment (power of two)
+ * \return          true if the allocation fits, false otherwise
+ */
+static bool block_fits(mvn_arena_block_t *block, size_t size, size_t alignment)
+{
+    size_t padding = block_padding(block, alignment);
+    return block->used + padding <= block->size && size <= block->size - block->used - padding;
+}
+
+/**
+ * \brief           Allocate a new block from the general allocator
+ * \param[in]       arena: Arena the block will belong to
+ * \param[in]       min_size: Minimum number of usable bytes
+ * \return          New block or NULL on failure
+ */
+static mvn_arena_block_t *create_block(mvn_arena_t *arena, size_t min_size)
+{
+    size_t size = SDL_max(arena->block_size, min_size);
+    if (size > SIZE_MAX - sizeof(mvn_arena_block_t)) {
+        mvn_set_error("Integer overflow detected when calculating arena block size");
+        return NULL;
+    }
+
+    mvn_arena_block_t *block = MVN_MALLOC(sizeof(mvn_arena_block_t) + size);
+    if (block == NULL) {
+        mvn_set_error("Failed to allocate arena block of %zu bytes", size);
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    arena->stats.reserved_bytes += size;
+    arena->stats.block_count++;
+    arena->stats.heap_allocations++;
+    return block;
+}
+
+/**
+ * \brief           Free every block of an arena
+ * \param[in]       arena: Arena to release blocks of
+ */
+static void free_blocks(mvn_arena_t *arena)
+{
+    mvn_arena_block_t *block = arena->first;
+    while (block != NULL) {
+        mvn_arena_block_t *next = block->next;
+        MVN_FREE(block);
+        block = next;
+    }
+
+    arena->first                = NULL;
+    arena->current              = NULL;
+    arena->stats.reserved_bytes = 0;
+    arena->stats.block_count    = 0;
+}
+
+/**
+ * \brief           Recompute used bytes after the current block moved backwards
+ * \param[in]       arena: Arena to update
+ */
+static void update_used_bytes(mvn_arena_t *arena)
+{
+    size_t used = 0;
+    for (mvn_arena_block_t *block = arena->first; block != NULL; block = block->next) {
+        used += block->used;
+        if (block == arena->current) {
+            break;
+        }
+    }
+    arena->stats.used_bytes = used;
+}
+
+/**
+ * \brief           Initialize a new arena
+ * \note            No memory is reserved for blocks until the first allocation
+ * \param[in]       block_size: Size of each block in bytes (0 for default)
+ * \return          New arena or NULL on failure
+ */
+mvn_arena_t *mvn_arena_init(size_t block_size)
+{
+    /* Use default block size if not specified */
+    if (block_size == 0) {
+        block_size = MVN_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+
+    mvn_arena_t *arena = MVN_MALLOC(sizeof(mvn_arena_t));
+    if (arena == NULL) {
+        mvn_set_error("Failed to allocate memory for arena");
+        return NULL;
+    }
+
+    arena->first      = NULL;
+    arena->current    = NULL;
+    arena->block_size = block_size;
+    SDL_zero(arena->stats);
+
+    mvn_log_debug("Arena initialized with block_size=%zu", block_size);
+    return arena;
+}
+
+/**
+ * \brief           Free an arena and every allocation made from it
+ * \param[in]       arena: Arena to free
+ */
+void mvn_arena_free(mvn_arena_t *arena)
+{
+    if (arena == NULL) {
+        return;
+    }
+
+    free_blocks(arena);
+    MVN_FREE(arena);
+    mvn_log_debug("Arena freed");
+}
+
+/**
+ * \brief           Allocate memory from an arena with a specific alignment
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       alignment: Required alignment, must be a power of two
+ * \return          Pointer to uninitialized memory or NULL on failure
+ */
+void *mvn_arena_alloc_aligned(mvn_arena_t *arena, size_t size, size_t alignment)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot allocate from NULL arena");
+        return NULL;
+    }
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        mvn_set_error("Arena alignment %zu is not a power of two", alignment);
+        return NULL;
+    }
+
+    if (size > SIZE_MAX - alignment) {
+        mvn_set_error("Integer overflow detected when calculating arena allocation size");
+        return NULL;
+    }
+
+    mvn_arena_block_t *block = arena->current;
+    if (block == NULL || !block_fits(block, size, alignment)) {
+        /* Reuse blocks left over from before a reset or rewind, they are free past current */
+        mvn_arena_block_t *next = block != NULL ? block->next : arena->first;
+        while (next != NULL) {
+            next->used = 0;
+            if (block_fits(next, size, alignment)) {
+                break;
+            }
+            next = next->next;
+        }
+
+        if (next == NULL) {
+            next = create_block(arena, size + alignment);
+            if (next == NULL) {
+                return NULL;
+            }
+
+            /* Link the new block right after the current one to keep markers valid */
+            if (block == NULL) {
+                next->next   = arena->first;
+                arena->first = next;
+            } else {
+                next->next  = block->next;
+                block->next = next;
+            }
+        }
+
+        arena->current = next;
+        block          = next;
+    }
+
+    size_t         padding = block_padding(block, alignment);
+    unsigned char *result  = block_data(block) + block->used + padding;
+    block->used += padding + size;
+
+    arena->stats.used_bytes += padding + size;
+    arena->stats.peak_used_bytes = SDL_max(arena->stats.peak_used_bytes, arena->stats.used_bytes);
+    arena->stats.allocation_count++;
+    arena->stats.allocated_bytes += size;
+
+    return result;
+}
+
+/**
+ * \brief           Allocate memory from an arena
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to uninitialized memory aligned to 16 bytes or NULL on failure
+ */
+void *mvn_arena_alloc(mvn_arena_t *arena, size_t size)
+{
+    return mvn_arena_alloc_aligned(arena, size, MVN_ARENA_DEFAULT_ALIGNMENT);
+}
+
+/**
+ * \brief           Resize an allocation made from an arena
+ * \note            The most recent allocation grows or shrinks in place, anything else is
+ *                  copied to a new allocation. The old memory is only reclaimed on reset.
+ * \param[in]       arena: Arena the allocation belongs to
+ * \param[in]       ptr: Allocation to resize, NULL to allocate
+ * \param[in]       old_size: Current size of the allocation in bytes
+ * \param[in]       new_size: Requested size in bytes
+ * \return          Pointer to the resized allocation or NULL on failure
+ */
+void *mvn_arena_realloc(mvn_arena_t *arena, void *ptr, size_t old_size, size_t new_size)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot reallocate from NULL arena");
+        return NULL;
+    }
+
+    if (ptr == NULL) {
+        return mvn_arena_alloc(arena, new_size);
+    }
+
+    /* Extend or shrink in place when ptr is the last allocation of the current block */
+    mvn_arena_block_t *block = arena->current;
+    if (block != NULL && (unsigned char *)ptr + old_size == block_data(block) + block->used) {
+        size_t offset = (size_t)((unsigned char *)ptr - block_data(block));
+        if (new_size <= block->size - offset) {
+            block->used = offset + new_size;
+            if (new_size > old_size) {
+                arena->stats.used_bytes += new_size - old_size;
+                arena->stats.allocated_bytes += new_size - old_size;
+                arena->stats.peak_used_bytes =
+                    SDL_max(arena->stats.peak_used_bytes, arena->stats.used_bytes);
+            } else {
+                arena->stats.used_bytes -= old_size - new_size;
+            }
+            return ptr;
+        }
+    }
+
+    if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void *result = mvn_arena_alloc(arena, new_size);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    SDL_memcpy(result, ptr, old_size);
+    return result;
+}
+
+/**
+ * \brief           Capture the current arena position
+ * \param[in]       arena: Arena to mark
+ * \return          Marker to pass to mvn_arena_rewind
+ */
+mvn_arena_marker_t mvn_arena_mark(const mvn_arena_t *arena)
+{
+    mvn_arena_marker_t marker = { NULL, 0 };
+
+    if (arena == NULL) {
+        mvn_set_error("Cannot mark NULL arena");
+        return marker;
+    }
+
+    if (arena->current != NULL) {
+        marker.block = arena->current;
+        marker.used  = arena->current->used;
+    }
+    return marker;
+}
+
+/**
+ * \brief           Release every allocation made after a marker was taken
+ * \note            Markers must be rewound in reverse order and become invalid after a reset
+ * \param[in]       arena: Arena to rewind
+ * \param[in]       marker: Marker from mvn_arena_mark
+ */
+void mvn_arena_rewind(mvn_arena_t *arena, mvn_arena_marker_t marker)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot rewind NULL arena");
+        return;
+    }
+
+    if (marker.block == NULL) {
+        /* Marker taken before the first allocation */
+        if (arena->first != NULL) {
+            arena->first->used = 0;
+        }
+        arena->current          = arena->first;
+        arena->stats.used_bytes = 0;
+        return;
+    }
+
+    arena->current      = marker.block;
+    marker.block->used  = marker.used;
+    update_used_bytes(arena);
+}
+
+/**
+ * \brief           Release every allocation of an arena while keeping its memory
+ * \note            If the arena spilled into several blocks they are merged into a single
+ *                  block on the next allocation, so steady state usage needs one block.
+ * \param[in]       arena: Arena to reset
+ */
+void mvn_arena_reset(mvn_arena_t *arena)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot reset NULL arena");
+        return;
+    }
+
+    if (arena->stats.block_count > 1) {
+        arena->block_size = SDL_max(arena->block_size, arena->stats.reserved_bytes);
+        free_blocks(arena);
+    } else if (arena->first != NULL) {
+        arena->first->used = 0;
+        arena->current     = arena->first;
+    }
+
+    arena->stats.used_bytes = 0;
+    arena->stats.reset_count++;
+}
+
+/**
+ * \brief           Get allocation statistics of an arena
+ * \param[in]       arena: Arena to query
+ * \return          Statistics, all zero if arena is NULL
+ */
+mvn_arena_stats_t mvn_arena_get_stats(const mvn_arena_t *arena)
+{
+    mvn_arena_stats_t stats;
+
+    if (arena == NULL) {
+        mvn_set_error("Cannot get stats of NULL arena");
+        SDL_zero(stats);
+        return stats;
+    }
+    return arena->stats;
+}
+
+/**
+ * \brief           Destructor for per-thread arenas
+ * \param[in]       value: Arena stored in thread local storage
+ */
+static void SDLCALL free_thread_arena(void *value)
+{
+    mvn_arena_free((mvn_arena_t *)value);
+}
+
+/**
+ * \brief           Get the arena owned by the calling thread
+ * \note            Created on first use and freed when the thread exits. Nothing resets it
+ *                  automatically, use mvn_arena_mark and mvn_arena_rewind to scope allocations.
+ * \return          Arena of the calling thread or NULL on failure
+ */
+mvn_arena_t *mvn_get_thread_arena(void)
+{
+    mvn_arena_t *arena = (mvn_arena_t *)SDL_GetTLS(&thread_arena_tls_id);
+    if (arena != NULL) {
+        return arena;
+    }
+
+    arena = mvn_arena_init(0);
+    if (arena == NULL) {
+        return NULL;
+    }
+
+    if (!SDL_SetTLS(&thread_arena_tls_id, arena, free_thread_arena)) {
+        mvn_set_error("Failed to store thread arena: %s", SDL_GetError());
+        mvn_arena_free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+/**
+ * \brief           Free the calling thread's scratch arena
+ * \note            Arenas of other threads are released when those threads exit, the main
+ *                  thread calls this from mvn_quit
+ */
+void mvn_release_thread_arena(void)
+{
+    mvn_arena_t *arena = (mvn_arena_t *)SDL_GetTLS(&thread_arena_tls_id);
+    if (arena == NULL) {
+        return;
+    }
+
+    SDL_SetTLS(&thread_arena_tls_id, NULL, NULL);
+    mvn_arena_free(arena);
+}
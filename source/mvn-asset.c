@@ -0,0 +1,473 @@
+/**
+ * \file            mvn-asset.c
+ * \brief           Asynchronous asset loading for MVN game framework
+ */
+
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_TEXTURE
+
+#include "mvn/mvn-asset.h"
+
+#include "mvn/mvn-aio.h"
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-core.h"
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-file.h"
+#include "mvn/mvn-job.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-profile.h"
+#include "mvn/mvn-text.h"
+#include "mvn/mvn-texture.h"
+#include "mvn/mvn-utils.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+/**
+ * \brief           Kind of asset a handle loads
+ */
+typedef enum mvn_asset_type_t {
+    MVN_ASSET_TYPE_TEXTURE = 0, /*!< Image decoded on a worker, uploaded on the main thread */
+    MVN_ASSET_TYPE_FONT,        /*!< Font opened on a worker */
+} mvn_asset_type_t;
+
+/**
+ * \brief           Handle of an asset loaded in the background
+ * \note            Owned by the caller and by the loading pipeline, freed when both let go
+ */
+struct mvn_asset_t {
+    struct mvn_asset_t *next;      /*!< Link in the upload queue */
+    mvn_asset_type_t    type;      /*!< Kind of asset */
+    SDL_AtomicInt       state;     /*!< Current mvn_asset_state_t */
+    SDL_AtomicInt       cancelled; /*!< Non-zero once cancellation was requested */
+    SDL_AtomicInt       refs;      /*!< Owners of the handle */
+    bool                taken;     /*!< The result was handed to the caller */
+    float               font_size; /*!< Point size of a font */
+    mvn_aio_read_t     *read;      /*!< Read of the image file, until it is decoded */
+    mvn_image_t        *image;     /*!< Decoded image waiting for the upload */
+    mvn_texture_t      *texture;   /*!< Loaded texture */
+    TTF_Font           *font;      /*!< Loaded font */
+    char                path[];    /*!< File to load */
+};
+
+/* Default time per frame spent creating textures from decoded images */
+#define MVN_ASSET_DEFAULT_UPLOAD_BUDGET 0.002
+
+/* Decoded images waiting for the main thread, oldest first */
+static SDL_SpinLock g_upload_lock;
+static mvn_asset_t *g_upload_head = NULL;
+static mvn_asset_t *g_upload_tail = NULL;
+
+static double        g_upload_budget = MVN_ASSET_DEFAULT_UPLOAD_BUDGET; // Seconds per frame
+static SDL_AtomicInt g_requested;                                     // Loads in this batch
+static SDL_AtomicInt g_finished;                                      // Finished loads in it
+
+/**
+ * \brief           Drop one owner of a handle and free it with the last one
+ * \param[in]       asset: Handle to release
+ */
+static void release_asset(mvn_asset_t *asset)
+{
+    if (!SDL_AtomicDecRef(&asset->refs)) {
+        return;
+    }
+
+    mvn_aio_release(asset->read);
+    mvn_unload_image(asset->image);
+    if (!asset->taken) {
+        mvn_unload_texture(asset->texture);
+        mvn_unload_font(asset->font);
+    }
+    MVN_FREE(asset);
+}
+
+/**
+ * \brief           End the pipeline's part of a load
+ * \param[in]       asset: Handle that finished
+ * \param[in]       state: Final state
+ */
+static void finish_asset(mvn_asset_t *asset, mvn_asset_state_t state)
+{
+    SDL_SetAtomicInt(&asset->state, (int)state);
+    SDL_AddAtomicInt(&g_finished, 1);
+    release_asset(asset);
+}
+
+/**
+ * \brief           Create a handle owned by the caller and the pipeline
+ * \param[in]       type: Kind of asset
+ * \param[in]       filename: File to load
+ * \return          Handle or NULL on failure
+ */
+static mvn_asset_t *create_asset(mvn_asset_type_t type, const char *filename)
+{
+    if (filename == NULL) {
+        mvn_set_error("Invalid filename for asynchronous load");
+        return NULL;
+    }
+
+    size_t       length = SDL_strlen(filename);
+    mvn_asset_t *asset  = MVN_CALLOC(1, sizeof(mvn_asset_t) + length + 1);
+    if (asset == NULL) {
+        mvn_set_error("Failed to allocate asset handle");
+        return NULL;
+    }
+    asset->type = type;
+    SDL_memcpy(asset->path, filename, length + 1);
+    SDL_SetAtomicInt(&asset->state, MVN_ASSET_PENDING);
+    SDL_SetAtomicInt(&asset->refs, 2);
+
+    // Start a new batch once everything requested before has finished
+    if (SDL_GetAtomicInt(&g_requested) == SDL_GetAtomicInt(&g_finished)) {
+        SDL_SetAtomicInt(&g_requested, 0);
+        SDL_SetAtomicInt(&g_finished, 0);
+    }
+    SDL_AddAtomicInt(&g_requested, 1);
+    return asset;
+}
+
+/**
+ * \brief           Queue a decoded image for the upload on the main thread
+ * \param[in]       asset: Handle with a decoded image
+ */
+static void push_upload(mvn_asset_t *asset)
+{
+    asset->next = NULL;
+    SDL_LockSpinlock(&g_upload_lock);
+    if (g_upload_tail != NULL) {
+        g_upload_tail->next = asset;
+    } else {
+        g_upload_head = asset;
+    }
+    g_upload_tail = asset;
+    SDL_UnlockSpinlock(&g_upload_lock);
+}
+
+/**
+ * \brief           Take the oldest handle waiting for its upload
+ * \return          Handle or NULL if none is waiting
+ */
+static mvn_asset_t *pop_upload(void)
+{
+    SDL_LockSpinlock(&g_upload_lock);
+    mvn_asset_t *asset = g_upload_head;
+    if (asset != NULL) {
+        g_upload_head = asset->next;
+        if (g_upload_head == NULL) {
+            g_upload_tail = NULL;
+        }
+    }
+    SDL_UnlockSpinlock(&g_upload_lock);
+    return asset;
+}
+
+/**
+ * \brief           Decode an image on a worker
+ * \param[in]       user_data: Handle to load
+ */
+static void decode_texture_job(void *user_data)
+{
+    mvn_asset_t *asset = (mvn_asset_t *)user_data;
+    if (SDL_GetAtomicInt(&asset->cancelled) != 0) {
+        finish_asset(asset, MVN_ASSET_CANCELLED);
+        return;
+    }
+
+    // The job starts once the read finished, so waiting only takes the contents
+    SDL_SetAtomicInt(&asset->state, MVN_ASSET_DECODING);
+    mvn_file_view_t view;
+    if (!mvn_aio_wait(asset->read, &view)) {
+        mvn_log_error("Failed to load image: %s - %s", asset->path, mvn_get_error());
+        finish_asset(asset, MVN_ASSET_FAILED);
+        return;
+    }
+    mvn_aio_release(asset->read);
+    asset->read = NULL;
+
+    asset->image = mvn_load_image_from_memory(SDL_strrchr(asset->path, '.'), view.data, view.size);
+    mvn_file_unmap(&view);
+    if (asset->image == NULL) {
+        finish_asset(asset, MVN_ASSET_FAILED);
+        return;
+    }
+
+    // Textures can only be created on the main thread
+    SDL_SetAtomicInt(&asset->state, MVN_ASSET_UPLOADING);
+    push_upload(asset);
+}
+
+/**
+ * \brief           Open a font on a worker
+ * \param[in]       user_data: Handle to load
+ */
+static void open_font_job(void *user_data)
+{
+    mvn_asset_t *asset = (mvn_asset_t *)user_data;
+    if (SDL_GetAtomicInt(&asset->cancelled) != 0) {
+        finish_asset(asset, MVN_ASSET_CANCELLED);
+        return;
+    }
+
+    SDL_SetAtomicInt(&asset->state, MVN_ASSET_DECODING);
+    asset->font = mvn_load_font(asset->path, asset->font_size);
+    if (asset->font == NULL) {
+        finish_asset(asset, MVN_ASSET_FAILED);
+    } else if (SDL_GetAtomicInt(&asset->cancelled) != 0) {
+        finish_asset(asset, MVN_ASSET_CANCELLED);
+    } else {
+        finish_asset(asset, MVN_ASSET_READY);
+    }
+}
+
+/**
+ * \brief           Load a texture in the background
+ * \note            The file is read right away with mvn_aio_read(), so the reads of many
+ *                  textures requested together overlap. The image is decoded on a worker once
+ *                  its file was read and turned into a texture by mvn_process_asset_uploads() on
+ *                  the main thread. Poll the handle with
+ *                  mvn_asset_get_state() and take the texture with mvn_asset_get_texture().
+ * \param[in]       filename: Name of the image file to load
+ * \return          Handle to release with mvn_asset_release(), NULL on failure
+ */
+mvn_asset_t *mvn_load_texture_async(const char *filename)
+{
+    mvn_asset_t *asset = create_asset(MVN_ASSET_TYPE_TEXTURE, filename);
+    if (asset == NULL) {
+        return NULL;
+    }
+
+    asset->read = mvn_aio_read(filename);
+    if (asset->read == NULL ||
+        !mvn_job_run_after(mvn_aio_get_counter(asset->read), decode_texture_job, asset, NULL)) {
+        finish_asset(asset, MVN_ASSET_FAILED);
+    }
+    return asset;
+}
+
+/**
+ * \brief           Load a font in the background
+ * \note            The font is opened on a worker and is ready without a main thread step. Take
+ *                  it with mvn_asset_get_font().
+ * \param[in]       filename: Name of the font file
+ * \param[in]       size: Size of the font in points
+ * \return          Handle to release with mvn_asset_release(), NULL on failure
+ */
+mvn_asset_t *mvn_load_font_async(const char *filename, float size)
+{
+    // Start SDL_ttf here rather than racing to do it from several workers
+    if (!TTF_WasInit() && !TTF_Init()) {
+        mvn_set_error("Failed to initialize SDL_ttf: %s", SDL_GetError());
+        return NULL;
+    }
+
+    mvn_asset_t *asset = create_asset(MVN_ASSET_TYPE_FONT, filename);
+    if (asset == NULL) {
+        return NULL;
+    }
+    asset->font_size = size;
+
+    if (!mvn_job_run(open_font_job, asset, NULL)) {
+        finish_asset(asset, MVN_ASSET_FAILED);
+    }
+    return asset;
+}
+
+/**
+ * \brief           Get the loading state of an asset
+ * \param[in]       asset: Handle to query
+ * \return          Current state, MVN_ASSET_FAILED for a NULL handle
+ */
+mvn_asset_state_t mvn_asset_get_state(const mvn_asset_t *asset)
+{
+    if (asset == NULL) {
+        return MVN_ASSET_FAILED;
+    }
+    return (mvn_asset_state_t)SDL_GetAtomicInt((SDL_AtomicInt *)&asset->state);
+}
+
+/**
+ * \brief           Check whether an asset finished loading, failed or was cancelled
+ * \param[in]       asset: Handle to query
+ * \return          true if the asset will not change anymore, false while it is loading
+ */
+bool mvn_asset_is_done(const mvn_asset_t *asset)
+{
+    return mvn_asset_get_state(asset) >= MVN_ASSET_READY;
+}
+
+/**
+ * \brief           Take the texture of a loaded asset
+ * \note            The texture belongs to the caller from then on and is not freed by
+ *                  mvn_asset_release(). Unload it with mvn_unload_texture().
+ * \param[in]       asset: Handle of a texture load
+ * \return          Texture, NULL if the asset is not ready or not a texture
+ */
+mvn_texture_t *mvn_asset_get_texture(mvn_asset_t *asset)
+{
+    if (asset == NULL || asset->type != MVN_ASSET_TYPE_TEXTURE ||
+        mvn_asset_get_state(asset) != MVN_ASSET_READY) {
+        return NULL;
+    }
+    asset->taken = true;
+    return asset->texture;
+}
+
+/**
+ * \brief           Take the font of a loaded asset
+ * \note            The font belongs to the caller from then on and is not freed by
+ *                  mvn_asset_release(). Unload it with mvn_unload_font().
+ * \param[in]       asset: Handle of a font load
+ * \return          Font, NULL if the asset is not ready or not a font
+ */
+TTF_Font *mvn_asset_get_font(mvn_asset_t *asset)
+{
+    if (asset == NULL || asset->type != MVN_ASSET_TYPE_FONT ||
+        mvn_asset_get_state(asset) != MVN_ASSET_READY) {
+        return NULL;
+    }
+    asset->taken = true;
+    return asset->font;
+}
+
+/**
+ * \brief           Cancel loading an asset
+ * \note            The state turns to MVN_ASSET_CANCELLED at the next step of the pipeline.
+ *                  Work already running is finished and thrown away.
+ * \param[in]       asset: Handle to cancel
+ * \return          true if the asset was still loading, false if it was already done
+ */
+bool mvn_asset_cancel(mvn_asset_t *asset)
+{
+    if (asset == NULL || mvn_asset_is_done(asset)) {
+        return false;
+    }
+    SDL_SetAtomicInt(&asset->cancelled, 1);
+    return true;
+}
+
+/**
+ * \brief           Release a handle
+ * \note            Cancels the load if it is still running and frees a result that was not taken
+ * \param[in]       asset: Handle to release, may be NULL
+ */
+void mvn_asset_release(mvn_asset_t *asset)
+{
+    if (asset != NULL) {
+        mvn_asset_cancel(asset);
+        release_asset(asset);
+    }
+}
+
+/**
+ * \brief           Get the progress of the current batch of asynchronous loads
+ * \note            A batch starts with the first load requested while nothing else is loading,
+ *                  so the value fits a loading screen that requests all of its assets up front
+ * \return          Fraction of the batch that finished, 1.0 when nothing is loading
+ */
+float mvn_get_asset_load_progress(void)
+{
+    int requested = SDL_GetAtomicInt(&g_requested);
+    int finished  = SDL_GetAtomicInt(&g_finished);
+    if (requested <= 0 || finished >= requested) {
+        return 1.0f;
+    }
+    return (float)finished / (float)requested;
+}
+
+/**
+ * \brief           Get the number of asynchronous loads that have not finished
+ * \return          Number of loads in flight
+ */
+int mvn_get_pending_asset_count(void)
+{
+    return SDL_max(0, SDL_GetAtomicInt(&g_requested) - SDL_GetAtomicInt(&g_finished));
+}
+
+/**
+ * \brief           Set the time per frame spent creating textures from decoded images
+ * \note            At least one texture is created per frame regardless of the budget
+ * \param[in]       seconds: Budget in seconds, negative values are treated as zero
+ */
+void mvn_set_asset_upload_budget(double seconds)
+{
+    g_upload_budget = SDL_max(0.0, seconds);
+}
+
+/**
+ * \brief           Create textures for decoded images until the frame budget is spent
+ * \note            Called by mvn_begin_drawing(), must run on the main thread
+ * \return          Number of textures created
+ */
+size_t mvn_process_asset_uploads(void)
+{
+    uint64_t start    = SDL_GetPerformanceCounter();
+    uint64_t budget   = (uint64_t)(g_upload_budget * (double)SDL_GetPerformanceFrequency());
+    size_t   uploaded = 0;
+
+    mvn_asset_t *asset;
+    while ((asset = pop_upload()) != NULL) {
+        if (SDL_GetAtomicInt(&asset->cancelled) != 0) {
+            finish_asset(asset, MVN_ASSET_CANCELLED);
+            continue;
+        }
+
+        asset->texture = mvn_image_to_texture(mvn_get_renderer(), asset->image);
+        mvn_unload_image(asset->image);
+        asset->image = NULL;
+
+        if (asset->texture == NULL) {
+            finish_asset(asset, MVN_ASSET_FAILED);
+        } else {
+            // Match mvn_load_texture, which keeps pixel art sharp
+            SDL_SetTextureScaleMode(asset->texture, SDL_SCALEMODE_NEAREST);
+            finish_asset(asset, MVN_ASSET_READY);
+        }
+
+        uploaded++;
+        if (SDL_GetPerformanceCounter() - start >= budget) {
+            break;
+        }
+    }
+    return uploaded;
+}
+
+/**
+ * \brief           Cancel every upload still waiting for the main thread
+ * \note            Called by mvn_quit() after the job system stopped and before the renderer is
+ *                  destroyed. Handles stay valid until they are released.
+ */
+void mvn_asset_shutdown(void)
+{
+    mvn_asset_t *asset;
+    while ((asset = pop_upload()) != NULL) {
+        finish_asset(asset, MVN_ASSET_CANCELLED);
+    }
+}
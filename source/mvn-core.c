@@ -31,24 +31,66 @@
  * Author:          Jake Larson
  */
 
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+/* Expose clock_nanosleep when compiling in strict ISO C mode */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "mvn/mvn-core.h"
 
+#include "mvn/mvn-aio.h"
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-arena.h"
+#include "mvn/mvn-asset.h"
 #include "mvn/mvn-error.h" // Added error module
 #include "mvn/mvn-file.h"  // IWYU pragma: keep
+#include "mvn/mvn-input.h"
+#include "mvn/mvn-job.h"
 #include "mvn/mvn-logger.h"
+#include "mvn/mvn-profile.h"
 #include "mvn/mvn-string.h"
 #include "mvn/mvn-types.h"
 #include "mvn/mvn-utils.h"
+#include "mvn/mvn-vfs.h"
+#include "mvn/mvn-watch.h"
 #include "mvn/mvn-window.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 
+#if defined(__linux__)
+#include <errno.h>
+#include <time.h>
+#define MVN_LIMITER_CLOCK_NANOSLEEP
+#endif
+
 /* Static variables to hold the window and renderer */
 mvn_window_t             *g_window      = NULL;
 static mvn_renderer_t    *g_renderer    = NULL;
 static mvn_text_engine_t *g_text_engine = NULL;
 
+/* Render target of the software renderer in headless mode, NULL when rendering to the window */
+static SDL_Surface *g_headless_surface = NULL;
+
+/* Subsystems deferred to first use, see mvn_set_init_flags */
+static mvn_init_flags_t g_init_flags = MVN_INIT_DEFAULT;
+
+/**
+ * \brief           Performance counter values taken between the startup steps
+ */
+typedef struct startup_marks_t {
+    uint64_t start;    /*!< Entry into mvn_init */
+    uint64_t sdl;      /*!< SDL subsystems started */
+    uint64_t window;   /*!< Window created */
+    uint64_t renderer; /*!< Renderer created and SDL_ttf ready */
+} startup_marks_t;
+
+/* Block size of the per-frame arena */
+#define MVN_FRAME_ARENA_BLOCK_SIZE (256 * 1024)
+
+/* Arena for transient allocations, reset at the start of every frame */
+static mvn_arena_t *g_frame_arena = NULL;
+
 /* Static variables for timing */
 static uint64_t g_performance_frequency = 0;   // Frequency of the performance counter
 static uint64_t g_start_time            = 0;   // Time point when mvn_init was called
@@ -61,6 +103,33 @@ static int      g_frame_counter         = 0;   // Frames counted in the current
 static uint64_t g_fps_timer             = 0;   // Timer to track 1 second for FPS calculation
 static int      g_current_fps           = 0;   // Calculated FPS for the last second
 
+/* Frame limiter tuning, all values in seconds */
+#define MVN_LIMITER_INITIAL_MARGIN 0.001   // Spin margin before the first sleep is measured
+#define MVN_LIMITER_MIN_MARGIN     0.00005 // Lower bound of the spin margin
+#define MVN_LIMITER_MAX_MARGIN     0.002   // Upper bound of the spin margin
+#define MVN_LIMITER_SMOOTHING      0.1     // Weight of a new oversleep sample in the average
+
+/* Static variables for the frame limiter */
+static double g_oversleep_mean     = MVN_LIMITER_INITIAL_MARGIN; // Average sleep overshoot
+static double g_oversleep_variance = 0.0;                        // Variance of the overshoot
+
+/* Waiting statistics reported by mvn_get_frame_limiter_stats */
+static mvn_frame_limiter_stats_t g_limiter_stats;
+
+/* Static variables for the fixed update scheduler */
+static double   g_fixed_step        = 1.0 / 60.0; // Simulation step in seconds (default 60 Hz)
+static double   g_fixed_accumulator = 0.0;        // Frame time not yet consumed by fixed updates
+static int      g_max_fixed_updates = 8;          // Fixed updates allowed per frame
+static uint64_t g_fixed_tick        = 0;          // Fixed updates run since mvn_init
+
+/* Static variables for the frame time history */
+static mvn_frame_sample_t g_frame_history[MVN_FRAME_HISTORY_SIZE]; // Ring of recent frames
+static size_t             g_frame_history_next  = 0;           // Slot written by the next frame
+static size_t             g_frame_history_count = 0;           // Valid samples in the ring
+static uint64_t           g_previous_frame_end  = 0;           // End time of the previous frame
+static uint64_t           g_hitch_count         = 0;           // Hitches since mvn_init
+static float              g_hitch_threshold     = 1.0f / 30.0f; // Frame time counted as a hitch
+
 /**
  * \brief           Get the current version of the MVN engine
  * \return          Pointer to string containing version info, NULL on error
@@ -70,6 +139,117 @@ mvn_string_t *mvn_get_engine_version(void)
     return mvn_string_from_cstr("0.1.0");
 }
 
+/**
+ * \brief           Destroy the renderer, its headless target and the window
+ */
+static void destroy_video(void)
+{
+    if (g_renderer != NULL) {
+        SDL_DestroyRenderer(g_renderer);
+        g_renderer = NULL;
+    }
+
+    if (g_headless_surface != NULL) {
+        SDL_DestroySurface(g_headless_surface);
+        g_headless_surface = NULL;
+    }
+
+    if (g_window != NULL) {
+        SDL_DestroyWindow(g_window);
+        g_window = NULL;
+    }
+    mvn_refresh_window_state();
+}
+
+/**
+ * \brief           Start SDL_ttf on a worker thread
+ * \param[in]       data: Unused
+ * \return          0 on success, -1 on failure
+ */
+static int init_ttf_worker(void *data)
+{
+    (void)data;
+    return TTF_Init() ? 0 : -1;
+}
+
+/**
+ * \brief           Start SDL_ttf in the background unless the text subsystem is lazy
+ * \note            SDL_ttf does not depend on the window, so it loads FreeType while the main
+ *                  thread creates the window and renderer. A failure is reported by the retry in
+ *                  mvn_init_text(), which runs on the thread owning the error message.
+ * \return          Thread to wait for, NULL if there is nothing to wait for
+ */
+static SDL_Thread *start_ttf_init(void)
+{
+    if ((g_init_flags & MVN_INIT_LAZY_TEXT) || TTF_WasInit()) {
+        return NULL;
+    }
+    return SDL_CreateThread(init_ttf_worker, "mvn-ttf-init", NULL);
+}
+
+/**
+ * \brief           Log how long each startup step took
+ * \param[in]       marks: Counter values taken between the steps
+ */
+static void log_startup_times(const startup_marks_t *marks)
+{
+    double   to_ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    uint64_t end   = SDL_GetPerformanceCounter();
+
+    mvn_log_info("Startup took %.2f ms (SDL %.2f ms, window %.2f ms, renderer %.2f ms, "
+                 "text %.2f ms%s)",
+                 (double)(end - marks->start) * to_ms,
+                 (double)(marks->sdl - marks->start) * to_ms,
+                 (double)(marks->window - marks->sdl) * to_ms,
+                 (double)(marks->renderer - marks->window) * to_ms,
+                 (double)(end - marks->renderer) * to_ms,
+                 (g_init_flags & MVN_INIT_LAZY_TEXT) ? ", deferred" : "");
+}
+
+/**
+ * \brief           Finish startup once the renderer exists
+ * \param[in]       marks: Counter values taken during startup
+ * \return          true on success, false on failure
+ */
+static bool finish_init(const startup_marks_t *marks)
+{
+    if (!(g_init_flags & MVN_INIT_LAZY_TEXT) && !mvn_init_text()) {
+        TTF_Quit();
+        destroy_video();
+        SDL_Quit();
+        return false;
+    }
+
+    // Initialize timing variables
+    g_performance_frequency = SDL_GetPerformanceFrequency();
+    g_start_time            = SDL_GetPerformanceCounter();
+    g_last_frame_time       = g_start_time;
+    g_current_frame_time    = g_start_time;
+    g_fps_timer             = g_start_time;
+    g_oversleep_mean        = MVN_LIMITER_INITIAL_MARGIN;
+    g_oversleep_variance    = 0.0;
+    SDL_zero(g_limiter_stats);
+    g_limiter_stats.spin_margin = MVN_LIMITER_INITIAL_MARGIN;
+    g_fixed_accumulator         = 0.0;
+    g_fixed_tick                = 0;
+    g_frame_history_next        = 0;
+    g_frame_history_count       = 0;
+    g_previous_frame_end        = g_start_time;
+    g_hitch_count               = 0;
+    mvn_set_target_fps(300); // Set default target FPS
+
+    // Load the window and monitor state that events keep current from now on
+    mvn_refresh_window_state();
+
+    // Jobs run inline if the workers cannot be started, so this is not fatal
+    if (mvn_job_get_worker_count() == 0 && !mvn_job_system_init(0)) {
+        mvn_log_warn("Running jobs on the main thread: %s", mvn_get_error());
+    }
+
+    log_startup_times(marks);
+    return true;
+}
+
 /**
  * \brief           Initialize the MVN framework
  * \param[in]       width: Width of the window to create
@@ -80,11 +260,21 @@ mvn_string_t *mvn_get_engine_version(void)
  */
 bool mvn_init(int width, int height, const char *title, mvn_window_flags_t flags)
 {
+    startup_marks_t marks;
+    marks.start = SDL_GetPerformanceCounter();
+
     // Initialize SDL first - needed for video and other features
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
+    SDL_InitFlags sdl_flags = SDL_INIT_VIDEO | SDL_INIT_GAMEPAD;
+    if (!(g_init_flags & MVN_INIT_LAZY_AUDIO)) {
+        sdl_flags |= SDL_INIT_AUDIO;
+    }
+    if (!SDL_Init(sdl_flags)) {
         mvn_set_error("SDL initialization failed: %s", SDL_GetError());
         return false;
     }
+    marks.sdl = SDL_GetPerformanceCounter();
+
+    SDL_Thread *ttf_thread = start_ttf_init();
 
     // Add default high DPI flag if no flags provided
     if (flags == 0) {
@@ -95,50 +285,165 @@ bool mvn_init(int width, int height, const char *title, mvn_window_flags_t flags
     }
 
     // Create the window with specified flags
-    g_window = SDL_CreateWindow(title, width, height, flags);
-    if (g_window == NULL) {
+    g_window     = SDL_CreateWindow(title, width, height, flags);
+    marks.window = SDL_GetPerformanceCounter();
+
+    // Create renderer for window
+    if (g_window != NULL) {
+        g_renderer = SDL_CreateRenderer(g_window, NULL);
+    }
+
+    // The worker must be done before anything is torn down
+    SDL_WaitThread(ttf_thread, NULL);
+    marks.renderer = SDL_GetPerformanceCounter();
+
+    if (g_window == NULL || g_renderer == NULL) {
+        // Capture the message before the cleanup below can replace it
+        mvn_set_error("%s creation failed: %s",
+                      g_window == NULL ? "Window" : "Renderer",
+                      SDL_GetError());
+        TTF_Quit();
+        destroy_video();
         SDL_Quit();
-        mvn_set_error("Window creation failed: %s", SDL_GetError());
         return false;
     }
 
-    // Create renderer for window
-    g_renderer = SDL_CreateRenderer(g_window, NULL);
+    return finish_init(&marks);
+}
+
+/**
+ * \brief           Initialize the MVN framework without a display
+ * \note            Uses the offscreen (or dummy) video driver, skips audio and renders with the
+ *                  software renderer into an offscreen surface. Read frames back with
+ *                  mvn_load_image_from_screen(). Suited to CI, benchmarks and servers.
+ * \param[in]       width: Width of the render target
+ * \param[in]       height: Height of the render target
+ * \return          true on success, false on failure
+ */
+bool mvn_init_headless(int width, int height)
+{
+    startup_marks_t marks;
+    marks.start = SDL_GetPerformanceCounter();
+
+    // The driver hint is only read by SDL_Init, reset it so a later mvn_init gets a display
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+    bool initialized = SDL_Init(SDL_INIT_VIDEO);
+    SDL_ResetHint(SDL_HINT_VIDEO_DRIVER);
+
+    if (!initialized) {
+        mvn_set_error("SDL initialization failed: %s", SDL_GetError());
+        return false;
+    }
+    marks.sdl = SDL_GetPerformanceCounter();
+
+    SDL_Thread *ttf_thread = start_ttf_init();
+
+    // A hidden window keeps the window functions working
+    g_window     = SDL_CreateWindow("MVN Headless", width, height, SDL_WINDOW_HIDDEN);
+    marks.window = SDL_GetPerformanceCounter();
+
+    if (g_window != NULL) {
+        g_headless_surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    }
+    if (g_headless_surface != NULL) {
+        g_renderer = SDL_CreateSoftwareRenderer(g_headless_surface);
+    }
+
+    // The worker must be done before anything is torn down
+    SDL_WaitThread(ttf_thread, NULL);
+    marks.renderer = SDL_GetPerformanceCounter();
+
     if (g_renderer == NULL) {
-        SDL_DestroyWindow(g_window);
+        mvn_set_error("%s creation failed: %s",
+                      g_window == NULL             ? "Window"
+                      : g_headless_surface == NULL ? "Render target"
+                                                   : "Renderer",
+                      SDL_GetError());
+        TTF_Quit();
+        destroy_video();
         SDL_Quit();
-        mvn_set_error("Renderer creation failed: %s", SDL_GetError());
         return false;
     }
 
-    // Initialize SDL_ttf
+    return finish_init(&marks);
+}
+
+/**
+ * \brief           Check whether the framework was initialized with mvn_init_headless()
+ * \return          true in headless mode, false otherwise
+ */
+bool mvn_is_headless(void)
+{
+    return g_headless_surface != NULL;
+}
+
+/**
+ * \brief           Choose which subsystems mvn_init() defers to their first use
+ * \note            Call before mvn_init(). Deferring text and audio shortens the time to the first
+ *                  frame for games that use them late or not at all. The flags stay in effect
+ *                  across mvn_quit().
+ * \param[in]       flags: Combination of mvn_init_flags_t values
+ */
+void mvn_set_init_flags(mvn_init_flags_t flags)
+{
+    g_init_flags = flags;
+}
+
+/**
+ * \brief           Start the SDL audio subsystem if it is not running yet
+ * \note            Called by mvn_init() unless MVN_INIT_LAZY_AUDIO is set. Audio code should call
+ *                  it before opening a device.
+ * \return          true on success, false on failure
+ */
+bool mvn_init_audio(void)
+{
+    if (SDL_WasInit(SDL_INIT_AUDIO)) {
+        return true;
+    }
+
+    uint64_t start = SDL_GetPerformanceCounter();
+    if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+        return mvn_set_error("Failed to initialize audio: %s", SDL_GetError());
+    }
+
+    mvn_log_debug("Audio started in %.2f ms",
+                  (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+                      (double)SDL_GetPerformanceFrequency());
+    return true;
+}
+
+/**
+ * \brief           Start SDL_ttf and create the renderer text engine if not done yet
+ * \note            Called by mvn_init() unless MVN_INIT_LAZY_TEXT is set, otherwise by the first
+ *                  mvn_get_text_engine() call
+ * \return          true on success, false on failure
+ */
+bool mvn_init_text(void)
+{
+    if (g_text_engine != NULL) {
+        return true;
+    }
+
+    if (g_renderer == NULL) {
+        return mvn_set_error("Renderer not initialized - call mvn_init() first");
+    }
+
+    uint64_t start = SDL_GetPerformanceCounter();
     if (!TTF_WasInit() && !TTF_Init()) {
-        SDL_DestroyRenderer(g_renderer);
-        SDL_DestroyWindow(g_window);
-        SDL_Quit();
-        mvn_set_error("Failed to initialize SDL_ttf: %s", SDL_GetError());
-        return false;
+        return mvn_set_error("Failed to initialize SDL_ttf: %s", SDL_GetError());
     }
 
     // Create the renderer text engine
-    g_text_engine = TTF_CreateRendererTextEngine(mvn_get_renderer());
+    g_text_engine = TTF_CreateRendererTextEngine(g_renderer);
     if (g_text_engine == NULL) {
-        TTF_Quit();
-        SDL_DestroyRenderer(g_renderer);
-        SDL_DestroyWindow(g_window);
-        SDL_Quit();
-        mvn_set_error("Failed to create renderer text engine: %s", SDL_GetError());
-        return false;
+        return mvn_set_error("Failed to create renderer text engine: %s", SDL_GetError());
     }
 
-    // Initialize timing variables
-    g_performance_frequency = SDL_GetPerformanceFrequency();
-    g_start_time            = SDL_GetPerformanceCounter();
-    g_last_frame_time       = g_start_time;
-    g_current_frame_time    = g_start_time;
-    g_fps_timer             = g_start_time;
-    mvn_set_target_fps(300); // Set default target FPS
-
+    if (g_init_flags & MVN_INIT_LAZY_TEXT) {
+        mvn_log_debug("Text engine started in %.2f ms",
+                      (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+                          (double)SDL_GetPerformanceFrequency());
+    }
     return true;
 }
 
@@ -147,17 +452,19 @@ bool mvn_init(int width, int height, const char *title, mvn_window_flags_t flags
  */
 void mvn_quit(void)
 {
-    // Clean up in reverse order of creation
-    if (g_renderer != NULL) {
-        SDL_DestroyRenderer(g_renderer);
-        g_renderer = NULL;
-    }
+    // Stop watching files, reloads still queued for the main thread are dropped
+    mvn_watch_shutdown();
 
-    // Clean up the window
-    if (g_window != NULL) {
-        SDL_DestroyWindow(g_window);
-        g_window = NULL;
-    }
+    // Finish reads in flight, jobs waiting for them are run by the job system shutdown
+    mvn_aio_shutdown();
+
+    // Finish outstanding jobs while the renderer still exists
+    mvn_job_system_shutdown();
+    mvn_asset_shutdown();
+    mvn_input_shutdown();
+
+    // Clean up in reverse order of creation
+    destroy_video();
 
     // Clean up text engine
     if (g_text_engine != NULL) {
@@ -165,6 +472,25 @@ void mvn_quit(void)
         g_text_engine = NULL;
     }
 
+    // Release the frame arena
+    mvn_arena_free(g_frame_arena);
+    g_frame_arena = NULL;
+    mvn_release_thread_arena();
+
+    // Unmount archives, views still open keep their archive mapped until released
+    mvn_vfs_unmount_all();
+
+    // Write the requested profile and release the profiler buffers
+    mvn_profile_shutdown();
+
+    // Write queued log messages, anything logged from here on is written synchronously
+    mvn_logger_stop_async();
+    mvn_logger_stop_binary();
+
+    // Report framework memory that was never released
+    mvn_alloc_report_leaks();
+    mvn_logger_flush();
+
     // Quit SDL_ttf
     TTF_Quit();
 
@@ -191,13 +517,28 @@ mvn_renderer_t *mvn_get_renderer(void)
  */
 mvn_text_engine_t *mvn_get_text_engine(void)
 {
-    if (g_text_engine == NULL) {
-        mvn_set_error("Text engine not initialized - call mvn_init() first");
+    // Created here on first use when the text subsystem is lazy
+    if (!mvn_init_text()) {
         return NULL;
     }
     return g_text_engine;
 }
 
+/**
+ * \brief           Get the per-frame arena
+ * \note            Created on first use and reset by every mvn_begin_drawing call, so
+ *                  allocations from it are only valid until the next frame begins. Only use it
+ *                  from the thread that drives the frame loop.
+ * \return          Pointer to the frame arena, NULL on failure
+ */
+mvn_arena_t *mvn_get_frame_arena(void)
+{
+    if (g_frame_arena == NULL) {
+        g_frame_arena = mvn_arena_init(MVN_FRAME_ARENA_BLOCK_SIZE);
+    }
+    return g_frame_arena;
+}
+
 /**
  * \brief           Check if the window should close
  * \return          true if window should close, false otherwise
@@ -209,25 +550,9 @@ bool mvn_window_should_close(void)
         return false;
     }
 
-    SDL_Event event;
-    bool      should_close = false;
-
-    /* Process all pending events */
-    while (SDL_PollEvent(&event)) {
-        /* Check for quit events */
-        if (event.type == SDL_EVENT_QUIT) {
-            should_close = true;
-            break;
-        }
-
-        /* Check for ESC key press */
-        if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE) {
-            should_close = true;
-            break;
-        }
-    }
-
-    return should_close;
+    // Start a new input frame, which also processes quit and ESC
+    mvn_update_input();
+    return mvn_is_quit_requested();
 }
 
 /**
@@ -241,11 +566,32 @@ bool mvn_begin_drawing(void)
         return false;
     }
 
+    MVN_PROFILE_BEGIN("mvn_begin_drawing");
+
     // Calculate delta time from the previous frame
     uint64_t frame_start_time = SDL_GetPerformanceCounter();
     g_delta_time = (double)(frame_start_time - g_last_frame_time) / (double)g_performance_frequency;
     g_last_frame_time = frame_start_time; // Update last frame time for the next frame
 
+    // Bank the frame time for fixed updates, dropping what cannot be simulated this frame
+    // so a slow frame does not cause ever more updates (spiral of death)
+    g_fixed_accumulator =
+        SDL_min(g_fixed_accumulator + g_delta_time, g_fixed_step * g_max_fixed_updates);
+
+    // Release the previous frame's transient allocations
+    if (g_frame_arena != NULL) {
+        mvn_arena_reset(g_frame_arena);
+    }
+
+    // Run renderer work that jobs handed to the main thread
+    mvn_job_run_main_thread_queue();
+    mvn_process_asset_uploads();
+
+    // Pick up input that arrived since mvn_window_should_close() for this frame's drawing
+    mvn_sample_input();
+
+    MVN_PROFILE_END();
+
     // No longer clearing automatically - user should call mvn_clear_background
     return true;
 }
@@ -277,6 +623,121 @@ bool mvn_clear_background(mvn_color_t color)
     return true;
 }
 
+/**
+ * \brief           Convert performance counter ticks to seconds
+ * \param[in]       ticks: Tick count
+ * \return          Duration in seconds
+ */
+static double ticks_to_seconds(uint64_t ticks)
+{
+    return (double)ticks / (double)g_performance_frequency;
+}
+
+/**
+ * \brief           Sleep the calling thread without spinning
+ * \param[in]       seconds: Duration to sleep
+ */
+static void limiter_sleep(double seconds)
+{
+    uint64_t nanoseconds = (uint64_t)(seconds * (double)SDL_NS_PER_SECOND);
+
+#if defined(MVN_LIMITER_CLOCK_NANOSLEEP)
+    /* An absolute deadline keeps the wake-up time exact across signal interruptions */
+    struct timespec deadline;
+    if (clock_gettime(CLOCK_MONOTONIC, &deadline) == 0) {
+        deadline.tv_sec += (time_t)(nanoseconds / SDL_NS_PER_SECOND);
+        deadline.tv_nsec += (long)(nanoseconds % SDL_NS_PER_SECOND);
+        if (deadline.tv_nsec >= SDL_NS_PER_SECOND) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= SDL_NS_PER_SECOND;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {
+        }
+        return;
+    }
+#endif /* MVN_LIMITER_CLOCK_NANOSLEEP */
+
+    SDL_DelayNS(nanoseconds);
+}
+
+/**
+ * \brief           Feed a measured sleep overshoot into the spin margin calibration
+ * \param[in]       oversleep: Observed minus requested sleep duration in seconds
+ */
+static void limiter_calibrate(double oversleep)
+{
+    double delta = oversleep - g_oversleep_mean;
+    g_oversleep_mean += MVN_LIMITER_SMOOTHING * delta;
+    g_oversleep_variance = (1.0 - MVN_LIMITER_SMOOTHING) *
+                           (g_oversleep_variance + MVN_LIMITER_SMOOTHING * delta * delta);
+
+    /* Stop sleeping early enough to absorb a typical overshoot plus two deviations */
+    double margin = g_oversleep_mean + 2.0 * SDL_sqrt(g_oversleep_variance);
+    g_limiter_stats.spin_margin =
+        SDL_clamp(margin, MVN_LIMITER_MIN_MARGIN, MVN_LIMITER_MAX_MARGIN);
+}
+
+/**
+ * \brief           Wait until the performance counter reaches a deadline
+ * \note            Sleeps until the calibrated spin margin remains and busy-waits only for that
+ *                  remainder, so CPU usage stays low while wake-up stays precise
+ * \param[in]       target_ticks: Deadline in performance counter ticks
+ * \return          Performance counter value after waiting
+ */
+static uint64_t limiter_wait_until(uint64_t target_ticks)
+{
+    uint64_t wait_start = SDL_GetPerformanceCounter();
+    uint64_t now        = wait_start;
+
+    while (now < target_ticks) {
+        double remaining = ticks_to_seconds(target_ticks - now);
+        if (remaining <= g_limiter_stats.spin_margin) {
+            break;
+        }
+
+        double requested = remaining - g_limiter_stats.spin_margin;
+        limiter_sleep(requested);
+
+        uint64_t woke = SDL_GetPerformanceCounter();
+        limiter_calibrate(ticks_to_seconds(woke - now) - requested);
+        now = woke;
+    }
+
+    uint64_t spin_start = now;
+    while (now < target_ticks) {
+        SDL_CPUPauseInstruction();
+        now = SDL_GetPerformanceCounter();
+    }
+
+    g_limiter_stats.wait_time = ticks_to_seconds(now - wait_start);
+    g_limiter_stats.spin_time = ticks_to_seconds(now - spin_start);
+    g_limiter_stats.total_wait_time += g_limiter_stats.wait_time;
+    g_limiter_stats.total_spin_time += g_limiter_stats.spin_time;
+    return now;
+}
+
+/**
+ * \brief           Store the timing of the frame that just ended in the history ring
+ * \param[in]       present_time: Time spent in SDL_RenderPresent in seconds
+ */
+static void record_frame_sample(double present_time)
+{
+    mvn_frame_sample_t *sample = &g_frame_history[g_frame_history_next];
+
+    sample->total   = (float)ticks_to_seconds(g_current_frame_time - g_previous_frame_end);
+    sample->present = (float)present_time;
+    sample->wait    = (float)g_limiter_stats.wait_time;
+    sample->cpu     = SDL_max(sample->total - sample->present - sample->wait, 0.0f);
+
+    if (sample->total > g_hitch_threshold) {
+        g_hitch_count++;
+    }
+
+    g_previous_frame_end  = g_current_frame_time;
+    g_frame_history_next  = (g_frame_history_next + 1) % MVN_FRAME_HISTORY_SIZE;
+    g_frame_history_count = SDL_min(g_frame_history_count + 1, MVN_FRAME_HISTORY_SIZE);
+}
+
 /**
  * \brief           End drawing, present the rendered content, and manage frame timing/FPS
  * \return          true if successful, false on failure
@@ -288,8 +749,14 @@ bool mvn_end_drawing(void)
         return false;
     }
 
+    MVN_PROFILE_BEGIN("mvn_end_drawing");
+
     // Present the renderer contents to the screen
-    SDL_RenderPresent(g_renderer);
+    uint64_t present_start_time = SDL_GetPerformanceCounter();
+    MVN_PROFILE_ZONE("SDL_RenderPresent")
+    {
+        SDL_RenderPresent(g_renderer);
+    }
 
     // --- Accurate Frame Limiting ---
     uint64_t frame_end_time = SDL_GetPerformanceCounter();
@@ -297,31 +764,22 @@ bool mvn_end_drawing(void)
         (double)(frame_end_time - g_last_frame_time) / (double)g_performance_frequency;
 
     if (g_target_fps > 0 && elapsed_frame_time_seconds < g_target_frame_time) {
-        double time_to_wait_seconds = g_target_frame_time - elapsed_frame_time_seconds;
-
-        // Use SDL_Delay for most of the wait time, leave ~1.5ms for busy-wait
-        const double busy_wait_threshold_seconds = 0.0015;
-        if (time_to_wait_seconds > busy_wait_threshold_seconds) {
-            uint32_t delay_ms =
-                (uint32_t)((time_to_wait_seconds - busy_wait_threshold_seconds) * 1000.0);
-            if (delay_ms > 0) {
-                SDL_Delay(delay_ms);
-            }
-        }
-
-        // Busy-wait for the remaining time for precision
         uint64_t target_ticks =
             g_last_frame_time + (uint64_t)(g_target_frame_time * (double)g_performance_frequency);
-        while (SDL_GetPerformanceCounter() < target_ticks) {
-            // Spin-lock briefly to free up CPU resources
+        MVN_PROFILE_ZONE("frame limiter wait")
+        {
+            g_current_frame_time = limiter_wait_until(target_ticks);
         }
-        g_current_frame_time = SDL_GetPerformanceCounter(); // Update after waiting
     } else {
         // Frame took too long, no wait needed
-        g_current_frame_time = frame_end_time;
+        g_current_frame_time      = frame_end_time;
+        g_limiter_stats.wait_time = 0.0;
+        g_limiter_stats.spin_time = 0.0;
     }
     // --- End Accurate Frame Limiting ---
 
+    record_frame_sample(ticks_to_seconds(frame_end_time - present_start_time));
+
     // FPS calculation (uses the final current_frame_time)
     g_frame_counter++;
     double time_since_fps_reset =
@@ -333,6 +791,7 @@ bool mvn_end_drawing(void)
         g_fps_timer     = g_current_frame_time; // Reset timer for the next second
     }
 
+    MVN_PROFILE_END();
     return true;
 }
 
@@ -389,3 +848,237 @@ int mvn_get_fps(void)
     }
     return g_current_fps;
 }
+
+/**
+ * \brief           Get statistics of the time spent waiting for the target frame rate
+ * \return          Frame limiter statistics, all zero before mvn_init()
+ */
+mvn_frame_limiter_stats_t mvn_get_frame_limiter_stats(void)
+{
+    return g_limiter_stats;
+}
+
+/**
+ * \brief           Set the rate of fixed simulation updates
+ * \param[in]       hz: Fixed updates per second, must be positive
+ * \return          true on success, false on failure
+ */
+bool mvn_set_fixed_update_rate(double hz)
+{
+    if (!(hz > 0.0)) {
+        return mvn_set_error("Fixed update rate must be positive, got %f", hz);
+    }
+
+    g_fixed_step        = 1.0 / hz;
+    g_fixed_accumulator = SDL_min(g_fixed_accumulator, g_fixed_step * g_max_fixed_updates);
+    return true;
+}
+
+/**
+ * \brief           Get the rate of fixed simulation updates
+ * \return          Fixed updates per second
+ */
+double mvn_get_fixed_update_rate(void)
+{
+    return 1.0 / g_fixed_step;
+}
+
+/**
+ * \brief           Limit the number of fixed updates run in one frame
+ * \note            Frame time beyond this limit is dropped, so the simulation slows down
+ *                  instead of falling further behind when updates cost more than they cover
+ * \param[in]       count: Maximum fixed updates per frame, values below 1 are treated as 1
+ */
+void mvn_set_max_fixed_updates(int count)
+{
+    g_max_fixed_updates = SDL_max(count, 1);
+    g_fixed_accumulator = SDL_min(g_fixed_accumulator, g_fixed_step * g_max_fixed_updates);
+}
+
+/**
+ * \brief           Consume one pending fixed update
+ * \note            Call in a loop after mvn_begin_drawing():
+ *                  while (mvn_fixed_update()) { simulate(mvn_get_fixed_frame_time()); }
+ *                  Frames rendered faster than the update rate run no updates at all.
+ * \return          true if an update is due, false once the frame's time is consumed
+ */
+bool mvn_fixed_update(void)
+{
+    if (g_fixed_accumulator < g_fixed_step) {
+        return false;
+    }
+
+    g_fixed_accumulator -= g_fixed_step;
+    g_fixed_tick++;
+    return true;
+}
+
+/**
+ * \brief           Run every pending fixed update through a callback
+ * \param[in]       update: Function called once per fixed update
+ * \param[in]       user_data: Pointer passed to update
+ * \return          Number of updates run, -1 on failure
+ */
+int mvn_run_fixed_updates(mvn_fixed_update_fn update, void *user_data)
+{
+    if (update == NULL) {
+        mvn_set_error("Fixed update callback is NULL");
+        return -1;
+    }
+
+    int count = 0;
+    while (mvn_fixed_update()) {
+        update((float)g_fixed_step, user_data);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * \brief           Get the time simulated by one fixed update
+ * \return          Fixed step in seconds
+ */
+float mvn_get_fixed_frame_time(void)
+{
+    return (float)g_fixed_step;
+}
+
+/**
+ * \brief           Get the interpolation factor between the last two simulation states
+ * \note            Render with previous + (current - previous) * alpha to hide the difference
+ *                  between the update rate and the frame rate
+ * \return          Fraction of a fixed step left in the accumulator, in [0, 1)
+ */
+float mvn_get_fixed_alpha(void)
+{
+    return (float)(g_fixed_accumulator / g_fixed_step);
+}
+
+/**
+ * \brief           Get the number of fixed updates run since mvn_init()
+ * \return          Fixed update count
+ */
+uint64_t mvn_get_fixed_tick(void)
+{
+    return g_fixed_tick;
+}
+
+/**
+ * \brief           Set the frame time above which a frame counts as a hitch
+ * \param[in]       seconds: Hitch threshold in seconds, must be positive
+ * \return          true on success, false on failure
+ */
+bool mvn_set_hitch_threshold(float seconds)
+{
+    if (!(seconds > 0.0f)) {
+        return mvn_set_error("Hitch threshold must be positive, got %f", (double)seconds);
+    }
+
+    g_hitch_threshold = seconds;
+    return true;
+}
+
+/**
+ * \brief           Compare two floats for sorting
+ * \param[in]       a: First float
+ * \param[in]       b: Second float
+ * \return          Negative, zero or positive like strcmp
+ */
+static int compare_floats(const void *a, const void *b)
+{
+    float lhs = *(const float *)a;
+    float rhs = *(const float *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * \brief           Summarize one phase of the frame history
+ * \param[in]       values: Phase durations, sorted in place
+ * \param[in]       count: Number of values, must be positive
+ * \return          Summary of the values
+ */
+static mvn_frame_phase_stats_t summarize_phase(float *values, size_t count)
+{
+    mvn_frame_phase_stats_t stats;
+    double                  sum = 0.0;
+
+    SDL_qsort(values, count, sizeof(float), compare_floats);
+    for (size_t i = 0; i < count; i++) {
+        sum += values[i];
+    }
+
+    // Nearest-rank percentiles
+    stats.min = values[0];
+    stats.max = values[count - 1];
+    stats.avg = (float)(sum / (double)count);
+    stats.p50 = values[(count * 50 + 99) / 100 - 1];
+    stats.p95 = values[(count * 95 + 99) / 100 - 1];
+    stats.p99 = values[(count * 99 + 99) / 100 - 1];
+    return stats;
+}
+
+/**
+ * \brief           Get statistics over the recent frame history
+ * \note            Covers the last MVN_FRAME_HISTORY_SIZE frames, except hitch_count which
+ *                  counts every hitch since mvn_init()
+ * \return          Frame statistics, all zero before the first frame
+ */
+mvn_frame_stats_t mvn_get_frame_stats(void)
+{
+    mvn_frame_stats_t stats;
+    float             values[MVN_FRAME_HISTORY_SIZE];
+    size_t            count = g_frame_history_count;
+
+    SDL_zero(stats);
+    stats.sample_count = count;
+    stats.hitch_count  = g_hitch_count;
+    if (count == 0) {
+        return stats;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = g_frame_history[i].total;
+        if (values[i] > g_hitch_threshold) {
+            stats.recent_hitch_count++;
+        }
+    }
+    stats.total = summarize_phase(values, count);
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = g_frame_history[i].cpu;
+    }
+    stats.cpu = summarize_phase(values, count);
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = g_frame_history[i].present;
+    }
+    stats.present = summarize_phase(values, count);
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = g_frame_history[i].wait;
+    }
+    stats.wait = summarize_phase(values, count);
+
+    return stats;
+}
+
+/**
+ * \brief           Copy the recent frame history, e.g. for drawing a frame time graph
+ * \param[out]      samples: Array receiving the samples from oldest to newest
+ * \param[in]       max_count: Capacity of samples
+ * \return          Number of samples copied, the newest ones when max_count is too small
+ */
+size_t mvn_get_frame_history(mvn_frame_sample_t *samples, size_t max_count)
+{
+    if (samples == NULL) {
+        return 0;
+    }
+
+    size_t count = SDL_min(g_frame_history_count, max_count);
+    size_t first =
+        (g_frame_history_next + MVN_FRAME_HISTORY_SIZE - count) % MVN_FRAME_HISTORY_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = g_frame_history[(first + i) % MVN_FRAME_HISTORY_SIZE];
+    }
+    return count;
+}
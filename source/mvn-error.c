@@ -5,66 +5,261 @@
 
 #include "mvn/mvn-error.h"
 
+#include "mvn/mvn-format.h"
 #include "mvn/mvn-logger.h"
 
 #include <SDL3/SDL.h>
 #include <stdarg.h>
 
-/* Thread local storage for error messages */
+/**
+ * \brief           Error as it was set, formatted only when its message is read
+ */
+typedef struct mvn_error_entry_t {
+    mvn_error_code_t code;                      /*!< Error code */
+    const char      *fmt;                       /*!< Format string, NULL if args holds the text */
+    size_t           args_size;                 /*!< Bytes used in args */
+    uint8_t          args[MVN_ERROR_ARGS_SIZE]; /*!< Packed arguments or the formatted text */
+} mvn_error_entry_t;
+
+/**
+ * \brief           Errors of one thread, allocated the first time the thread sets an error
+ */
+typedef struct mvn_error_state_t {
+    mvn_error_entry_t history[MVN_ERROR_HISTORY_SIZE]; /*!< Ring of recent errors */
+    size_t            count;                           /*!< Errors in the ring */
+    size_t            newest;                          /*!< Index of the newest error */
+    bool              current;                         /*!< Whether the newest error is set */
+    bool              formatted;                       /*!< Whether message holds it */
+    char              message[MVN_ERROR_MESSAGE_SIZE]; /*!< Text returned by mvn_get_error() */
+} mvn_error_state_t;
+
+/* Thread local storage for error state */
 static SDL_TLSID error_tls_id;
-static char      error_buffer[1024]; // Fixed size buffer for error messages
 
-bool mvn_set_error(const char *fmt, ...)
+/* Names of the error codes, in the order of mvn_error_code_t */
+static const char *const error_code_names[MVN_ERROR_COUNT] = {
+    "none",
+    "unknown",
+    "invalid argument",
+    "out of memory",
+    "not found",
+    "I/O",
+    "SDL",
+    "unsupported",
+    "invalid state",
+};
+
+/**
+ * \brief           Get the error state of the calling thread
+ * \param[in]       create: true to allocate the state if the thread has none
+ * \return          Error state, NULL if there is none or it cannot be allocated
+ */
+static mvn_error_state_t *get_state(bool create)
 {
-    va_list ap;
-    char   *error_copy;
-    void   *old_value;
-
-    va_start(ap, fmt);
-    SDL_vsnprintf(error_buffer, sizeof(error_buffer), fmt, ap);
-    va_end(ap);
-
-    // Make a copy of the error message for TLS storage
-    error_copy = SDL_strdup(error_buffer);
-    if (!error_copy) {
-        return false;
+    mvn_error_state_t *state = SDL_GetTLS(&error_tls_id);
+    if (state == NULL && create) {
+        // SDL frees it when the thread exits, after MVN reported leaks, so it is not tracked
+        state = SDL_calloc(1, sizeof(mvn_error_state_t));
+        if (state != NULL && !SDL_SetTLS(&error_tls_id, state, SDL_free)) {
+            SDL_free(state);
+            state = NULL;
+        }
     }
+    return state;
+}
 
-    // Get the old value first to avoid potential race conditions
-    old_value = SDL_GetTLS(&error_tls_id);
+/**
+ * \brief           Format the message of an error
+ * \param[in]       entry: Error
+ * \param[out]      message: Receives the message
+ * \param[in]       size: Size of message
+ */
+static void format_entry(const mvn_error_entry_t *entry, char *message, size_t size)
+{
+    if (entry->fmt == NULL) {
+        SDL_strlcpy(message, (const char *)entry->args, size);
+        return;
+    }
 
-    // SDL3 initializes the TLS ID automatically if needed
-    if (!SDL_SetTLS(&error_tls_id, error_copy, SDL_free)) {
-        SDL_free(error_copy);
-        return false;
+    const uint8_t *cursor = entry->args;
+    if (!mvn_format_unpack(message, size, entry->fmt, &cursor, entry->args + entry->args_size)) {
+        SDL_strlcpy(message, entry->fmt, size);
     }
+}
 
-    // Free old value if there was one
-    if (old_value != NULL) {
-        SDL_free(old_value);
+/**
+ * \brief           Log the error that was just set, if debug messages of errors are enabled
+ */
+static void log_error(void)
+{
+    // Check the level first, formatting the message would defeat the lazy formatting
+    if (mvn_log_is_enabled(MVN_LOG_CATEGORY_ERROR, MVN_LOG_DEBUG) &&
+        SDL_GetLogPriority(SDL_LOG_CATEGORY_ERROR) <= SDL_LOG_PRIORITY_DEBUG) {
+        mvn_log(MVN_LOG_CATEGORY_ERROR, MVN_LOG_DEBUG, "Error set: %s", mvn_get_error());
     }
+}
 
-    // Also log the error at DEBUG level
-    mvn_log_error("Error set: %s", error_buffer);
+/**
+ * \brief           Set the error of the calling thread
+ * \param[in]       code: Error code
+ * \param[in]       fmt: Formatting string for the message
+ * \param[in]       args: Arguments for the format string
+ */
+static void set_errorv(mvn_error_code_t code, const char *fmt, va_list args)
+{
+    mvn_error_state_t *state = get_state(true);
+    if (state == NULL) {
+        return;
+    }
+
+    state->newest            = (state->newest + 1) % MVN_ERROR_HISTORY_SIZE;
+    state->count             = SDL_min(state->count + 1, MVN_ERROR_HISTORY_SIZE);
+    state->current           = true;
+    state->formatted         = false;
+    mvn_error_entry_t *entry = &state->history[state->newest];
+    entry->code              = code;
+
+    // Keep the arguments and format only when the message is asked for. Format strings
+    // that cannot be packed are formatted right away.
+    uint8_t types[MVN_FORMAT_MAX_ARGS];
+    int     count = fmt != NULL ? mvn_format_parse(fmt, types) : -1;
+    if (count >= 0) {
+        entry->fmt       = fmt;
+        entry->args_size = mvn_format_pack(types, count, entry->args, sizeof(entry->args), args);
+    } else {
+        entry->fmt = NULL;
+        SDL_vsnprintf((char *)entry->args, sizeof(entry->args), fmt != NULL ? fmt : "", args);
+    }
+}
+
+/**
+ * \brief           Set the error of the calling thread
+ * \note            No memory is allocated after the first error of a thread. The format string
+ *                  must stay valid until the message is read, which holds for string literals.
+ * \param[in]       fmt: Formatting string for the message
+ * \param[in]       ...: Arguments for the format string
+ * \return          false, for convenient use in return statements
+ */
+bool mvn_set_error(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    set_errorv(MVN_ERROR_UNKNOWN, fmt, args);
+    va_end(args);
+
+    // The caller decides whether the error is worth reporting, so only log it when debugging
+    log_error();
 
     return false; // Return false for convenient usage in return statements
 }
 
+/**
+ * \brief           Set the error of the calling thread with an error code
+ * \note            See mvn_set_error()
+ * \param[in]       code: Error code
+ * \param[in]       fmt: Formatting string for the message
+ * \param[in]       ...: Arguments for the format string
+ * \return          false, for convenient use in return statements
+ */
+bool mvn_set_error_code(mvn_error_code_t code, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    set_errorv(code, fmt, args);
+    va_end(args);
+
+    log_error();
+    return false;
+}
+
+/**
+ * \brief           Get the message of the last error of the calling thread
+ * \return          Error message, valid until the thread sets another error, or an empty
+ *                  string if no error is set
+ */
 const char *mvn_get_error(void)
 {
-    const char *error = (const char *)SDL_GetTLS(&error_tls_id);
-    return error ? error : "";
+    mvn_error_state_t *state = get_state(false);
+    if (state == NULL || !state->current) {
+        return "";
+    }
+    if (!state->formatted) {
+        format_entry(&state->history[state->newest], state->message, sizeof(state->message));
+        state->formatted = true;
+    }
+    return state->message;
+}
+
+/**
+ * \brief           Get the code of the last error of the calling thread
+ * \return          Error code, MVN_ERROR_NONE if no error is set
+ */
+mvn_error_code_t mvn_get_error_code(void)
+{
+    mvn_error_state_t *state = get_state(false);
+    if (state == NULL || !state->current) {
+        return MVN_ERROR_NONE;
+    }
+    return state->history[state->newest].code;
 }
 
+/**
+ * \brief           Get a readable name of an error code
+ * \param[in]       code: Error code
+ * \return          Name of the code
+ */
+const char *mvn_get_error_code_name(mvn_error_code_t code)
+{
+    if ((int)code < 0 || code >= MVN_ERROR_COUNT) {
+        return "invalid";
+    }
+    return error_code_names[code];
+}
+
+/**
+ * \brief           Clear the error of the calling thread
+ * \note            The error stays in the history of recent errors
+ */
 void mvn_clear_error(void)
 {
-    void *old_value = SDL_GetTLS(&error_tls_id);
+    mvn_error_state_t *state = get_state(false);
+    if (state != NULL) {
+        state->current   = false;
+        state->formatted = false;
+    }
+}
 
-    // Set TLS to NULL while keeping the destructor
-    SDL_SetTLS(&error_tls_id, NULL, SDL_free);
+/**
+ * \brief           Get the number of recent errors kept for the calling thread
+ * \return          Errors available to mvn_get_recent_error(), at most MVN_ERROR_HISTORY_SIZE
+ */
+size_t mvn_get_error_history_count(void)
+{
+    mvn_error_state_t *state = get_state(false);
+    return state != NULL ? state->count : 0;
+}
+
+/**
+ * \brief           Get one of the recent errors of the calling thread
+ * \param[in]       index: 0 for the newest error, up to mvn_get_error_history_count() - 1
+ * \param[out]      message: Receives the formatted message, may be NULL
+ * \param[in]       size: Size of message
+ * \return          Error code, MVN_ERROR_NONE if index is out of range
+ */
+mvn_error_code_t mvn_get_recent_error(size_t index, char *message, size_t size)
+{
+    mvn_error_state_t *state = get_state(false);
+    if (message != NULL && size > 0) {
+        message[0] = '\0';
+    }
+    if (state == NULL || index >= state->count) {
+        return MVN_ERROR_NONE;
+    }
 
-    // Free old value manually since SDL won't call the destructor for NULL
-    if (old_value != NULL) {
-        SDL_free(old_value);
+    size_t position = (state->newest + MVN_ERROR_HISTORY_SIZE - index) % MVN_ERROR_HISTORY_SIZE;
+    const mvn_error_entry_t *entry = &state->history[position];
+    if (message != NULL && size > 0) {
+        format_entry(entry, message, size);
     }
+    return entry->code;
 }
@@ -31,15 +31,359 @@
  * Author:          Jake Larson
  */
 
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+/* Expose mmap and fstat when compiling in strict ISO C mode */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_FILE
+
 #include "mvn/mvn-file.h"
 
 #include "mvn/mvn-error.h" // Added error module
 #include "mvn/mvn-logger.h"
 #include "mvn/mvn-string.h"
 #include "mvn/mvn-utils.h"
+#include "mvn/mvn-vfs.h"
 
 #include <SDL3/SDL.h>
 
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MVN_FILE_MMAP
+#endif
+
+/**
+ * \brief           Stream reading a file view, see mvn_file_open_io()
+ */
+typedef struct mvn_file_stream_t {
+    mvn_file_view_t view;     /*!< Contents of the file */
+    size_t          position; /*!< Offset of the next read */
+} mvn_file_stream_t;
+
+/**
+ * \brief           Copy a file stored in a mounted archive into a heap buffer
+ * \param[in]       fileName: Path to the file, for error messages
+ * \param[in]       view: View of the file, released before returning
+ * \param[out]      size: Receives the size of the contents
+ * \return          Contents followed by a NUL byte, NULL on failure
+ */
+static void *read_archive_file(const char *fileName, mvn_file_view_t *view, size_t *size)
+{
+    uint8_t *data = MVN_MALLOC(view->size + 1);
+    if (data == NULL) {
+        mvn_file_unmap(view);
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate memory for '%s'", fileName);
+        return NULL;
+    }
+
+    SDL_memcpy(data, view->data, view->size);
+    data[view->size] = '\0';
+    *size            = view->size;
+    mvn_file_unmap(view);
+    return data;
+}
+
+/**
+ * \brief           Read a whole file on disk into a heap buffer
+ * \param[in]       fileName: Path to the file, not looked up in mounts
+ * \param[out]      size: Receives the size of the contents
+ * \return          Contents followed by a NUL byte, NULL on failure
+ */
+static void *read_native_file(const char *fileName, size_t *size)
+{
+    SDL_IOStream *stream = SDL_IOFromFile(fileName, "rb");
+    if (stream == NULL) {
+        mvn_set_error_code(MVN_ERROR_IO, "Failed to open '%s': %s", fileName, SDL_GetError());
+        return NULL;
+    }
+
+    int64_t length = SDL_GetIOSize(stream);
+    if (length < 0 || (uint64_t)length >= SIZE_MAX) {
+        SDL_CloseIO(stream);
+        mvn_set_error_code(MVN_ERROR_IO, "Failed to get the size of '%s'", fileName);
+        return NULL;
+    }
+
+    uint8_t *data = MVN_MALLOC((size_t)length + 1);
+    if (data == NULL) {
+        SDL_CloseIO(stream);
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate memory for '%s'", fileName);
+        return NULL;
+    }
+
+    size_t read = SDL_ReadIO(stream, data, (size_t)length);
+    SDL_CloseIO(stream);
+    if (read != (size_t)length) {
+        MVN_FREE(data);
+        mvn_set_error_code(MVN_ERROR_IO, "Failed to read '%s': %s", fileName, SDL_GetError());
+        return NULL;
+    }
+
+    data[read] = '\0';
+    *size = read;
+    return data;
+}
+
+/**
+ * \brief           Read a whole file into a heap buffer
+ * \param[in]       fileName: Path to the file
+ * \param[out]      size: Receives the size of the contents
+ * \return          Contents followed by a NUL byte, NULL on failure
+ */
+static void *read_file(const char *fileName, size_t *size)
+{
+    char             native[MVN_VFS_PATH_SIZE];
+    mvn_file_view_t  view;
+    mvn_vfs_source_t source = MVN_VFS_SOURCE_NONE;
+    if (!mvn_vfs_open(fileName, native, sizeof(native), &view, &source)) {
+        return NULL;
+    }
+    if (source == MVN_VFS_SOURCE_ARCHIVE) {
+        return read_archive_file(fileName, &view, size);
+    }
+    return read_native_file(source == MVN_VFS_SOURCE_DIRECTORY ? native : fileName, size);
+}
+
+/**
+ * \brief           Get the size of a file stream
+ * \param[in]       user_data: Stream
+ * \return          Size in bytes
+ */
+static int64_t stream_size(void *user_data)
+{
+    return (int64_t)((mvn_file_stream_t *)user_data)->view.size;
+}
+
+/**
+ * \brief           Move the read position of a file stream
+ * \param[in]       user_data: Stream
+ * \param[in]       offset: Offset relative to whence
+ * \param[in]       whence: Position the offset is relative to
+ * \return          New position, -1 on failure
+ */
+static int64_t stream_seek(void *user_data, int64_t offset, SDL_IOWhence whence)
+{
+    mvn_file_stream_t *stream = (mvn_file_stream_t *)user_data;
+    int64_t            base   = 0;
+
+    if (whence == SDL_IO_SEEK_CUR) {
+        base = (int64_t)stream->position;
+    } else if (whence == SDL_IO_SEEK_END) {
+        base = (int64_t)stream->view.size;
+    }
+
+    if (offset < -base || offset > (int64_t)stream->view.size - base) {
+        SDL_SetError("Seek outside of the file");
+        return -1;
+    }
+
+    stream->position = (size_t)(base + offset);
+    return (int64_t)stream->position;
+}
+
+/**
+ * \brief           Read from a file stream
+ * \param[in]       user_data: Stream
+ * \param[out]      ptr: Receives the bytes
+ * \param[in]       size: Bytes to read
+ * \param[out]      status: Set to SDL_IO_STATUS_EOF at the end of the file
+ * \return          Bytes read
+ */
+static size_t stream_read(void *user_data, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    mvn_file_stream_t *stream = (mvn_file_stream_t *)user_data;
+    size_t             count  = SDL_min(size, stream->view.size - stream->position);
+
+    if (count == 0 && size > 0) {
+        *status = SDL_IO_STATUS_EOF;
+        return 0;
+    }
+
+    SDL_memcpy(ptr, (const uint8_t *)stream->view.data + stream->position, count);
+    stream->position += count;
+    return count;
+}
+
+/**
+ * \brief           Close a file stream and release its view
+ * \param[in]       user_data: Stream
+ * \return          true
+ */
+static bool stream_close(void *user_data)
+{
+    mvn_file_stream_t *stream = (mvn_file_stream_t *)user_data;
+    mvn_file_unmap(&stream->view);
+    MVN_FREE(stream);
+    return true;
+}
+
+/**
+ * \brief           Check whether a character separates path components
+ * \param[in]       character: Character to check
+ * \return          true for '/' and '\\', false otherwise
+ */
+static bool is_separator(char character)
+{
+    return character == '/' || character == '\\';
+}
+
+/**
+ * \brief           Find the last separator of a path
+ * \param[in]       path: Path to search
+ * \param[in]       length: Number of characters of path to search
+ * \return          Index of the last separator, length if there is none
+ */
+static size_t find_last_separator(const char *path, size_t length)
+{
+    for (size_t i = length; i > 0; i--) {
+        if (is_separator(path[i - 1])) {
+            return i - 1;
+        }
+    }
+    return length;
+}
+
+/**
+ * \brief           Make a view of part of a string
+ * \param[in]       data: First character
+ * \param[in]       length: Number of characters
+ * \return          View
+ */
+static mvn_path_view_t make_view(const char *data, size_t length)
+{
+    mvn_path_view_t view = {data, length};
+    return view;
+}
+
+/**
+ * \brief           Copy a view into a new string
+ * \param[in]       view: Characters to copy
+ * \return          New string, an empty string if it cannot be allocated
+ */
+static mvn_string_t *string_from_view(mvn_path_view_t view)
+{
+    mvn_string_t *result = mvn_string_init(view.length + 1);
+    if (result == NULL) {
+        mvn_set_error("Failed to create string for path");
+        return mvn_string_from_cstr("");
+    }
+
+    SDL_memcpy(result->data, view.data, view.length);
+    result->data[view.length] = '\0';
+    result->length            = view.length;
+    return result;
+}
+
+/**
+ * \brief           Path being built by mvn_normalize_path() and mvn_join_path()
+ */
+typedef struct path_writer_t {
+    char  *buffer; /*!< Output */
+    size_t size;   /*!< Size of buffer */
+    size_t length; /*!< Characters written */
+    size_t root;   /*!< Characters of the root, 1 for absolute paths, never removed by ".." */
+} path_writer_t;
+
+/**
+ * \brief           Append the components of a path, resolving "." and ".."
+ * \note            Never writes ahead of what it read, so path may be the output buffer itself
+ * \param[in,out]   writer: Path being built
+ * \param[in]       path: Components to append
+ * \return          true on success, false if the buffer is too small
+ */
+static bool append_components(path_writer_t *writer, const char *path)
+{
+    size_t read = 0;
+    while (path[read] != '\0') {
+        while (is_separator(path[read])) {
+            read++;
+        }
+        size_t start = read;
+        while (path[read] != '\0' && !is_separator(path[read])) {
+            read++;
+        }
+
+        size_t length = read - start;
+        if (length == 0 || (length == 1 && path[start] == '.')) {
+            continue;
+        }
+
+        if (length == 2 && path[start] == '.' && path[start + 1] == '.') {
+            // Remove the previous component, unless there is none or it is a ".." itself
+            size_t previous = writer->length;
+            while (previous > writer->root && writer->buffer[previous - 1] != '/') {
+                previous--;
+            }
+            bool parent = writer->length - previous == 2 && writer->buffer[previous] == '.' &&
+                          writer->buffer[previous + 1] == '.';
+            if (writer->length > writer->root && !parent) {
+                writer->length = previous > writer->root ? previous - 1 : writer->root;
+                continue;
+            }
+            if (writer->root > 0) {
+                continue; // Nothing is above the root
+            }
+        }
+
+        bool separator = writer->length > writer->root;
+        if (writer->length + (separator ? 1 : 0) + length >= writer->size) {
+            return false;
+        }
+        if (separator) {
+            writer->buffer[writer->length++] = '/';
+        }
+        SDL_memmove(writer->buffer + writer->length, path + start, length);
+        writer->length += length;
+    }
+    return true;
+}
+
+/**
+ * \brief           Start building a path
+ * \param[out]      writer: Path being built
+ * \param[in]       absolute: Whether the path starts at the root
+ * \param[out]      buffer: Output
+ * \param[in]       size: Size of buffer
+ * \return          true on success, false if the buffer is too small
+ */
+static bool begin_path(path_writer_t *writer, bool absolute, char *buffer, size_t size)
+{
+    writer->buffer = buffer;
+    writer->size   = size;
+    writer->length = 0;
+    writer->root   = 0;
+    if (absolute) {
+        if (size < 2) {
+            return false;
+        }
+        buffer[0]      = '/';
+        writer->length = 1;
+        writer->root   = 1;
+    }
+    return true;
+}
+
+/**
+ * \brief           Terminate a built path, an empty path becomes "."
+ * \param[in,out]   writer: Path being built
+ * \return          Length of the path, 0 if the buffer is too small
+ */
+static size_t end_path(path_writer_t *writer)
+{
+    if (writer->length == 0) {
+        if (writer->size < 2) {
+            return 0;
+        }
+        writer->buffer[writer->length++] = '.';
+    }
+    writer->buffer[writer->length] = '\0';
+    return writer->length;
+}
+
 /**
  * \brief           Check if a file exists
  * \param[in]       fileName: Path to the file
@@ -56,6 +400,10 @@ bool mvn_file_exists(const char *fileName)
         return mvn_set_error("Cannot check if file exists: Empty filename");
     }
 
+    if (mvn_vfs_resolve(fileName, NULL, 0, NULL) != MVN_VFS_SOURCE_NONE) {
+        return true;
+    }
+
     SDL_PathInfo info;
     if (SDL_GetPathInfo(fileName, &info)) {
         return info.type == SDL_PATHTYPE_FILE;
@@ -106,20 +454,9 @@ bool mvn_is_file_extension(const char *fileName, const char *ext)
         return false;
     }
 
-    mvn_string_t *fileExt = mvn_get_file_extension(fileName);
-    if (!fileExt) {
-        return mvn_set_error("Failed to get file extension");
-    }
-
-    bool result = false;
-    if (fileExt->length == 0) {
-        result = false;
-    } else {
-        result = (SDL_strcasecmp(mvn_string_to_cstr(fileExt), ext) == 0);
-    }
-
-    mvn_string_free(fileExt);
-    return result;
+    // The extension runs to the end of fileName, so it can be compared in place
+    mvn_path_view_t fileExt = mvn_get_file_extension_view(fileName);
+    return fileExt.length > 0 && SDL_strcasecmp(fileExt.data, ext) == 0;
 }
 
 /**
@@ -134,8 +471,16 @@ int32_t mvn_get_file_length(const char *fileName)
         return -1;
     }
 
+    // Mounted files are found without querying the file system
     SDL_PathInfo info;
-    if (SDL_GetPathInfo(fileName, &info) && info.type == SDL_PATHTYPE_FILE) {
+    size_t       size = 0;
+    bool         found = mvn_vfs_resolve(fileName, NULL, 0, &size) != MVN_VFS_SOURCE_NONE;
+    if (found) {
+        info.type = SDL_PATHTYPE_FILE;
+        info.size = size;
+    }
+
+    if (found || (SDL_GetPathInfo(fileName, &info) && info.type == SDL_PATHTYPE_FILE)) {
         if (info.size > INT32_MAX) {
             mvn_set_error("File size exceeds int32_t limit: %s", fileName);
             return INT32_MAX;
@@ -148,209 +493,243 @@ int32_t mvn_get_file_length(const char *fileName)
 }
 
 /**
- * \brief           Get file extension
+ * \brief           Get the extension of a file without allocating
  * \param[in]       fileName: Path to the file
- * \return          File extension as mvn_string_t including dot (e.g. ".png"), empty string if no
- * extension
+ * \return          View of the extension including the dot (e.g. ".png") into fileName, empty if
+ *                  there is no extension. It runs to the end of fileName, so it is NUL terminated.
  */
-mvn_string_t *mvn_get_file_extension(const char *fileName)
+mvn_path_view_t mvn_get_file_extension_view(const char *fileName)
 {
     if (fileName == NULL) {
         mvn_set_error("Cannot get file extension: NULL filename");
-        return mvn_string_from_cstr("");
+        return make_view("", 0);
     }
 
-    const char *dot = SDL_strrchr(fileName, '.');
+    size_t      length = SDL_strlen(fileName);
+    const char *dot    = SDL_strrchr(fileName, '.');
     if (dot == NULL || dot == fileName) {
-        return mvn_string_from_cstr(""); // No extension or filename starts with dot
+        return make_view(fileName + length, 0); // No extension or filename starts with dot
     }
 
     // Make sure there's no directory separator after the last dot
-    const char *slash = SDL_max(SDL_strrchr(fileName, '/'), SDL_strrchr(fileName, '\\'));
-    if (slash != NULL && slash > dot) {
-        return mvn_string_from_cstr(""); // Last dot is in a directory component
+    size_t slash = find_last_separator(fileName, length);
+    if (slash != length && fileName + slash > dot) {
+        return make_view(fileName + length, 0); // Last dot is in a directory component
     }
 
-    mvn_string_t *result = mvn_string_from_cstr(dot);
-    if (!result) {
-        mvn_set_error("Failed to create string for file extension");
-    }
-    return result;
+    return make_view(dot, length - (size_t)(dot - fileName));
 }
 
 /**
- * \brief           Get filename from a path
+ * \brief           Get the file name of a path without allocating
  * \param[in]       filePath: Path to the file
- * \return          Filename part of the path as mvn_string_t
+ * \return          View of the part after the last separator into filePath, NUL terminated
  */
-mvn_string_t *mvn_get_file_name(const char *filePath)
+mvn_path_view_t mvn_get_file_name_view(const char *filePath)
 {
     if (filePath == NULL) {
         mvn_set_error("Cannot get file name: NULL file path");
-        return mvn_string_from_cstr("");
+        return make_view("", 0);
     }
 
-    const char *slash1    = SDL_strrchr(filePath, '/');
-    const char *slash2    = SDL_strrchr(filePath, '\\');
-    const char *lastSlash = SDL_max(slash1, slash2);
-
-    const char   *name   = (lastSlash != NULL) ? lastSlash + 1 : filePath;
-    mvn_string_t *result = mvn_string_from_cstr(name);
+    size_t length = SDL_strlen(filePath);
+    size_t slash  = find_last_separator(filePath, length);
+    size_t start  = slash != length ? slash + 1 : 0;
+    return make_view(filePath + start, length - start);
+}
 
-    if (!result) {
-        mvn_set_error("Failed to create string for file name");
-        return mvn_string_from_cstr("");
+/**
+ * \brief           Get the file name of a path without its extension, without allocating
+ * \param[in]       filePath: Path to the file
+ * \return          View into filePath, not NUL terminated if the file has an extension
+ */
+mvn_path_view_t mvn_get_file_name_without_ext_view(const char *filePath)
+{
+    if (filePath == NULL) {
+        mvn_set_error("Cannot get file name without extension: NULL file path");
+        return make_view("", 0);
     }
 
-    return result;
+    mvn_path_view_t name = mvn_get_file_name_view(filePath);
+    mvn_path_view_t ext  = mvn_get_file_extension_view(name.data);
+    return make_view(name.data, name.length - ext.length);
 }
 
 /**
- * \brief           Get filename without extension
+ * \brief           Get the directory of a file path without allocating
  * \param[in]       filePath: Path to the file
- * \return          Filename without extension as a mvn_string_t
+ * \return          View of the part before the last separator into filePath, not NUL
+ *                  terminated, or of "." if the path has no directory
  */
-mvn_string_t *mvn_get_file_name_without_ext(const char *filePath)
+mvn_path_view_t mvn_get_directory_path_view(const char *filePath)
 {
     if (filePath == NULL) {
-        mvn_set_error("Cannot get file name without extension: NULL file path");
-        return mvn_string_from_cstr("");
+        mvn_set_error("Cannot get directory path: NULL file path");
+        return make_view("", 0);
     }
 
-    mvn_string_t *fileName = mvn_get_file_name(filePath);
-    if (!fileName) {
-        return mvn_string_from_cstr("");
+    size_t length = SDL_strlen(filePath);
+    size_t slash  = find_last_separator(filePath, length);
+    if (slash == length) {
+        return make_view(".", 1); // No directory component
     }
+    return make_view(filePath, slash);
+}
 
-    mvn_string_t *extStr = mvn_get_file_extension(mvn_string_to_cstr(fileName));
-    if (!extStr) {
-        mvn_string_free(fileName);
-        return mvn_string_from_cstr("");
+/**
+ * \brief           Get the parent of a directory path without allocating
+ * \param[in]       dirPath: Current directory path
+ * \return          View into dirPath, not NUL terminated, or of "/" for the root and "." if the
+ *                  path has no parent. Empty if dirPath is empty.
+ */
+mvn_path_view_t mvn_get_parent_directory_path_view(const char *dirPath)
+{
+    if (dirPath == NULL) {
+        mvn_set_error("Cannot get parent directory: NULL directory path");
+        return make_view("", 0);
     }
 
-    const char *name = mvn_string_to_cstr(fileName);
-    const char *ext  = mvn_string_to_cstr(extStr);
+    if (dirPath[0] == '\0') {
+        mvn_set_error("Cannot get parent directory: Empty directory path");
+        return make_view(dirPath, 0);
+    }
 
-    // Calculate the length of the filename without extension
-    size_t length = (ext[0] != '\0') ? (size_t)(ext - name) : fileName->length;
+    // Ignore trailing slashes
+    size_t length = SDL_strlen(dirPath);
+    while (length > 0 && is_separator(dirPath[length - 1])) {
+        length--;
+    }
+    if (length == 0) {
+        return make_view("/", 1); // Root directory
+    }
 
-    // Create a new string with the calculated length
-    mvn_string_t *result = mvn_string_init(length + 1);
-    if (result == NULL) {
-        mvn_set_error("Failed to create string for filename without extension");
-        mvn_string_free(fileName);
-        mvn_string_free(extStr);
-        return mvn_string_from_cstr("");
+    size_t slash = find_last_separator(dirPath, length);
+    if (slash == length) {
+        return make_view(".", 1); // No parent directory
+    }
+    if (slash == 0) {
+        return make_view("/", 1); // Root directory
     }
+    return make_view(dirPath, slash);
+}
 
-    // Copy the filename without the extension
-    SDL_memcpy(result->data, name, length);
-    result->data[length] = '\0';
-    result->length       = length;
+/**
+ * \brief           Get file extension
+ * \note            Allocates, see mvn_get_file_extension_view() for a view
+ * \param[in]       fileName: Path to the file
+ * \return          File extension as mvn_string_t including dot (e.g. ".png"), empty string if no
+ * extension
+ */
+mvn_string_t *mvn_get_file_extension(const char *fileName)
+{
+    return string_from_view(mvn_get_file_extension_view(fileName));
+}
 
-    mvn_string_free(fileName);
-    mvn_string_free(extStr);
-    return result;
+/**
+ * \brief           Get filename from a path
+ * \note            Allocates, see mvn_get_file_name_view() for a view
+ * \param[in]       filePath: Path to the file
+ * \return          Filename part of the path as mvn_string_t
+ */
+mvn_string_t *mvn_get_file_name(const char *filePath)
+{
+    return string_from_view(mvn_get_file_name_view(filePath));
+}
+
+/**
+ * \brief           Get filename without extension
+ * \note            Allocates, see mvn_get_file_name_without_ext_view() for a view
+ * \param[in]       filePath: Path to the file
+ * \return          Filename without extension as a mvn_string_t
+ */
+mvn_string_t *mvn_get_file_name_without_ext(const char *filePath)
+{
+    return string_from_view(mvn_get_file_name_without_ext_view(filePath));
 }
 
 /**
  * \brief           Get directory path from a file path
+ * \note            Allocates, see mvn_get_directory_path_view() for a view
  * \param[in]       filePath: Path to the file
  * \return          Directory path as a mvn_string_t
  */
 mvn_string_t *mvn_get_directory_path(const char *filePath)
 {
-    if (filePath == NULL) {
-        mvn_set_error("Cannot get directory path: NULL file path");
-        return mvn_string_from_cstr("");
-    }
-
-    // Find the last slash
-    const char *lastSlash1 = SDL_strrchr(filePath, '/');
-    const char *lastSlash2 = SDL_strrchr(filePath, '\\');
-    const char *lastSlash  = SDL_max(lastSlash1, lastSlash2);
-
-    mvn_string_t *result;
-
-    if (lastSlash == NULL) {
-        // No directory component, return "."
-        result = mvn_string_from_cstr(".");
-    } else {
-        // Calculate the length of the directory path
-        size_t length = (size_t)(lastSlash - filePath);
-
-        // Create a new string with the calculated length
-        result = mvn_string_init(length + 1);
-        if (result == NULL) {
-            mvn_set_error("Failed to create string for directory path");
-            return mvn_string_from_cstr("");
-        }
-
-        // Copy the directory path
-        SDL_memcpy(result->data, filePath, length);
-        result->data[length] = '\0';
-        result->length       = length;
-    }
-
-    return result;
+    return string_from_view(mvn_get_directory_path_view(filePath));
 }
 
 /**
  * \brief           Get previous directory path
+ * \note            Allocates, see mvn_get_parent_directory_path_view() for a view
  * \param[in]       dirPath: Current directory path
  * \return          Parent directory path as a mvn_string_t
  */
 mvn_string_t *mvn_get_parent_directory_path(const char *dirPath)
 {
-    if (dirPath == NULL) {
-        mvn_set_error("Cannot get parent directory: NULL directory path");
-        return mvn_string_from_cstr("");
-    }
+    return string_from_view(mvn_get_parent_directory_path_view(dirPath));
+}
 
-    if (dirPath[0] == '\0') {
-        mvn_set_error("Cannot get parent directory: Empty directory path");
-        return mvn_string_from_cstr("");
+/**
+ * \brief           Normalize a path into a buffer
+ * \note            Separators become '/', repeated separators and "." components are removed and
+ *                  ".." removes the component before it. Leading ".." of relative paths are kept,
+ *                  absolute paths stop at the root. An empty result becomes ".". Nothing is
+ *                  allocated and buffer may be path itself.
+ * \param[in]       path: Path to normalize
+ * \param[out]      buffer: Receives the NUL terminated path
+ * \param[in]       size: Size of buffer
+ * \return          Length of the normalized path, 0 on failure
+ */
+size_t mvn_normalize_path(const char *path, char *buffer, size_t size)
+{
+    if (path == NULL || buffer == NULL || size == 0) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot normalize path: invalid arguments");
+        return 0;
     }
 
-    // Make a copy of the path that we can modify
-    mvn_string_t *path = mvn_string_from_cstr(dirPath);
-    if (path == NULL) {
-        mvn_set_error("Failed to create string for parent directory path");
-        return mvn_string_from_cstr("");
+    path_writer_t writer;
+    size_t        length = 0;
+    if (begin_path(&writer, is_separator(path[0]), buffer, size) &&
+        append_components(&writer, path)) {
+        length = end_path(&writer);
     }
-
-    // Remove trailing slashes
-    while (path->length > 0 &&
-           (path->data[path->length - 1] == '/' || path->data[path->length - 1] == '\\')) {
-        path->data[path->length - 1] = '\0';
-        path->length--;
+    if (length == 0) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Buffer too small to normalize '%s'", path);
     }
+    return length;
+}
 
-    if (path->length == 0) {
-        mvn_string_free(path);
-        return mvn_string_from_cstr("/"); // Root directory
+/**
+ * \brief           Join a directory and a path into a buffer and normalize the result
+ * \note            See mvn_normalize_path(). An absolute name replaces the directory. Nothing is
+ *                  allocated and buffer may be directory itself, but not name.
+ * \param[in]       directory: Directory to start from
+ * \param[in]       name: Path relative to directory
+ * \param[out]      buffer: Receives the NUL terminated path
+ * \param[in]       size: Size of buffer
+ * \return          Length of the joined path, 0 on failure
+ */
+size_t mvn_join_path(const char *directory, const char *name, char *buffer, size_t size)
+{
+    if (directory == NULL || name == NULL || buffer == NULL || size == 0) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot join path: invalid arguments");
+        return 0;
     }
 
-    // Find the last slash
-    char *lastSlash1 = SDL_strrchr(path->data, '/');
-    char *lastSlash2 = SDL_strrchr(path->data, '\\');
-    char *lastSlash  = SDL_max(lastSlash1, lastSlash2);
-
-    if (lastSlash == NULL) {
-        mvn_string_free(path);
-        return mvn_string_from_cstr("."); // No parent directory
+    path_writer_t writer;
+    size_t        length = 0;
+    if (is_separator(name[0])) {
+        if (begin_path(&writer, true, buffer, size) && append_components(&writer, name)) {
+            length = end_path(&writer);
+        }
+    } else if (begin_path(&writer, is_separator(directory[0]), buffer, size) &&
+               append_components(&writer, directory) && append_components(&writer, name)) {
+        length = end_path(&writer);
     }
-
-    // Terminate the string at the last slash
-    *lastSlash   = '\0';
-    path->length = (size_t)(lastSlash - path->data);
-
-    if (path->length == 0) {
-        mvn_string_free(path);
-        return mvn_string_from_cstr("/"); // Root directory
+    if (length == 0) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Buffer too small to join '%s'", name);
     }
-
-    return path;
+    return length;
 }
 
 /**
@@ -365,8 +744,8 @@ mvn_string_t *mvn_get_application_directory(void)
                mvn_string_from_cstr("");
     }
 
+    /* SDL owns the base path, it must not be freed */
     mvn_string_t *result = mvn_string_from_cstr(basePath);
-    MVN_FREE((void *)basePath);
 
     if (result == NULL) {
         mvn_set_error("Failed to create string for application directory");
@@ -392,6 +771,10 @@ bool mvn_is_path_file(const char *path)
         return mvn_set_error("Cannot check if path is a file: Empty path");
     }
 
+    if (mvn_vfs_resolve(path, NULL, 0, NULL) != MVN_VFS_SOURCE_NONE) {
+        return true;
+    }
+
     SDL_PathInfo info;
     if (SDL_GetPathInfo(path, &info)) {
         return info.type == SDL_PATHTYPE_FILE;
@@ -441,6 +824,12 @@ int64_t mvn_get_file_mod_time(const char *fileName)
         return -1;
     }
 
+    // Files in archives have the modification time of the archive
+    char native[MVN_VFS_PATH_SIZE];
+    if (mvn_vfs_resolve(fileName, native, sizeof(native), NULL) != MVN_VFS_SOURCE_NONE) {
+        fileName = native;
+    }
+
     SDL_PathInfo info;
     if (SDL_GetPathInfo(fileName, &info)) {
         if (info.type == SDL_PATHTYPE_FILE) {
@@ -453,3 +842,184 @@ int64_t mvn_get_file_mod_time(const char *fileName)
     mvn_set_error("Failed to get path info: %s", SDL_GetError());
     return -1;
 }
+
+/**
+ * \brief           Open a read-only view of a whole file
+ * \note            Regular files are memory mapped on Linux, so pages are only read when they are
+ *                  touched and nothing is copied. Other files and platforms fall back to reading
+ *                  the file into a heap buffer.
+ * \param[in]       fileName: Path to the file
+ * \param[out]      view: Receives the view, release it with mvn_file_unmap()
+ * \return          true on success, false on failure
+ */
+bool mvn_file_map(const char *fileName, mvn_file_view_t *view)
+{
+    if (view == NULL) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot map file: NULL view");
+    }
+
+    SDL_zerop(view);
+    if (fileName == NULL) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot map file: NULL filename");
+    }
+
+    char             native[MVN_VFS_PATH_SIZE];
+    mvn_vfs_source_t source = MVN_VFS_SOURCE_NONE;
+    if (!mvn_vfs_open(fileName, native, sizeof(native), view, &source)) {
+        return false;
+    }
+    if (source == MVN_VFS_SOURCE_ARCHIVE) {
+        return true;
+    }
+    if (source == MVN_VFS_SOURCE_DIRECTORY) {
+        fileName = native;
+    }
+
+#if defined(MVN_FILE_MMAP)
+    int fd = open(fileName, O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 &&
+            (uint64_t)info.st_size <= SIZE_MAX) {
+            void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                close(fd); // The mapping keeps the file alive
+                view->data   = data;
+                view->size   = (size_t)info.st_size;
+                view->mapped = true;
+                return true;
+            }
+        }
+        close(fd);
+    }
+    // Empty files and files that cannot be mapped are read instead
+#endif
+
+    size_t size = 0;
+    void  *data = read_native_file(fileName, &size);
+    if (data == NULL) {
+        return false;
+    }
+
+    view->data = data;
+    view->size = size;
+    return true;
+}
+
+/**
+ * \brief           Release a view opened with mvn_file_map()
+ * \param[in]       view: View to release, reset to an empty view
+ */
+void mvn_file_unmap(mvn_file_view_t *view)
+{
+    if (view == NULL || view->data == NULL) {
+        return;
+    }
+
+    if (view->release != NULL) {
+        view->release(view->owner);
+    } else if (view->mapped) {
+#if defined(MVN_FILE_MMAP)
+        munmap((void *)view->data, view->size);
+#endif
+    } else {
+        MVN_FREE((void *)view->data);
+    }
+
+    SDL_zerop(view);
+}
+
+/**
+ * \brief           Open a read-only SDL stream over a view of a whole file
+ * \note            Lets SDL_image and SDL_ttf read mapped memory instead of going through stdio.
+ *                  The view is released when the stream is closed.
+ * \param[in]       fileName: Path to the file
+ * \return          Stream to close with SDL_CloseIO(), NULL on failure
+ */
+SDL_IOStream *mvn_file_open_io(const char *fileName)
+{
+    mvn_file_stream_t *stream = MVN_MALLOC(sizeof(mvn_file_stream_t));
+    if (stream == NULL) {
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate file stream");
+        return NULL;
+    }
+
+    stream->position = 0;
+    if (!mvn_file_map(fileName, &stream->view)) {
+        MVN_FREE(stream);
+        return NULL;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size  = stream_size;
+    iface.seek  = stream_seek;
+    iface.read  = stream_read;
+    iface.close = stream_close;
+
+    SDL_IOStream *io = SDL_OpenIO(&iface, stream);
+    if (io == NULL) {
+        mvn_set_error_code(MVN_ERROR_SDL, "Failed to open file stream: %s", SDL_GetError());
+        stream_close(stream);
+    }
+    return io;
+}
+
+/**
+ * \brief           Load the whole contents of a file
+ * \param[in]       fileName: Path to the file
+ * \param[out]      size: Receives the size of the contents in bytes, may be NULL
+ * \return          Contents to free with mvn_unload_file_data(), NULL on failure
+ */
+void *mvn_load_file_data(const char *fileName, size_t *size)
+{
+    if (size != NULL) {
+        *size = 0;
+    }
+
+    if (fileName == NULL) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot load file data: NULL filename");
+        return NULL;
+    }
+
+    size_t length = 0;
+    void  *data   = read_file(fileName, &length);
+    if (data != NULL && size != NULL) {
+        *size = length;
+    }
+    return data;
+}
+
+/**
+ * \brief           Free contents loaded with mvn_load_file_data()
+ * \param[in]       data: Contents to free, may be NULL
+ */
+void mvn_unload_file_data(void *data)
+{
+    MVN_FREE(data);
+}
+
+/**
+ * \brief           Load the whole contents of a file as a NUL terminated string
+ * \param[in]       fileName: Path to the file
+ * \return          Text to free with mvn_unload_file_text(), NULL on failure
+ */
+char *mvn_load_file_text(const char *fileName)
+{
+    if (fileName == NULL) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot load file text: NULL filename");
+        return NULL;
+    }
+
+    size_t length = 0;
+    return read_file(fileName, &length);
+}
+
+/**
+ * \brief           Free text loaded with mvn_load_file_text()
+ * \param[in]       text: Text to free, may be NULL
+ */
+void mvn_unload_file_text(char *text)
+{
+    MVN_FREE(text);
+}
@@ -0,0 +1,498 @@
+/**
+ * \file            mvn-format.c
+ * \brief           Deferred printf-style formatting for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn-format.h"
+
+#include <SDL3/SDL.h>
+
+/* Longest flags part of a conversion specification that is kept */
+#define MVN_FORMAT_MAX_FLAGS 7
+
+/**
+ * \brief           One conversion specification of a format string
+ */
+typedef struct mvn_format_spec_t {
+    size_t length;                          /*!< Characters from the '%' to the conversion */
+    char   flags[MVN_FORMAT_MAX_FLAGS + 1]; /*!< Flags, null terminated */
+    int    width;                           /*!< Field width, 0 if there is none */
+    int    precision;                       /*!< Precision, -1 if there is none */
+    bool   star_width;                      /*!< Width is taken from an int argument */
+    bool   star_precision;                  /*!< Precision is taken from an int argument */
+    char   modifier[3];                     /*!< Length modifier, empty if there is none */
+    char   conversion;                      /*!< Conversion character */
+} mvn_format_spec_t;
+
+/**
+ * \brief           Output buffer that truncates like snprintf
+ */
+typedef struct mvn_format_output_t {
+    char  *data;   /*!< Output buffer */
+    size_t size;   /*!< Size of data, including the null terminator */
+    size_t length; /*!< Characters written so far */
+} mvn_format_output_t;
+
+/**
+ * \brief           Read a decimal number of a conversion specification
+ * \param[in,out]   p: Read position, advanced past the digits
+ * \return          Value of the number
+ */
+static int parse_number(const char **p)
+{
+    int value = 0;
+    while (SDL_isdigit(**p)) {
+        value = SDL_min(value * 10 + (**p - '0'), 0xFFFF);
+        (*p)++;
+    }
+    return value;
+}
+
+/**
+ * \brief           Parse the conversion specification starting at a '%'
+ * \param[in]       fmt: Pointer to the '%'
+ * \param[out]      spec: Parsed specification
+ * \return          true on success, false if the format string ends inside the specification
+ */
+static bool parse_spec(const char *fmt, mvn_format_spec_t *spec)
+{
+    const char *p     = fmt + 1;
+    size_t      flags = 0;
+    SDL_zerop(spec);
+    spec->precision = -1;
+
+    while (*p != '\0' && SDL_strchr("-+ #0", *p) != NULL) {
+        if (flags < MVN_FORMAT_MAX_FLAGS) {
+            spec->flags[flags++] = *p;
+        }
+        p++;
+    }
+    if (*p == '*') {
+        spec->star_width = true;
+        p++;
+    } else if (SDL_isdigit(*p)) {
+        spec->width = parse_number(&p);
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->star_precision = true;
+            p++;
+        } else {
+            spec->precision = parse_number(&p);
+        }
+    }
+    for (size_t i = 0; i < 2 && *p != '\0' && SDL_strchr("hljztL", *p) != NULL; i++) {
+        spec->modifier[i] = *p++;
+    }
+    if (*p == '\0') {
+        return false;
+    }
+    spec->conversion = *p;
+    spec->length     = (size_t)(p + 1 - fmt);
+    return true;
+}
+
+/**
+ * \brief           Get how the argument of a conversion is read
+ * \param[in]       spec: Conversion specification
+ * \return          mvn_format_arg_t of the argument, -1 if the conversion cannot be packed
+ */
+static int get_arg_type(const mvn_format_spec_t *spec)
+{
+    const char *modifier = spec->modifier;
+    switch (spec->conversion) {
+        case 'c':
+            return modifier[0] == '\0' ? MVN_FORMAT_ARG_INT : -1;
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            if (SDL_strcmp(modifier, "l") == 0) {
+                return MVN_FORMAT_ARG_LONG;
+            }
+            if (SDL_strcmp(modifier, "ll") == 0) {
+                return MVN_FORMAT_ARG_LLONG;
+            }
+            if (SDL_strcmp(modifier, "z") == 0) {
+                return MVN_FORMAT_ARG_SIZE;
+            }
+            if (SDL_strcmp(modifier, "j") == 0) {
+                return MVN_FORMAT_ARG_INTMAX;
+            }
+            if (SDL_strcmp(modifier, "t") == 0) {
+                return MVN_FORMAT_ARG_PTRDIFF;
+            }
+            // Narrower types are promoted to int
+            return MVN_FORMAT_ARG_INT;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            return modifier[0] == 'L' ? MVN_FORMAT_ARG_LDOUBLE : MVN_FORMAT_ARG_DOUBLE;
+        case 's':
+            return modifier[0] == '\0' ? MVN_FORMAT_ARG_STRING : -1;
+        case 'p':
+            return MVN_FORMAT_ARG_POINTER;
+        default:
+            // %n and wide characters are not supported
+            return -1;
+    }
+}
+
+/**
+ * \brief           Read bytes of packed arguments
+ * \param[in,out]   cursor: Read position, advanced past the bytes
+ * \param[in]       end: End of the packed arguments
+ * \param[out]      out: Receives the bytes
+ * \param[in]       size: Number of bytes
+ * \return          true on success, false if the arguments end first
+ */
+static bool read_packed(const uint8_t **cursor, const uint8_t *end, void *out, size_t size)
+{
+    if ((size_t)(end - *cursor) < size) {
+        return false;
+    }
+    SDL_memcpy(out, *cursor, size);
+    *cursor += size;
+    return true;
+}
+
+/**
+ * \brief           Append formatted text to an output buffer, truncating it when full
+ * \param[in,out]   output: Output buffer
+ * \param[in]       fmt: Formatting string
+ * \param[in]       ...: Arguments for the format string
+ */
+static void output_format(mvn_format_output_t *output, const char *fmt, ...)
+{
+    if (output->length + 1 >= output->size) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    int written = SDL_vsnprintf(
+        output->data + output->length, output->size - output->length, fmt, args);
+    va_end(args);
+
+    if (written > 0) {
+        output->length = SDL_min(output->length + (size_t)written, output->size - 1);
+    }
+}
+
+/**
+ * \brief           Append one conversion of packed arguments to an output buffer
+ * \param[in,out]   output: Output buffer
+ * \param[in]       spec: Parsed specification
+ * \param[in,out]   cursor: Read position of the packed arguments
+ * \param[in]       end: End of the packed arguments
+ * \return          true on success, false if the arguments are truncated
+ */
+static bool unpack_conversion(mvn_format_output_t     *output,
+                              const mvn_format_spec_t *spec,
+                              const uint8_t          **cursor,
+                              const uint8_t           *end)
+{
+    int     width     = spec->width;
+    int     precision = spec->precision;
+    int64_t value     = 0;
+    if (spec->star_width) {
+        if (!read_packed(cursor, end, &value, sizeof(value))) {
+            return false;
+        }
+        width = (int)value;
+    }
+    if (spec->star_precision) {
+        if (!read_packed(cursor, end, &value, sizeof(value))) {
+            return false;
+        }
+        precision = (int)value;
+    }
+
+    // Rebuild the specification with the width and precision passed as arguments
+    char        text[32];
+    const char *modifier   = spec->modifier;
+    char        conversion = spec->conversion;
+    int         type       = get_arg_type(spec);
+    int         prefix     = SDL_snprintf(text, sizeof(text), "%%%s*", spec->flags);
+    char       *suffix     = text + prefix;
+    size_t      room       = sizeof(text) - (size_t)prefix;
+
+    switch (type) {
+        case MVN_FORMAT_ARG_STRING: {
+            uint16_t stored = 0;
+            if (!read_packed(cursor, end, &stored, sizeof(stored)) ||
+                (size_t)(end - *cursor) < stored) {
+                return false;
+            }
+            const char *string = (const char *)*cursor;
+            *cursor += stored;
+
+            // The packed characters are not null terminated, the precision bounds them
+            int length = precision >= 0 ? SDL_min(precision, (int)stored) : (int)stored;
+            SDL_strlcpy(suffix, ".*s", room);
+            output_format(output, text, width, length, string);
+            return true;
+        }
+        case MVN_FORMAT_ARG_DOUBLE:
+        case MVN_FORMAT_ARG_LDOUBLE: {
+            double number = 0.0;
+            if (!read_packed(cursor, end, &number, sizeof(number))) {
+                return false;
+            }
+            // A negative precision counts as none
+            SDL_snprintf(suffix, room, ".*%c", conversion);
+            output_format(output, text, width, precision, number);
+            return true;
+        }
+        case MVN_FORMAT_ARG_POINTER: {
+            uint64_t pointer = 0;
+            if (!read_packed(cursor, end, &pointer, sizeof(pointer))) {
+                return false;
+            }
+            SDL_strlcpy(suffix, "p", room);
+            output_format(output, text, width, (void *)(uintptr_t)pointer);
+            return true;
+        }
+        default:
+            break;
+    }
+
+    if (!read_packed(cursor, end, &value, sizeof(value))) {
+        return false;
+    }
+    if (conversion == 'c') {
+        SDL_strlcpy(suffix, "c", room);
+        output_format(output, text, width, (int)value);
+        return true;
+    }
+
+    // Integers were widened when packed, narrow them back to the type that was printed
+    SDL_snprintf(suffix, room, ".*ll%c", conversion);
+    if (conversion == 'd' || conversion == 'i') {
+        long long number = (long long)value;
+        if (SDL_strcmp(modifier, "hh") == 0) {
+            number = (signed char)value;
+        } else if (SDL_strcmp(modifier, "h") == 0) {
+            number = (short)value;
+        } else if (modifier[0] == '\0') {
+            number = (int)value;
+        } else if (SDL_strcmp(modifier, "l") == 0) {
+            number = (long)value;
+        }
+        output_format(output, text, width, precision, number);
+        return true;
+    }
+
+    unsigned long long number = (unsigned long long)value;
+    if (SDL_strcmp(modifier, "hh") == 0) {
+        number = (unsigned char)value;
+    } else if (SDL_strcmp(modifier, "h") == 0) {
+        number = (unsigned short)value;
+    } else if (modifier[0] == '\0') {
+        number = (unsigned int)value;
+    } else if (SDL_strcmp(modifier, "l") == 0) {
+        number = (unsigned long)value;
+    }
+    output_format(output, text, width, precision, number);
+    return true;
+}
+
+/**
+ * \brief           Find the arguments a format string reads
+ * \param[in]       fmt: Format string
+ * \param[out]      types: Receives the mvn_format_arg_t of each argument
+ * \return          Number of arguments, -1 if the format string cannot be packed
+ */
+int mvn_format_parse(const char *fmt, uint8_t types[MVN_FORMAT_MAX_ARGS])
+{
+    int count = 0;
+    if (fmt == NULL) {
+        return -1;
+    }
+
+    for (const char *p = fmt; *p != '\0'; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+
+        mvn_format_spec_t spec;
+        int               type = -1;
+        if (!parse_spec(p, &spec) || (type = get_arg_type(&spec)) < 0 ||
+            count + 3 > MVN_FORMAT_MAX_ARGS) {
+            return -1;
+        }
+        if (spec.star_width) {
+            types[count++] = MVN_FORMAT_ARG_INT;
+        }
+        if (spec.star_precision) {
+            types[count++] = MVN_FORMAT_ARG_INT;
+        }
+        types[count++] = (uint8_t)type;
+        p += spec.length - 1;
+    }
+    return count;
+}
+
+/**
+ * \brief           Copy the arguments of a format string so it can be formatted later
+ * \param[in]       types: Argument types found by mvn_format_parse()
+ * \param[in]       count: Number of arguments
+ * \param[out]      out: Receives the packed arguments
+ * \param[in]       capacity: Size of out, at least 8 bytes per argument. Strings are
+ *                  truncated to fit.
+ * \param[in]       args: Arguments for the format string
+ * \return          Bytes written to out
+ */
+size_t mvn_format_pack(const uint8_t *types, int count, void *out, size_t capacity, va_list args)
+{
+    uint8_t *bytes = out;
+    size_t   size  = 0;
+    for (int i = 0; i < count; i++) {
+        int64_t value = 0;
+        switch (types[i]) {
+            case MVN_FORMAT_ARG_INT:
+                value = va_arg(args, int);
+                break;
+            case MVN_FORMAT_ARG_LONG:
+                value = va_arg(args, long);
+                break;
+            case MVN_FORMAT_ARG_LLONG:
+                value = va_arg(args, long long);
+                break;
+            case MVN_FORMAT_ARG_SIZE:
+                value = (int64_t)va_arg(args, size_t);
+                break;
+            case MVN_FORMAT_ARG_INTMAX:
+                value = (int64_t)va_arg(args, intmax_t);
+                break;
+            case MVN_FORMAT_ARG_PTRDIFF:
+                value = (int64_t)va_arg(args, ptrdiff_t);
+                break;
+            case MVN_FORMAT_ARG_DOUBLE: {
+                double number = va_arg(args, double);
+                SDL_memcpy(&value, &number, sizeof(value));
+                break;
+            }
+            case MVN_FORMAT_ARG_LDOUBLE: {
+                double number = (double)va_arg(args, long double);
+                SDL_memcpy(&value, &number, sizeof(value));
+                break;
+            }
+            case MVN_FORMAT_ARG_POINTER:
+                value = (int64_t)(uintptr_t)va_arg(args, void *);
+                break;
+            case MVN_FORMAT_ARG_STRING: {
+                const char *text   = va_arg(args, const char *);
+                size_t      length = 0;
+                if (text == NULL) {
+                    text = "(null)";
+                }
+                if (size + sizeof(uint16_t) > capacity) {
+                    continue;
+                }
+
+                // Leave room for the arguments that follow
+                size_t room = capacity - size - sizeof(uint16_t);
+                size_t rest = (size_t)(count - i - 1) * sizeof(value);
+                room        = SDL_min(room > rest ? room - rest : 0, UINT16_MAX);
+                while (length < room && text[length] != '\0') {
+                    length++;
+                }
+                uint16_t stored = (uint16_t)length;
+                SDL_memcpy(bytes + size, &stored, sizeof(stored));
+                SDL_memcpy(bytes + size + sizeof(stored), text, length);
+                size += sizeof(stored) + length;
+                continue;
+            }
+            default:
+                break;
+        }
+        if (size + sizeof(value) <= capacity) {
+            SDL_memcpy(bytes + size, &value, sizeof(value));
+            size += sizeof(value);
+        }
+    }
+    return size;
+}
+
+/**
+ * \brief           Format a format string with arguments packed by mvn_format_pack()
+ * \param[out]      out: Receives the formatted text, truncated to fit
+ * \param[in]       size: Size of out, including the null terminator
+ * \param[in]       fmt: Format string the arguments were packed for
+ * \param[in,out]   cursor: Start of the packed arguments, advanced past them
+ * \param[in]       end: End of the packed arguments
+ * \return          true on success, false if the arguments do not match the format string
+ */
+bool mvn_format_unpack(
+    char *out, size_t size, const char *fmt, const uint8_t **cursor, const uint8_t *end)
+{
+    if (out == NULL || size == 0 || fmt == NULL || cursor == NULL) {
+        return false;
+    }
+
+    mvn_format_output_t output = { out, size, 0 };
+    const char         *p      = fmt;
+    out[0]                     = '\0';
+    while (*p != '\0') {
+        const char *percent = SDL_strchr(p, '%');
+        if (percent == NULL) {
+            output_format(&output, "%s", p);
+            break;
+        }
+        output_format(&output, "%.*s", (int)(percent - p), p);
+        if (percent[1] == '%') {
+            output_format(&output, "%%");
+            p = percent + 2;
+            continue;
+        }
+
+        mvn_format_spec_t spec;
+        if (!parse_spec(percent, &spec) || get_arg_type(&spec) < 0 ||
+            !unpack_conversion(&output, &spec, cursor, end)) {
+            return false;
+        }
+        p = percent + spec.length;
+    }
+    return true;
+}
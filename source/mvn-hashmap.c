@@ -3,6 +3,8 @@
  * \brief           Implementation of unordered hashmap for MVN game framework
  */
 
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_HASHMAP
+
 #include "mvn/mvn-hashmap.h"
 
 #include "mvn/mvn-error.h"
@@ -19,39 +21,49 @@
 #define MVN_HMAP_GROWTH_FACTOR 2
 
 /**
- * \brief           Calculate hash for a string key
- * \param[in]       key: String key to hash
- * \return          Hash value for the key
- *
- * Uses FNV-1a hash algorithm
+ * \brief           Get the bucket index for a key hash
+ * \param[in]       hash: Hash value of the key
+ * \param[in]       bucket_count: Number of buckets
+ * \return          Bucket index
  */
-static size_t hash_string(const char *key)
+static size_t bucket_index(uint64_t hash, size_t bucket_count)
 {
-    if (!key) {
-        return 0;
-    }
-
-    /* FNV-1a hash parameters */
-    const size_t FNV_PRIME        = 16777619;
-    const size_t FNV_OFFSET_BASIS = 2166136261;
-
-    size_t hash = FNV_OFFSET_BASIS;
-    while (*key) {
-        hash ^= (unsigned char)*key++;
-        hash *= FNV_PRIME;
-    }
+    return (size_t)(hash % bucket_count);
+}
 
-    return hash;
+/**
+ * \brief           Check whether an entry holds a key
+ * \param[in]       entry: Entry to check
+ * \param[in]       key: Key data
+ * \param[in]       key_length: Key length in bytes
+ * \param[in]       hash: Hash of the key
+ * \return          true if the entry key matches, false otherwise
+ *
+ * Compares hash, then length, then bytes so mismatches rarely touch the key data
+ */
+static bool entry_matches(const mvn_hmap_entry_t *entry,
+                          const char             *key,
+                          size_t                  key_length,
+                          uint64_t                hash)
+{
+    return entry->hash == hash && entry->key_length == key_length &&
+           SDL_memcmp(entry->key, key, key_length) == 0;
 }
 
 /**
  * \brief           Create a new entry
  * \param[in]       key: String key for the entry
+ * \param[in]       key_length: Key length in bytes
+ * \param[in]       hash: Hash of the key
  * \param[in]       value: Pointer to value data
  * \param[in]       value_size: Size of the value in bytes
  * \return          Newly created entry or NULL on failure
  */
-static mvn_hmap_entry_t *create_entry(const char *key, const void *value, size_t value_size)
+static mvn_hmap_entry_t *create_entry(const char *key,
+                                      size_t      key_length,
+                                      uint64_t    hash,
+                                      const void *value,
+                                      size_t      value_size)
 {
     if (!key || !value) {
         return NULL;
@@ -64,14 +76,16 @@ static mvn_hmap_entry_t *create_entry(const char *key, const void *value, size_t
     }
 
     /* Copy key */
-    size_t key_len = SDL_strlen(key) + 1;
-    entry->key     = MVN_MALLOC(key_len);
+    entry->key = MVN_MALLOC(key_length + 1);
     if (!entry->key) {
         mvn_set_error("Failed to allocate memory for hashmap entry key");
         MVN_FREE(entry);
         return NULL;
     }
-    SDL_memcpy(entry->key, key, key_len);
+    SDL_memcpy(entry->key, key, key_length);
+    entry->key[key_length] = '\0';
+    entry->key_length      = key_length;
+    entry->hash            = hash;
 
     /* Copy value */
     entry->value = MVN_MALLOC(value_size);
@@ -137,8 +151,8 @@ static bool resize_hashmap(mvn_hmap_t *hmap, size_t new_capacity)
             /* Get the next entry before we modify this one */
             mvn_hmap_entry_t *next = entry->next;
 
-            /* Insert into new buckets */
-            size_t new_index       = hash_string(entry->key) % new_capacity;
+            /* Insert into new buckets, reusing the stored hash */
+            size_t new_index       = bucket_index(entry->hash, new_capacity);
             entry->next            = new_buckets[new_index];
             new_buckets[new_index] = entry;
 
@@ -246,29 +260,17 @@ size_t mvn_hmap_length(const mvn_hmap_t *hmap)
 }
 
 /**
- * \brief           Set a value in the hashmap
+ * \brief           Set a value for a key with a precomputed hash
  * \param[in]       hmap: Hashmap to modify
- * \param[in]       key: String key
+ * \param[in]       key: Key data
+ * \param[in]       key_length: Key length in bytes
+ * \param[in]       hash: Hash of the key
  * \param[in]       value: Pointer to value (will be copied)
  * \return          true if successful, false otherwise
  */
-bool mvn_hmap_set(mvn_hmap_t *hmap, const char *key, const void *value)
+static bool
+hmap_set(mvn_hmap_t *hmap, const char *key, size_t key_length, uint64_t hash, const void *value)
 {
-    if (hmap == NULL) {
-        mvn_set_error("Cannot set value in NULL hashmap");
-        return false;
-    }
-
-    if (key == NULL) {
-        mvn_set_error("Cannot set value with NULL key");
-        return false;
-    }
-
-    if (value == NULL) {
-        mvn_set_error("Cannot set NULL value in hashmap");
-        return false;
-    }
-
     /* Check if we need to resize */
     if (hmap->length > (size_t)((double)hmap->bucket_count * MVN_HMAP_LOAD_FACTOR)) {
         size_t new_capacity = hmap->bucket_count * MVN_HMAP_GROWTH_FACTOR;
@@ -278,12 +280,12 @@ bool mvn_hmap_set(mvn_hmap_t *hmap, const char *key, const void *value)
     }
 
     /* Calculate bucket index */
-    size_t index = hash_string(key) % hmap->bucket_count;
+    size_t index = bucket_index(hash, hmap->bucket_count);
 
     /* Check if key already exists */
     mvn_hmap_entry_t *entry = hmap->buckets[index];
     while (entry) {
-        if (SDL_strcmp(entry->key, key) == 0) {
+        if (entry_matches(entry, key, key_length, hash)) {
             /* Update existing entry */
             SDL_memcpy(entry->value, value, hmap->item_size);
             return true;
@@ -292,7 +294,7 @@ bool mvn_hmap_set(mvn_hmap_t *hmap, const char *key, const void *value)
     }
 
     /* Create new entry */
-    mvn_hmap_entry_t *new_entry = create_entry(key, value, hmap->item_size);
+    mvn_hmap_entry_t *new_entry = create_entry(key, key_length, hash, value, hmap->item_size);
     if (!new_entry) {
         return false; // Error already set by create_entry
     }
@@ -305,6 +307,85 @@ bool mvn_hmap_set(mvn_hmap_t *hmap, const char *key, const void *value)
     return true;
 }
 
+/**
+ * \brief           Get a value for a key with a precomputed hash
+ * \param[in]       hmap: Hashmap to query
+ * \param[in]       key: Key data
+ * \param[in]       key_length: Key length in bytes
+ * \param[in]       hash: Hash of the key
+ * \return          Pointer to value or NULL if not found
+ */
+static void *hmap_get(const mvn_hmap_t *hmap, const char *key, size_t key_length, uint64_t hash)
+{
+    /* Search for key in the bucket */
+    mvn_hmap_entry_t *entry = hmap->buckets[bucket_index(hash, hmap->bucket_count)];
+    while (entry) {
+        if (entry_matches(entry, key, key_length, hash)) {
+            return entry->value;
+        }
+        entry = entry->next;
+    }
+
+    /* Key not found */
+    mvn_set_error_code(MVN_ERROR_NOT_FOUND, "Key '%s' not found in hashmap", key);
+    return NULL;
+}
+
+/**
+ * \brief           Delete the entry for a key with a precomputed hash
+ * \param[in]       hmap: Hashmap to modify
+ * \param[in]       key: Key data
+ * \param[in]       key_length: Key length in bytes
+ * \param[in]       hash: Hash of the key
+ * \return          true if entry was deleted, false if not found
+ */
+static bool hmap_delete(mvn_hmap_t *hmap, const char *key, size_t key_length, uint64_t hash)
+{
+    /* Walk the bucket keeping a pointer to the link that references the entry */
+    mvn_hmap_entry_t **link = &hmap->buckets[bucket_index(hash, hmap->bucket_count)];
+    while (*link) {
+        mvn_hmap_entry_t *entry = *link;
+        if (entry_matches(entry, key, key_length, hash)) {
+            *link = entry->next;
+            free_entry(entry);
+            hmap->length--;
+            return true;
+        }
+        link = &entry->next;
+    }
+
+    /* Key not found */
+    return mvn_set_error_code(MVN_ERROR_NOT_FOUND, "Key '%s' not found in hashmap", key);
+}
+
+/**
+ * \brief           Set a value in the hashmap
+ * \param[in]       hmap: Hashmap to modify
+ * \param[in]       key: String key
+ * \param[in]       value: Pointer to value (will be copied)
+ * \return          true if successful, false otherwise
+ */
+bool mvn_hmap_set(mvn_hmap_t *hmap, const char *key, const void *value)
+{
+    if (hmap == NULL) {
+        mvn_set_error("Cannot set value in NULL hashmap");
+        return false;
+    }
+
+    if (key == NULL) {
+        mvn_set_error("Cannot set value with NULL key");
+        return false;
+    }
+
+    if (value == NULL) {
+        mvn_set_error("Cannot set NULL value in hashmap");
+        return false;
+    }
+
+    size_t key_length = SDL_strlen(key);
+    return hmap_set(hmap, key, key_length, mvn_string_hash_bytes(key, key_length), value);
+}
+
 /**
  * \brief           Get a value from the hashmap
  * \param[in]       hmap: Hashmap to query
@@ -323,21 +404,8 @@ void *mvn_hmap_get(const mvn_hmap_t *hmap, const char *key)
         return NULL;
     }
 
-    /* Calculate bucket index */
-    size_t index = hash_string(key) % hmap->bucket_count;
-
-    /* Search for key in the bucket */
-    mvn_hmap_entry_t *entry = hmap->buckets[index];
-    while (entry) {
-        if (SDL_strcmp(entry->key, key) == 0) {
-            return entry->value;
-        }
-        entry = entry->next;
-    }
-
-    /* Key not found */
-    mvn_set_error("Key '%s' not found in hashmap", key);
-    return NULL;
+    size_t key_length = SDL_strlen(key);
+    return hmap_get(hmap, key, key_length, mvn_string_hash_bytes(key, key_length));
 }
 
 /**
@@ -358,40 +426,81 @@ bool mvn_hmap_delete(mvn_hmap_t *hmap, const char *key)
         return false;
     }
 
-    /* Calculate bucket index */
-    size_t index = hash_string(key) % hmap->bucket_count;
+    size_t key_length = SDL_strlen(key);
+    return hmap_delete(hmap, key, key_length, mvn_string_hash_bytes(key, key_length));
+}
 
-    /* Handle first entry in bucket */
-    mvn_hmap_entry_t *entry = hmap->buckets[index];
-    if (!entry) {
-        return mvn_set_error("Key '%s' not found in hashmap", key); /* Bucket is empty */
+/**
+ * \brief           Set a value in the hashmap using a string key
+ * \note            Reuses the cached hash and length of the key instead of rescanning it
+ * \param[in]       hmap: Hashmap to modify
+ * \param[in]       key: String key
+ * \param[in]       value: Pointer to value (will be copied)
+ * \return          true if successful, false otherwise
+ */
+bool mvn_hmap_set_string(mvn_hmap_t *hmap, const mvn_string_t *key, const void *value)
+{
+    if (hmap == NULL) {
+        mvn_set_error("Cannot set value in NULL hashmap");
+        return false;
     }
 
-    if (SDL_strcmp(entry->key, key) == 0) {
-        /* First entry matches */
-        hmap->buckets[index] = entry->next;
-        free_entry(entry);
-        hmap->length--;
-        return true;
+    if (key == NULL) {
+        mvn_set_error("Cannot set value with NULL key");
+        return false;
     }
 
-    /* Search rest of the bucket */
-    mvn_hmap_entry_t *prev = entry;
-    entry                  = entry->next;
-    while (entry) {
-        if (SDL_strcmp(entry->key, key) == 0) {
-            /* Found the entry */
-            prev->next = entry->next;
-            free_entry(entry);
-            hmap->length--;
-            return true;
-        }
-        prev  = entry;
-        entry = entry->next;
+    if (value == NULL) {
+        mvn_set_error("Cannot set NULL value in hashmap");
+        return false;
     }
 
-    /* Key not found */
-    return mvn_set_error("Key '%s' not found in hashmap", key);
+    return hmap_set(hmap, key->data, key->length, mvn_string_hash(key), value);
+}
+
+/**
+ * \brief           Get a value from the hashmap using a string key
+ * \note            Reuses the cached hash and length of the key instead of rescanning it. Fills
+ *                  the cache of the key, see mvn_string_hash() for sharing keys between threads.
+ * \param[in]       hmap: Hashmap to query
+ * \param[in]       key: String key
+ * \return          Pointer to value or NULL if not found
+ */
+void *mvn_hmap_get_string(const mvn_hmap_t *hmap, const mvn_string_t *key)
+{
+    if (!hmap) {
+        mvn_set_error("Cannot get value from NULL hashmap");
+        return NULL;
+    }
+
+    if (!key) {
+        mvn_set_error("Cannot get value with NULL key");
+        return NULL;
+    }
+
+    return hmap_get(hmap, key->data, key->length, mvn_string_hash(key));
+}
+
+/**
+ * \brief           Delete an entry from the hashmap using a string key
+ * \note            Reuses the cached hash and length of the key instead of rescanning it
+ * \param[in]       hmap: Hashmap to modify
+ * \param[in]       key: String key
+ * \return          true if entry was deleted, false if not found or error
+ */
+bool mvn_hmap_delete_string(mvn_hmap_t *hmap, const mvn_string_t *key)
+{
+    if (hmap == NULL) {
+        mvn_set_error("Cannot delete from NULL hashmap");
+        return false;
+    }
+
+    if (key == NULL) {
+        mvn_set_error("Cannot delete NULL key from hashmap");
+        return false;
+    }
+
+    return hmap_delete(hmap, key->data, key->length, mvn_string_hash(key));
 }
 
 /**
@@ -418,8 +527,10 @@ mvn_list_t *mvn_hmap_keys(const mvn_hmap_t *hmap)
         mvn_hmap_entry_t *entry = hmap->buckets[i];
         while (entry) {
             /* Copy the key string */
-            char *key_copy = SDL_strdup(entry->key);
-            if (!key_copy) {
+            char *key_copy = MVN_MALLOC(entry->key_length + 1);
+            if (key_copy) {
+                SDL_memcpy(key_copy, entry->key, entry->key_length + 1);
+            } else {
                 mvn_set_error("Failed to copy key for hashmap keys list");
                 // Free previously added keys before freeing the list
                 for (size_t j = 0; j < mvn_list_length(keys); ++j) {
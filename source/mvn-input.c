@@ -0,0 +1,576 @@
+/**
+ * \file            mvn-input.c
+ * \brief           Buffered keyboard, mouse and gamepad input for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn-input.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-window.h"
+
+#include <SDL3/SDL.h>
+
+/* Bits of a key or button state */
+#define MVN_INPUT_DOWN     0x01 // Held at the time of the last event
+#define MVN_INPUT_PRESSED  0x02 // Went down during the current frame
+#define MVN_INPUT_RELEASED 0x04 // Went up during the current frame
+
+/* Edges found by mvn_sample_input(), reported in the next frame */
+#define MVN_INPUT_PENDING_PRESSED  0x08 // Went down after the current frame was updated
+#define MVN_INPUT_PENDING_RELEASED 0x10 // Went up after the current frame was updated
+#define MVN_INPUT_PENDING_SHIFT    2    // Shift from pending to current edge bits
+
+/**
+ * \brief           State of one connected gamepad
+ */
+typedef struct mvn_gamepad_state_t {
+    SDL_Gamepad   *handle;                            /*!< Open gamepad, NULL for a free slot */
+    SDL_JoystickID id;                                /*!< Instance id of the gamepad */
+    uint8_t        buttons[SDL_GAMEPAD_BUTTON_COUNT]; /*!< Button states */
+    float          axes[SDL_GAMEPAD_AXIS_COUNT];      /*!< Axis values from -1 to 1 */
+} mvn_gamepad_state_t;
+
+/* Keyboard and mouse state, updated from events */
+static uint8_t      g_keys[SDL_SCANCODE_COUNT];              // Key states by scancode
+static uint8_t      g_mouse_buttons[MVN_MOUSE_BUTTON_COUNT]; // Button states by SDL_BUTTON_*
+static mvn_fpoint_t g_mouse_position = { 0.0f, 0.0f };       // Last known cursor position
+static mvn_fpoint_t g_mouse_delta    = { 0.0f, 0.0f };       // Motion during this frame
+static mvn_fpoint_t g_mouse_wheel    = { 0.0f, 0.0f };       // Scrolling during this frame
+static bool         g_quit_requested = false;                // Quit or ESC this frame
+
+/* Changes found by mvn_sample_input(), moved into the next frame by mvn_update_input() */
+static bool         g_sampling      = false;          // Whether events are being sampled
+static mvn_fpoint_t g_pending_delta = { 0.0f, 0.0f }; // Motion after the frame was updated
+static mvn_fpoint_t g_pending_wheel = { 0.0f, 0.0f }; // Scrolling after the frame was updated
+static bool         g_quit_pending  = false;          // Quit or ESC after the frame was updated
+
+/* Gamepad slots, filled in the order gamepads connect */
+static mvn_gamepad_state_t g_gamepads[MVN_MAX_GAMEPADS];
+
+/* Ring of typed characters, written by events and read by mvn_get_char_pressed */
+static uint32_t g_text_ring[MVN_TEXT_INPUT_RING_SIZE];
+static uint32_t g_text_head = 0; // Next slot to write
+static uint32_t g_text_tail = 0; // Next slot to read
+
+/**
+ * \brief           Record a key or button going down or up
+ * \param[in,out]   state: State bits to update
+ * \param[in]       down: true if the key went down, false if it went up
+ */
+static void set_button_state(uint8_t *state, bool down)
+{
+    // Edges sampled late belong to the next frame, the held state is current right away
+    uint8_t pressed  = g_sampling ? MVN_INPUT_PENDING_PRESSED : MVN_INPUT_PRESSED;
+    uint8_t released = g_sampling ? MVN_INPUT_PENDING_RELEASED : MVN_INPUT_RELEASED;
+    if (down) {
+        *state |= MVN_INPUT_DOWN | pressed;
+    } else {
+        *state = (uint8_t)((*state & ~MVN_INPUT_DOWN) | released);
+    }
+}
+
+/**
+ * \brief           Replace the pressed and released bits of a state array with the pending ones
+ * \param[in,out]   states: States to update
+ * \param[in]       count: Number of states
+ */
+static void clear_edges(uint8_t *states, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        uint8_t edges = (uint8_t)(states[i] >> MVN_INPUT_PENDING_SHIFT);
+        edges &= MVN_INPUT_PRESSED | MVN_INPUT_RELEASED;
+        states[i] = (uint8_t)((states[i] & MVN_INPUT_DOWN) | edges);
+    }
+}
+
+/**
+ * \brief           Find the slot of a connected gamepad
+ * \param[in]       id: Instance id of the gamepad
+ * \return          Slot or NULL if the gamepad is not tracked
+ */
+static mvn_gamepad_state_t *find_gamepad(SDL_JoystickID id)
+{
+    for (int i = 0; i < MVN_MAX_GAMEPADS; i++) {
+        if (g_gamepads[i].handle != NULL && g_gamepads[i].id == id) {
+            return &g_gamepads[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Open a gamepad that was connected and give it a free slot
+ * \param[in]       id: Instance id of the gamepad
+ */
+static void add_gamepad(SDL_JoystickID id)
+{
+    if (find_gamepad(id) != NULL) {
+        return;
+    }
+
+    for (int i = 0; i < MVN_MAX_GAMEPADS; i++) {
+        if (g_gamepads[i].handle == NULL) {
+            g_gamepads[i].handle = SDL_OpenGamepad(id);
+            if (g_gamepads[i].handle == NULL) {
+                mvn_log_warn("Failed to open gamepad %u: %s", (unsigned)id, SDL_GetError());
+                return;
+            }
+            g_gamepads[i].id = id;
+            return;
+        }
+    }
+    mvn_log_warn("Ignoring gamepad %u, all %d slots are in use", (unsigned)id, MVN_MAX_GAMEPADS);
+}
+
+/**
+ * \brief           Close a disconnected gamepad and free its slot
+ * \param[in]       id: Instance id of the gamepad
+ */
+static void remove_gamepad(SDL_JoystickID id)
+{
+    mvn_gamepad_state_t *gamepad = find_gamepad(id);
+    if (gamepad != NULL) {
+        SDL_CloseGamepad(gamepad->handle);
+        SDL_zerop(gamepad);
+    }
+}
+
+/**
+ * \brief           Append the characters of a text input event to the ring
+ * \note            Characters that do not fit are dropped until the ring is read
+ * \param[in]       text: UTF-8 text of the event
+ */
+static void push_text(const char *text)
+{
+    size_t length = SDL_strlen(text);
+    while (length > 0) {
+        uint32_t codepoint = SDL_StepUTF8(&text, &length);
+        if (codepoint == 0) {
+            break;
+        }
+        if (g_text_head - g_text_tail >= MVN_TEXT_INPUT_RING_SIZE) {
+            continue;
+        }
+        g_text_ring[g_text_head & (MVN_TEXT_INPUT_RING_SIZE - 1)] = codepoint;
+        g_text_head++;
+    }
+}
+
+/**
+ * \brief           Apply one event to the input state
+ * \param[in]       event: Event to apply
+ */
+static void handle_event(const SDL_Event *event)
+{
+    mvn_gamepad_state_t *gamepad;
+    mvn_fpoint_t        *delta = g_sampling ? &g_pending_delta : &g_mouse_delta;
+    mvn_fpoint_t        *wheel = g_sampling ? &g_pending_wheel : &g_mouse_wheel;
+    bool                *quit  = g_sampling ? &g_quit_pending : &g_quit_requested;
+
+    // Window and display events keep the cached window state current
+    mvn_window_handle_event(event);
+
+    switch (event->type) {
+        case SDL_EVENT_QUIT:
+            *quit = true;
+            break;
+
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            // Key repeat only produces text, not new presses
+            if (event->key.repeat) {
+                break;
+            }
+            if (event->key.scancode > SDL_SCANCODE_UNKNOWN &&
+                event->key.scancode < SDL_SCANCODE_COUNT) {
+                set_button_state(&g_keys[event->key.scancode], event->key.down);
+            }
+            if (event->key.down && event->key.key == SDLK_ESCAPE) {
+                *quit = true;
+            }
+            break;
+
+        case SDL_EVENT_TEXT_INPUT:
+            push_text(event->text.text);
+            break;
+
+        case SDL_EVENT_MOUSE_MOTION:
+            g_mouse_position.x = event->motion.x;
+            g_mouse_position.y = event->motion.y;
+            delta->x += event->motion.xrel;
+            delta->y += event->motion.yrel;
+            break;
+
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            if (event->button.button < MVN_MOUSE_BUTTON_COUNT) {
+                set_button_state(&g_mouse_buttons[event->button.button], event->button.down);
+            }
+            g_mouse_position.x = event->button.x;
+            g_mouse_position.y = event->button.y;
+            break;
+
+        case SDL_EVENT_MOUSE_WHEEL:
+            wheel->x += event->wheel.x;
+            wheel->y += event->wheel.y;
+            break;
+
+        case SDL_EVENT_GAMEPAD_ADDED:
+            add_gamepad(event->gdevice.which);
+            break;
+
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            remove_gamepad(event->gdevice.which);
+            break;
+
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+            gamepad = find_gamepad(event->gbutton.which);
+            if (gamepad != NULL && event->gbutton.button < SDL_GAMEPAD_BUTTON_COUNT) {
+                set_button_state(&gamepad->buttons[event->gbutton.button], event->gbutton.down);
+            }
+            break;
+
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            gamepad = find_gamepad(event->gaxis.which);
+            if (gamepad != NULL && event->gaxis.axis < SDL_GAMEPAD_AXIS_COUNT) {
+                // Map the asymmetric integer range to -1..1
+                gamepad->axes[event->gaxis.axis] =
+                    SDL_max((float)event->gaxis.value / (float)SDL_JOYSTICK_AXIS_MAX, -1.0f);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * \brief           Apply all pending events to the input state
+ */
+static void pump_events(void)
+{
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        handle_event(&event);
+    }
+}
+
+/**
+ * \brief           Start a new input frame and apply all pending events
+ * \note            Called by mvn_window_should_close(). Pressed and released edges, mouse motion
+ *                  and scrolling describe what happened since the previous call, including what
+ *                  mvn_sample_input() found after it.
+ */
+void mvn_update_input(void)
+{
+    clear_edges(g_keys, SDL_arraysize(g_keys));
+    clear_edges(g_mouse_buttons, SDL_arraysize(g_mouse_buttons));
+    for (int i = 0; i < MVN_MAX_GAMEPADS; i++) {
+        clear_edges(g_gamepads[i].buttons, SDL_arraysize(g_gamepads[i].buttons));
+    }
+    g_mouse_delta    = g_pending_delta;
+    g_mouse_wheel    = g_pending_wheel;
+    g_quit_requested = g_quit_pending;
+    g_quit_pending   = false;
+    SDL_zero(g_pending_delta);
+    SDL_zero(g_pending_wheel);
+
+    pump_events();
+}
+
+/**
+ * \brief           Apply events that arrived since the last update without starting a new frame
+ * \note            Called by mvn_begin_drawing() so drawing uses input sampled as late as
+ *                  possible, e.g. for a cursor. Positions and held states change right away.
+ *                  Edges, motion, scrolling and quit requests are kept for the next frame, as
+ *                  the game already ran its update for the current one.
+ */
+void mvn_sample_input(void)
+{
+    g_sampling = true;
+    pump_events();
+    g_sampling = false;
+}
+
+/**
+ * \brief           Check whether closing was requested during the current input frame
+ * \return          true after a quit event or an ESC press, false otherwise
+ */
+bool mvn_is_quit_requested(void)
+{
+    return g_quit_requested;
+}
+
+/**
+ * \brief           Close gamepads and reset the input state
+ * \note            Called by mvn_quit()
+ */
+void mvn_input_shutdown(void)
+{
+    for (int i = 0; i < MVN_MAX_GAMEPADS; i++) {
+        if (g_gamepads[i].handle != NULL) {
+            SDL_CloseGamepad(g_gamepads[i].handle);
+        }
+    }
+    SDL_zeroa(g_gamepads);
+    SDL_zeroa(g_keys);
+    SDL_zeroa(g_mouse_buttons);
+    g_mouse_position.x = 0.0f;
+    g_mouse_position.y = 0.0f;
+    g_mouse_delta      = g_mouse_position;
+    g_mouse_wheel      = g_mouse_position;
+    g_quit_requested   = false;
+    g_quit_pending     = false;
+    g_pending_delta    = g_mouse_position;
+    g_pending_wheel    = g_mouse_position;
+    g_text_head        = 0;
+    g_text_tail        = 0;
+}
+
+/**
+ * \brief           Check if a key is held down
+ * \param[in]       key: Key to check
+ * \return          true if the key is down, false otherwise
+ */
+bool mvn_is_key_down(mvn_key_t key)
+{
+    return key >= 0 && key < SDL_SCANCODE_COUNT && (g_keys[key] & MVN_INPUT_DOWN) != 0;
+}
+
+/**
+ * \brief           Check if a key is not held down
+ * \param[in]       key: Key to check
+ * \return          true if the key is up, false otherwise
+ */
+bool mvn_is_key_up(mvn_key_t key)
+{
+    return !mvn_is_key_down(key);
+}
+
+/**
+ * \brief           Check if a key went down during the current input frame
+ * \param[in]       key: Key to check
+ * \return          true if the key was pressed, false otherwise
+ */
+bool mvn_is_key_pressed(mvn_key_t key)
+{
+    return key >= 0 && key < SDL_SCANCODE_COUNT && (g_keys[key] & MVN_INPUT_PRESSED) != 0;
+}
+
+/**
+ * \brief           Check if a key went up during the current input frame
+ * \param[in]       key: Key to check
+ * \return          true if the key was released, false otherwise
+ */
+bool mvn_is_key_released(mvn_key_t key)
+{
+    return key >= 0 && key < SDL_SCANCODE_COUNT && (g_keys[key] & MVN_INPUT_RELEASED) != 0;
+}
+
+/**
+ * \brief           Check if a mouse button is held down
+ * \param[in]       button: Button to check, one of SDL_BUTTON_*
+ * \return          true if the button is down, false otherwise
+ */
+bool mvn_is_mouse_button_down(int button)
+{
+    return button >= 0 && button < MVN_MOUSE_BUTTON_COUNT &&
+           (g_mouse_buttons[button] & MVN_INPUT_DOWN) != 0;
+}
+
+/**
+ * \brief           Check if a mouse button went down during the current input frame
+ * \param[in]       button: Button to check, one of SDL_BUTTON_*
+ * \return          true if the button was pressed, false otherwise
+ */
+bool mvn_is_mouse_button_pressed(int button)
+{
+    return button >= 0 && button < MVN_MOUSE_BUTTON_COUNT &&
+           (g_mouse_buttons[button] & MVN_INPUT_PRESSED) != 0;
+}
+
+/**
+ * \brief           Check if a mouse button went up during the current input frame
+ * \param[in]       button: Button to check, one of SDL_BUTTON_*
+ * \return          true if the button was released, false otherwise
+ */
+bool mvn_is_mouse_button_released(int button)
+{
+    return button >= 0 && button < MVN_MOUSE_BUTTON_COUNT &&
+           (g_mouse_buttons[button] & MVN_INPUT_RELEASED) != 0;
+}
+
+/**
+ * \brief           Get the cursor position in window coordinates
+ * \return          Last known cursor position
+ */
+mvn_fpoint_t mvn_get_mouse_position(void)
+{
+    return g_mouse_position;
+}
+
+/**
+ * \brief           Get the mouse motion of the current input frame
+ * \return          Motion in window coordinates
+ */
+mvn_fpoint_t mvn_get_mouse_delta(void)
+{
+    return g_mouse_delta;
+}
+
+/**
+ * \brief           Get the scrolling of the current input frame
+ * \return          Horizontal and vertical scroll amount
+ */
+mvn_fpoint_t mvn_get_mouse_wheel(void)
+{
+    return g_mouse_wheel;
+}
+
+/**
+ * \brief           Get the slot of a gamepad index
+ * \param[in]       gamepad: Gamepad index
+ * \return          Slot or NULL if no gamepad uses the index
+ */
+static const mvn_gamepad_state_t *get_gamepad(int gamepad)
+{
+    if (gamepad < 0 || gamepad >= MVN_MAX_GAMEPADS || g_gamepads[gamepad].handle == NULL) {
+        return NULL;
+    }
+    return &g_gamepads[gamepad];
+}
+
+/**
+ * \brief           Check if a gamepad is connected
+ * \param[in]       gamepad: Gamepad index, from 0 to MVN_MAX_GAMEPADS - 1
+ * \return          true if the gamepad is connected, false otherwise
+ */
+bool mvn_is_gamepad_available(int gamepad)
+{
+    return get_gamepad(gamepad) != NULL;
+}
+
+/**
+ * \brief           Check if a gamepad button is held down
+ * \param[in]       gamepad: Gamepad index
+ * \param[in]       button: Button to check
+ * \return          true if the button is down, false otherwise
+ */
+bool mvn_is_gamepad_button_down(int gamepad, mvn_gamepad_button_t button)
+{
+    const mvn_gamepad_state_t *state = get_gamepad(gamepad);
+    return state != NULL && button >= 0 && button < SDL_GAMEPAD_BUTTON_COUNT &&
+           (state->buttons[button] & MVN_INPUT_DOWN) != 0;
+}
+
+/**
+ * \brief           Check if a gamepad button went down during the current input frame
+ * \param[in]       gamepad: Gamepad index
+ * \param[in]       button: Button to check
+ * \return          true if the button was pressed, false otherwise
+ */
+bool mvn_is_gamepad_button_pressed(int gamepad, mvn_gamepad_button_t button)
+{
+    const mvn_gamepad_state_t *state = get_gamepad(gamepad);
+    return state != NULL && button >= 0 && button < SDL_GAMEPAD_BUTTON_COUNT &&
+           (state->buttons[button] & MVN_INPUT_PRESSED) != 0;
+}
+
+/**
+ * \brief           Check if a gamepad button went up during the current input frame
+ * \param[in]       gamepad: Gamepad index
+ * \param[in]       button: Button to check
+ * \return          true if the button was released, false otherwise
+ */
+bool mvn_is_gamepad_button_released(int gamepad, mvn_gamepad_button_t button)
+{
+    const mvn_gamepad_state_t *state = get_gamepad(gamepad);
+    return state != NULL && button >= 0 && button < SDL_GAMEPAD_BUTTON_COUNT &&
+           (state->buttons[button] & MVN_INPUT_RELEASED) != 0;
+}
+
+/**
+ * \brief           Get the value of a gamepad axis
+ * \param[in]       gamepad: Gamepad index
+ * \param[in]       axis: Axis to read
+ * \return          Value from -1 to 1 for sticks and 0 to 1 for triggers, 0 if unavailable
+ */
+float mvn_get_gamepad_axis(int gamepad, mvn_gamepad_axis_t axis)
+{
+    const mvn_gamepad_state_t *state = get_gamepad(gamepad);
+    if (state == NULL || axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT) {
+        return 0.0f;
+    }
+    return state->axes[axis];
+}
+
+/**
+ * \brief           Start receiving text input for mvn_get_char_pressed()
+ * \note            May show an on-screen keyboard on some platforms
+ * \return          true on success, false on failure
+ */
+bool mvn_start_text_input(void)
+{
+    if (!SDL_StartTextInput(mvn_get_window())) {
+        return mvn_set_error("Failed to start text input: %s", SDL_GetError());
+    }
+    return true;
+}
+
+/**
+ * \brief           Stop receiving text input
+ * \return          true on success, false on failure
+ */
+bool mvn_stop_text_input(void)
+{
+    if (!SDL_StopTextInput(mvn_get_window())) {
+        return mvn_set_error("Failed to stop text input: %s", SDL_GetError());
+    }
+    return true;
+}
+
+/**
+ * \brief           Take the next typed character
+ * \note            Call repeatedly until it returns 0 to read everything typed since the last
+ *                  call. Requires mvn_start_text_input().
+ * \return          Unicode codepoint, 0 when no character is buffered
+ */
+uint32_t mvn_get_char_pressed(void)
+{
+    if (g_text_tail == g_text_head) {
+        return 0;
+    }
+    uint32_t codepoint = g_text_ring[g_text_tail & (MVN_TEXT_INPUT_RING_SIZE - 1)];
+    g_text_tail++;
+    return codepoint;
+}
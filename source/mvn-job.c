@@ -0,0 +1,791 @@
+/**
+ * \file            mvn-job.c
+ * \brief           Work-stealing job system for MVN game framework
+ */
+
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_JOB
+
+#include "mvn/mvn-job.h"
+
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-profile.h"
+#include "mvn/mvn-utils.h"
+
+#include <SDL3/SDL.h>
+
+/* Jobs each deque can hold, must be a power of two */
+#define MVN_JOB_DEQUE_SIZE 4096
+
+/* Jobs allocated at once when the free list runs empty */
+#define MVN_JOB_BLOCK_SIZE 256
+
+/* Idle iterations mvn_job_wait spins before yielding the CPU */
+#define MVN_JOB_WAIT_SPINS 64
+
+/**
+ * \brief           Submitted job
+ */
+typedef struct mvn_job_t {
+    mvn_job_fn         function;  /*!< Function to run */
+    void              *user_data; /*!< Argument of function */
+    mvn_job_counter_t *counter;   /*!< Counter released when the job finished, may be NULL */
+    struct mvn_job_t  *next;      /*!< Link in the free list, a waiter list or the inject queue */
+} mvn_job_t;
+
+/**
+ * \brief           Block of jobs allocated together
+ */
+typedef struct mvn_job_block_t {
+    struct mvn_job_block_t *next;                      /*!< Next allocated block */
+    mvn_job_t               jobs[MVN_JOB_BLOCK_SIZE]; /*!< Jobs of the block */
+} mvn_job_block_t;
+
+/**
+ * \brief           Chase-Lev work-stealing deque
+ * \note            The owning thread pushes and pops at the bottom, other threads steal from the
+ *                  top. Indices wrap and are only compared through their difference.
+ */
+typedef struct mvn_job_deque_t {
+    SDL_AtomicU32 top;                       /*!< Next index to steal */
+    uint8_t       padding[60];               /*!< Keeps top and bottom on separate cache lines */
+    SDL_AtomicU32 bottom;                    /*!< Next index to push */
+    void         *slots[MVN_JOB_DEQUE_SIZE]; /*!< Queued jobs */
+} mvn_job_deque_t;
+
+/**
+ * \brief           Call queued for the main thread
+ */
+typedef struct mvn_main_thread_call_t {
+    mvn_job_fn function;  /*!< Function to run */
+    void      *user_data; /*!< Argument of function */
+} mvn_main_thread_call_t;
+
+/* Worker pool, deque 0 belongs to the main thread and deque i to worker i */
+static SDL_Thread     **g_workers      = NULL; // Worker threads, indexed from 1
+static mvn_job_deque_t *g_deques       = NULL; // One deque per participating thread
+static int              g_deque_count  = 0;    // Length of g_deques, fixed while workers run
+static int              g_worker_count = 0;    // Number of worker threads started
+static SDL_AtomicInt    g_running;             // Non-zero while workers should keep running
+static SDL_AtomicInt    g_sleeping;            // Workers waiting on g_wake
+static SDL_Semaphore   *g_wake = NULL;         // Signalled when work is submitted
+static SDL_TLSID        g_deque_tls;           // Deque index + 1 of the calling thread
+static SDL_AtomicInt    g_outstanding;         // Jobs scheduled and not finished running
+
+/* Queue for jobs submitted by threads that own no deque */
+static SDL_Mutex    *g_inject_lock = NULL;
+static mvn_job_t    *g_inject_head = NULL;
+static mvn_job_t    *g_inject_tail = NULL;
+static SDL_AtomicInt g_inject_count;
+
+/* Job allocation */
+static SDL_SpinLock     g_pool_lock;        // Guards g_free_jobs and g_job_blocks
+static mvn_job_t       *g_free_jobs  = NULL; // Jobs ready for reuse
+static mvn_job_block_t *g_job_blocks = NULL; // Every block allocated so far
+
+/* Calls for the main thread, swapped with the back list while they are run */
+static SDL_Mutex  *g_main_lock       = NULL;
+static mvn_list_t *g_main_calls      = NULL;
+static mvn_list_t *g_main_calls_back = NULL;
+
+/**
+ * \brief           Push a job at the bottom of a deque, owner thread only
+ * \param[in]       deque: Deque of the calling thread
+ * \param[in]       job: Job to push
+ * \return          true on success, false if the deque is full
+ */
+static bool deque_push(mvn_job_deque_t *deque, mvn_job_t *job)
+{
+    uint32_t bottom = SDL_GetAtomicU32(&deque->bottom);
+    uint32_t top    = SDL_GetAtomicU32(&deque->top);
+    if (bottom - top >= MVN_JOB_DEQUE_SIZE) {
+        return false;
+    }
+
+    SDL_SetAtomicPointer(&deque->slots[bottom & (MVN_JOB_DEQUE_SIZE - 1)], job);
+    SDL_SetAtomicU32(&deque->bottom, bottom + 1);
+    return true;
+}
+
+/**
+ * \brief           Pop the most recently pushed job of a deque, owner thread only
+ * \param[in]       deque: Deque of the calling thread
+ * \return          Job or NULL if the deque is empty
+ */
+static mvn_job_t *deque_pop(mvn_job_deque_t *deque)
+{
+    uint32_t bottom = SDL_GetAtomicU32(&deque->bottom) - 1;
+    SDL_SetAtomicU32(&deque->bottom, bottom);
+    uint32_t top = SDL_GetAtomicU32(&deque->top);
+
+    if ((int32_t)(bottom - top) < 0) {
+        SDL_SetAtomicU32(&deque->bottom, bottom + 1);
+        return NULL;
+    }
+
+    mvn_job_t *job = SDL_GetAtomicPointer(&deque->slots[bottom & (MVN_JOB_DEQUE_SIZE - 1)]);
+    if (bottom != top) {
+        return job;
+    }
+
+    // Last job, a thief may be taking it at the same time
+    if (!SDL_CompareAndSwapAtomicU32(&deque->top, top, top + 1)) {
+        job = NULL;
+    }
+    SDL_SetAtomicU32(&deque->bottom, bottom + 1);
+    return job;
+}
+
+/**
+ * \brief           Steal the oldest job of a deque, any thread
+ * \param[in]       deque: Deque to steal from
+ * \return          Job or NULL if the deque is empty or another thread won the race
+ */
+static mvn_job_t *deque_steal(mvn_job_deque_t *deque)
+{
+    uint32_t top    = SDL_GetAtomicU32(&deque->top);
+    uint32_t bottom = SDL_GetAtomicU32(&deque->bottom);
+    if ((int32_t)(bottom - top) <= 0) {
+        return NULL;
+    }
+
+    mvn_job_t *job = SDL_GetAtomicPointer(&deque->slots[top & (MVN_JOB_DEQUE_SIZE - 1)]);
+    if (!SDL_CompareAndSwapAtomicU32(&deque->top, top, top + 1)) {
+        return NULL;
+    }
+    return job;
+}
+
+/**
+ * \brief           Get the deque index of the calling thread
+ * \return          Index into g_deques, -1 if the thread owns no deque
+ */
+static int current_deque_index(void)
+{
+    return (int)(intptr_t)SDL_GetTLS(&g_deque_tls) - 1;
+}
+
+/**
+ * \brief           Take a job from the free list, allocating a new block if needed
+ * \return          Job or NULL on allocation failure
+ */
+static mvn_job_t *alloc_job(void)
+{
+    SDL_LockSpinlock(&g_pool_lock);
+    if (g_free_jobs == NULL) {
+        mvn_job_block_t *block = MVN_MALLOC(sizeof(mvn_job_block_t));
+        if (block == NULL) {
+            SDL_UnlockSpinlock(&g_pool_lock);
+            return NULL;
+        }
+        for (int i = 0; i < MVN_JOB_BLOCK_SIZE - 1; i++) {
+            block->jobs[i].next = &block->jobs[i + 1];
+        }
+        block->jobs[MVN_JOB_BLOCK_SIZE - 1].next = NULL;
+        block->next                              = g_job_blocks;
+        g_job_blocks                             = block;
+        g_free_jobs                              = block->jobs;
+    }
+
+    mvn_job_t *job = g_free_jobs;
+    g_free_jobs    = job->next;
+    SDL_UnlockSpinlock(&g_pool_lock);
+    return job;
+}
+
+/**
+ * \brief           Return a job to the free list
+ * \param[in]       job: Job that finished
+ */
+static void free_job(mvn_job_t *job)
+{
+    SDL_LockSpinlock(&g_pool_lock);
+    job->next   = g_free_jobs;
+    g_free_jobs = job;
+    SDL_UnlockSpinlock(&g_pool_lock);
+}
+
+/**
+ * \brief           Queue a job that is ready to run and wake a sleeping worker
+ * \param[in]       job: Job to queue
+ */
+static void schedule_job(mvn_job_t *job)
+{
+    SDL_AddAtomicInt(&g_outstanding, 1);
+
+    int index = current_deque_index();
+    if (index < 0 || !deque_push(&g_deques[index], job)) {
+        job->next = NULL;
+        SDL_LockMutex(g_inject_lock);
+        if (g_inject_tail != NULL) {
+            g_inject_tail->next = job;
+        } else {
+            g_inject_head = job;
+        }
+        g_inject_tail = job;
+        SDL_AddAtomicInt(&g_inject_count, 1);
+        SDL_UnlockMutex(g_inject_lock);
+    }
+
+    if (SDL_GetAtomicInt(&g_sleeping) > 0) {
+        SDL_SignalSemaphore(g_wake);
+    }
+}
+
+/**
+ * \brief           Find a job for a thread: its own deque first, then the inject queue, then steal
+ * \param[in]       index: Deque index of the calling thread, -1 if it owns none
+ * \return          Job or NULL if no work was found
+ */
+static mvn_job_t *find_job(int index)
+{
+    mvn_job_t *job = NULL;
+
+    if (index >= 0) {
+        job = deque_pop(&g_deques[index]);
+        if (job != NULL) {
+            return job;
+        }
+    }
+
+    if (SDL_GetAtomicInt(&g_inject_count) > 0) {
+        SDL_LockMutex(g_inject_lock);
+        job = g_inject_head;
+        if (job != NULL) {
+            g_inject_head = job->next;
+            if (g_inject_head == NULL) {
+                g_inject_tail = NULL;
+            }
+            SDL_AddAtomicInt(&g_inject_count, -1);
+        }
+        SDL_UnlockMutex(g_inject_lock);
+        if (job != NULL) {
+            return job;
+        }
+    }
+
+    // Start with the next deque so thieves spread over their victims
+    for (int i = 1; i <= g_deque_count; i++) {
+        int victim = (index + i + g_deque_count) % g_deque_count;
+        if (victim != index) {
+            job = deque_steal(&g_deques[victim]);
+            if (job != NULL) {
+                return job;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Release one job of a counter and start its waiters when it reaches zero
+ * \note            The transition to zero happens under the lock, so mvn_job_wait can take the
+ *                  lock once to know that no thread touches the counter anymore
+ * \param[in]       counter: Counter of a finished job
+ */
+static void release_counter(mvn_job_counter_t *counter)
+{
+    SDL_LockSpinlock(&counter->lock);
+    mvn_job_t *waiters = NULL;
+    if (SDL_AddAtomicInt(&counter->pending, -1) == 1) {
+        waiters          = counter->waiters;
+        counter->waiters = NULL;
+    }
+    SDL_UnlockSpinlock(&counter->lock);
+
+    while (waiters != NULL) {
+        mvn_job_t *next = waiters->next;
+        schedule_job(waiters);
+        waiters = next;
+    }
+}
+
+/**
+ * \brief           Run a job, return it to the pool and release its counter
+ * \param[in]       job: Job to run
+ */
+static void execute_job(mvn_job_t *job)
+{
+    mvn_job_fn         function  = job->function;
+    void              *user_data = job->user_data;
+    mvn_job_counter_t *counter   = job->counter;
+    free_job(job);
+
+    MVN_PROFILE_ZONE("job")
+    {
+        function(user_data);
+    }
+
+    if (counter != NULL) {
+        release_counter(counter);
+    }
+
+    // Jobs started by this one were scheduled before it stops counting as outstanding
+    SDL_AddAtomicInt(&g_outstanding, -1);
+}
+
+/**
+ * \brief           Worker thread main loop
+ * \param[in]       data: Deque index of the worker
+ * \return          0
+ */
+static int worker_main(void *data)
+{
+    int index = (int)(intptr_t)data;
+    SDL_SetTLS(&g_deque_tls, (void *)(intptr_t)(index + 1), NULL);
+
+    while (SDL_GetAtomicInt(&g_running) != 0) {
+        mvn_job_t *job = find_job(index);
+        if (job == NULL) {
+            // Announce the sleep before the last look so a submitter either sees the sleeper
+            // or the sleeper sees the job
+            SDL_AddAtomicInt(&g_sleeping, 1);
+            job = find_job(index);
+            if (job == NULL && SDL_GetAtomicInt(&g_running) != 0) {
+                SDL_WaitSemaphore(g_wake);
+            }
+            SDL_AddAtomicInt(&g_sleeping, -1);
+        }
+
+        if (job != NULL) {
+            execute_job(job);
+        }
+    }
+
+    SDL_SetTLS(&g_deque_tls, NULL, NULL);
+    return 0;
+}
+
+/**
+ * \brief           Start the job system
+ * \note            Called by mvn_init(). Must be called from the main thread, which takes part in
+ *                  running jobs while it waits for them. Until the job system runs, jobs run
+ *                  inline on the submitting thread.
+ * \param[in]       worker_count: Number of worker threads, 0 to use one per logical CPU core
+ *                  besides the main thread
+ * \return          true on success, false on failure
+ */
+bool mvn_job_system_init(int worker_count)
+{
+    if (g_deques != NULL) {
+        return mvn_set_error("Job system already initialized");
+    }
+
+    if (worker_count <= 0) {
+        worker_count = SDL_max(1, SDL_GetNumLogicalCPUCores() - 1);
+    }
+
+    g_deques          = MVN_CALLOC((size_t)worker_count + 1, sizeof(mvn_job_deque_t));
+    g_workers         = MVN_CALLOC((size_t)worker_count + 1, sizeof(SDL_Thread *));
+    g_wake            = SDL_CreateSemaphore(0);
+    g_inject_lock     = SDL_CreateMutex();
+    g_main_lock       = SDL_CreateMutex();
+    g_main_calls      = mvn_list_init(sizeof(mvn_main_thread_call_t), 64);
+    g_main_calls_back = mvn_list_init(sizeof(mvn_main_thread_call_t), 64);
+    if (g_deques == NULL || g_workers == NULL || g_wake == NULL || g_inject_lock == NULL ||
+        g_main_lock == NULL || g_main_calls == NULL || g_main_calls_back == NULL) {
+        mvn_job_system_shutdown();
+        return mvn_set_error("Failed to allocate job system");
+    }
+
+    g_deque_count = worker_count + 1;
+    SDL_SetTLS(&g_deque_tls, (void *)(intptr_t)1, NULL);
+    SDL_SetAtomicInt(&g_running, 1);
+
+    for (int i = 1; i <= worker_count; i++) {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "mvn-worker-%d", i);
+        g_workers[i] = SDL_CreateThread(worker_main, name, (void *)(intptr_t)i);
+        if (g_workers[i] == NULL) {
+            mvn_job_system_shutdown();
+            return mvn_set_error("Failed to create job worker: %s", SDL_GetError());
+        }
+        g_worker_count = i;
+    }
+
+    mvn_log_debug("Job system started with %d workers", g_worker_count);
+    return true;
+}
+
+/**
+ * \brief           Finish all queued jobs and stop the worker threads
+ * \note            Called by mvn_quit(). Waits until no job is queued or running, including
+ *                  jobs that running jobs start, and runs calls queued for the main thread.
+ *                  Jobs waiting on a counter that never reaches zero are dropped.
+ */
+void mvn_job_system_shutdown(void)
+{
+    if (g_deques != NULL && SDL_GetAtomicInt(&g_running) != 0) {
+        // Help the workers until no job runs that could start more work, and the main thread
+        // calls queue no more work
+        for (;;) {
+            mvn_job_t *job = find_job(0);
+            if (job != NULL) {
+                execute_job(job);
+            } else if (SDL_GetAtomicInt(&g_outstanding) > 0) {
+                SDL_DelayNS(0);
+            } else if (mvn_job_run_main_thread_queue() == 0) {
+                break;
+            }
+        }
+
+        SDL_SetAtomicInt(&g_running, 0);
+        for (int i = 0; i < g_worker_count; i++) {
+            SDL_SignalSemaphore(g_wake);
+        }
+    }
+
+    if (g_workers != NULL) {
+        for (int i = 1; i <= g_worker_count; i++) {
+            SDL_WaitThread(g_workers[i], NULL);
+        }
+    }
+    g_worker_count = 0;
+    g_deque_count  = 0;
+    SDL_SetTLS(&g_deque_tls, NULL, NULL);
+
+    SDL_DestroySemaphore(g_wake);
+    SDL_DestroyMutex(g_inject_lock);
+    SDL_DestroyMutex(g_main_lock);
+    mvn_list_free(g_main_calls);
+    mvn_list_free(g_main_calls_back);
+    MVN_FREE(g_workers);
+    MVN_FREE(g_deques);
+    g_wake            = NULL;
+    g_inject_lock     = NULL;
+    g_main_lock       = NULL;
+    g_main_calls      = NULL;
+    g_main_calls_back = NULL;
+    g_workers         = NULL;
+    g_deques          = NULL;
+    g_inject_head     = NULL;
+    g_inject_tail     = NULL;
+    SDL_SetAtomicInt(&g_inject_count, 0);
+    SDL_SetAtomicInt(&g_outstanding, 0);
+
+    while (g_job_blocks != NULL) {
+        mvn_job_block_t *next = g_job_blocks->next;
+        MVN_FREE(g_job_blocks);
+        g_job_blocks = next;
+    }
+    g_free_jobs = NULL;
+}
+
+/**
+ * \brief           Get the number of worker threads
+ * \return          Number of workers, 0 when the job system is not running
+ */
+int mvn_job_get_worker_count(void)
+{
+    return g_worker_count;
+}
+
+/**
+ * \brief           Check whether the calling thread is the thread that started the job system
+ * \return          true on the main thread, false otherwise or when the job system is not running
+ */
+bool mvn_job_is_main_thread(void)
+{
+    return g_deques != NULL && current_deque_index() == 0;
+}
+
+/**
+ * \brief           Submit a job
+ * \note            Runs the job inline when the job system is not running
+ * \param[in]       function: Function to run
+ * \param[in]       user_data: Argument of function
+ * \param[in]       counter: Counter to wait on for this job, may be NULL
+ * \return          true on success, false on failure
+ */
+bool mvn_job_run(mvn_job_fn function, void *user_data, mvn_job_counter_t *counter)
+{
+    return mvn_job_run_after(NULL, function, user_data, counter);
+}
+
+/**
+ * \brief           Submit a job that starts once all jobs of another counter finished
+ * \note            Runs the job inline when the job system is not running, after waiting for
+ *                  dependency. Work added with mvn_job_counter_add() can still be pending then.
+ * \param[in]       dependency: Counter to wait for, NULL to start right away
+ * \param[in]       function: Function to run
+ * \param[in]       user_data: Argument of function
+ * \param[in]       counter: Counter to wait on for this job, may be NULL
+ * \return          true on success, false on failure
+ */
+bool mvn_job_run_after(mvn_job_counter_t *dependency,
+                       mvn_job_fn         function,
+                       void              *user_data,
+                       mvn_job_counter_t *counter)
+{
+    if (function == NULL) {
+        return mvn_set_error("Job function is NULL");
+    }
+
+    if (g_deques == NULL || SDL_GetAtomicInt(&g_running) == 0) {
+        mvn_job_wait(dependency);
+        function(user_data);
+        return true;
+    }
+
+    mvn_job_t *job = alloc_job();
+    if (job == NULL) {
+        return mvn_set_error("Failed to allocate job");
+    }
+    job->function  = function;
+    job->user_data = user_data;
+    job->counter   = counter;
+    job->next      = NULL;
+
+    if (counter != NULL) {
+        SDL_AddAtomicInt(&counter->pending, 1);
+    }
+
+    if (dependency != NULL) {
+        SDL_LockSpinlock(&dependency->lock);
+        if (SDL_GetAtomicInt(&dependency->pending) > 0) {
+            job->next           = dependency->waiters;
+            dependency->waiters = job;
+            SDL_UnlockSpinlock(&dependency->lock);
+            return true;
+        }
+        SDL_UnlockSpinlock(&dependency->lock);
+    }
+
+    schedule_job(job);
+    return true;
+}
+
+/**
+ * \brief           Count work done outside the job system, such as I/O, on a counter
+ * \note            Jobs waiting on the counter start once every added piece of work was
+ *                  finished with mvn_job_counter_done()
+ * \param[in]       counter: Counter to add one piece of work to
+ */
+void mvn_job_counter_add(mvn_job_counter_t *counter)
+{
+    if (counter != NULL) {
+        SDL_AddAtomicInt(&counter->pending, 1);
+    }
+}
+
+/**
+ * \brief           Finish a piece of work added with mvn_job_counter_add()
+ * \note            May be called from any thread
+ * \param[in]       counter: Counter the work was added to
+ */
+void mvn_job_counter_done(mvn_job_counter_t *counter)
+{
+    if (counter != NULL) {
+        release_counter(counter);
+    }
+}
+
+/**
+ * \brief           Check whether all jobs of a counter finished
+ * \param[in]       counter: Counter to check
+ * \return          true if no job of the counter is pending, false otherwise
+ */
+bool mvn_job_is_done(mvn_job_counter_t *counter)
+{
+    return counter == NULL || SDL_GetAtomicInt(&counter->pending) == 0;
+}
+
+/**
+ * \brief           Wait until all jobs of a counter finished
+ * \note            The calling thread runs queued jobs while it waits, so waiting inside a job
+ *                  does not block a worker
+ * \param[in]       counter: Counter to wait for
+ */
+void mvn_job_wait(mvn_job_counter_t *counter)
+{
+    if (counter == NULL) {
+        return;
+    }
+
+    int index = g_deques != NULL ? current_deque_index() : -1;
+    int spins = 0;
+    while (SDL_GetAtomicInt(&counter->pending) > 0) {
+        mvn_job_t *job = g_deques != NULL ? find_job(index) : NULL;
+        if (job != NULL) {
+            execute_job(job);
+            spins = 0;
+        } else if (++spins < MVN_JOB_WAIT_SPINS) {
+            SDL_CPUPauseInstruction();
+        } else {
+            SDL_DelayNS(0);
+        }
+    }
+
+    // The releasing thread may still hold the lock after the counter reached zero
+    SDL_LockSpinlock(&counter->lock);
+    SDL_UnlockSpinlock(&counter->lock);
+}
+
+/**
+ * \brief           Shared state of one mvn_parallel_for call
+ */
+typedef struct mvn_parallel_for_t {
+    mvn_list_t         *list;        /*!< List being processed */
+    mvn_parallel_for_fn function;    /*!< Range function */
+    void               *user_data;   /*!< Argument of function */
+    size_t              batch_size;  /*!< Items per range */
+    int                 batch_count; /*!< Number of ranges */
+    SDL_AtomicInt       next_batch;  /*!< Next range to claim */
+} mvn_parallel_for_t;
+
+/**
+ * \brief           Claim and process ranges until none are left
+ * \param[in]       user_data: State of the mvn_parallel_for call
+ */
+static void parallel_for_job(void *user_data)
+{
+    mvn_parallel_for_t *state = (mvn_parallel_for_t *)user_data;
+
+    int batch;
+    while ((batch = SDL_AddAtomicInt(&state->next_batch, 1)) < state->batch_count) {
+        size_t start = (size_t)batch * state->batch_size;
+        size_t end   = SDL_min(start + state->batch_size, state->list->length);
+        state->function(state->list, start, end, state->user_data);
+    }
+}
+
+/**
+ * \brief           Process a list in ranges spread over the workers and wait for the result
+ * \note            Ranges are claimed dynamically, so uneven work balances itself. The calling
+ *                  thread processes ranges too. The list must not change until the call returns.
+ * \param[in]       list: List to process
+ * \param[in]       batch_size: Items per range, 0 to pick a size from the worker count
+ * \param[in]       function: Function called for each range
+ * \param[in]       user_data: Argument of function
+ * \return          true on success, false on failure
+ */
+bool mvn_parallel_for(mvn_list_t         *list,
+                      size_t              batch_size,
+                      mvn_parallel_for_fn function,
+                      void               *user_data)
+{
+    if (list == NULL || function == NULL) {
+        return mvn_set_error("Invalid parameters for parallel for");
+    }
+
+    if (list->length == 0) {
+        return true;
+    }
+
+    int thread_count = g_worker_count + 1;
+    if (batch_size == 0) {
+        // A few ranges per thread leave room for balancing
+        size_t ranges = (size_t)thread_count * 4;
+        batch_size    = (list->length + ranges - 1) / ranges;
+    }
+
+    size_t batch_count = (list->length + batch_size - 1) / batch_size;
+    if (batch_count > (size_t)SDL_MAX_SINT32) {
+        return mvn_set_error("Too many ranges for parallel for: %zu", batch_count);
+    }
+
+    mvn_parallel_for_t state;
+    state.list        = list;
+    state.function    = function;
+    state.user_data   = user_data;
+    state.batch_size  = batch_size;
+    state.batch_count = (int)batch_count;
+    SDL_SetAtomicInt(&state.next_batch, 0);
+
+    // One helper job per additional range, each claims ranges until none are left
+    mvn_job_counter_t counter = { 0 };
+    int               helpers = SDL_min(thread_count, state.batch_count) - 1;
+    for (int i = 0; i < helpers; i++) {
+        mvn_job_run(parallel_for_job, &state, &counter);
+    }
+
+    parallel_for_job(&state);
+    mvn_job_wait(&counter);
+    return true;
+}
+
+/**
+ * \brief           Queue a call to run on the main thread at the next mvn_begin_drawing()
+ * \note            Use for work that must happen on the main thread, such as renderer calls.
+ *                  Calls run in the order they were queued.
+ * \param[in]       function: Function to run
+ * \param[in]       user_data: Argument of function
+ * \return          true on success, false on failure
+ */
+bool mvn_job_run_on_main_thread(mvn_job_fn function, void *user_data)
+{
+    if (function == NULL) {
+        return mvn_set_error("Main thread function is NULL");
+    }
+
+    if (g_main_lock == NULL) {
+        return mvn_set_error("Job system not initialized - call mvn_init() first");
+    }
+
+    mvn_main_thread_call_t call = { function, user_data };
+    SDL_LockMutex(g_main_lock);
+    bool queued = mvn_list_push(g_main_calls, &call);
+    SDL_UnlockMutex(g_main_lock);
+
+    if (!queued) {
+        return mvn_set_error("Failed to queue main thread call");
+    }
+    return true;
+}
+
+/**
+ * \brief           Run the calls queued for the main thread
+ * \note            Called by mvn_begin_drawing(). Calls queued while the queue runs wait for
+ *                  the next time it runs.
+ * \return          Number of calls that ran
+ */
+size_t mvn_job_run_main_thread_queue(void)
+{
+    if (g_main_lock == NULL || !mvn_job_is_main_thread()) {
+        return 0;
+    }
+
+    SDL_LockMutex(g_main_lock);
+    mvn_list_t *calls = g_main_calls;
+    g_main_calls      = g_main_calls_back;
+    g_main_calls_back = calls;
+    SDL_UnlockMutex(g_main_lock);
+
+    size_t count = calls->length;
+    for (size_t i = 0; i < count; i++) {
+        mvn_main_thread_call_t *call = MVN_LIST_GET(mvn_main_thread_call_t, calls, i);
+        call->function(call->user_data);
+    }
+    calls->length = 0;
+    return count;
+}
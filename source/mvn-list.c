@@ -3,6 +3,8 @@
  * \brief           Implementation of dynamic array list for MVN game framework
  */
 
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_LIST
+
 #include "mvn/mvn-list.h"
 
 #include "mvn/mvn-error.h" // Added error module
@@ -21,12 +23,13 @@
 #define MVN_LIST_STACK_BUFFER_SIZE 64
 
 /**
- * \brief           Initialize a new list
+ * \brief           Create a new list
+ * \param[in]       arena: Arena owning the list, NULL for the general allocator
  * \param[in]       item_size: Size of each item in bytes
  * \param[in]       initial_capacity: Initial capacity (0 for default)
  * \return          New list or NULL on failure
  */
-mvn_list_t *mvn_list_init(size_t item_size, size_t initial_capacity)
+static mvn_list_t *mvn_list_create(mvn_arena_t *arena, size_t item_size, size_t initial_capacity)
 {
     if (item_size == 0) {
         mvn_set_error("Cannot create list with item_size 0");
@@ -45,7 +48,8 @@ mvn_list_t *mvn_list_init(size_t item_size, size_t initial_capacity)
     }
 
     /* Allocate list structure */
-    mvn_list_t *list = MVN_MALLOC(sizeof(mvn_list_t));
+    mvn_list_t *list = arena != NULL ? mvn_arena_alloc(arena, sizeof(mvn_list_t))
+                                     : MVN_MALLOC(sizeof(mvn_list_t));
     if (!list) {
         mvn_set_error("Failed to allocate memory for list");
         return NULL;
@@ -53,21 +57,53 @@ mvn_list_t *mvn_list_init(size_t item_size, size_t initial_capacity)
 
     /* Allocate data array - use MVN_MALLOC instead of MVN_CALLOC for better performance
      * since we'll be overwriting all this memory anyway */
-    list->data = MVN_MALLOC(initial_capacity * item_size);
+    list->data = arena != NULL ? mvn_arena_alloc(arena, initial_capacity * item_size)
+                               : MVN_MALLOC(initial_capacity * item_size);
     if (!list->data) {
         mvn_set_error("Failed to allocate memory for list data");
-        MVN_FREE(list);
+        if (arena == NULL) {
+            MVN_FREE(list);
+        }
         return NULL;
     }
 
     list->item_size = item_size;
     list->length    = 0;
     list->capacity  = initial_capacity;
+    list->arena     = arena;
 
     mvn_log_debug("List initialized with item_size=%zu, capacity=%zu", item_size, initial_capacity);
     return list;
 }
 
+/**
+ * \brief           Initialize a new list
+ * \param[in]       item_size: Size of each item in bytes
+ * \param[in]       initial_capacity: Initial capacity (0 for default)
+ * \return          New list or NULL on failure
+ */
+mvn_list_t *mvn_list_init(size_t item_size, size_t initial_capacity)
+{
+    return mvn_list_create(NULL, item_size, initial_capacity);
+}
+
+/**
+ * \brief           Initialize a new list owned by an arena
+ * \note            The list lives until the arena is reset, mvn_list_free is a no-op for it
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       item_size: Size of each item in bytes
+ * \param[in]       initial_capacity: Initial capacity (0 for default)
+ * \return          New list or NULL on failure
+ */
+mvn_list_t *mvn_list_init_arena(mvn_arena_t *arena, size_t item_size, size_t initial_capacity)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot create list in NULL arena");
+        return NULL;
+    }
+    return mvn_list_create(arena, item_size, initial_capacity);
+}
+
 /**
  * \brief           Free a list and all its resources
  * \param[in]       list: List to free
@@ -78,6 +114,11 @@ void mvn_list_free(mvn_list_t *list)
         return;
     }
 
+    /* Arena lists are released together with their arena */
+    if (list->arena != NULL) {
+        return;
+    }
+
     if (list->data) {
         MVN_FREE(list->data);
     }
@@ -136,7 +177,9 @@ bool mvn_list_resize(mvn_list_t *list, size_t new_capacity)
     if (new_capacity == 0) {
         /* Allow resizing to 0 capacity if length is also 0, effectively freeing data */
         if (list->length == 0) {
-            MVN_FREE(list->data);
+            if (list->arena == NULL) {
+                MVN_FREE(list->data);
+            }
             list->data     = NULL;
             list->capacity = 0;
             mvn_log_debug("List resized to 0 capacity");
@@ -165,7 +208,11 @@ bool mvn_list_resize(mvn_list_t *list, size_t new_capacity)
         return mvn_set_error("Integer overflow detected when calculating resize capacity");
     }
 
-    void *new_data = MVN_REALLOC(list->data, new_capacity * list->item_size);
+    void *new_data = list->arena != NULL ? mvn_arena_realloc(list->arena,
+                                                             list->data,
+                                                             list->capacity * list->item_size,
+                                                             new_capacity * list->item_size)
+                                         : MVN_REALLOC(list->data, new_capacity * list->item_size);
     if (!new_data) {
         /* If realloc fails for 0 capacity, it's not necessarily an error if length is 0 */
         if (new_capacity == 0 && list->length == 0) {
@@ -30,10 +30,984 @@
  *
  * Author:          Jake Larson
  */
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_LOGGER
+#define MVN_LOGGER_IMPLEMENTATION // Define the functions behind the level check macros
 
 #include "mvn/mvn-logger.h"
 
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-format.h"
+#include "mvn/mvn-string.h"
+#include "mvn/mvn-utils.h"
+
 #include <SDL3/SDL.h>
+#include <signal.h>
+
+/* Levels by category, read by mvn_log_is_enabled() */
+int mvn_log_levels[MVN_LOG_CACHED_CATEGORIES];
+
+/* Longest time the writer thread sleeps without being woken */
+#define MVN_LOG_WRITER_TIMEOUT_MS 100
+
+/* Attempts to take the buffer from the writer thread when crashing, one millisecond apart */
+#define MVN_LOG_CRASH_LOCK_ATTEMPTS 500
+
+/**
+ * \brief           Message waiting in the asynchronous log buffer
+ */
+typedef struct mvn_log_record_t {
+    SDL_AtomicU32   sequence;                   /*!< Position the slot is ready for, see below */
+    uint64_t        timestamp;                  /*!< SDL_GetTicksNS() when the message was logged */
+    int             category;                   /*!< Log category */
+    SDL_LogPriority priority;                   /*!< Log priority */
+    char           *long_text;                  /*!< Heap copy of a message too long for text */
+    char            text[MVN_LOG_MESSAGE_SIZE]; /*!< Formatted message */
+} mvn_log_record_t;
+
+/*
+ * Bounded multi-producer ring. A slot whose sequence equals a write position is free for the
+ * producer that claims that position, and a slot whose sequence is the position plus one holds
+ * a finished message. The single consumer hands the slot back one lap later.
+ */
+static mvn_log_record_t  *g_records  = NULL;
+static uint32_t           g_capacity = 0;
+static mvn_log_overflow_t g_overflow = MVN_LOG_OVERFLOW_DROP;
+static SDL_AtomicU32      g_write_pos;      // Next position claimed by a producer
+static SDL_AtomicU32      g_read_pos;       // Next position written by the consumer
+static SDL_SpinLock       g_drain_lock = 0; // Held by the consumer while it writes messages
+
+/* Writer thread state */
+static SDL_Thread    *g_writer = NULL;
+static SDL_Semaphore *g_wake   = NULL;
+static SDL_AtomicInt  g_async;           // 1 while producers queue messages
+static SDL_AtomicInt  g_producers;       // Producers that may be using the buffer
+static SDL_AtomicInt  g_stopping;        // 1 when the writer should exit once empty
+static SDL_AtomicInt  g_writer_sleeping; // 1 while the writer waits for g_wake
+static SDL_AtomicInt  g_dropped;         // Messages discarded by MVN_LOG_OVERFLOW_DROP
+
+/* File sink, written by whichever thread outputs messages */
+static SDL_IOStream *g_file      = NULL;
+static SDL_SpinLock  g_file_lock = 0;
+static SDL_AtomicInt g_file_open;
+
+/* Call sites tracked by the rate limiter, must be a power of two */
+#define MVN_LOG_CALLSITE_SLOTS 256
+#define MVN_LOG_CALLSITE_BITS  8
+
+/**
+ * \brief           Rate limiter state of one call site, identified by its format string
+ */
+typedef struct mvn_log_callsite_t {
+    const char *fmt;               /*!< Format string, NULL for an empty slot */
+    uint64_t    window_start;      /*!< SDL_GetTicksNS() when the current interval started */
+    uint32_t    window_count;      /*!< Messages logged in the current interval */
+    uint32_t    window_suppressed; /*!< Messages suppressed in the current interval */
+    uint32_t    suppressed;        /*!< Messages suppressed since the program started */
+} mvn_log_callsite_t;
+
+/**
+ * \brief           Last flood controlled message and how often it was repeated since
+ */
+typedef struct mvn_log_repeat_t {
+    uint64_t        hash;     /*!< Hash of the formatted message */
+    int             category; /*!< Log category */
+    SDL_LogPriority priority; /*!< Log priority */
+    uint32_t        repeats;  /*!< Repeats not yet reported */
+} mvn_log_repeat_t;
+
+/* Flood control of messages at or above g_flood_level */
+static mvn_log_callsite_t g_callsites[MVN_LOG_CALLSITE_SLOTS];
+static mvn_log_repeat_t   g_last_message;
+static SDL_SpinLock       g_flood_lock       = 0;
+static int                g_flood_level      = MVN_LOG_WARN;
+static uint32_t           g_rate_burst       = MVN_LOG_RATE_LIMIT_BURST;
+static uint64_t           g_rate_interval_ns = SDL_MS_TO_NS(MVN_LOG_RATE_LIMIT_INTERVAL_MS);
+static bool               g_collapse_repeats = true;
+static SDL_AtomicInt      g_suppressed; // Messages dropped by the rate limiter
+static SDL_AtomicInt      g_collapsed;  // Messages folded into a repeat count
+
+/* Signals after which queued messages are written before the process dies */
+static const int g_crash_signals[] = {
+    SIGSEGV,
+    SIGABRT,
+    SIGFPE,
+    SIGILL,
+#if defined(SIGBUS)
+    SIGBUS,
+#endif
+};
+static void (*g_previous_handlers[SDL_arraysize(g_crash_signals)])(int);
+
+/* Binary log file layout, see mvn_logger_start_binary() */
+#define MVN_LOG_BINARY_MAGIC          "MVNBLOG"
+#define MVN_LOG_BINARY_VERSION        1
+#define MVN_LOG_BINARY_BYTE_ORDER     0x0102
+#define MVN_LOG_BINARY_HEADER_SIZE    10
+#define MVN_LOG_BINARY_FORMAT_RECORD  'F'
+#define MVN_LOG_BINARY_MESSAGE_RECORD 'M'
+#define MVN_LOG_BINARY_MESSAGE_HEADER 14
+
+/* Threads that can record binary messages at once, the rest fall back to text */
+#define MVN_LOG_BINARY_MAX_THREADS 64
+
+/* Distinct format strings per binary log and the slots of the table holding them */
+#define MVN_LOG_BINARY_MAX_FORMATS  2048
+#define MVN_LOG_BINARY_FORMAT_SLOTS 4096
+#define MVN_LOG_BINARY_FORMAT_BITS  12
+
+/* Largest encoded message, string arguments are truncated to fit */
+#define MVN_LOG_BINARY_RECORD_SIZE 1024
+
+/* Longest line written by mvn_logger_decode_binary(), longer lines are truncated */
+#define MVN_LOG_BINARY_LINE_SIZE 4096
+
+/* Format lookups cached by each thread, must be a power of two */
+#define MVN_LOG_BINARY_CACHE_SIZE 64
+
+/**
+ * \brief           Format string known to the binary log
+ */
+typedef struct mvn_log_format_t {
+    const char   *fmt;                        /*!< Format string, NULL for an empty slot */
+    uint16_t      id;                         /*!< Identifier written with each message */
+    int           arg_count;                  /*!< Arguments recorded, -1 if unsupported */
+    uint8_t       types[MVN_FORMAT_MAX_ARGS]; /*!< mvn_format_arg_t of each argument */
+    SDL_AtomicInt written;                    /*!< 1 once the format is in the file */
+} mvn_log_format_t;
+
+/**
+ * \brief           Binary messages recorded by one thread and not yet written to the file
+ */
+typedef struct mvn_log_thread_buffer_t {
+    SDL_SpinLock            lock;       /*!< Held while recording and while swapping data */
+    uint32_t                generation; /*!< Binary log the buffer belongs to, 0 when unused */
+    uint8_t                *data;       /*!< Encoded records */
+    uint8_t                *spare;      /*!< Second array, NULL while the other is written */
+    size_t                  length;     /*!< Bytes used in data */
+    const mvn_log_format_t *cache[MVN_LOG_BINARY_CACHE_SIZE]; /*!< Recently used formats */
+} mvn_log_thread_buffer_t;
+
+/*
+ * Binary logging state. Each thread claims one buffer, remembered in thread local storage
+ * together with the generation of the binary log, so buffers released by
+ * mvn_logger_stop_binary() are never touched through a stale pointer.
+ */
+static mvn_log_thread_buffer_t g_thread_buffers[MVN_LOG_BINARY_MAX_THREADS];
+static mvn_log_format_t        g_formats[MVN_LOG_BINARY_FORMAT_SLOTS];
+static int                     g_format_count     = 0;
+static SDL_TLSID               g_binary_tls;
+static SDL_SpinLock            g_binary_lock      = 0; // Guards buffer claims and g_formats
+static SDL_IOStream           *g_binary_file      = NULL;
+static SDL_Mutex              *g_binary_file_lock = NULL;
+static SDL_AtomicInt           g_binary;            // 1 while mvn_log() records binary
+static SDL_AtomicU32           g_binary_generation; // Changes on every start and stop
+
+/**
+ * \brief           Get the name written to the log file for a priority
+ * \param[in]       priority: Log priority
+ * \return          Priority name
+ */
+static const char *get_priority_name(SDL_LogPriority priority)
+{
+    switch ((int)priority) {
+        case MVN_LOG_VERBOSE:
+            return "VERBOSE";
+        case MVN_LOG_DEBUG:
+            return "DEBUG";
+        case MVN_LOG_INFO:
+            return "INFO";
+        case MVN_LOG_WARN:
+            return "WARN";
+        case MVN_LOG_ERROR:
+            return "ERROR";
+        case MVN_LOG_CRITICAL:
+            return "CRITICAL";
+        default:
+            return "LOG";
+    }
+}
+
+/**
+ * \brief           Format a message, on the heap if it does not fit a buffer
+ * \note            Falls back to the truncated text in the buffer if the heap copy cannot be
+ *                  allocated
+ * \param[out]      buffer: Buffer for messages that fit
+ * \param[in]       size: Size of buffer
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       args: Arguments for the format string, copied before each use
+ * \return          buffer, or a heap copy to free with MVN_FREE()
+ */
+static char *format_message(char *buffer, size_t size, const char *fmt, va_list args)
+{
+    va_list copy;
+    va_copy(copy, args);
+    int length = SDL_vsnprintf(buffer, size, fmt, copy);
+    va_end(copy);
+    if (length < (int)size) {
+        return buffer;
+    }
+
+    char *text = MVN_MALLOC((size_t)length + 1);
+    if (text == NULL) {
+        return buffer;
+    }
+    va_copy(copy, args);
+    SDL_vsnprintf(text, (size_t)length + 1, fmt, copy);
+    va_end(copy);
+    return text;
+}
+
+/**
+ * \brief           Append a message to the log file, if one is open
+ * \param[in]       priority: Log priority
+ * \param[in]       timestamp: SDL_GetTicksNS() when the message was logged
+ * \param[in]       text: Formatted message
+ */
+static void write_file(SDL_LogPriority priority, uint64_t timestamp, const char *text)
+{
+    SDL_LockSpinlock(&g_file_lock);
+    if (g_file != NULL) {
+        SDL_IOprintf(g_file,
+                     "[%10.3f] [%s] %s\n",
+                     (double)timestamp / 1e9,
+                     get_priority_name(priority),
+                     text);
+    }
+    SDL_UnlockSpinlock(&g_file_lock);
+}
+
+/**
+ * \brief           Write the finished messages in the buffer to the console and file sinks
+ * \note            The caller must hold g_drain_lock
+ * \return          Number of messages written
+ */
+static size_t drain_records_locked(void)
+{
+    size_t count = 0;
+    for (;;) {
+        uint32_t          position = SDL_GetAtomicU32(&g_read_pos);
+        mvn_log_record_t *record   = &g_records[position & (g_capacity - 1)];
+        if (SDL_GetAtomicU32(&record->sequence) != position + 1) {
+            return count;
+        }
+
+        // SDL applies the output function and priority prefixes as for synchronous messages
+        const char *text = record->long_text != NULL ? record->long_text : record->text;
+        SDL_LogMessage(record->category, record->priority, "%s", text);
+        if (SDL_GetAtomicInt(&g_file_open)) {
+            write_file(record->priority, record->timestamp, text);
+        }
+        MVN_FREE(record->long_text);
+        record->long_text = NULL;
+
+        SDL_SetAtomicU32(&record->sequence, position + g_capacity);
+        SDL_SetAtomicU32(&g_read_pos, position + 1);
+        count++;
+    }
+}
+
+/**
+ * \brief           Write the finished messages in the buffer
+ * \return          Number of messages written
+ */
+static size_t drain_records(void)
+{
+    SDL_LockSpinlock(&g_drain_lock);
+    size_t count = drain_records_locked();
+    SDL_UnlockSpinlock(&g_drain_lock);
+    return count;
+}
+
+/**
+ * \brief           Wake the writer thread if it is waiting for messages
+ */
+static void wake_writer(void)
+{
+    if (SDL_CompareAndSwapAtomicInt(&g_writer_sleeping, 1, 0)) {
+        SDL_SignalSemaphore(g_wake);
+    }
+}
+
+/**
+ * \brief           Background thread writing queued messages
+ * \param[in]       data: Unused
+ * \return          0
+ */
+static int writer_main(void *data)
+{
+    (void)data;
+
+    for (;;) {
+        // Read the flag first so everything queued before stopping is written
+        bool stopping = SDL_GetAtomicInt(&g_stopping) != 0;
+        if (drain_records() > 0) {
+            continue;
+        }
+        if (stopping) {
+            return 0;
+        }
+
+        // Producers that publish after the flag is set see it and signal
+        SDL_SetAtomicInt(&g_writer_sleeping, 1);
+        uint32_t          position = SDL_GetAtomicU32(&g_read_pos);
+        mvn_log_record_t *record   = &g_records[position & (g_capacity - 1)];
+        if (SDL_GetAtomicU32(&record->sequence) != position + 1 &&
+            !SDL_GetAtomicInt(&g_stopping)) {
+            SDL_WaitSemaphoreTimeout(g_wake, MVN_LOG_WRITER_TIMEOUT_MS);
+        }
+        SDL_SetAtomicInt(&g_writer_sleeping, 0);
+    }
+}
+
+/**
+ * \brief           Queue a message for the writer thread
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       args: Arguments for the format string
+ */
+static void push_record(int category, SDL_LogPriority priority, const char *fmt, va_list args)
+{
+    uint32_t          position = SDL_GetAtomicU32(&g_write_pos);
+    mvn_log_record_t *record;
+
+    for (;;) {
+        record       = &g_records[position & (g_capacity - 1)];
+        int32_t diff = (int32_t)(SDL_GetAtomicU32(&record->sequence) - position);
+
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicU32(&g_write_pos, position, position + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The slot still holds a message from the previous lap, so the buffer is full
+            if (g_overflow == MVN_LOG_OVERFLOW_DROP) {
+                SDL_AddAtomicInt(&g_dropped, 1);
+                return;
+            }
+            wake_writer();
+            SDL_Delay(1);
+        }
+        position = SDL_GetAtomicU32(&g_write_pos);
+    }
+
+    record->timestamp = SDL_GetTicksNS();
+    record->category  = category;
+    record->priority  = priority;
+    char *text        = format_message(record->text, sizeof(record->text), fmt, args);
+    record->long_text = text != record->text ? text : NULL;
+    SDL_SetAtomicU32(&record->sequence, position + 1);
+
+    wake_writer();
+}
+
+/**
+ * \brief           Get the minimum priority logged for a category
+ * \param[in]       category: Log category
+ * \return          Minimum priority
+ */
+static int get_level(int category)
+{
+    if (category >= 0 && category < MVN_LOG_CACHED_CATEGORIES && mvn_log_levels[category] != 0) {
+        return mvn_log_levels[category];
+    }
+    return (int)SDL_GetLogPriority(category);
+}
+
+/**
+ * \brief           Output a message synchronously or through the writer thread
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       args: Arguments for the format string
+ */
+static void output_messagev(int category, SDL_LogPriority priority, const char *fmt, va_list args)
+{
+    // Registering first keeps mvn_logger_stop_async() from freeing the buffer under us
+    SDL_AddAtomicInt(&g_producers, 1);
+    if (SDL_GetAtomicInt(&g_async)) {
+        push_record(category, priority, fmt, args);
+        SDL_AddAtomicInt(&g_producers, -1);
+        return;
+    }
+    SDL_AddAtomicInt(&g_producers, -1);
+
+    if (!SDL_GetAtomicInt(&g_file_open)) {
+        SDL_LogMessageV(category, priority, fmt, args);
+        return;
+    }
+
+    char  buffer[MVN_LOG_MESSAGE_SIZE];
+    char *text = format_message(buffer, sizeof(buffer), fmt, args);
+    SDL_LogMessage(category, priority, "%s", text);
+    write_file(priority, SDL_GetTicksNS(), text);
+    if (text != buffer) {
+        MVN_FREE(text);
+    }
+}
+
+/**
+ * \brief           Output a message synchronously or through the writer thread
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       ...: Arguments for the format string
+ */
+static void output_message(int category, SDL_LogPriority priority, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    output_messagev(category, priority, fmt, args);
+    va_end(args);
+}
+
+/**
+ * \brief           Hash a pointer, for tables keyed by format string address
+ * \param[in]       pointer: Pointer to hash
+ * \param[in]       bits: Number of bits in the result
+ * \return          Hash below 2^bits
+ */
+static size_t hash_pointer(const void *pointer, int bits)
+{
+    // Fibonacci hashing, the high bits of the product are the best mixed
+    return (size_t)(((uint64_t)(uintptr_t)pointer * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
+
+/**
+ * \brief           Apply the rate limit of the call site of a message
+ * \note            Writes how many messages of the call site were suppressed once its next
+ *                  interval starts
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       fmt: Format string, identifying the call site
+ * \return          true to log the message, false if it is suppressed
+ */
+static bool check_rate_limit(int category, SDL_LogPriority priority, const char *fmt)
+{
+    uint32_t suppressed = 0;
+    bool     allowed    = true;
+
+    SDL_LockSpinlock(&g_flood_lock);
+    if (g_rate_burst > 0) {
+        uint64_t now  = SDL_GetTicksNS();
+        size_t   hash = hash_pointer(fmt, MVN_LOG_CALLSITE_BITS);
+        for (size_t i = 0; i < MVN_LOG_CALLSITE_SLOTS; i++) {
+            mvn_log_callsite_t *site = &g_callsites[(hash + i) & (MVN_LOG_CALLSITE_SLOTS - 1)];
+            if (site->fmt != NULL && site->fmt != fmt) {
+                continue;
+            }
+
+            // A full table leaves new call sites unlimited
+            if (site->fmt == NULL) {
+                site->fmt          = fmt;
+                site->window_start = now;
+            }
+            if (now - site->window_start >= g_rate_interval_ns) {
+                suppressed              = site->window_suppressed;
+                site->window_start      = now;
+                site->window_count      = 0;
+                site->window_suppressed = 0;
+            }
+            if (site->window_count >= g_rate_burst) {
+                site->window_suppressed++;
+                site->suppressed++;
+                allowed = false;
+            } else {
+                site->window_count++;
+            }
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&g_flood_lock);
+
+    if (!allowed) {
+        SDL_AddAtomicInt(&g_suppressed, 1);
+    } else if (suppressed > 0) {
+        output_message(
+            category, priority, "Suppressed %u more messages like \"%s\"", suppressed, fmt);
+    }
+    return allowed;
+}
+
+/**
+ * \brief           Write how often the last flood controlled message was repeated
+ * \note            The caller holds g_flood_lock and writes the note after releasing it
+ * \param[out]      note: Receives the note, the repeat count and where to write it
+ * \return          true if there is a note to write
+ */
+static bool take_repeat_note_locked(mvn_log_repeat_t *note)
+{
+    *note                  = g_last_message;
+    g_last_message.repeats = 0;
+    return note->repeats > 0;
+}
+
+/**
+ * \brief           Write the note for repeats of the last flood controlled message
+ * \param[in]       note: Note taken with take_repeat_note_locked()
+ */
+static void output_repeat_note(const mvn_log_repeat_t *note)
+{
+    output_message(note->category, note->priority, "Last message repeated %u times", note->repeats);
+}
+
+/**
+ * \brief           Log a flood controlled message, collapsing repeats of the previous one
+ * \note            Messages longer than MVN_LOG_MESSAGE_SIZE are formatted on the heap, so
+ *                  the text that is compared and written is never truncated
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       args: Arguments for the format string
+ */
+static void output_collapsedv(int category, SDL_LogPriority priority, const char *fmt, va_list args)
+{
+    SDL_LockSpinlock(&g_flood_lock);
+    bool collapse = g_collapse_repeats;
+    SDL_UnlockSpinlock(&g_flood_lock);
+    if (!collapse) {
+        output_messagev(category, priority, fmt, args);
+        return;
+    }
+
+    char     buffer[MVN_LOG_MESSAGE_SIZE];
+    char    *text = format_message(buffer, sizeof(buffer), fmt, args);
+    uint64_t hash = mvn_string_hash_bytes(text, SDL_strlen(text));
+
+    mvn_log_repeat_t note;
+    bool             has_note = false;
+    SDL_LockSpinlock(&g_flood_lock);
+    if (g_collapse_repeats && g_last_message.hash == hash &&
+        g_last_message.category == category && g_last_message.priority == priority) {
+        g_last_message.repeats++;
+        SDL_UnlockSpinlock(&g_flood_lock);
+        SDL_AddAtomicInt(&g_collapsed, 1);
+        if (text != buffer) {
+            MVN_FREE(text);
+        }
+        return;
+    }
+    has_note                = take_repeat_note_locked(&note);
+    g_last_message.hash     = hash;
+    g_last_message.category = category;
+    g_last_message.priority = priority;
+    SDL_UnlockSpinlock(&g_flood_lock);
+
+    if (has_note) {
+        output_repeat_note(&note);
+    }
+    output_message(category, priority, "%s", text);
+    if (text != buffer) {
+        MVN_FREE(text);
+    }
+}
+
+/**
+ * \brief           Write bytes to the binary log file
+ * \param[in]       data: Bytes to write
+ * \param[in]       size: Number of bytes
+ */
+static void write_binary(const void *data, size_t size)
+{
+    SDL_LockMutex(g_binary_file_lock);
+    SDL_WriteIO(g_binary_file, data, size);
+    SDL_UnlockMutex(g_binary_file_lock);
+}
+
+/**
+ * \brief           Swap out the records of a thread buffer so they can be written unlocked
+ * \note            The caller holds the buffer lock. Only one array of a buffer is written at a
+ *                  time, so records of a thread reach the file in order.
+ * \param[in,out]   buffer: Thread buffer
+ * \param[out]      length: Receives the number of bytes to write
+ * \return          Records to pass to write_swapped_records(), NULL if there is nothing to
+ *                  write or the other array is still being written
+ */
+static uint8_t *swap_thread_buffer(mvn_log_thread_buffer_t *buffer, size_t *length)
+{
+    if (buffer->length == 0 || buffer->spare == NULL) {
+        return NULL;
+    }
+
+    uint8_t *data  = buffer->data;
+    *length        = buffer->length;
+    buffer->data   = buffer->spare;
+    buffer->spare  = NULL;
+    buffer->length = 0;
+    return data;
+}
+
+/**
+ * \brief           Write records swapped out of a thread buffer and give the array back
+ * \note            Call without holding the buffer lock
+ * \param[in,out]   buffer: Thread buffer
+ * \param[in]       data: Records returned by swap_thread_buffer()
+ * \param[in]       length: Number of bytes to write
+ */
+static void write_swapped_records(mvn_log_thread_buffer_t *buffer, uint8_t *data, size_t length)
+{
+    write_binary(data, length);
+    SDL_LockSpinlock(&buffer->lock);
+    buffer->spare = data;
+    SDL_UnlockSpinlock(&buffer->lock);
+}
+
+/**
+ * \brief           Lock a thread buffer once none of its records are being written
+ * \param[in,out]   buffer: Thread buffer
+ */
+static void lock_idle_buffer(mvn_log_thread_buffer_t *buffer)
+{
+    SDL_LockSpinlock(&buffer->lock);
+    while (buffer->generation != 0 && buffer->spare == NULL) {
+        SDL_UnlockSpinlock(&buffer->lock);
+        SDL_Delay(1);
+        SDL_LockSpinlock(&buffer->lock);
+    }
+}
+
+/**
+ * \brief           Write out and free the records of a released thread buffer
+ * \param[in]       data: Records taken from the buffer
+ * \param[in]       length: Number of bytes to write
+ * \param[in]       spare: Spare array taken from the buffer
+ */
+static void free_thread_records(uint8_t *data, size_t length, uint8_t *spare)
+{
+    if (length > 0) {
+        write_binary(data, length);
+    }
+    MVN_FREE(data);
+    MVN_FREE(spare);
+}
+
+/**
+ * \brief           Take the arrays of a thread buffer and mark it unused
+ * \note            The caller holds the buffer lock, taken with lock_idle_buffer()
+ * \param[in,out]   buffer: Thread buffer
+ * \param[out]      data: Receives the records
+ * \param[out]      length: Receives the number of bytes recorded
+ * \param[out]      spare: Receives the spare array
+ */
+static void
+take_thread_buffer(mvn_log_thread_buffer_t *buffer, uint8_t **data, size_t *length, uint8_t **spare)
+{
+    *data              = buffer->data;
+    *length            = buffer->length;
+    *spare             = buffer->spare;
+    buffer->data       = NULL;
+    buffer->spare      = NULL;
+    buffer->length     = 0;
+    buffer->generation = 0;
+}
+
+/**
+ * \brief           Get the thread local storage value naming a buffer
+ * \param[in]       generation: Binary log the buffer belongs to
+ * \param[in]       index: Index of the buffer in g_thread_buffers
+ * \return          Value stored with SDL_SetTLS(), never 0
+ */
+static uintptr_t make_buffer_key(uint32_t generation, size_t index)
+{
+    return ((uintptr_t)generation << 8) | (uintptr_t)(index + 1);
+}
+
+/**
+ * \brief           Release the buffer of a thread that exits
+ * \param[in]       value: Key stored in thread local storage
+ */
+static void release_thread_key(void *value)
+{
+    uintptr_t key   = (uintptr_t)value;
+    size_t    index = (size_t)(key & 0xFF) - 1;
+    if (key == 0 || index >= MVN_LOG_BINARY_MAX_THREADS) {
+        return;
+    }
+
+    mvn_log_thread_buffer_t *buffer = &g_thread_buffers[index];
+    uint8_t                 *data   = NULL;
+    uint8_t                 *spare  = NULL;
+    size_t                   length = 0;
+    lock_idle_buffer(buffer);
+    if (buffer->generation != 0 && make_buffer_key(buffer->generation, index) == key) {
+        take_thread_buffer(buffer, &data, &length, &spare);
+    }
+    SDL_UnlockSpinlock(&buffer->lock);
+    free_thread_records(data, length, spare);
+}
+
+/**
+ * \brief           Get the buffer of the calling thread, claiming one if needed
+ * \param[in]       generation: Binary log being recorded
+ * \return          Buffer, or NULL if every buffer is in use or recording stopped
+ */
+static mvn_log_thread_buffer_t *get_thread_buffer(uint32_t generation)
+{
+    uintptr_t key = (uintptr_t)SDL_GetTLS(&g_binary_tls);
+    if (key != 0) {
+        size_t index = (size_t)(key & 0xFF) - 1;
+        if (index < MVN_LOG_BINARY_MAX_THREADS && make_buffer_key(generation, index) == key) {
+            return &g_thread_buffers[index];
+        }
+    }
+
+    uint8_t *data  = MVN_MALLOC(MVN_LOG_BINARY_BUFFER_SIZE);
+    uint8_t *spare = MVN_MALLOC(MVN_LOG_BINARY_BUFFER_SIZE);
+    if (data == NULL || spare == NULL) {
+        MVN_FREE(data);
+        MVN_FREE(spare);
+        return NULL;
+    }
+
+    mvn_log_thread_buffer_t *buffer = NULL;
+    size_t                   index  = 0;
+    SDL_LockSpinlock(&g_binary_lock);
+    if (SDL_GetAtomicU32(&g_binary_generation) == generation) {
+        for (index = 0; index < MVN_LOG_BINARY_MAX_THREADS; index++) {
+            SDL_LockSpinlock(&g_thread_buffers[index].lock);
+            if (g_thread_buffers[index].generation == 0) {
+                buffer             = &g_thread_buffers[index];
+                buffer->generation = generation;
+                buffer->data       = data;
+                buffer->spare      = spare;
+                buffer->length     = 0;
+                SDL_zeroa(buffer->cache);
+                SDL_UnlockSpinlock(&buffer->lock);
+                break;
+            }
+            SDL_UnlockSpinlock(&g_thread_buffers[index].lock);
+        }
+    }
+    SDL_UnlockSpinlock(&g_binary_lock);
+
+    if (buffer == NULL) {
+        MVN_FREE(data);
+        MVN_FREE(spare);
+        return NULL;
+    }
+    SDL_SetTLS(&g_binary_tls, (void *)make_buffer_key(generation, index), release_thread_key);
+    return buffer;
+}
+
+/**
+ * \brief           Get the format table entry of a format string, adding it if needed
+ * \note            The caller holds the buffer lock. A new format is written to the file
+ *                  before it is returned, and other threads only use it once it is written, so
+ *                  it always precedes the messages using it.
+ * \param[in,out]   buffer: Buffer of the calling thread, caches the result
+ * \param[in]       fmt: Format string
+ * \return          Format that can be recorded, NULL to log the message as text
+ */
+static const mvn_log_format_t *find_format(mvn_log_thread_buffer_t *buffer, const char *fmt)
+{
+    size_t                  hash        = hash_pointer(fmt, MVN_LOG_BINARY_FORMAT_BITS);
+    size_t                  cache_index = hash & (MVN_LOG_BINARY_CACHE_SIZE - 1);
+    const mvn_log_format_t *format      = buffer->cache[cache_index];
+    if (format == NULL || format->fmt != fmt) {
+        mvn_log_format_t *slot  = NULL;
+        bool              added = false;
+
+        SDL_LockSpinlock(&g_binary_lock);
+        for (size_t i = 0; i < MVN_LOG_BINARY_FORMAT_SLOTS; i++) {
+            mvn_log_format_t *candidate =
+                &g_formats[(hash + i) & (MVN_LOG_BINARY_FORMAT_SLOTS - 1)];
+            if (candidate->fmt == fmt) {
+                slot = candidate;
+                break;
+            }
+            if (candidate->fmt != NULL) {
+                continue;
+            }
+
+            if (g_format_count < MVN_LOG_BINARY_MAX_FORMATS && SDL_strlen(fmt) <= UINT16_MAX) {
+                candidate->fmt       = fmt;
+                candidate->id        = (uint16_t)g_format_count++;
+                candidate->arg_count = mvn_format_parse(fmt, candidate->types);
+                slot                 = candidate;
+                added                = true;
+            }
+            break;
+        }
+        SDL_UnlockSpinlock(&g_binary_lock);
+
+        if (added) {
+            uint8_t  header[5] = { MVN_LOG_BINARY_FORMAT_RECORD };
+            uint16_t size      = (uint16_t)SDL_strlen(fmt);
+            SDL_memcpy(header + 1, &slot->id, sizeof(slot->id));
+            SDL_memcpy(header + 3, &size, sizeof(size));
+            SDL_LockMutex(g_binary_file_lock);
+            SDL_WriteIO(g_binary_file, header, sizeof(header));
+            SDL_WriteIO(g_binary_file, fmt, size);
+            SDL_UnlockMutex(g_binary_file_lock);
+            SDL_SetAtomicInt(&slot->written, 1);
+        }
+
+        // A format another thread is still writing is logged as text this once
+        if (slot == NULL || !SDL_GetAtomicInt(&slot->written)) {
+            return NULL;
+        }
+        format                     = slot;
+        buffer->cache[cache_index] = format;
+    }
+    return format->arg_count >= 0 ? format : NULL;
+}
+
+/**
+ * \brief           Record a message in the binary log of the calling thread
+ * \note            args is only read when the message is recorded
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       args: Arguments for the format string
+ * \return          true if the message was recorded, false to log it as text
+ */
+static bool record_binary(int category, SDL_LogPriority priority, const char *fmt, va_list args)
+{
+    uint32_t                 generation = SDL_GetAtomicU32(&g_binary_generation);
+    mvn_log_thread_buffer_t *buffer     = get_thread_buffer(generation);
+    if (buffer == NULL) {
+        return false;
+    }
+
+    SDL_LockSpinlock(&buffer->lock);
+    const mvn_log_format_t *format =
+        buffer->generation == generation ? find_format(buffer, fmt) : NULL;
+    if (format == NULL) {
+        SDL_UnlockSpinlock(&buffer->lock);
+        return false;
+    }
+
+    // Write a full buffer unlocked while the spare array takes the next records. If the spare
+    // is still being written by a flush, this message is logged as text.
+    if (MVN_LOG_BINARY_BUFFER_SIZE - buffer->length < MVN_LOG_BINARY_RECORD_SIZE) {
+        size_t   length = 0;
+        uint8_t *data   = swap_thread_buffer(buffer, &length);
+        SDL_UnlockSpinlock(&buffer->lock);
+        if (data == NULL) {
+            return false;
+        }
+        write_swapped_records(buffer, data, length);
+
+        SDL_LockSpinlock(&buffer->lock);
+        if (buffer->generation != generation) {
+            SDL_UnlockSpinlock(&buffer->lock);
+            return false;
+        }
+    }
+
+    uint8_t *record      = buffer->data + buffer->length;
+    uint16_t category_id = (uint16_t)category;
+    uint64_t timestamp   = SDL_GetTicksNS();
+    record[0]            = MVN_LOG_BINARY_MESSAGE_RECORD;
+    SDL_memcpy(record + 1, &format->id, sizeof(format->id));
+    SDL_memcpy(record + 3, &category_id, sizeof(category_id));
+    record[5] = (uint8_t)priority;
+    SDL_memcpy(record + 6, &timestamp, sizeof(timestamp));
+
+    buffer->length += MVN_LOG_BINARY_MESSAGE_HEADER;
+    buffer->length += mvn_format_pack(format->types,
+                                      format->arg_count,
+                                      record + MVN_LOG_BINARY_MESSAGE_HEADER,
+                                      MVN_LOG_BINARY_RECORD_SIZE - MVN_LOG_BINARY_MESSAGE_HEADER,
+                                      args);
+    SDL_UnlockSpinlock(&buffer->lock);
+    return true;
+}
+
+/**
+ * \brief           Write the binary messages recorded so far by every thread
+ */
+static void flush_binary(void)
+{
+    for (size_t i = 0; i < MVN_LOG_BINARY_MAX_THREADS; i++) {
+        mvn_log_thread_buffer_t *buffer = &g_thread_buffers[i];
+        size_t                   length = 0;
+        SDL_LockSpinlock(&buffer->lock);
+        uint8_t *data = buffer->generation != 0 ? swap_thread_buffer(buffer, &length) : NULL;
+        SDL_UnlockSpinlock(&buffer->lock);
+        if (data != NULL) {
+            write_swapped_records(buffer, data, length);
+        }
+    }
+    SDL_LockMutex(g_binary_file_lock);
+    SDL_FlushIO(g_binary_file);
+    SDL_UnlockMutex(g_binary_file_lock);
+}
+
+/**
+ * \brief           Read bytes from a binary log while decoding it
+ * \param[in,out]   cursor: Read position, advanced past the bytes
+ * \param[in]       end: End of the log
+ * \param[out]      out: Receives the bytes
+ * \param[in]       size: Number of bytes
+ * \return          true on success, false if the log ends first
+ */
+static bool read_binary(const uint8_t **cursor, const uint8_t *end, void *out, size_t size)
+{
+    if ((size_t)(end - *cursor) < size) {
+        return false;
+    }
+    SDL_memcpy(out, *cursor, size);
+    *cursor += size;
+    return true;
+}
+
+/**
+ * \brief           Filter a message and log it as text or binary
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       binary: true if the message may be recorded in the binary log
+ * \param[in]       fmt: Formatting string for the log message
+ * \param[in]       args: Arguments for the format string
+ */
+static void
+log_messagev(int category, SDL_LogPriority priority, bool binary, const char *fmt, va_list args)
+{
+    // Filter before formatting or queuing anything
+    if ((int)priority < get_level(category)) {
+        return;
+    }
+
+    bool flood_control = (int)priority >= g_flood_level;
+    if (flood_control && !check_rate_limit(category, priority, fmt)) {
+        return;
+    }
+    if (binary && SDL_GetAtomicInt(&g_binary) && record_binary(category, priority, fmt, args)) {
+        return;
+    }
+    if (flood_control) {
+        output_collapsedv(category, priority, fmt, args);
+    } else {
+        output_messagev(category, priority, fmt, args);
+    }
+}
+
+/**
+ * \brief           Write queued messages and end the process after a crash
+ * \note            Not async-signal-safe, but the process is lost anyway and the messages
+ *                  leading up to a crash are the ones most worth keeping
+ * \param[in]       signal_number: Signal that was raised
+ */
+static void crash_handler(int signal_number)
+{
+    // The writer thread normally finishes its batch quickly, unless it is the one crashing
+    for (int i = 0; i < MVN_LOG_CRASH_LOCK_ATTEMPTS; i++) {
+        if (SDL_TryLockSpinlock(&g_drain_lock)) {
+            drain_records_locked();
+            SDL_UnlockSpinlock(&g_drain_lock);
+            break;
+        }
+        SDL_Delay(1);
+    }
+    if (SDL_GetAtomicInt(&g_file_open)) {
+        SDL_FlushIO(g_file);
+    }
+
+    for (size_t i = 0; i < SDL_arraysize(g_crash_signals); i++) {
+        signal(g_crash_signals[i], g_previous_handlers[i]);
+    }
+    raise(signal_number);
+}
 
 /**
  * \brief           Initialize the MVN logger
@@ -69,6 +1043,9 @@ bool mvn_logger_init(void)
 void mvn_logger_set_level(mvn_log_category_t category, mvn_log_level_t level)
 {
     SDL_SetLogPriority((SDL_LogCategory)category, (SDL_LogPriority)level);
+    if ((int)category >= 0 && (int)category < MVN_LOG_CACHED_CATEGORIES) {
+        mvn_log_levels[category] = (int)level;
+    }
 }
 
 /**
@@ -78,6 +1055,9 @@ void mvn_logger_set_level(mvn_log_category_t category, mvn_log_level_t level)
 void mvn_logger_set_all_levels(mvn_log_level_t level)
 {
     SDL_SetLogPriorities((SDL_LogPriority)level);
+    for (int i = 0; i < MVN_LOG_CACHED_CATEGORIES; i++) {
+        mvn_log_levels[i] = (int)level;
+    }
 }
 
 /**
@@ -91,7 +1071,7 @@ void mvn_log(mvn_log_category_t category, mvn_log_level_t priority, const char *
 {
     va_list args;
     va_start(args, fmt);
-    SDL_LogMessageV((SDL_LogCategory)category, (SDL_LogPriority)priority, fmt, args);
+    log_messagev((int)category, (SDL_LogPriority)priority, true, fmt, args);
     va_end(args);
 }
 
@@ -104,7 +1084,7 @@ void mvn_log_info(const char *fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
-    SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, fmt, args);
+    log_messagev(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, false, fmt, args);
     va_end(args);
 }
 
@@ -117,7 +1097,7 @@ void mvn_log_debug(const char *fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
-    SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, fmt, args);
+    log_messagev(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_DEBUG, false, fmt, args);
     va_end(args);
 }
 
@@ -130,7 +1110,7 @@ void mvn_log_warn(const char *fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
-    SDL_LogMessageV(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, fmt, args);
+    log_messagev(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, false, fmt, args);
     va_end(args);
 }
 
@@ -143,7 +1123,7 @@ void mvn_log_error(const char *fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
-    SDL_LogMessageV(SDL_LOG_CATEGORY_ERROR, SDL_LOG_PRIORITY_ERROR, fmt, args);
+    log_messagev(SDL_LOG_CATEGORY_ERROR, SDL_LOG_PRIORITY_ERROR, false, fmt, args);
     va_end(args);
 }
 
@@ -156,6 +1136,427 @@ void mvn_log_critical(const char *fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
-    SDL_LogMessageV(SDL_LOG_CATEGORY_ERROR, SDL_LOG_PRIORITY_CRITICAL, fmt, args);
+    log_messagev(SDL_LOG_CATEGORY_ERROR, SDL_LOG_PRIORITY_CRITICAL, false, fmt, args);
     va_end(args);
 }
+
+/**
+ * \brief           Move log output to a background writer thread
+ * \note            Messages are formatted on the calling thread into a lock-free buffer and
+ *                  written to the console and file sinks by the writer. Messages are written in
+ *                  the order they were queued. mvn_quit() stops the writer after writing every
+ *                  queued message, and a crash writes them before the process ends.
+ * \param[in]       capacity: Messages the buffer holds, rounded up to a power of two, 0 for 1024
+ * \param[in]       overflow: What to do with messages logged while the buffer is full
+ * \return          true on success, false on failure
+ */
+bool mvn_logger_start_async(size_t capacity, mvn_log_overflow_t overflow)
+{
+    if (g_writer != NULL) {
+        return mvn_set_error("Asynchronous logging already started");
+    }
+    if (capacity > 0x10000) {
+        return mvn_set_error("Log buffer capacity too large: %zu", capacity);
+    }
+
+    g_capacity = 2;
+    while (g_capacity < (capacity > 0 ? capacity : 1024)) {
+        g_capacity *= 2;
+    }
+
+    g_records = MVN_MALLOC(sizeof(mvn_log_record_t) * g_capacity);
+    g_wake    = SDL_CreateSemaphore(0);
+    if (g_records == NULL || g_wake == NULL) {
+        MVN_FREE(g_records);
+        g_records = NULL;
+        SDL_DestroySemaphore(g_wake);
+        g_wake = NULL;
+        return mvn_set_error("Failed to allocate log buffer");
+    }
+
+    for (uint32_t i = 0; i < g_capacity; i++) {
+        SDL_SetAtomicU32(&g_records[i].sequence, i);
+    }
+    SDL_SetAtomicU32(&g_write_pos, 0);
+    SDL_SetAtomicU32(&g_read_pos, 0);
+    SDL_SetAtomicInt(&g_stopping, 0);
+    SDL_SetAtomicInt(&g_writer_sleeping, 0);
+    g_overflow = overflow;
+
+    g_writer = SDL_CreateThread(writer_main, "mvn-log-writer", NULL);
+    if (g_writer == NULL) {
+        MVN_FREE(g_records);
+        g_records = NULL;
+        SDL_DestroySemaphore(g_wake);
+        g_wake = NULL;
+        return mvn_set_error("Failed to create log writer thread: %s", SDL_GetError());
+    }
+
+    for (size_t i = 0; i < SDL_arraysize(g_crash_signals); i++) {
+        g_previous_handlers[i] = signal(g_crash_signals[i], crash_handler);
+    }
+    SDL_SetAtomicInt(&g_async, 1);
+    return true;
+}
+
+/**
+ * \brief           Write every queued message and return to synchronous logging
+ * \note            Called by mvn_quit()
+ */
+void mvn_logger_stop_async(void)
+{
+    if (g_writer == NULL) {
+        return;
+    }
+
+    // New messages are written synchronously, wait for the ones already being queued
+    SDL_SetAtomicInt(&g_async, 0);
+    while (SDL_GetAtomicInt(&g_producers) > 0) {
+        SDL_Delay(0);
+    }
+
+    SDL_SetAtomicInt(&g_stopping, 1);
+    SDL_SignalSemaphore(g_wake);
+    SDL_WaitThread(g_writer, NULL);
+    g_writer = NULL;
+
+    for (size_t i = 0; i < SDL_arraysize(g_crash_signals); i++) {
+        signal(g_crash_signals[i], g_previous_handlers[i]);
+    }
+
+    SDL_DestroySemaphore(g_wake);
+    g_wake = NULL;
+    MVN_FREE(g_records);
+    g_records  = NULL;
+    g_capacity = 0;
+}
+
+/**
+ * \brief           Check whether messages are written by the background writer thread
+ * \return          true if asynchronous logging is active, false otherwise
+ */
+bool mvn_logger_is_async(void)
+{
+    return SDL_GetAtomicInt(&g_async) != 0;
+}
+
+/**
+ * \brief           Wait until every message logged so far has been written
+ * \note            Must not be called from a log output function
+ */
+void mvn_logger_flush(void)
+{
+    mvn_log_repeat_t note;
+    SDL_LockSpinlock(&g_flood_lock);
+    bool has_note = take_repeat_note_locked(&note);
+    SDL_UnlockSpinlock(&g_flood_lock);
+    if (has_note) {
+        output_repeat_note(&note);
+    }
+
+    if (SDL_GetAtomicInt(&g_async)) {
+        // Positions claimed before this point may still be formatted by their producers
+        uint32_t target = SDL_GetAtomicU32(&g_write_pos);
+        while ((int32_t)(SDL_GetAtomicU32(&g_read_pos) - target) < 0) {
+            SDL_SignalSemaphore(g_wake);
+            SDL_Delay(1);
+        }
+    }
+
+    SDL_LockSpinlock(&g_file_lock);
+    if (g_file != NULL) {
+        SDL_FlushIO(g_file);
+    }
+    SDL_UnlockSpinlock(&g_file_lock);
+
+    if (SDL_GetAtomicInt(&g_binary)) {
+        flush_binary();
+    }
+}
+
+/**
+ * \brief           Also write log messages to a file
+ * \note            Lines carry the time since SDL initialization and the priority. The file is
+ *                  replaced if it exists.
+ * \param[in]       path: Path of the log file, NULL to stop writing to a file
+ * \return          true on success, false on failure
+ */
+bool mvn_logger_set_file(const char *path)
+{
+    SDL_IOStream *file = NULL;
+    if (path != NULL) {
+        file = SDL_IOFromFile(path, "w");
+        if (file == NULL) {
+            return mvn_set_error("Failed to open log file %s: %s", path, SDL_GetError());
+        }
+    }
+
+    SDL_LockSpinlock(&g_file_lock);
+    SDL_IOStream *previous = g_file;
+    g_file                 = file;
+    SDL_SetAtomicInt(&g_file_open, file != NULL);
+    SDL_UnlockSpinlock(&g_file_lock);
+
+    if (previous != NULL) {
+        SDL_CloseIO(previous);
+    }
+    return true;
+}
+
+/**
+ * \brief           Get the number of messages discarded because the buffer was full
+ * \return          Messages dropped under MVN_LOG_OVERFLOW_DROP since the program started
+ */
+uint32_t mvn_logger_get_dropped_count(void)
+{
+    return (uint32_t)SDL_GetAtomicInt(&g_dropped);
+}
+
+/**
+ * \brief           Configure flood control of repeated messages
+ * \note            Each call site, told apart by its format string, may log burst messages per
+ *                  interval. Further messages are counted and reported once the next interval
+ *                  starts. Identical consecutive messages are collapsed into a repeat count,
+ *                  see mvn_logger_set_collapse_repeats().
+ * \param[in]       level: Lowest priority under flood control, MVN_LOG_WARN by default
+ * \param[in]       burst: Messages per call site and interval, 0 to disable rate limiting
+ * \param[in]       interval_ms: Length of an interval in milliseconds
+ */
+void mvn_logger_set_rate_limit(mvn_log_level_t level, uint32_t burst, uint32_t interval_ms)
+{
+    SDL_LockSpinlock(&g_flood_lock);
+    g_flood_level      = (int)level;
+    g_rate_burst       = burst;
+    g_rate_interval_ns = SDL_MS_TO_NS((uint64_t)interval_ms);
+    SDL_UnlockSpinlock(&g_flood_lock);
+}
+
+/**
+ * \brief           Enable or disable collapsing of identical consecutive messages
+ * \note            Collapsed messages are reported as "Last message repeated N times" before the
+ *                  next different message or by mvn_logger_flush()
+ * \param[in]       enabled: true to collapse repeats (the default), false to log each one
+ */
+void mvn_logger_set_collapse_repeats(bool enabled)
+{
+    SDL_LockSpinlock(&g_flood_lock);
+    g_collapse_repeats = enabled;
+    SDL_UnlockSpinlock(&g_flood_lock);
+}
+
+/**
+ * \brief           Get the number of messages suppressed by the rate limiter
+ * \return          Messages suppressed since the program started
+ */
+uint32_t mvn_logger_get_suppressed_count(void)
+{
+    return (uint32_t)SDL_GetAtomicInt(&g_suppressed);
+}
+
+/**
+ * \brief           Get the number of messages collapsed into a repeat count
+ * \return          Repeated messages not logged since the program started
+ */
+uint32_t mvn_logger_get_collapsed_count(void)
+{
+    return (uint32_t)SDL_GetAtomicInt(&g_collapsed);
+}
+
+/**
+ * \brief           Record messages logged with mvn_log() in a binary log file
+ * \note            Only the format string address, a timestamp and the raw arguments are
+ *                  recorded, into a buffer per thread, and formatting is left to
+ *                  mvn_logger_decode_binary(). Format strings must stay valid until
+ *                  mvn_logger_stop_binary(), which holds for string literals. Messages using
+ *                  %n, wide characters or more than 16 arguments are logged as text.
+ *                  Not thread safe with mvn_logger_stop_binary().
+ * \param[in]       path: Path of the binary log file, replaced if it exists
+ * \return          true on success, false on failure
+ */
+bool mvn_logger_start_binary(const char *path)
+{
+    if (path == NULL) {
+        return mvn_set_error("Binary log path is NULL");
+    }
+    if (SDL_GetAtomicInt(&g_binary)) {
+        return mvn_set_error("Binary logging is already running");
+    }
+
+    SDL_IOStream *file = SDL_IOFromFile(path, "wb");
+    if (file == NULL) {
+        return mvn_set_error("Failed to open binary log %s: %s", path, SDL_GetError());
+    }
+
+    uint8_t  header[MVN_LOG_BINARY_HEADER_SIZE] = MVN_LOG_BINARY_MAGIC;
+    uint16_t byte_order                         = MVN_LOG_BINARY_BYTE_ORDER;
+    header[7]                                   = MVN_LOG_BINARY_VERSION;
+    SDL_memcpy(header + 8, &byte_order, sizeof(byte_order));
+
+    g_binary_file_lock = SDL_CreateMutex();
+    if (g_binary_file_lock == NULL || SDL_WriteIO(file, header, sizeof(header)) != sizeof(header)) {
+        SDL_DestroyMutex(g_binary_file_lock);
+        g_binary_file_lock = NULL;
+        SDL_CloseIO(file);
+        return mvn_set_error("Failed to start binary log %s: %s", path, SDL_GetError());
+    }
+
+    SDL_zeroa(g_formats);
+    g_format_count = 0;
+    g_binary_file  = file;
+
+    SDL_LockSpinlock(&g_binary_lock);
+    SDL_SetAtomicU32(&g_binary_generation, SDL_GetAtomicU32(&g_binary_generation) + 1);
+    SDL_SetAtomicInt(&g_binary, 1);
+    SDL_UnlockSpinlock(&g_binary_lock);
+    return true;
+}
+
+/**
+ * \brief           Write every recorded binary message and close the binary log file
+ * \note            Messages logged afterwards are text again
+ */
+void mvn_logger_stop_binary(void)
+{
+    if (!SDL_GetAtomicInt(&g_binary)) {
+        return;
+    }
+
+    // Buffers claimed after this point see the new generation and give up
+    SDL_LockSpinlock(&g_binary_lock);
+    SDL_SetAtomicInt(&g_binary, 0);
+    SDL_SetAtomicU32(&g_binary_generation, SDL_GetAtomicU32(&g_binary_generation) + 1);
+    SDL_UnlockSpinlock(&g_binary_lock);
+
+    // Records are written once any write of the same buffer in flight has finished
+    for (size_t i = 0; i < MVN_LOG_BINARY_MAX_THREADS; i++) {
+        mvn_log_thread_buffer_t *buffer = &g_thread_buffers[i];
+        uint8_t                 *data   = NULL;
+        uint8_t                 *spare  = NULL;
+        size_t                   length = 0;
+        lock_idle_buffer(buffer);
+        if (buffer->generation != 0) {
+            take_thread_buffer(buffer, &data, &length, &spare);
+        }
+        SDL_UnlockSpinlock(&buffer->lock);
+        free_thread_records(data, length, spare);
+    }
+
+    SDL_CloseIO(g_binary_file);
+    SDL_DestroyMutex(g_binary_file_lock);
+    g_binary_file      = NULL;
+    g_binary_file_lock = NULL;
+}
+
+/**
+ * \brief           Check whether mvn_log() records binary messages
+ * \return          true between mvn_logger_start_binary() and mvn_logger_stop_binary()
+ */
+bool mvn_logger_is_binary(void)
+{
+    return SDL_GetAtomicInt(&g_binary) != 0;
+}
+
+/**
+ * \brief           Turn a binary log file back into text
+ * \note            Lines have the layout of mvn_logger_set_file(). Messages of one thread are in
+ *                  order, messages of different threads are grouped by buffer flush.
+ * \param[in]       path: Path of a file written by mvn_logger_start_binary()
+ * \param[in]       callback: Called with each decoded line, without a newline
+ * \param[in]       user_data: Passed to callback
+ * \return          true on success, false if the file cannot be read or is malformed
+ */
+bool mvn_logger_decode_binary(const char *path, mvn_log_decode_fn callback, void *user_data)
+{
+    if (path == NULL || callback == NULL) {
+        return mvn_set_error("Invalid arguments to decode binary log");
+    }
+
+    size_t   size = 0;
+    uint8_t *data = SDL_LoadFile(path, &size);
+    if (data == NULL) {
+        return mvn_set_error("Failed to read binary log %s: %s", path, SDL_GetError());
+    }
+
+    uint16_t byte_order = 0;
+    if (size >= MVN_LOG_BINARY_HEADER_SIZE) {
+        SDL_memcpy(&byte_order, data + 8, sizeof(byte_order));
+    }
+    if (size < MVN_LOG_BINARY_HEADER_SIZE || SDL_memcmp(data, MVN_LOG_BINARY_MAGIC, 7) != 0 ||
+        data[7] != MVN_LOG_BINARY_VERSION || byte_order != MVN_LOG_BINARY_BYTE_ORDER) {
+        SDL_free(data);
+        return mvn_set_error("%s is not a binary log written on this platform", path);
+    }
+
+    char **formats = MVN_CALLOC(MVN_LOG_BINARY_MAX_FORMATS, sizeof(char *));
+    bool   result  = formats != NULL;
+
+    const uint8_t *cursor = data + MVN_LOG_BINARY_HEADER_SIZE;
+    const uint8_t *end    = data + size;
+    while (result && cursor < end) {
+        uint8_t  type = *cursor++;
+        uint16_t id   = 0;
+        if (!read_binary(&cursor, end, &id, sizeof(id)) || id >= MVN_LOG_BINARY_MAX_FORMATS) {
+            result = false;
+            break;
+        }
+
+        if (type == MVN_LOG_BINARY_FORMAT_RECORD) {
+            uint16_t length = 0;
+            if (!read_binary(&cursor, end, &length, sizeof(length)) || formats[id] != NULL ||
+                (formats[id] = MVN_MALLOC((size_t)length + 1)) == NULL ||
+                !read_binary(&cursor, end, formats[id], length)) {
+                result = false;
+                break;
+            }
+            formats[id][length] = '\0';
+            continue;
+        }
+
+        uint16_t category  = 0;
+        uint8_t  priority  = 0;
+        uint64_t timestamp = 0;
+        if (type != MVN_LOG_BINARY_MESSAGE_RECORD || formats[id] == NULL ||
+            !read_binary(&cursor, end, &category, sizeof(category)) ||
+            !read_binary(&cursor, end, &priority, sizeof(priority)) ||
+            !read_binary(&cursor, end, &timestamp, sizeof(timestamp))) {
+            result = false;
+            break;
+        }
+
+        char line[MVN_LOG_BINARY_LINE_SIZE];
+        int  prefix = SDL_snprintf(line,
+                                  sizeof(line),
+                                  "[%10.3f] [%s] ",
+                                  (double)timestamp / 1e9,
+                                  get_priority_name((SDL_LogPriority)priority));
+        if (!mvn_format_unpack(
+                line + prefix, sizeof(line) - (size_t)prefix, formats[id], &cursor, end)) {
+            result = false;
+            break;
+        }
+        callback(line, user_data);
+    }
+
+    if (formats != NULL) {
+        for (size_t i = 0; i < MVN_LOG_BINARY_MAX_FORMATS; i++) {
+            MVN_FREE(formats[i]);
+        }
+        MVN_FREE(formats);
+    }
+    SDL_free(data);
+
+    if (!result) {
+        return mvn_set_error("Binary log %s is malformed or truncated", path);
+    }
+    return true;
+}
+
+/**
+ * \brief           Stop asynchronous and binary logging and close the log files
+ */
+void mvn_logger_shutdown(void)
+{
+    mvn_logger_stop_async();
+    mvn_logger_stop_binary();
+    mvn_logger_set_file(NULL);
+}
@@ -0,0 +1,478 @@
+/**
+ * \file            mvn-profile.c
+ * \brief           CPU profiler zones for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn-profile.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-utils.h"
+
+#include <SDL3/SDL.h>
+
+#if defined(MVN_PROFILE_ENABLED)
+
+/* Completed zones kept per thread, must be a power of two */
+#define MVN_PROFILE_RING_SIZE 16384
+
+/* Deepest zone nesting recorded per thread */
+#define MVN_PROFILE_MAX_DEPTH 64
+
+/**
+ * \brief           Completed profiler zone
+ */
+typedef struct mvn_profile_event_t {
+    const char *name;  /*!< Zone name */
+    uint64_t    begin; /*!< Performance counter at zone begin */
+    uint64_t    end;   /*!< Performance counter at zone end */
+} mvn_profile_event_t;
+
+/**
+ * \brief           Zone events of one thread
+ * \note            Only the owning thread writes events, so recording needs no locks. Readers
+ *                  use head to detect events that were overwritten while they were copied.
+ *                  When the owner exits the ring keeps its events until another thread adopts
+ *                  it, so threads that come and go reuse a bounded number of rings.
+ */
+typedef struct mvn_profile_ring_t {
+    struct mvn_profile_ring_t *next;                          /*!< Next registered ring */
+    SDL_ThreadID               thread_id;                     /*!< Owning or last thread */
+    bool                       orphaned;                      /*!< Whether the owner exited */
+    SDL_AtomicU32              head;                          /*!< Events written, wraps */
+    uint32_t                   depth;                         /*!< Number of open zones */
+    mvn_profile_event_t        open[MVN_PROFILE_MAX_DEPTH];   /*!< Open zones */
+    mvn_profile_event_t        events[MVN_PROFILE_RING_SIZE]; /*!< Completed zones */
+} mvn_profile_ring_t;
+
+static SDL_TLSID           g_profile_tls;                // Ring of the calling thread
+static mvn_profile_ring_t *g_profile_rings       = NULL; // All registered rings
+static SDL_SpinLock        g_profile_lock;               // Guards g_profile_rings and adoption
+static SDL_AtomicInt       g_profile_disabled;           // Non-zero while recording is paused
+static char               *g_profile_export_path = NULL; // Written by mvn_profile_shutdown
+
+/**
+ * \brief           Leave the ring of an exiting thread for adoption by another thread
+ * \note            Called by SDL when a thread that recorded zones exits
+ * \param[in]       value: Ring of the thread
+ */
+static void SDLCALL orphan_thread_ring(void *value)
+{
+    // Rings released by mvn_profile_shutdown() are no longer registered
+    SDL_LockSpinlock(&g_profile_lock);
+    for (mvn_profile_ring_t *ring = g_profile_rings; ring != NULL; ring = ring->next) {
+        if (ring == value) {
+            ring->orphaned = true;
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&g_profile_lock);
+}
+
+/**
+ * \brief           Take over the ring of a thread that exited
+ * \return          Ring cleared for the calling thread, NULL if there is none
+ */
+static mvn_profile_ring_t *adopt_thread_ring(void)
+{
+    mvn_profile_ring_t *ring = NULL;
+
+    // Export copies events under the lock, so clearing the ring here cannot tear a copy
+    SDL_LockSpinlock(&g_profile_lock);
+    ring = g_profile_rings;
+    while (ring != NULL && !ring->orphaned) {
+        ring = ring->next;
+    }
+    if (ring != NULL) {
+        ring->orphaned  = false;
+        ring->thread_id = SDL_GetCurrentThreadID();
+        ring->depth     = 0;
+        SDL_SetAtomicU32(&ring->head, 0);
+    }
+    SDL_UnlockSpinlock(&g_profile_lock);
+    return ring;
+}
+
+/**
+ * \brief           Get the ring of the calling thread, creating it on first use
+ * \note            The ring of a thread that exited is reused before a new one is allocated
+ * \return          Ring or NULL on allocation failure
+ */
+static mvn_profile_ring_t *get_thread_ring(void)
+{
+    mvn_profile_ring_t *ring = (mvn_profile_ring_t *)SDL_GetTLS(&g_profile_tls);
+    if (ring != NULL) {
+        return ring;
+    }
+
+    ring = adopt_thread_ring();
+    if (ring != NULL) {
+        if (!SDL_SetTLS(&g_profile_tls, ring, orphan_thread_ring)) {
+            orphan_thread_ring(ring);
+            return NULL;
+        }
+        return ring;
+    }
+
+    ring = MVN_CALLOC(1, sizeof(mvn_profile_ring_t));
+    if (ring == NULL) {
+        return NULL;
+    }
+    ring->thread_id = SDL_GetCurrentThreadID();
+
+    if (!SDL_SetTLS(&g_profile_tls, ring, orphan_thread_ring)) {
+        MVN_FREE(ring);
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&g_profile_lock);
+    ring->next      = g_profile_rings;
+    g_profile_rings = ring;
+    SDL_UnlockSpinlock(&g_profile_lock);
+    return ring;
+}
+
+/**
+ * \brief           Open a profiler zone on the calling thread
+ * \param[in]       name: Zone name, must be a string with static lifetime
+ */
+void mvn_profile_begin(const char *name)
+{
+    if (SDL_GetAtomicInt(&g_profile_disabled) != 0) {
+        return;
+    }
+
+    mvn_profile_ring_t *ring = get_thread_ring();
+    if (ring == NULL) {
+        return;
+    }
+
+    // Zones nested too deeply are counted but not recorded
+    if (ring->depth < MVN_PROFILE_MAX_DEPTH) {
+        ring->open[ring->depth].name  = name;
+        ring->open[ring->depth].begin = SDL_GetPerformanceCounter();
+    }
+    ring->depth++;
+}
+
+/**
+ * \brief           Close the innermost profiler zone of the calling thread
+ */
+void mvn_profile_end(void)
+{
+    mvn_profile_ring_t *ring = (mvn_profile_ring_t *)SDL_GetTLS(&g_profile_tls);
+    if (ring == NULL || ring->depth == 0) {
+        return;
+    }
+
+    ring->depth--;
+    if (ring->depth >= MVN_PROFILE_MAX_DEPTH) {
+        return;
+    }
+
+    uint32_t             head  = SDL_GetAtomicU32(&ring->head);
+    mvn_profile_event_t *event = &ring->events[head & (MVN_PROFILE_RING_SIZE - 1)];
+    *event                     = ring->open[ring->depth];
+    event->end                 = SDL_GetPerformanceCounter();
+    SDL_SetAtomicU32(&ring->head, head + 1);
+}
+
+/**
+ * \brief           Pause or resume recording of profiler zones
+ * \note            Zones opened before pausing are still closed normally
+ * \param[in]       enabled: true to record zones, false to ignore them
+ */
+void mvn_profile_set_enabled(bool enabled)
+{
+    SDL_SetAtomicInt(&g_profile_disabled, enabled ? 0 : 1);
+}
+
+/**
+ * \brief           Write a zone name as a JSON string
+ * \param[in]       stream: Output stream
+ * \param[in]       name: Zone name
+ */
+static void write_json_string(SDL_IOStream *stream, const char *name)
+{
+    SDL_WriteIO(stream, "\"", 1);
+    for (const char *c = name; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            SDL_WriteIO(stream, "\\", 1);
+            SDL_WriteIO(stream, c, 1);
+        } else if ((unsigned char)*c < 0x20) {
+            SDL_IOprintf(stream, "\\u%04x", (unsigned)*c);
+        } else {
+            SDL_WriteIO(stream, c, 1);
+        }
+    }
+    SDL_WriteIO(stream, "\"", 1);
+}
+
+/**
+ * \brief           Copy of the completed zones of one ring, taken for export
+ */
+typedef struct mvn_profile_snapshot_t {
+    SDL_ThreadID        thread_id;                     /*!< Thread that recorded the zones */
+    uint32_t            first;                         /*!< First valid event */
+    uint32_t            count;                         /*!< Number of events copied */
+    mvn_profile_event_t events[MVN_PROFILE_RING_SIZE]; /*!< Copied zones, oldest first */
+} mvn_profile_snapshot_t;
+
+/**
+ * \brief           Count the registered rings
+ * \note            Call with g_profile_lock held
+ * \return          Number of rings
+ */
+static size_t count_rings(void)
+{
+    size_t count = 0;
+    for (mvn_profile_ring_t *ring = g_profile_rings; ring != NULL; ring = ring->next) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * \brief           Copy the completed zones of one ring
+ * \note            Call with g_profile_lock held. The owning thread keeps recording meanwhile.
+ * \param[in]       ring: Ring to copy
+ * \param[out]      snapshot: Receives the zones
+ */
+static void copy_ring_events(mvn_profile_ring_t *ring, mvn_profile_snapshot_t *snapshot)
+{
+    uint32_t head  = SDL_GetAtomicU32(&ring->head);
+    uint32_t count = SDL_min(head, (uint32_t)MVN_PROFILE_RING_SIZE);
+    uint32_t start = head - count;
+
+    for (uint32_t i = 0; i < count; i++) {
+        snapshot->events[i] = ring->events[(start + i) & (MVN_PROFILE_RING_SIZE - 1)];
+    }
+
+    // Skip events the owning thread overwrote while they were being copied, including the
+    // slot of event head_after, which it may be writing right now
+    uint32_t head_after = SDL_GetAtomicU32(&ring->head);
+    uint32_t touched    = head_after - start + 1;
+    uint32_t skipped    = 0;
+    if (touched > MVN_PROFILE_RING_SIZE) {
+        skipped = SDL_min(touched - MVN_PROFILE_RING_SIZE, count);
+    }
+
+    snapshot->thread_id = ring->thread_id;
+    snapshot->first     = skipped;
+    snapshot->count     = count;
+}
+
+/**
+ * \brief           Copy the completed zones of all rings
+ * \note            Events are copied under the lock and formatted after it is released, so
+ *                  threads registering rings only wait for the copies
+ * \param[out]      count: Receives the number of snapshots
+ * \return          Array of snapshots to free with MVN_FREE(), NULL on failure
+ */
+static mvn_profile_snapshot_t *snapshot_rings(size_t *count)
+{
+    SDL_LockSpinlock(&g_profile_lock);
+    size_t capacity = count_rings();
+    SDL_UnlockSpinlock(&g_profile_lock);
+
+    for (;;) {
+        // Allocate outside the lock, and retry if threads registered rings meanwhile
+        mvn_profile_snapshot_t *snapshots =
+            MVN_MALLOC(sizeof(mvn_profile_snapshot_t) * SDL_max(capacity, (size_t)1));
+        if (snapshots == NULL) {
+            return NULL;
+        }
+
+        SDL_LockSpinlock(&g_profile_lock);
+        size_t rings = count_rings();
+        if (rings <= capacity) {
+            size_t index = 0;
+            for (mvn_profile_ring_t *ring = g_profile_rings; ring != NULL; ring = ring->next) {
+                copy_ring_events(ring, &snapshots[index++]);
+            }
+            SDL_UnlockSpinlock(&g_profile_lock);
+            *count = rings;
+            return snapshots;
+        }
+        SDL_UnlockSpinlock(&g_profile_lock);
+
+        MVN_FREE(snapshots);
+        capacity = rings;
+    }
+}
+
+/**
+ * \brief           Write the zones of one snapshot as trace events
+ * \param[in]       stream: Output stream
+ * \param[in]       snapshot: Zones to write
+ * \param[in]       first: Whether no event has been written yet
+ * \return          Whether no event has been written yet after this snapshot
+ */
+static bool write_snapshot_events(SDL_IOStream                 *stream,
+                                  const mvn_profile_snapshot_t *snapshot,
+                                  bool                          first)
+{
+    double ticks_per_us = (double)SDL_GetPerformanceFrequency() / 1000000.0;
+
+    for (uint32_t i = snapshot->first; i < snapshot->count; i++) {
+        const mvn_profile_event_t *event = &snapshot->events[i];
+        SDL_IOprintf(stream, first ? "\n" : ",\n");
+        SDL_IOprintf(stream, "{\"name\":");
+        write_json_string(stream, event->name);
+        SDL_IOprintf(stream,
+                     ",\"ph\":\"X\",\"pid\":1,\"tid\":%" SDL_PRIu64
+                     ",\"ts\":%.3f,\"dur\":%.3f}",
+                     (uint64_t)snapshot->thread_id,
+                     (double)event->begin / ticks_per_us,
+                     (double)(event->end - event->begin) / ticks_per_us);
+        first = false;
+    }
+    return first;
+}
+
+/**
+ * \brief           Export recorded zones as Chrome trace JSON
+ * \note            The file opens in chrome://tracing and the Perfetto UI. Only the most recent
+ *                  MVN_PROFILE_RING_SIZE zones of each thread are kept.
+ * \param[in]       path: Output file path
+ * \return          true on success, false on failure
+ */
+bool mvn_profile_export(const char *path)
+{
+    if (path == NULL) {
+        return mvn_set_error("Profile export path is NULL");
+    }
+
+    size_t                  count     = 0;
+    mvn_profile_snapshot_t *snapshots = snapshot_rings(&count);
+    if (snapshots == NULL) {
+        return mvn_set_error("Failed to allocate profile export buffer");
+    }
+
+    SDL_IOStream *stream = SDL_IOFromFile(path, "w");
+    if (stream == NULL) {
+        MVN_FREE(snapshots);
+        return mvn_set_error("Failed to open profile export %s: %s", path, SDL_GetError());
+    }
+
+    bool first = true;
+    SDL_IOprintf(stream, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (size_t i = 0; i < count; i++) {
+        first = write_snapshot_events(stream, &snapshots[i], first);
+    }
+    MVN_FREE(snapshots);
+
+    SDL_IOprintf(stream, "\n]}\n");
+    if (!SDL_CloseIO(stream)) {
+        return mvn_set_error("Failed to write profile export %s: %s", path, SDL_GetError());
+    }
+
+    mvn_log_info("Profile written to %s", path);
+    return true;
+}
+
+/**
+ * \brief           Export recorded zones when the framework shuts down
+ * \param[in]       path: Output file path, NULL to disable the export
+ * \return          true on success, false on failure
+ */
+bool mvn_profile_set_export_on_quit(const char *path)
+{
+    char *copy = NULL;
+    if (path != NULL) {
+        size_t length = SDL_strlen(path);
+        copy          = MVN_MALLOC(length + 1);
+        if (copy == NULL) {
+            return mvn_set_error("Failed to allocate profile export path");
+        }
+        SDL_memcpy(copy, path, length + 1);
+    }
+
+    MVN_FREE(g_profile_export_path);
+    g_profile_export_path = copy;
+    return true;
+}
+
+/**
+ * \brief           Export the profile if requested and release all recorded zones
+ * \note            Called by mvn_quit(). Threads other than the caller must not record zones
+ *                  afterwards.
+ */
+void mvn_profile_shutdown(void)
+{
+    if (g_profile_export_path != NULL) {
+        mvn_profile_export(g_profile_export_path);
+        MVN_FREE(g_profile_export_path);
+        g_profile_export_path = NULL;
+    }
+
+    SDL_LockSpinlock(&g_profile_lock);
+    mvn_profile_ring_t *ring = g_profile_rings;
+    g_profile_rings          = NULL;
+    SDL_UnlockSpinlock(&g_profile_lock);
+
+    while (ring != NULL) {
+        mvn_profile_ring_t *next = ring->next;
+        MVN_FREE(ring);
+        ring = next;
+    }
+    SDL_SetTLS(&g_profile_tls, NULL, NULL);
+}
+
+#else
+
+void mvn_profile_begin(const char *name)
+{
+    (void)name;
+}
+
+void mvn_profile_end(void) {}
+
+void mvn_profile_set_enabled(bool enabled)
+{
+    (void)enabled;
+}
+
+bool mvn_profile_export(const char *path)
+{
+    (void)path;
+    return mvn_set_error("Profiler not compiled in, configure with MVN_PROFILE=ON");
+}
+
+bool mvn_profile_set_export_on_quit(const char *path)
+{
+    (void)path;
+    return mvn_set_error("Profiler not compiled in, configure with MVN_PROFILE=ON");
+}
+
+void mvn_profile_shutdown(void) {}
+
+#endif /* MVN_PROFILE_ENABLED */
@@ -3,6 +3,8 @@
  * \brief           Implementation of dynamic string for MVN game framework
  */
 
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_STRING
+
 #include "mvn/mvn-string.h"
 
 #include "mvn/mvn-error.h" // Add this include
@@ -18,6 +20,24 @@
 /* Growth factor when resizing */
 #define MVN_STRING_GROWTH_FACTOR 2
 
+/* Default initial capacity for string builders */
+#define MVN_STRBUF_DEFAULT_CAPACITY 64
+
+/* Free space reserved before formatting so small appendf calls finish in a single pass */
+#define MVN_STRBUF_FORMAT_RESERVE 256
+
+/* Select a SIMD implementation for the byte scanning kernels, scalar code handles the tails */
+#if defined(SDL_SSE2_INTRINSICS)
+#define MVN_STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MVN_STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif /* SDL_SSE2_INTRINSICS */
+
+/* Bytes processed per SIMD block */
+#define MVN_STRING_SIMD_WIDTH 16
+
 /* Empty string constant for safety */
 static const char EMPTY_STRING[] = "";
 
@@ -25,6 +45,7 @@ static const char EMPTY_STRING[] = "";
 static bool mvn_string_ensure_capacity(mvn_string_t *str, size_t needed_capacity);
 static bool mvn_string_resize(mvn_string_t *str, size_t new_capacity);
 static bool is_whitespace(char character);
+static bool mvn_strbuf_grow(mvn_strbuf_t *buf, size_t needed_capacity);
 
 /**
  * \brief           Create a deep copy of a string
@@ -69,11 +90,23 @@ static void mvn_free_string_list(mvn_list_t *list)
 }
 
 /**
- * \brief           Initialize a new empty string
+ * \brief           Allocate memory for a string from its arena or the general allocator
+ * \param[in]       arena: Arena to allocate from, NULL for the general allocator
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to the memory or NULL on failure
+ */
+static void *mvn_string_alloc(mvn_arena_t *arena, size_t size)
+{
+    return arena != NULL ? mvn_arena_alloc(arena, size) : MVN_MALLOC(size);
+}
+
+/**
+ * \brief           Create a new empty string
+ * \param[in]       arena: Arena owning the string, NULL for the general allocator
  * \param[in]       initial_capacity: Initial capacity for the string buffer
  * \return          Newly created string or NULL on failure
  */
-mvn_string_t *mvn_string_init(size_t initial_capacity)
+static mvn_string_t *mvn_string_create(mvn_arena_t *arena, size_t initial_capacity)
 {
     /* Use default capacity if not specified */
     if (initial_capacity == 0) {
@@ -81,35 +114,41 @@ mvn_string_t *mvn_string_init(size_t initial_capacity)
     }
 
     /* Allocate string structure */
-    mvn_string_t *str = MVN_MALLOC(sizeof(mvn_string_t));
+    mvn_string_t *str = mvn_string_alloc(arena, sizeof(mvn_string_t));
     if (str == NULL) {
         mvn_set_error("Failed to allocate memory for string");
         return NULL;
     }
 
     /* Allocate data array */
-    str->data = MVN_MALLOC(initial_capacity);
+    str->data = mvn_string_alloc(arena, initial_capacity);
     if (!str->data) {
-        MVN_FREE(str);
+        if (arena == NULL) {
+            MVN_FREE(str);
+        }
         mvn_set_error("Failed to allocate memory for string data");
         return NULL;
     }
 
     /* Initialize with empty string */
-    str->data[0]  = '\0';
-    str->length   = 0;
-    str->capacity = initial_capacity;
+    str->data[0]    = '\0';
+    str->length     = 0;
+    str->capacity   = initial_capacity;
+    str->hash       = 0;
+    str->hash_valid = false;
+    str->arena      = arena;
 
     mvn_log_debug("String initialized with capacity=%zu", initial_capacity);
     return str;
 }
 
 /**
- * \brief           Initialize a string from a C string
+ * \brief           Create a string from a C string
+ * \param[in]       arena: Arena owning the string, NULL for the general allocator
  * \param[in]       cstr: C string to copy
  * \return          Newly created string or NULL on failure
  */
-mvn_string_t *mvn_string_from_cstr(const char *cstr)
+static mvn_string_t *mvn_string_create_from_cstr(mvn_arena_t *arena, const char *cstr)
 {
     if (!cstr) {
         mvn_log_debug("NULL C string provided to mvn_string_from_cstr, treating as empty string");
@@ -119,7 +158,7 @@ mvn_string_t *mvn_string_from_cstr(const char *cstr)
     size_t len             = SDL_strlen(cstr);
     size_t needed_capacity = len + 1; /* +1 for null terminator */
 
-    mvn_string_t *str = mvn_string_init(needed_capacity);
+    mvn_string_t *str = mvn_string_create(arena, needed_capacity);
     if (!str) {
         return NULL;
     }
@@ -130,6 +169,58 @@ mvn_string_t *mvn_string_from_cstr(const char *cstr)
     return str;
 }
 
+/**
+ * \brief           Initialize a new empty string
+ * \param[in]       initial_capacity: Initial capacity for the string buffer
+ * \return          Newly created string or NULL on failure
+ */
+mvn_string_t *mvn_string_init(size_t initial_capacity)
+{
+    return mvn_string_create(NULL, initial_capacity);
+}
+
+/**
+ * \brief           Initialize a string from a C string
+ * \param[in]       cstr: C string to copy
+ * \return          Newly created string or NULL on failure
+ */
+mvn_string_t *mvn_string_from_cstr(const char *cstr)
+{
+    return mvn_string_create_from_cstr(NULL, cstr);
+}
+
+/**
+ * \brief           Initialize a new empty string owned by an arena
+ * \note            The string lives until the arena is reset, mvn_string_free is a no-op for it
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       initial_capacity: Initial capacity for the string buffer
+ * \return          Newly created string or NULL on failure
+ */
+mvn_string_t *mvn_string_init_arena(mvn_arena_t *arena, size_t initial_capacity)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot create string in NULL arena");
+        return NULL;
+    }
+    return mvn_string_create(arena, initial_capacity);
+}
+
+/**
+ * \brief           Initialize a string owned by an arena from a C string
+ * \note            The string lives until the arena is reset, mvn_string_free is a no-op for it
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       cstr: C string to copy
+ * \return          Newly created string or NULL on failure
+ */
+mvn_string_t *mvn_string_from_cstr_arena(mvn_arena_t *arena, const char *cstr)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot create string in NULL arena");
+        return NULL;
+    }
+    return mvn_string_create_from_cstr(arena, cstr);
+}
+
 /**
  * \brief           Free a string and all its resources
  * \param[in]       str: String to free
@@ -140,6 +231,11 @@ void mvn_string_free(mvn_string_t *str)
         return;
     }
 
+    /* Arena strings are released together with their arena */
+    if (str->arena != NULL) {
+        return;
+    }
+
     if (str->data) {
         MVN_FREE(str->data);
     }
@@ -191,7 +287,9 @@ static bool mvn_string_resize(mvn_string_t *str, size_t new_capacity)
         new_capacity = str->length + 1;
     }
 
-    char *new_data = MVN_REALLOC(str->data, new_capacity);
+    char *new_data = str->arena != NULL
+                         ? mvn_arena_realloc(str->arena, str->data, str->capacity, new_capacity)
+                         : MVN_REALLOC(str->data, new_capacity);
     if (!new_data) {
         return mvn_set_error("Failed to resize string to capacity %zu", new_capacity);
     }
@@ -291,7 +389,8 @@ bool mvn_string_append(mvn_string_t *str, const char *cstr)
     }
 
     SDL_memcpy(str->data + str->length, cstr, cstr_len + 1); /* Include null terminator */
-    str->length = new_length;
+    str->length     = new_length;
+    str->hash_valid = false;
 
     return true;
 }
@@ -713,8 +812,308 @@ struct mvn_list_t *mvn_string_split(const mvn_string_t *str, const char *delimit
     return list;
 }
 
+/**
+ * \brief           Check if a character is whitespace
+ * \param[in]       character: Character to check
+ * \return          true if character is whitespace, false otherwise
+ */
+static bool is_whitespace(char character)
+{
+    return character == ' ' || character == '\t' || character == '\n' || character == '\r' ||
+           character == '\f' || character == '\v';
+}
+
+#if defined(MVN_STRING_SIMD_SSE2) || defined(MVN_STRING_SIMD_NEON)
+
+/**
+ * \brief           Index of the lowest set bit of a non-zero block mask
+ * \param[in]       mask: Non-zero bit mask
+ * \return          Index of the lowest set bit
+ */
+static int lowest_set_bit(uint32_t mask)
+{
+    return SDL_MostSignificantBitIndex32(mask & (~mask + 1));
+}
+
+#endif /* MVN_STRING_SIMD_SSE2 || MVN_STRING_SIMD_NEON */
+
+#if defined(MVN_STRING_SIMD_SSE2)
+
+/**
+ * \brief           Count set bits of a block mask
+ * \param[in]       mask: Bit mask
+ * \return          Number of set bits
+ */
+static size_t count_set_bits(uint32_t mask)
+{
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0Fu;
+    return (size_t)((mask * 0x01010101u) >> 24);
+}
+
+/**
+ * \brief           Load one 16 byte block without alignment requirements
+ */
+#define MVN_SIMD_LOAD(ptr) _mm_loadu_si128((const __m128i *)(const void *)(ptr))
+
+/**
+ * \brief           Build a 16 bit mask with one bit set per whitespace byte of a block
+ * \param[in]       block: Block of 16 bytes
+ * \return          Whitespace mask, bit N corresponds to byte N
+ */
+static uint32_t simd_whitespace_mask(__m128i block)
+{
+    /* '\t' '\n' '\v' '\f' '\r' are the contiguous range 9..13, bytes >= 0x80 compare negative */
+    __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)),
+                                     _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1)));
+    __m128i space    = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(in_range, space));
+}
+
+#elif defined(MVN_STRING_SIMD_NEON)
+
+/**
+ * \brief           Load one 16 byte block without alignment requirements
+ */
+#define MVN_SIMD_LOAD(ptr) vld1q_u8((const uint8_t *)(const void *)(ptr))
+
+/**
+ * \brief           Collapse a NEON byte comparison result into a 16 bit mask
+ * \param[in]       cmp: Comparison result with every byte either 0x00 or 0xFF
+ * \return          Bit mask, bit N corresponds to byte N
+ */
+static uint32_t simd_movemask(uint8x16_t cmp)
+{
+    static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t           bits        = vandq_u8(cmp, vld1q_u8(weights));
+    return (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+/**
+ * \brief           Build a 16 bit mask with one bit set per whitespace byte of a block
+ * \param[in]       block: Block of 16 bytes
+ * \return          Whitespace mask, bit N corresponds to byte N
+ */
+static uint32_t simd_whitespace_mask(uint8x16_t block)
+{
+    uint8x16_t in_range = vcleq_u8(vsubq_u8(block, vdupq_n_u8('\t')), vdupq_n_u8('\r' - '\t'));
+    uint8x16_t space    = vceqq_u8(block, vdupq_n_u8(' '));
+    return simd_movemask(vorrq_u8(in_range, space));
+}
+
+#endif /* MVN_STRING_SIMD_SSE2 */
+
+/**
+ * \brief           Convert the ASCII letters of a buffer to one case
+ * \note            Bytes outside the ASCII letter ranges (including every UTF-8 lead and
+ *                  continuation byte) are copied unchanged. `dest` may alias `src`.
+ * \param[out]      dest: Destination buffer of at least `length` bytes
+ * \param[in]       src: Source buffer
+ * \param[in]       length: Number of bytes to convert
+ * \param[in]       to_upper: true to convert to uppercase, false for lowercase
+ */
+static void ascii_convert_case(char *dest, const char *src, size_t length, bool to_upper)
+{
+    const char first = to_upper ? 'a' : 'A';
+    size_t     i     = 0;
+
+#if defined(MVN_STRING_SIMD_SSE2)
+    const __m128i lower_bound = _mm_set1_epi8((char)(first - 1));
+    const __m128i upper_bound = _mm_set1_epi8((char)(first + 26));
+    const __m128i case_bit    = _mm_set1_epi8(0x20);
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        __m128i block  = MVN_SIMD_LOAD(src + i);
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(block, lower_bound),
+                                       _mm_cmplt_epi8(block, upper_bound));
+        block          = _mm_xor_si128(block, _mm_and_si128(letter, case_bit));
+        _mm_storeu_si128((__m128i *)(void *)(dest + i), block);
+    }
+#elif defined(MVN_STRING_SIMD_NEON)
+    const uint8x16_t base     = vdupq_n_u8((uint8_t)first);
+    const uint8x16_t span     = vdupq_n_u8(25);
+    const uint8x16_t case_bit = vdupq_n_u8(0x20);
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        uint8x16_t block  = MVN_SIMD_LOAD(src + i);
+        uint8x16_t letter = vcleq_u8(vsubq_u8(block, base), span);
+        block             = veorq_u8(block, vandq_u8(letter, case_bit));
+        vst1q_u8((uint8_t *)(void *)(dest + i), block);
+    }
+#endif /* MVN_STRING_SIMD_SSE2 */
+
+    for (; i < length; i++) {
+        unsigned char character = (unsigned char)src[i];
+        bool          letter    = (unsigned char)(character - (unsigned char)first) < 26;
+        dest[i]                 = (char)(character ^ (letter ? 0x20 : 0x00));
+    }
+}
+
+/**
+ * \brief           Count the whitespace bytes at the start of a buffer
+ * \param[in]       data: Buffer to scan
+ * \param[in]       length: Buffer length in bytes
+ * \return          Number of leading whitespace bytes
+ */
+static size_t whitespace_prefix_length(const char *data, size_t length)
+{
+    size_t i = 0;
+
+#if defined(MVN_STRING_SIMD_SSE2) || defined(MVN_STRING_SIMD_NEON)
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        uint32_t other = ~simd_whitespace_mask(MVN_SIMD_LOAD(data + i)) & 0xFFFFu;
+        if (other != 0) {
+            return i + (size_t)lowest_set_bit(other);
+        }
+    }
+#endif /* MVN_STRING_SIMD_SSE2 || MVN_STRING_SIMD_NEON */
+
+    while (i < length && is_whitespace(data[i])) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * \brief           Count the whitespace bytes at the end of a buffer
+ * \param[in]       data: Buffer to scan
+ * \param[in]       length: Buffer length in bytes
+ * \return          Number of trailing whitespace bytes
+ */
+static size_t whitespace_suffix_length(const char *data, size_t length)
+{
+    size_t end = length;
+
+#if defined(MVN_STRING_SIMD_SSE2) || defined(MVN_STRING_SIMD_NEON)
+    for (; end >= MVN_STRING_SIMD_WIDTH; end -= MVN_STRING_SIMD_WIDTH) {
+        uint32_t other =
+            ~simd_whitespace_mask(MVN_SIMD_LOAD(data + end - MVN_STRING_SIMD_WIDTH)) & 0xFFFFu;
+        if (other != 0) {
+            size_t last = end - MVN_STRING_SIMD_WIDTH +
+                          (size_t)SDL_MostSignificantBitIndex32(other);
+            return length - (last + 1);
+        }
+    }
+#endif /* MVN_STRING_SIMD_SSE2 || MVN_STRING_SIMD_NEON */
+
+    while (end > 0 && is_whitespace(data[end - 1])) {
+        end--;
+    }
+    return length - end;
+}
+
+/**
+ * \brief           Count the bytes at the start of a buffer that are plain ASCII
+ * \param[in]       data: Buffer to scan
+ * \param[in]       length: Buffer length in bytes
+ * \return          Number of leading bytes below 0x80
+ */
+static size_t ascii_prefix_length(const char *data, size_t length)
+{
+    size_t i = 0;
+
+#if defined(MVN_STRING_SIMD_SSE2)
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        uint32_t high = (uint32_t)_mm_movemask_epi8(MVN_SIMD_LOAD(data + i));
+        if (high != 0) {
+            return i + (size_t)lowest_set_bit(high);
+        }
+    }
+#elif defined(MVN_STRING_SIMD_NEON)
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        uint8x16_t block = MVN_SIMD_LOAD(data + i);
+        if (vmaxvq_u8(block) >= 0x80) {
+            return i + (size_t)lowest_set_bit(simd_movemask(vcgeq_u8(block, vdupq_n_u8(0x80))));
+        }
+    }
+#endif /* MVN_STRING_SIMD_SSE2 */
+
+    while (i < length && (unsigned char)data[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * \brief           Validate one multi-byte UTF-8 sequence
+ * \param[in]       data: Pointer to the lead byte
+ * \param[in]       remaining: Bytes available from the lead byte onwards
+ * \return          Length of the sequence (2-4) or 0 if it is malformed
+ */
+static size_t utf8_sequence_length(const unsigned char *data, size_t remaining)
+{
+    unsigned char lead = data[0];
+    unsigned char min  = 0x80;
+    unsigned char max  = 0xBF;
+    size_t        length;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) {
+            min = 0xA0; /* Overlong encoding */
+        } else if (lead == 0xED) {
+            max = 0x9F; /* UTF-16 surrogate */
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) {
+            min = 0x90; /* Overlong encoding */
+        } else if (lead == 0xF4) {
+            max = 0x8F; /* Above U+10FFFF */
+        }
+    } else {
+        return 0;
+    }
+
+    if (remaining < length || data[1] < min || data[1] > max) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; i++) {
+        if ((data[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+/**
+ * \brief           Count UTF-8 lead bytes (everything that is not a continuation byte)
+ * \param[in]       data: Buffer to scan
+ * \param[in]       length: Buffer length in bytes
+ * \return          Number of codepoints, assuming well-formed input
+ */
+static size_t utf8_count_codepoints(const char *data, size_t length)
+{
+    size_t count = 0;
+    size_t i     = 0;
+
+#if defined(MVN_STRING_SIMD_SSE2)
+    /* Continuation bytes 0x80..0xBF are exactly the signed bytes below -64 */
+    const __m128i threshold = _mm_set1_epi8(-65);
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        __m128i lead = _mm_cmpgt_epi8(MVN_SIMD_LOAD(data + i), threshold);
+        count += count_set_bits((uint32_t)_mm_movemask_epi8(lead));
+    }
+#elif defined(MVN_STRING_SIMD_NEON)
+    const uint8x16_t mask         = vdupq_n_u8(0xC0);
+    const uint8x16_t continuation = vdupq_n_u8(0x80);
+    for (; i + MVN_STRING_SIMD_WIDTH <= length; i += MVN_STRING_SIMD_WIDTH) {
+        uint8x16_t block = vandq_u8(MVN_SIMD_LOAD(data + i), mask);
+        uint8x16_t lead  = vshrq_n_u8(vmvnq_u8(vceqq_u8(block, continuation)), 7);
+        count += vaddvq_u8(lead);
+    }
+#endif /* MVN_STRING_SIMD_SSE2 */
+
+    for (; i < length; i++) {
+        count += ((unsigned char)data[i] & 0xC0) != 0x80;
+    }
+    return count;
+}
+
 /**
  * \brief           Convert string to lowercase
+ * \note            Only ASCII letters are converted, multi-byte UTF-8 sequences are preserved
  * \param[in]       str: String to convert
  * \return          New string in lowercase or NULL on failure
  */
@@ -730,9 +1129,7 @@ mvn_string_t *mvn_string_to_lowercase(const mvn_string_t *str)
         return NULL;
     }
 
-    for (size_t i = 0; i < str->length; i++) {
-        result->data[i] = (char)SDL_tolower((unsigned char)str->data[i]);
-    }
+    ascii_convert_case(result->data, str->data, str->length, false);
 
     result->data[str->length] = '\0';
     result->length            = str->length;
@@ -742,6 +1139,7 @@ mvn_string_t *mvn_string_to_lowercase(const mvn_string_t *str)
 
 /**
  * \brief           Convert string to uppercase
+ * \note            Only ASCII letters are converted, multi-byte UTF-8 sequences are preserved
  * \param[in]       str: String to convert
  * \return          New string in uppercase or NULL on failure
  */
@@ -757,9 +1155,7 @@ mvn_string_t *mvn_string_to_uppercase(const mvn_string_t *str)
         return NULL;
     }
 
-    for (size_t i = 0; i < str->length; i++) {
-        result->data[i] = (char)SDL_toupper((unsigned char)str->data[i]);
-    }
+    ascii_convert_case(result->data, str->data, str->length, true);
 
     result->data[str->length] = '\0';
     result->length            = str->length;
@@ -768,14 +1164,37 @@ mvn_string_t *mvn_string_to_uppercase(const mvn_string_t *str)
 }
 
 /**
- * \brief           Check if a character is whitespace
- * \param[in]       character: Character to check
- * \return          true if character is whitespace, false otherwise
+ * \brief           Convert string to lowercase without allocating
+ * \param[in,out]   str: String to convert
+ * \return          true on success, false on failure
  */
-static bool is_whitespace(char character)
+bool mvn_string_to_lowercase_inplace(mvn_string_t *str)
 {
-    return character == ' ' || character == '\t' || character == '\n' || character == '\r' ||
-           character == '\f' || character == '\v';
+    if (str == NULL) {
+        mvn_set_error("Cannot convert NULL string to lowercase");
+        return false;
+    }
+
+    ascii_convert_case(str->data, str->data, str->length, false);
+    str->hash_valid = false;
+    return true;
+}
+
+/**
+ * \brief           Convert string to uppercase without allocating
+ * \param[in,out]   str: String to convert
+ * \return          true on success, false on failure
+ */
+bool mvn_string_to_uppercase_inplace(mvn_string_t *str)
+{
+    if (str == NULL) {
+        mvn_set_error("Cannot convert NULL string to uppercase");
+        return false;
+    }
+
+    ascii_convert_case(str->data, str->data, str->length, true);
+    str->hash_valid = false;
+    return true;
 }
 
 /**
@@ -790,34 +1209,15 @@ mvn_string_t *mvn_string_trim(const mvn_string_t *str)
         return NULL;
     }
 
-    if (!str) {
-        return NULL;
-    }
-
-    if (str->length == 0) {
-        return mvn_string_init(0);
-    }
-
-    /* Find start position (first non-whitespace) */
-    size_t start = 0;
-    while (start < str->length && is_whitespace(str->data[start])) {
-        start++;
-    }
-
-    /* Find end position (last non-whitespace) */
-    size_t end = str->length - 1;
-    while (end > start && is_whitespace(str->data[end])) {
-        end--;
-    }
-
-    /* If the whole string is whitespace */
-    if (start > end) {
+    size_t start = whitespace_prefix_length(str->data, str->length);
+    if (start == str->length) {
         return mvn_string_init(0);
     }
 
     /* Create result with trimmed substring */
-    size_t        result_len = end - start + 1;
-    mvn_string_t *result     = mvn_string_init(result_len + 1);
+    size_t result_len = str->length - start -
+                        whitespace_suffix_length(str->data + start, str->length - start);
+    mvn_string_t *result = mvn_string_init(result_len + 1);
     if (!result) {
         return NULL;
     }
@@ -841,27 +1241,13 @@ mvn_string_t *mvn_string_trim_end(const mvn_string_t *str)
         return NULL;
     }
 
-    if (!str) {
-        return NULL;
-    }
-
-    if (str->length == 0) {
-        return mvn_string_init(0);
-    }
-
-    /* Find end position (last non-whitespace) */
-    size_t end = str->length - 1;
-    while (end > 0 && is_whitespace(str->data[end])) {
-        end--;
-    }
-
-    if (end == 0 && is_whitespace(str->data[0])) {
+    size_t result_len = str->length - whitespace_suffix_length(str->data, str->length);
+    if (result_len == 0) {
         return mvn_string_init(0);
     }
 
     /* Create result with trimmed substring */
-    size_t        result_len = end + 1;
-    mvn_string_t *result     = mvn_string_init(result_len + 1);
+    mvn_string_t *result = mvn_string_init(result_len + 1);
     if (!result) {
         return NULL;
     }
@@ -885,20 +1271,7 @@ mvn_string_t *mvn_string_trim_start(const mvn_string_t *str)
         return NULL;
     }
 
-    if (!str) {
-        return NULL;
-    }
-
-    if (str->length == 0) {
-        return mvn_string_init(0);
-    }
-
-    /* Find start position (first non-whitespace) */
-    size_t start = 0;
-    while (start < str->length && is_whitespace(str->data[start])) {
-        start++;
-    }
-
+    size_t start = whitespace_prefix_length(str->data, str->length);
     if (start == str->length) {
         return mvn_string_init(0);
     }
@@ -917,6 +1290,81 @@ mvn_string_t *mvn_string_trim_start(const mvn_string_t *str)
     return result;
 }
 
+/**
+ * \brief           Trim whitespace from both ends of the string without allocating
+ * \param[in,out]   str: String to trim
+ * \return          true on success, false on failure
+ */
+bool mvn_string_trim_inplace(mvn_string_t *str)
+{
+    if (str == NULL) {
+        mvn_set_error("Cannot trim NULL string");
+        return false;
+    }
+
+    size_t start      = whitespace_prefix_length(str->data, str->length);
+    size_t result_len = str->length - start;
+    result_len -= whitespace_suffix_length(str->data + start, result_len);
+
+    if (start > 0) {
+        SDL_memmove(str->data, str->data + start, result_len);
+    }
+    str->data[result_len] = '\0';
+    str->length           = result_len;
+    str->hash_valid       = false;
+
+    return true;
+}
+
+/**
+ * \brief           Check whether a string holds well-formed UTF-8
+ * \note            Rejects overlong encodings, UTF-16 surrogates and codepoints above U+10FFFF
+ * \param[in]       str: String to validate
+ * \return          true if the string is valid UTF-8, false otherwise
+ */
+bool mvn_string_is_valid_utf8(const mvn_string_t *str)
+{
+    if (str == NULL) {
+        mvn_set_error("Cannot validate NULL string");
+        return false;
+    }
+
+    const unsigned char *data = (const unsigned char *)str->data;
+    size_t               i    = 0;
+
+    while (i < str->length) {
+        /* Skip ASCII runs a block at a time, only multi-byte sequences take the slow path */
+        i += ascii_prefix_length(str->data + i, str->length - i);
+        if (i == str->length) {
+            break;
+        }
+
+        size_t sequence = utf8_sequence_length(data + i, str->length - i);
+        if (sequence == 0) {
+            return false;
+        }
+        i += sequence;
+    }
+
+    return true;
+}
+
+/**
+ * \brief           Get the number of UTF-8 codepoints in a string
+ * \note            Input is not validated, use mvn_string_is_valid_utf8 first for untrusted data
+ * \param[in]       str: String to measure
+ * \return          Number of codepoints, 0 if str is NULL
+ */
+size_t mvn_string_utf8_length(const mvn_string_t *str)
+{
+    if (str == NULL) {
+        mvn_set_error("Cannot get UTF-8 length of NULL string");
+        return 0;
+    }
+
+    return utf8_count_codepoints(str->data, str->length);
+}
+
 /**
  * \brief           Extract a substring
  * \param[in]       str: String to get substring from
@@ -962,6 +1410,7 @@ mvn_string_t *mvn_string_substring(const mvn_string_t *str, size_t start, size_t
 
 /**
  * \brief           Compare two mvn_string_t strings for equality
+ * \note            Reads the cached hashes, so the threading rule of mvn_string_hash() applies
  * \param[in]       str1: First string to compare
  * \param[in]       str2: Second string to compare
  * \return          true if strings are equal, false otherwise
@@ -978,12 +1427,67 @@ bool mvn_string_compare(const mvn_string_t *str1, const mvn_string_t *str2)
         return false;
     }
 
+    /* Cached hashes reject most mismatches without touching the data */
+    if (str1->hash_valid && str2->hash_valid && str1->hash != str2->hash) {
+        return false;
+    }
     if (str1->length != str2->length) {
         return false;
     }
     return SDL_memcmp(str1->data, str2->data, str1->length) == 0;
 }
 
+/**
+ * \brief           Hash a byte range
+ * \note            Same function the hashmap uses for its keys, so a string hash can be reused
+ *                  for lookups. Uses the 64-bit FNV-1a algorithm.
+ * \param[in]       data: Bytes to hash
+ * \param[in]       length: Number of bytes
+ * \return          64-bit hash value
+ */
+uint64_t mvn_string_hash_bytes(const char *data, size_t length)
+{
+    /* FNV-1a hash parameters */
+    const uint64_t FNV_PRIME        = 1099511628211ULL;
+    const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief           Get the hash of a string, computing it on first use
+ * \note            The hash is cached in the string and invalidated by every mvn_string_*
+ *                  function that modifies it. Code writing to `data` directly must reset
+ *                  `hash_valid`. Filling the cache writes to the string, so this is not thread
+ *                  safe: hash a string shared between threads before sharing it, or protect it.
+ * \param[in]       str: String to hash
+ * \return          64-bit hash value, 0 if str is NULL
+ */
+uint64_t mvn_string_hash(const mvn_string_t *str)
+{
+    if (str == NULL) {
+        mvn_set_error("Cannot hash NULL string");
+        return 0;
+    }
+
+    if (!str->hash_valid) {
+        /* The hash is a cache rather than part of the value. Strings are only created by the
+         * constructors, on the heap or in an arena and never as const objects, so writing
+         * through the cast pointer is defined. */
+        mvn_string_t *cache = (mvn_string_t *)str;
+        cache->hash         = mvn_string_hash_bytes(str->data, str->length);
+        cache->hash_valid   = true;
+    }
+
+    return str->hash;
+}
+
 /**
  * \brief           Get the current capacity of the string
  * \param[in]       str: String to get capacity of
@@ -1014,6 +1518,390 @@ void mvn_string_clear(mvn_string_t *str)
         return;
     }
 
-    str->length  = 0;
-    str->data[0] = '\0';
+    str->length     = 0;
+    str->data[0]    = '\0';
+    str->hash_valid = false;
+}
+
+/**
+ * \brief           Create a new string builder
+ * \param[in]       arena: Arena owning the builder, NULL for the general allocator
+ * \param[in]       initial_capacity: Initial capacity for the buffer (0 for default)
+ * \return          Newly created string builder or NULL on failure
+ */
+static mvn_strbuf_t *mvn_strbuf_create(mvn_arena_t *arena, size_t initial_capacity)
+{
+    /* Use default capacity if not specified */
+    if (initial_capacity == 0) {
+        initial_capacity = MVN_STRBUF_DEFAULT_CAPACITY;
+    }
+
+    /* Allocate builder structure */
+    mvn_strbuf_t *buf = mvn_string_alloc(arena, sizeof(mvn_strbuf_t));
+    if (buf == NULL) {
+        mvn_set_error("Failed to allocate memory for string builder");
+        return NULL;
+    }
+
+    /* Allocate data array */
+    buf->data = mvn_string_alloc(arena, initial_capacity);
+    if (buf->data == NULL) {
+        if (arena == NULL) {
+            MVN_FREE(buf);
+        }
+        mvn_set_error("Failed to allocate memory for string builder data");
+        return NULL;
+    }
+
+    buf->data[0]  = '\0';
+    buf->length   = 0;
+    buf->capacity = initial_capacity;
+    buf->arena    = arena;
+
+    return buf;
+}
+
+/**
+ * \brief           Initialize a new string builder
+ * \param[in]       initial_capacity: Initial capacity for the buffer (0 for default)
+ * \return          Newly created string builder or NULL on failure
+ */
+mvn_strbuf_t *mvn_strbuf_init(size_t initial_capacity)
+{
+    return mvn_strbuf_create(NULL, initial_capacity);
+}
+
+/**
+ * \brief           Initialize a new string builder owned by an arena
+ * \note            Growth extends the buffer in place while it is the arena's last allocation.
+ *                  The builder and any string finished from it live until the arena is reset.
+ * \param[in]       arena: Arena to allocate from
+ * \param[in]       initial_capacity: Initial capacity for the buffer (0 for default)
+ * \return          Newly created string builder or NULL on failure
+ */
+mvn_strbuf_t *mvn_strbuf_init_arena(mvn_arena_t *arena, size_t initial_capacity)
+{
+    if (arena == NULL) {
+        mvn_set_error("Cannot create string builder in NULL arena");
+        return NULL;
+    }
+    return mvn_strbuf_create(arena, initial_capacity);
+}
+
+/**
+ * \brief           Free a string builder and all its resources
+ * \param[in]       buf: String builder to free
+ */
+void mvn_strbuf_free(mvn_strbuf_t *buf)
+{
+    if (buf == NULL) {
+        return;
+    }
+
+    /* Arena builders are released together with their arena */
+    if (buf->arena != NULL) {
+        return;
+    }
+
+    if (buf->data != NULL) {
+        MVN_FREE(buf->data);
+    }
+
+    MVN_FREE(buf);
+}
+
+/**
+ * \brief           Grow the builder buffer geometrically to hold at least needed_capacity bytes
+ * \param[in]       buf: String builder to grow
+ * \param[in]       needed_capacity: Minimum required capacity (including null terminator)
+ * \return          true on success, false on failure
+ */
+static bool mvn_strbuf_grow(mvn_strbuf_t *buf, size_t needed_capacity)
+{
+    if (needed_capacity <= buf->capacity) {
+        return true;
+    }
+
+    size_t new_capacity = buf->capacity > 0 ? buf->capacity : MVN_STRBUF_DEFAULT_CAPACITY;
+    while (new_capacity < needed_capacity) {
+        /* Fall back to the exact size if doubling would overflow */
+        if (new_capacity > SIZE_MAX / MVN_STRING_GROWTH_FACTOR) {
+            new_capacity = needed_capacity;
+            break;
+        }
+        new_capacity *= MVN_STRING_GROWTH_FACTOR;
+    }
+
+    char *new_data = buf->arena != NULL
+                         ? mvn_arena_realloc(buf->arena, buf->data, buf->capacity, new_capacity)
+                         : MVN_REALLOC(buf->data, new_capacity);
+    if (new_data == NULL) {
+        return mvn_set_error("Failed to grow string builder to capacity %zu", new_capacity);
+    }
+
+    buf->data     = new_data;
+    buf->capacity = new_capacity;
+    return true;
+}
+
+/**
+ * \brief           Reserve capacity for future appends
+ * \param[in]       buf: String builder to reserve capacity for
+ * \param[in]       capacity: Desired minimum number of characters (excluding null terminator)
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_reserve(mvn_strbuf_t *buf, size_t capacity)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot reserve capacity for NULL string builder");
+        return false;
+    }
+
+    if (capacity == SIZE_MAX) {
+        return mvn_set_error("Integer overflow detected when reserving string builder capacity");
+    }
+
+    return mvn_strbuf_grow(buf, capacity + 1);
+}
+
+/**
+ * \brief           Reset the builder to an empty string without releasing its buffer
+ * \param[in]       buf: String builder to reset
+ */
+void mvn_strbuf_reset(mvn_strbuf_t *buf)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot reset NULL string builder");
+        return;
+    }
+
+    buf->length = 0;
+    if (buf->data != NULL) {
+        buf->data[0] = '\0';
+    }
+}
+
+/**
+ * \brief           Append a number of bytes to the builder
+ * \param[in,out]   buf: String builder to append to
+ * \param[in]       data: Bytes to append (does not need to be null terminated)
+ * \param[in]       length: Number of bytes to append
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_append_n(mvn_strbuf_t *buf, const char *data, size_t length)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot append to NULL string builder");
+        return false;
+    }
+
+    if (data == NULL) {
+        mvn_set_error("Cannot append NULL data to string builder");
+        return false;
+    }
+
+    if (length == 0) {
+        return true; /* Nothing to append */
+    }
+
+    if (length > SIZE_MAX - buf->length - 1) {
+        return mvn_set_error("Integer overflow detected when appending to string builder");
+    }
+
+    if (!mvn_strbuf_grow(buf, buf->length + length + 1)) {
+        return false;
+    }
+
+    SDL_memcpy(buf->data + buf->length, data, length);
+    buf->length += length;
+    buf->data[buf->length] = '\0';
+
+    return true;
+}
+
+/**
+ * \brief           Append a C string to the builder
+ * \param[in,out]   buf: String builder to append to
+ * \param[in]       cstr: C string to append
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_append(mvn_strbuf_t *buf, const char *cstr)
+{
+    if (cstr == NULL) {
+        mvn_set_error("Cannot append NULL C string to string builder");
+        return false;
+    }
+
+    return mvn_strbuf_append_n(buf, cstr, SDL_strlen(cstr));
+}
+
+/**
+ * \brief           Append a single character to the builder
+ * \param[in,out]   buf: String builder to append to
+ * \param[in]       character: Character to append
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_append_char(mvn_strbuf_t *buf, char character)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot append to NULL string builder");
+        return false;
+    }
+
+    if (!mvn_strbuf_grow(buf, buf->length + 2)) {
+        return false;
+    }
+
+    buf->data[buf->length++] = character;
+    buf->data[buf->length]   = '\0';
+
+    return true;
+}
+
+/**
+ * \brief           Append the contents of a mvn_string_t to the builder
+ * \param[in,out]   buf: String builder to append to
+ * \param[in]       str: String to append
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_append_string(mvn_strbuf_t *buf, const mvn_string_t *str)
+{
+    if (str == NULL) {
+        mvn_set_error("Cannot append NULL string to string builder");
+        return false;
+    }
+
+    return mvn_strbuf_append_n(buf, str->data, str->length);
+}
+
+/**
+ * \brief           Append formatted text to the builder (va_list version)
+ * \param[in,out]   buf: String builder to append to
+ * \param[in]       fmt: printf-style format string
+ * \param[in]       args: Arguments for the format string
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_appendfv(mvn_strbuf_t *buf, const char *fmt, va_list args)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot append to NULL string builder");
+        return false;
+    }
+
+    if (fmt == NULL) {
+        mvn_set_error("Cannot append with NULL format string");
+        return false;
+    }
+
+    /* Make sure there is some room so the first pass usually succeeds in place */
+    size_t available = buf->capacity - buf->length;
+    if (available < MVN_STRBUF_FORMAT_RESERVE) {
+        if (!mvn_strbuf_grow(buf, buf->length + MVN_STRBUF_FORMAT_RESERVE)) {
+            return false;
+        }
+        available = buf->capacity - buf->length;
+    }
+
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int written = SDL_vsnprintf(buf->data + buf->length, available, fmt, args_copy);
+    va_end(args_copy);
+
+    if (written < 0) {
+        buf->data[buf->length] = '\0';
+        return mvn_set_error("Failed to format string builder text");
+    }
+
+    /* Output was truncated: grow to the exact size and format again */
+    if ((size_t)written >= available) {
+        if (!mvn_strbuf_grow(buf, buf->length + (size_t)written + 1)) {
+            buf->data[buf->length] = '\0';
+            return false;
+        }
+
+        va_copy(args_copy, args);
+        SDL_vsnprintf(buf->data + buf->length, (size_t)written + 1, fmt, args_copy);
+        va_end(args_copy);
+    }
+
+    buf->length += (size_t)written;
+    return true;
+}
+
+/**
+ * \brief           Append formatted text to the builder
+ * \param[in,out]   buf: String builder to append to
+ * \param[in]       fmt: printf-style format string
+ * \param[in]       ...: Arguments for the format string
+ * \return          true on success, false on failure
+ */
+bool mvn_strbuf_appendf(mvn_strbuf_t *buf, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    bool result = mvn_strbuf_appendfv(buf, fmt, args);
+    va_end(args);
+
+    return result;
+}
+
+/**
+ * \brief           Get the current length of the builder contents
+ * \param[in]       buf: String builder to query
+ * \return          Length of the contents, 0 if buf is NULL
+ */
+size_t mvn_strbuf_length(const mvn_strbuf_t *buf)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot get length of NULL string builder");
+        return 0;
+    }
+    return buf->length;
+}
+
+/**
+ * \brief           Get the builder contents as a C string
+ * \param[in]       buf: String builder to read
+ * \return          Null terminated contents, empty string if buf is NULL
+ * \note            The pointer is invalidated by the next append or free
+ */
+const char *mvn_strbuf_to_cstr(const mvn_strbuf_t *buf)
+{
+    if (buf == NULL || buf->data == NULL) {
+        return EMPTY_STRING;
+    }
+    return buf->data;
+}
+
+/**
+ * \brief           Finish the builder and transfer its buffer into a new string
+ * \param[in]       buf: String builder to finish, freed by this call
+ * \return          New string owning the builder buffer or NULL on failure
+ * \note            The buffer is handed over without copying. On failure the builder is left
+ *                  untouched and must still be freed by the caller.
+ */
+mvn_string_t *mvn_strbuf_finish(mvn_strbuf_t *buf)
+{
+    if (buf == NULL) {
+        mvn_set_error("Cannot finish NULL string builder");
+        return NULL;
+    }
+
+    mvn_string_t *str = mvn_string_alloc(buf->arena, sizeof(mvn_string_t));
+    if (str == NULL) {
+        mvn_set_error("Failed to allocate memory for string");
+        return NULL;
+    }
+
+    str->data       = buf->data;
+    str->length     = buf->length;
+    str->capacity   = buf->capacity;
+    str->hash       = 0;
+    str->hash_valid = false;
+    str->arena      = buf->arena;
+
+    if (buf->arena == NULL) {
+        MVN_FREE(buf);
+    }
+    return str;
 }
@@ -33,18 +33,90 @@
 
 #include "mvn/mvn-text.h"
 
+#include "mvn/mvn-alloc.h"
 #include "mvn/mvn-core.h"
+#include "mvn/mvn-file.h"
 #include "mvn/mvn-logger.h"
+#include "mvn/mvn-profile.h"
 #include "mvn/mvn-types.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
+/* Property of a font holding the size of its file, for memory tracking */
+#define MVN_FONT_FILE_SIZE_PROPERTY "mvn.font.file_size"
+
 /* Private variables */
 static int32_t mvn_line_spacing = 0;
 
+/* Serializes opening and closing fonts, which share one FreeType library between threads */
+static void *mvn_font_lock = NULL;
+
+/**
+ * \brief           Create the font lock on first use
+ * \note            Threads that race to create it keep the first one
+ * \return          true when the lock exists, false on failure
+ */
+static bool ensure_font_lock(void)
+{
+    if (SDL_GetAtomicPointer(&mvn_font_lock) != NULL) {
+        return true;
+    }
+
+    SDL_Mutex *lock = SDL_CreateMutex();
+    if (lock == NULL) {
+        mvn_log_error("Failed to create font lock: %s", SDL_GetError());
+        return false;
+    }
+    if (!SDL_CompareAndSwapAtomicPointer(&mvn_font_lock, NULL, lock)) {
+        SDL_DestroyMutex(lock);
+    }
+    return true;
+}
+
+/**
+ * \brief           Start SDL_ttf if mvn_init() deferred it
+ * \return          true when SDL_ttf is running, false on failure
+ */
+static bool ensure_ttf_init(void)
+{
+    if (!TTF_WasInit() && !TTF_Init()) {
+        mvn_log_error("Failed to initialize SDL_ttf: %s", SDL_GetError());
+        return false;
+    }
+    return ensure_font_lock();
+}
+
+/**
+ * \brief           Open a font and account for the file it reads from
+ * \param[in]       path: Path to the font file
+ * \param[in]       size: Size of the font in points
+ * \return          Font handle on success, NULL on failure
+ */
+static TTF_Font *open_font(const char *path, float size)
+{
+    // The font reads from a view of the file for as long as it is open
+    SDL_IOStream *stream = mvn_file_open_io(path);
+    if (stream == NULL) {
+        return NULL;
+    }
+
+    int64_t file_size = SDL_GetIOSize(stream);
+    SDL_LockMutex(SDL_GetAtomicPointer(&mvn_font_lock));
+    TTF_Font *font = TTF_OpenFontIO(stream, true, size);
+    SDL_UnlockMutex(SDL_GetAtomicPointer(&mvn_font_lock));
+
+    // The view stays mapped while the font is open, glyph caches are owned by SDL_ttf
+    if (font != NULL && file_size > 0) {
+        SDL_SetNumberProperty(TTF_GetFontProperties(font), MVN_FONT_FILE_SIZE_PROPERTY, file_size);
+        mvn_alloc_track(MVN_ALLOC_TAG_TEXT, (size_t)file_size);
+    }
+    return font;
+}
+
 /**
  * \brief           Load a font from the assets directory
+ * \note            Safe to call from worker threads once SDL_ttf was started
  * \param[in]       fileName: Name of the font file
  * \param[in]       size: Size of the font in points
  * \return          Font handle on success, NULL on failure
@@ -54,15 +126,22 @@ TTF_Font *mvn_load_font(const char *fileName, float size)
     char      path[512];
     TTF_Font *font = NULL;
 
+    if (!ensure_ttf_init()) {
+        return NULL;
+    }
+
     // Construct path to the font file
     SDL_snprintf(path, sizeof(path), "%s", fileName);
 
     // Load font with the specified size
-    font = TTF_OpenFont(path, size);
+    MVN_PROFILE_ZONE("mvn_load_font")
+    {
+        font = open_font(path, size);
+    }
     if (font == NULL) {
         mvn_log_error("Failed to load font: %s - %s", path, SDL_GetError());
+        return NULL;
     }
-
     return font;
 }
 
@@ -80,11 +159,18 @@ mvn_load_font_ex(const char *fileName, float size, const int *codePoints, int co
     char      path[512];
     TTF_Font *font = NULL;
 
+    if (!ensure_ttf_init()) {
+        return NULL;
+    }
+
     // Construct path to the font file
     SDL_snprintf(path, sizeof(path), "%s", fileName);
 
     // Load font with the specified size
-    font = TTF_OpenFont(path, size);
+    MVN_PROFILE_ZONE("mvn_load_font_ex")
+    {
+        font = open_font(path, size);
+    }
     if (font == NULL) {
         mvn_log_error("Failed to load font: %s - %s", path, SDL_GetError());
         return NULL;
@@ -99,7 +185,6 @@ mvn_load_font_ex(const char *fileName, float size, const int *codePoints, int co
             }
         }
     }
-
     return font;
 }
 
@@ -110,7 +195,14 @@ mvn_load_font_ex(const char *fileName, float size, const int *codePoints, int co
 void mvn_unload_font(TTF_Font *font)
 {
     if (font != NULL) {
+        int64_t file_size =
+            SDL_GetNumberProperty(TTF_GetFontProperties(font), MVN_FONT_FILE_SIZE_PROPERTY, 0);
+        if (file_size > 0) {
+            mvn_alloc_untrack(MVN_ALLOC_TAG_TEXT, (size_t)file_size);
+        }
+        SDL_LockMutex(SDL_GetAtomicPointer(&mvn_font_lock));
         TTF_CloseFont(font);
+        SDL_UnlockMutex(SDL_GetAtomicPointer(&mvn_font_lock));
     }
 }
 
@@ -180,10 +272,13 @@ void mvn_draw_text(TTF_Font *font, const char *text, mvn_fpoint_t position, mvn_
         return;
     }
 
+    MVN_PROFILE_BEGIN("mvn_draw_text");
+
     /* Create text object */
     text_obj = TTF_CreateText(text_engine, font, text, 0);
     if (text_obj == NULL) {
         mvn_log_error("Failed to create text: %s", SDL_GetError());
+        MVN_PROFILE_END();
         return;
     }
 
@@ -201,6 +296,7 @@ void mvn_draw_text(TTF_Font *font, const char *text, mvn_fpoint_t position, mvn_
 
     /* Clean up */
     TTF_DestroyText(text_obj);
+    MVN_PROFILE_END();
 }
 
 /**
@@ -236,10 +332,13 @@ void mvn_draw_text_pro(TTF_Font    *font,
         return;
     }
 
+    MVN_PROFILE_BEGIN("mvn_draw_text_pro");
+
     /* Render text to surface */
     surface = TTF_RenderText_Blended(font, text, 0, tint);
     if (surface == NULL) {
         mvn_log_error("Failed to render text: %s", SDL_GetError());
+        MVN_PROFILE_END();
         return;
     }
 
@@ -249,6 +348,7 @@ void mvn_draw_text_pro(TTF_Font    *font,
 
     if (texture == NULL) {
         mvn_log_error("Failed to create texture from text: %s", SDL_GetError());
+        MVN_PROFILE_END();
         return;
     }
 
@@ -270,4 +370,5 @@ void mvn_draw_text_pro(TTF_Font    *font,
 
     /* Clean up */
     SDL_DestroyTexture(texture);
+    MVN_PROFILE_END();
 }
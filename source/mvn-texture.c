@@ -33,11 +33,24 @@
 
 #include "mvn/mvn-texture.h"
 
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-file.h"
 #include "mvn/mvn-logger.h"
+#include "mvn/mvn-profile.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 
+/**
+ * \brief           Estimate the memory owned by a texture
+ * \param[in]       texture: Texture to measure
+ * \return          Size of the texture's pixel data in bytes
+ */
+static size_t texture_size(const mvn_texture_t *texture)
+{
+    return (size_t)texture->w * (size_t)texture->h * SDL_BYTESPERPIXEL(texture->format);
+}
+
 /**
  * \brief           Load an image from the assets directory
  * \param[in]       filename: Name of the image file in assets/images/ directory
@@ -51,13 +64,55 @@ mvn_image_t *mvn_load_image(const char *filename)
     // Construct path to the asset file
     SDL_snprintf(path, sizeof(path), "%s", filename);
 
-    // Load image directly using SDL_image
-    surface = IMG_Load(path);
+    // Decode from a view of the file, the extension helps formats without a signature
+    MVN_PROFILE_ZONE("mvn_load_image")
+    {
+        SDL_IOStream *stream    = mvn_file_open_io(path);
+        const char   *extension = SDL_strrchr(path, '.');
+        if (stream != NULL) {
+            surface = IMG_LoadTyped_IO(stream, true, extension != NULL ? extension + 1 : NULL);
+        }
+    }
 
     if (!surface) {
         mvn_log_error("Failed to load image: %s - %s", path, SDL_GetError());
+        return NULL;
+    }
+
+    mvn_alloc_track(MVN_ALLOC_TAG_TEXTURE, (size_t)surface->h * (size_t)surface->pitch);
+    return surface;
+}
+
+/**
+ * \brief           Decode an image from file contents in memory
+ * \param[in]       fileType: Extension of the file such as ".png", helps formats without a
+ *                  signature, may be NULL
+ * \param[in]       data: Contents of the image file
+ * \param[in]       size: Size of the contents in bytes
+ * \return          Decoded image surface, NULL on failure
+ */
+mvn_image_t *mvn_load_image_from_memory(const char *fileType, const void *data, size_t size)
+{
+    mvn_image_t *surface = NULL;
+
+    if (fileType != NULL && fileType[0] == '.') {
+        fileType++;
+    }
+
+    MVN_PROFILE_ZONE("mvn_load_image_from_memory")
+    {
+        SDL_IOStream *stream = SDL_IOFromConstMem(data, size);
+        if (stream != NULL) {
+            surface = IMG_LoadTyped_IO(stream, true, fileType);
+        }
     }
 
+    if (!surface) {
+        mvn_log_error("Failed to decode image from memory - %s", SDL_GetError());
+        return NULL;
+    }
+
+    mvn_alloc_track(MVN_ALLOC_TAG_TEXTURE, (size_t)surface->h * (size_t)surface->pitch);
     return surface;
 }
 
@@ -68,10 +123,44 @@ mvn_image_t *mvn_load_image(const char *filename)
 void mvn_unload_image(mvn_image_t *surface)
 {
     if (surface != NULL) {
+        mvn_alloc_untrack(MVN_ALLOC_TAG_TEXTURE, (size_t)surface->h * (size_t)surface->pitch);
         SDL_DestroySurface(surface);
     }
 }
 
+/**
+ * \brief           Read back the current contents of the render target
+ * \note            Call after drawing and before mvn_end_drawing(), since the back buffer of
+ *                  hardware renderers is undefined after presenting. Works in any mode and is
+ *                  how frames are captured after mvn_init_headless().
+ * \param[in]       renderer: Renderer to read from
+ * \return          RGBA32 image of the frame, NULL on failure. Free with mvn_unload_image()
+ */
+mvn_image_t *mvn_load_image_from_screen(mvn_renderer_t *renderer)
+{
+    if (renderer == NULL) {
+        mvn_log_error("Invalid renderer for screen readback");
+        return NULL;
+    }
+
+    mvn_image_t *pixels = SDL_RenderReadPixels(renderer, NULL);
+    if (pixels == NULL) {
+        mvn_log_error("Failed to read back frame: %s", SDL_GetError());
+        return NULL;
+    }
+
+    // Normalize the renderer's native format so callers can index pixels directly
+    mvn_image_t *image = SDL_ConvertSurface(pixels, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(pixels);
+    if (image == NULL) {
+        mvn_log_error("Failed to convert frame: %s", SDL_GetError());
+        return NULL;
+    }
+
+    mvn_alloc_track(MVN_ALLOC_TAG_TEXTURE, (size_t)image->h * (size_t)image->pitch);
+    return image;
+}
+
 /**
  * \brief           Convert mvn_image_t to mvn_texture_t
  * \param[in]       renderer: SDL renderer to create texture with
@@ -89,12 +178,16 @@ mvn_texture_t *mvn_image_to_texture(mvn_renderer_t *renderer, mvn_image_t *surfa
     }
 
     // Create texture from the surface
-    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    MVN_PROFILE_ZONE("mvn_image_to_texture")
+    {
+        texture = SDL_CreateTextureFromSurface(renderer, surface);
+    }
     if (!texture) {
         mvn_log_error("Failed to create texture from surface: %s", SDL_GetError());
         return NULL;
     }
 
+    mvn_alloc_track(MVN_ALLOC_TAG_TEXTURE, texture_size(texture));
     return texture;
 }
 
@@ -135,6 +228,54 @@ mvn_texture_t *mvn_load_texture(mvn_renderer_t *renderer, const char *filename)
     return texture;
 }
 
+/**
+ * \brief           Replace the pixels of a texture with an image file
+ * \note            The texture keeps its identity, so every holder of the pointer draws the new
+ *                  pixels. The image must have the size of the texture.
+ * \param[in]       texture: Texture to update
+ * \param[in]       filename: Name of the image file to load
+ * \return          true on success, false on failure
+ */
+bool mvn_reload_texture(mvn_texture_t *texture, const char *filename)
+{
+    if (texture == NULL) {
+        mvn_log_error("Cannot reload a NULL texture");
+        return false;
+    }
+
+    mvn_image_t *surface = mvn_load_image(filename);
+    if (!surface) {
+        // Error already logged in mvn_load_image
+        return false;
+    }
+
+    if (surface->w != texture->w || surface->h != texture->h) {
+        mvn_log_error("Cannot reload %s in place: size changed from %dx%d to %dx%d",
+                      filename,
+                      texture->w,
+                      texture->h,
+                      surface->w,
+                      surface->h);
+        mvn_unload_image(surface);
+        return false;
+    }
+
+    // Match the pixel format the texture was created with
+    mvn_image_t *converted = SDL_ConvertSurface(surface, texture->format);
+    mvn_unload_image(surface);
+    if (!converted) {
+        mvn_log_error("Failed to convert image: %s - %s", filename, SDL_GetError());
+        return false;
+    }
+
+    bool updated = SDL_UpdateTexture(texture, NULL, converted->pixels, converted->pitch);
+    SDL_DestroySurface(converted);
+    if (!updated) {
+        mvn_log_error("Failed to update texture: %s - %s", filename, SDL_GetError());
+    }
+    return updated;
+}
+
 /**
  * \brief           Unload a texture
  * \param[in]       texture: Texture to be unloaded
@@ -142,6 +283,7 @@ mvn_texture_t *mvn_load_texture(mvn_renderer_t *renderer, const char *filename)
 void mvn_unload_texture(mvn_texture_t *texture)
 {
     if (texture != NULL) {
+        mvn_alloc_untrack(MVN_ALLOC_TAG_TEXTURE, texture_size(texture));
         SDL_DestroyTexture(texture);
     }
 }
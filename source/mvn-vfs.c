@@ -0,0 +1,1130 @@
+/**
+ * \file            mvn-vfs.c
+ * \brief           Packed asset archives and virtual file system for MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_FILE
+
+#include "mvn/mvn-vfs.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-file.h"
+#include "mvn/mvn-list.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-string.h"
+#include "mvn/mvn-utils.h"
+
+#include <SDL3/SDL.h>
+
+/*
+ * Archive layout, all integers little endian:
+ *
+ * header   "MVNPAK", u16 version, u32 entry count, u32 alignment, u64 table offset,
+ *          u64 names offset
+ * payloads file contents, each aligned to the alignment of the header
+ * table    one entry per file, sorted by path hash and then by path: u64 hash, u64 offset,
+ *          u64 stored size, u64 size, u32 name offset, u16 name length, u16 compression. The
+ *          hash is mvn_string_hash_bytes() of the path.
+ * names    paths relative to the packed directory, '/' separated and not terminated
+ */
+
+/* Size of the archive header */
+#define PAK_HEADER_SIZE 32
+
+/* Size of an entry of the table of contents */
+#define PAK_ENTRY_SIZE 40
+
+/* Offsets of the fields of an entry */
+#define PAK_ENTRY_HASH        0
+#define PAK_ENTRY_OFFSET      8
+#define PAK_ENTRY_STORED_SIZE 16
+#define PAK_ENTRY_SIZE_FIELD  24
+#define PAK_ENTRY_NAME_OFFSET 32
+#define PAK_ENTRY_NAME_LENGTH 36
+#define PAK_ENTRY_COMPRESSION 38
+
+/* Number of LZ4 match finder slots, a power of two */
+#define LZ4_HASH_BITS 12
+
+/* Shortest LZ4 match */
+#define LZ4_MIN_MATCH 4
+
+/* LZ4 blocks end with at least this many literals */
+#define LZ4_LAST_LITERALS 5
+
+/* The last LZ4 match starts at least this far from the end of the block */
+#define LZ4_MATCH_LIMIT 12
+
+/**
+ * \brief           Mounted archive
+ */
+typedef struct mvn_vfs_archive_t {
+    mvn_file_view_t view;  /*!< Contents of the archive */
+    SDL_AtomicInt   refs;  /*!< The mount and every view into the archive */
+    const uint8_t  *table; /*!< First entry of the table of contents */
+    const char     *names; /*!< Paths of the entries */
+    uint32_t        count; /*!< Number of entries */
+} mvn_vfs_archive_t;
+
+/**
+ * \brief           Archive or directory mounted into the virtual file system
+ */
+typedef struct mvn_vfs_mount_t {
+    char               path[MVN_VFS_PATH_SIZE]; /*!< Path it was mounted with */
+    mvn_vfs_archive_t *archive;                 /*!< Archive, NULL for a directory */
+} mvn_vfs_mount_t;
+
+/**
+ * \brief           File collected by mvn_pak_build()
+ */
+typedef struct pak_file_t {
+    char    *name; /*!< Path relative to the packed directory */
+    uint64_t hash; /*!< Hash of name */
+} pak_file_t;
+
+/**
+ * \brief           State of a directory walk of mvn_pak_build()
+ */
+typedef struct pak_walk_t {
+    const char *root;   /*!< Directory being packed */
+    mvn_list_t *files;  /*!< Collected pak_file_t */
+    bool        failed; /*!< An error stopped the walk */
+} pak_walk_t;
+
+/* Mounts in the order they were made, later mounts take precedence */
+static mvn_vfs_mount_t g_mounts[MVN_VFS_MAX_MOUNTS];
+
+/* Number of mounts, read without the lock to skip resolving when nothing is mounted */
+static SDL_AtomicInt g_mount_count;
+
+/* Guards the mounts, created by the first mount */
+static SDL_RWLock *g_mount_lock = NULL;
+
+/**
+ * \brief           Read a little endian 16 bit integer
+ * \param[in]       data: Bytes to read
+ * \return          Value
+ */
+static uint16_t read_u16(const uint8_t *data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+/**
+ * \brief           Read a little endian 32 bit integer
+ * \param[in]       data: Bytes to read
+ * \return          Value
+ */
+static uint32_t read_u32(const uint8_t *data)
+{
+    return (uint32_t)read_u16(data) | ((uint32_t)read_u16(data + 2) << 16);
+}
+
+/**
+ * \brief           Read a little endian 64 bit integer
+ * \param[in]       data: Bytes to read
+ * \return          Value
+ */
+static uint64_t read_u64(const uint8_t *data)
+{
+    return (uint64_t)read_u32(data) | ((uint64_t)read_u32(data + 4) << 32);
+}
+
+/**
+ * \brief           Write a little endian integer
+ * \param[out]      data: Receives the bytes
+ * \param[in]       value: Value to write
+ * \param[in]       size: Number of bytes to write
+ */
+static void write_le(uint8_t *data, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        data[i] = (uint8_t)(value >> (i * 8));
+    }
+}
+
+/**
+ * \brief           Normalize a relative path the way archives store them
+ * \note            See mvn_normalize_path(). Absolute paths and paths that leave the mount are
+ *                  not looked up in mounts.
+ * \param[in]       path: Path to normalize
+ * \param[out]      out: Receives the normalized path
+ * \param[in]       size: Size of out
+ * \return          Length of the normalized path, 0 if it cannot be looked up
+ */
+static size_t normalize_path(const char *path, char *out, size_t size)
+{
+    if (path[0] == '/' || path[0] == '\\' || (path[0] != '\0' && path[1] == ':')) {
+        return 0;
+    }
+
+    size_t length = mvn_normalize_path(path, out, size);
+    if (length == 0 || (length == 1 && out[0] == '.') ||
+        (length >= 2 && out[0] == '.' && out[1] == '.' && (length == 2 || out[2] == '/'))) {
+        return 0;
+    }
+    return length;
+}
+
+/**
+ * \brief           Read an LZ4 length that continues in the following bytes
+ * \param[in,out]   cursor: Position in the input, advanced past the length
+ * \param[in]       end: End of the input
+ * \param[in,out]   length: Length read so far, receives the full length
+ * \return          true on success, false if the input ends
+ */
+static bool lz4_read_length(const uint8_t **cursor, const uint8_t *end, size_t *length)
+{
+    uint8_t byte;
+    do {
+        if (*cursor >= end) {
+            return false;
+        }
+        byte = *(*cursor)++;
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * \brief           Decompress an LZ4 block
+ * \param[in]       src: Compressed block
+ * \param[in]       src_size: Size of the block
+ * \param[out]      dst: Receives the data
+ * \param[in]       dst_size: Size of the decompressed data
+ * \return          true on success, false if the block is corrupt
+ */
+static bool lz4_decompress(const uint8_t *src, size_t src_size, uint8_t *dst, size_t dst_size)
+{
+    const uint8_t *cursor = src;
+    const uint8_t *end    = src + src_size;
+    size_t         out    = 0;
+
+    while (cursor < end) {
+        uint8_t token   = *cursor++;
+        size_t  literal = token >> 4;
+        if (literal == 15 && !lz4_read_length(&cursor, end, &literal)) {
+            return false;
+        }
+        if (literal > (size_t)(end - cursor) || literal > dst_size - out) {
+            return false;
+        }
+        SDL_memcpy(dst + out, cursor, literal);
+        cursor += literal;
+        out += literal;
+
+        // The last sequence has no match
+        if (cursor == end) {
+            break;
+        }
+
+        if (end - cursor < 2) {
+            return false;
+        }
+        size_t offset = read_u16(cursor);
+        size_t match  = token & 15;
+        cursor += 2;
+        if (offset == 0 || offset > out) {
+            return false;
+        }
+        if (match == 15 && !lz4_read_length(&cursor, end, &match)) {
+            return false;
+        }
+        match += LZ4_MIN_MATCH;
+        if (match > dst_size - out) {
+            return false;
+        }
+
+        // Matches may overlap the bytes they produce, so copy forward one byte at a time
+        for (size_t i = 0; i < match; i++) {
+            dst[out + i] = dst[out - offset + i];
+        }
+        out += match;
+    }
+
+    return out == dst_size;
+}
+
+/**
+ * \brief           Write an LZ4 length that does not fit in its token
+ * \param[out]      dst: Output buffer
+ * \param[in,out]   out: Bytes written to dst
+ * \param[in]       capacity: Size of dst
+ * \param[in]       length: Length minus the 15 stored in the token
+ * \return          true on success, false if dst is full
+ */
+static bool lz4_write_length(uint8_t *dst, size_t *out, size_t capacity, size_t length)
+{
+    size_t bytes = length / 255 + 1;
+    if (bytes > capacity - *out) {
+        return false;
+    }
+    for (; length >= 255; length -= 255) {
+        dst[(*out)++] = 255;
+    }
+    dst[(*out)++] = (uint8_t)length;
+    return true;
+}
+
+/**
+ * \brief           Write an LZ4 sequence
+ * \param[out]      dst: Output buffer
+ * \param[in,out]   out: Bytes written to dst
+ * \param[in]       capacity: Size of dst
+ * \param[in]       literals: Literal bytes
+ * \param[in]       literal: Number of literal bytes
+ * \param[in]       offset: Distance back to the match, 0 for the last sequence
+ * \param[in]       match: Length of the match
+ * \return          true on success, false if dst is full
+ */
+static bool lz4_write_sequence(uint8_t       *dst,
+                               size_t        *out,
+                               size_t         capacity,
+                               const uint8_t *literals,
+                               size_t         literal,
+                               size_t         offset,
+                               size_t         match)
+{
+    size_t match_code = offset != 0 ? match - LZ4_MIN_MATCH : 0;
+    if (*out >= capacity) {
+        return false;
+    }
+    dst[(*out)++] = (uint8_t)((SDL_min(literal, 15) << 4) | SDL_min(match_code, 15));
+    if (literal >= 15 && !lz4_write_length(dst, out, capacity, literal - 15)) {
+        return false;
+    }
+    if (literal > capacity - *out) {
+        return false;
+    }
+    SDL_memcpy(dst + *out, literals, literal);
+    *out += literal;
+
+    if (offset == 0) {
+        return true;
+    }
+    if (capacity - *out < 2) {
+        return false;
+    }
+    write_le(dst + *out, offset, 2);
+    *out += 2;
+    return match_code < 15 || lz4_write_length(dst, out, capacity, match_code - 15);
+}
+
+/**
+ * \brief           Compress data into an LZ4 block
+ * \note            Greedy single-probe match finder, fast rather than small
+ * \param[in]       src: Data to compress
+ * \param[in]       size: Size of the data
+ * \param[out]      dst: Receives the block
+ * \param[in]       capacity: Size of dst
+ * \return          Size of the block, 0 if it does not fit in dst
+ */
+static size_t lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity)
+{
+    uint32_t table[1 << LZ4_HASH_BITS] = { 0 }; // Position + 1 of the last 4 bytes with the hash
+    size_t   anchor                    = 0;
+    size_t   out                       = 0;
+
+    if (size > LZ4_MATCH_LIMIT && size <= UINT32_MAX) {
+        for (size_t position = 0; position < size - LZ4_MATCH_LIMIT;) {
+            uint32_t sequence = read_u32(src + position);
+            uint32_t slot     = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+            size_t   previous = table[slot];
+            table[slot]       = (uint32_t)position + 1;
+
+            if (previous == 0 || position - (previous - 1) > 65535 ||
+                read_u32(src + previous - 1) != sequence) {
+                position++;
+                continue;
+            }
+
+            size_t candidate = previous - 1;
+            size_t match     = LZ4_MIN_MATCH;
+            while (position + match < size - LZ4_LAST_LITERALS &&
+                   src[candidate + match] == src[position + match]) {
+                match++;
+            }
+
+            if (!lz4_write_sequence(dst,
+                                    &out,
+                                    capacity,
+                                    src + anchor,
+                                    position - anchor,
+                                    position - candidate,
+                                    match)) {
+                return 0;
+            }
+            position += match;
+            anchor = position;
+        }
+    }
+
+    if (!lz4_write_sequence(dst, &out, capacity, src + anchor, size - anchor, 0, 0)) {
+        return 0;
+    }
+    return out;
+}
+
+/**
+ * \brief           Compare two entries of a table of contents
+ * \param[in]       hash: Hash of the first path
+ * \param[in]       name: First path
+ * \param[in]       length: Length of the first path
+ * \param[in]       other_hash: Hash of the second path
+ * \param[in]       other_name: Second path
+ * \param[in]       other_length: Length of the second path
+ * \return          Negative, zero or positive like strcmp
+ */
+static int compare_entries(uint64_t    hash,
+                           const char *name,
+                           size_t      length,
+                           uint64_t    other_hash,
+                           const char *other_name,
+                           size_t      other_length)
+{
+    if (hash != other_hash) {
+        return hash < other_hash ? -1 : 1;
+    }
+    int order = SDL_memcmp(name, other_name, SDL_min(length, other_length));
+    if (order != 0) {
+        return order;
+    }
+    return length < other_length ? -1 : (length > other_length ? 1 : 0);
+}
+
+/**
+ * \brief           Find an entry of an archive
+ * \param[in]       archive: Archive to search
+ * \param[in]       name: Normalized path
+ * \param[in]       length: Length of name
+ * \param[in]       hash: Hash of name
+ * \return          Entry, NULL if the archive does not contain the path
+ */
+static const uint8_t *
+find_entry(const mvn_vfs_archive_t *archive, const char *name, size_t length, uint64_t hash)
+{
+    size_t low  = 0;
+    size_t high = archive->count;
+    while (low < high) {
+        size_t         middle       = low + (high - low) / 2;
+        const uint8_t *entry        = archive->table + middle * PAK_ENTRY_SIZE;
+        uint64_t       other_hash   = read_u64(entry + PAK_ENTRY_HASH);
+        const char    *other_name   = archive->names + read_u32(entry + PAK_ENTRY_NAME_OFFSET);
+        size_t         other_length = read_u16(entry + PAK_ENTRY_NAME_LENGTH);
+        int order = compare_entries(hash, name, length, other_hash, other_name, other_length);
+        if (order == 0) {
+            return entry;
+        }
+        if (order < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Drop a reference to an archive, closing it with the last one
+ * \param[in]       owner: Archive
+ */
+static void release_archive(void *owner)
+{
+    mvn_vfs_archive_t *archive = (mvn_vfs_archive_t *)owner;
+    if (SDL_AddAtomicInt(&archive->refs, -1) == 1) {
+        mvn_file_unmap(&archive->view);
+        MVN_FREE(archive);
+    }
+}
+
+/**
+ * \brief           Open an archive and check its table of contents
+ * \param[in]       path: Path of the archive
+ * \return          Archive with one reference, NULL on failure
+ */
+static mvn_vfs_archive_t *open_archive(const char *path)
+{
+    mvn_vfs_archive_t *archive = MVN_MALLOC(sizeof(mvn_vfs_archive_t));
+    if (archive == NULL) {
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate archive");
+        return NULL;
+    }
+    if (!mvn_file_map(path, &archive->view)) {
+        MVN_FREE(archive);
+        return NULL;
+    }
+
+    const uint8_t *data  = archive->view.data;
+    size_t         size  = archive->view.size;
+    bool           valid = size >= PAK_HEADER_SIZE && SDL_memcmp(data, "MVNPAK", 6) == 0;
+    if (!valid || read_u16(data + 6) != MVN_PAK_VERSION) {
+        mvn_file_unmap(&archive->view);
+        MVN_FREE(archive);
+        mvn_set_error_code(MVN_ERROR_UNSUPPORTED,
+                           "'%s' is not a version %d archive",
+                           path,
+                           MVN_PAK_VERSION);
+        return NULL;
+    }
+
+    uint64_t count        = read_u32(data + 8);
+    uint64_t table_offset = read_u64(data + 16);
+    uint64_t names_offset = read_u64(data + 24);
+    valid = table_offset >= PAK_HEADER_SIZE && table_offset <= size && names_offset <= size &&
+            count <= (names_offset - SDL_min(names_offset, table_offset)) / PAK_ENTRY_SIZE;
+
+    archive->table = data + table_offset;
+    archive->names = (const char *)data + names_offset;
+    archive->count = (uint32_t)count;
+
+    // Check every entry once so lookups can trust the table
+    const uint8_t *previous = NULL;
+    for (uint32_t i = 0; valid && i < archive->count; i++) {
+        const uint8_t *entry       = archive->table + (size_t)i * PAK_ENTRY_SIZE;
+        uint64_t       offset      = read_u64(entry + PAK_ENTRY_OFFSET);
+        uint64_t       stored      = read_u64(entry + PAK_ENTRY_STORED_SIZE);
+        uint64_t       name_offset = read_u32(entry + PAK_ENTRY_NAME_OFFSET);
+        uint16_t       length      = read_u16(entry + PAK_ENTRY_NAME_LENGTH);
+        uint16_t       compression = read_u16(entry + PAK_ENTRY_COMPRESSION);
+        const char    *name        = archive->names + name_offset;
+
+        valid = offset <= table_offset && stored <= table_offset - offset &&
+                name_offset + length <= size - names_offset &&
+                (compression == MVN_PAK_COMPRESSION_LZ4 ||
+                 (compression == MVN_PAK_COMPRESSION_NONE &&
+                  stored == read_u64(entry + PAK_ENTRY_SIZE_FIELD))) &&
+                read_u64(entry + PAK_ENTRY_HASH) == mvn_string_hash_bytes(name, length);
+        if (valid && previous != NULL) {
+            valid = compare_entries(read_u64(previous + PAK_ENTRY_HASH),
+                                    archive->names + read_u32(previous + PAK_ENTRY_NAME_OFFSET),
+                                    read_u16(previous + PAK_ENTRY_NAME_LENGTH),
+                                    read_u64(entry + PAK_ENTRY_HASH),
+                                    name,
+                                    length) < 0;
+        }
+        previous = entry;
+    }
+
+    if (!valid) {
+        mvn_file_unmap(&archive->view);
+        MVN_FREE(archive);
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Archive '%s' is corrupt", path);
+        return NULL;
+    }
+
+    SDL_SetAtomicInt(&archive->refs, 1);
+    return archive;
+}
+
+/**
+ * \brief           Collect the files of a directory for mvn_pak_build()
+ * \param[in]       user_data: Walk state (pak_walk_t)
+ * \param[in]       dirname: Directory being enumerated, with a trailing separator
+ * \param[in]       fname: Name of the file or directory
+ * \return          SDL_ENUM_CONTINUE, SDL_ENUM_FAILURE on error
+ */
+static SDL_EnumerationResult collect_file(void *user_data, const char *dirname, const char *fname)
+{
+    pak_walk_t  *walk = (pak_walk_t *)user_data;
+    char         path[MVN_VFS_PATH_SIZE];
+    SDL_PathInfo info;
+
+    if ((size_t)SDL_snprintf(path, sizeof(path), "%s%s", dirname, fname) >= sizeof(path) ||
+        !SDL_GetPathInfo(path, &info)) {
+        walk->failed = true;
+        mvn_set_error_code(MVN_ERROR_IO, "Failed to read '%s%s'", dirname, fname);
+        return SDL_ENUM_FAILURE;
+    }
+
+    if (info.type == SDL_PATHTYPE_DIRECTORY) {
+        if (!SDL_EnumerateDirectory(path, collect_file, walk) && !walk->failed) {
+            walk->failed = true;
+            mvn_set_error_code(MVN_ERROR_IO, "Failed to read '%s': %s", path, SDL_GetError());
+        }
+        return walk->failed ? SDL_ENUM_FAILURE : SDL_ENUM_CONTINUE;
+    }
+    // Archives are not packed, so an earlier build in the directory is left out
+    if (info.type != SDL_PATHTYPE_FILE || mvn_is_file_extension(fname, MVN_PAK_EXTENSION)) {
+        return SDL_ENUM_CONTINUE;
+    }
+
+    const char *relative = path + SDL_strlen(walk->root);
+    while (*relative == '/' || *relative == '\\') {
+        relative++;
+    }
+
+    char   name[MVN_VFS_PATH_SIZE];
+    size_t length = normalize_path(relative, name, sizeof(name));
+    if (length == 0 || length > UINT16_MAX) {
+        walk->failed = true;
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot pack '%s'", path);
+        return SDL_ENUM_FAILURE;
+    }
+
+    pak_file_t file = { MVN_MALLOC(length + 1), mvn_string_hash_bytes(name, length) };
+    if (file.name == NULL || !mvn_list_push(walk->files, &file)) {
+        MVN_FREE(file.name);
+        walk->failed = true;
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to collect '%s'", path);
+        return SDL_ENUM_FAILURE;
+    }
+    SDL_memcpy(file.name, name, length + 1);
+    return SDL_ENUM_CONTINUE;
+}
+
+/**
+ * \brief           Order collected files like the table of contents
+ * \param[in]       a: First file (pak_file_t)
+ * \param[in]       b: Second file (pak_file_t)
+ * \return          Negative, zero or positive like strcmp
+ */
+static int compare_files(const void *a, const void *b)
+{
+    const pak_file_t *first  = (const pak_file_t *)a;
+    const pak_file_t *second = (const pak_file_t *)b;
+    return compare_entries(first->hash,
+                           first->name,
+                           SDL_strlen(first->name),
+                           second->hash,
+                           second->name,
+                           SDL_strlen(second->name));
+}
+
+/**
+ * \brief           Write zeros up to the next multiple of an alignment
+ * \param[in]       stream: Output
+ * \param[in,out]   offset: Current offset, receives the aligned offset
+ * \param[in]       alignment: Alignment
+ * \return          true on success, false on failure
+ */
+static bool write_padding(SDL_IOStream *stream, uint64_t *offset, uint64_t alignment)
+{
+    static const uint8_t zeros[MVN_PAK_ALIGNMENT] = { 0 };
+    size_t               padding = (size_t)((alignment - *offset % alignment) % alignment);
+    *offset += padding;
+    return SDL_WriteIO(stream, zeros, padding) == padding;
+}
+
+/**
+ * \brief           Write the payloads and table of contents of an archive
+ * \param[in]       stream: Output, positioned at the start
+ * \param[in]       root: Directory the files were collected from
+ * \param[in]       files: Files sorted by compare_files()
+ * \param[in]       compress: true to store files with LZ4 where it makes them smaller
+ * \param[out]      header: Receives the header
+ * \return          true on success, false on failure
+ */
+static bool write_archive(SDL_IOStream     *stream,
+                          const char       *root,
+                          const mvn_list_t *files,
+                          bool              compress,
+                          uint8_t           header[PAK_HEADER_SIZE])
+{
+    size_t   count   = mvn_list_length(files);
+    uint8_t *table   = MVN_CALLOC(count + 1, PAK_ENTRY_SIZE);
+    uint64_t offset  = PAK_HEADER_SIZE;
+    uint32_t names   = 0;
+    bool     written = SDL_WriteIO(stream, header, PAK_HEADER_SIZE) == PAK_HEADER_SIZE;
+
+    if (table == NULL) {
+        return mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate archive table");
+    }
+
+    for (size_t i = 0; written && i < count; i++) {
+        const pak_file_t *file  = (const pak_file_t *)mvn_list_get(files, i);
+        uint8_t          *entry = table + i * PAK_ENTRY_SIZE;
+        char              path[MVN_VFS_PATH_SIZE];
+        size_t            size = 0;
+
+        if ((size_t)SDL_snprintf(path, sizeof(path), "%s/%s", root, file->name) >= sizeof(path)) {
+            MVN_FREE(table);
+            return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Path too long: %s", file->name);
+        }
+
+        uint8_t *data = mvn_load_file_data(path, &size);
+        if (data == NULL) {
+            MVN_FREE(table);
+            return false;
+        }
+
+        // Keep the compressed block only if it is smaller
+        const uint8_t *stored      = data;
+        size_t         stored_size = size;
+        uint8_t       *block       = compress && size > 0 ? MVN_MALLOC(size) : NULL;
+        size_t         block_size  = block != NULL ? lz4_compress(data, size, block, size) : 0;
+        if (block_size > 0) {
+            stored      = block;
+            stored_size = block_size;
+        }
+
+        written = write_padding(stream, &offset, MVN_PAK_ALIGNMENT) &&
+                  SDL_WriteIO(stream, stored, stored_size) == stored_size;
+
+        size_t length = SDL_strlen(file->name);
+        write_le(entry + PAK_ENTRY_HASH, file->hash, 8);
+        write_le(entry + PAK_ENTRY_OFFSET, offset, 8);
+        write_le(entry + PAK_ENTRY_STORED_SIZE, stored_size, 8);
+        write_le(entry + PAK_ENTRY_SIZE_FIELD, size, 8);
+        write_le(entry + PAK_ENTRY_NAME_OFFSET, names, 4);
+        write_le(entry + PAK_ENTRY_NAME_LENGTH, length, 2);
+        write_le(entry + PAK_ENTRY_COMPRESSION,
+                 block_size > 0 ? MVN_PAK_COMPRESSION_LZ4 : MVN_PAK_COMPRESSION_NONE,
+                 2);
+        offset += stored_size;
+        names += (uint32_t)length;
+
+        MVN_FREE(block);
+        mvn_unload_file_data(data);
+    }
+
+    uint64_t table_offset = offset;
+    written = written && write_padding(stream, &table_offset, 8) &&
+              SDL_WriteIO(stream, table, count * PAK_ENTRY_SIZE) == count * PAK_ENTRY_SIZE;
+    for (size_t i = 0; written && i < count; i++) {
+        const pak_file_t *file   = (const pak_file_t *)mvn_list_get(files, i);
+        size_t            length = SDL_strlen(file->name);
+        written                  = SDL_WriteIO(stream, file->name, length) == length;
+    }
+    MVN_FREE(table);
+
+    SDL_memcpy(header, "MVNPAK", 6);
+    write_le(header + 6, MVN_PAK_VERSION, 2);
+    write_le(header + 8, count, 4);
+    write_le(header + 12, MVN_PAK_ALIGNMENT, 4);
+    write_le(header + 16, table_offset, 8);
+    write_le(header + 24, table_offset + count * PAK_ENTRY_SIZE, 8);
+
+    if (!written) {
+        return mvn_set_error_code(MVN_ERROR_IO, "Failed to write archive: %s", SDL_GetError());
+    }
+    return true;
+}
+
+/**
+ * \brief           Pack the files of a directory into an archive
+ * \note            Paths in the archive are relative to directory, so mounting the archive
+ *                  makes directory/a/b.png readable as a/b.png.
+ * \param[in]       directory: Directory to pack, including its subdirectories
+ * \param[in]       output: Path of the archive to write
+ * \param[in]       compress: true to compress files with LZ4 where it makes them smaller
+ * \return          true on success, false on failure
+ */
+bool mvn_pak_build(const char *directory, const char *output, bool compress)
+{
+    if (directory == NULL || output == NULL) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot build archive: NULL path");
+    }
+
+    char   root[MVN_VFS_PATH_SIZE];
+    size_t length = SDL_strlcpy(root, directory, sizeof(root));
+    if (length >= sizeof(root)) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Path too long: %s", directory);
+    }
+    while (length > 1 && (root[length - 1] == '/' || root[length - 1] == '\\')) {
+        root[--length] = '\0';
+    }
+
+    pak_walk_t walk = { root, mvn_list_init(sizeof(pak_file_t), 64), false };
+    if (walk.files == NULL) {
+        return mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate file list");
+    }
+
+    bool success = SDL_EnumerateDirectory(root, collect_file, &walk) && !walk.failed;
+    if (!success && !walk.failed) {
+        mvn_set_error_code(MVN_ERROR_IO, "Failed to read '%s': %s", root, SDL_GetError());
+    }
+
+    SDL_IOStream *stream = success ? SDL_IOFromFile(output, "wb") : NULL;
+    if (success && stream == NULL) {
+        success = mvn_set_error_code(
+            MVN_ERROR_IO, "Failed to create '%s': %s", output, SDL_GetError());
+    }
+
+    if (success) {
+        SDL_qsort(walk.files->data, mvn_list_length(walk.files), sizeof(pak_file_t), compare_files);
+
+        // The header is written last, once the offsets are known
+        uint8_t header[PAK_HEADER_SIZE] = { 0 };
+        success = write_archive(stream, root, walk.files, compress, header);
+        if (success && (SDL_SeekIO(stream, 0, SDL_IO_SEEK_SET) != 0 ||
+                        SDL_WriteIO(stream, header, sizeof(header)) != sizeof(header))) {
+            success = mvn_set_error_code(MVN_ERROR_IO, "Failed to write '%s'", output);
+        }
+        if (!SDL_CloseIO(stream) && success) {
+            success = mvn_set_error_code(MVN_ERROR_IO, "Failed to close '%s'", output);
+        }
+        if (!success) {
+            SDL_RemovePath(output);
+        }
+    }
+
+    for (size_t i = 0; i < mvn_list_length(walk.files); i++) {
+        MVN_FREE(((pak_file_t *)mvn_list_get(walk.files, i))->name);
+    }
+    mvn_list_free(walk.files);
+    return success;
+}
+
+/**
+ * \brief           Mount an archive or a directory into the virtual file system
+ * \note            Relative paths read through mvn-file, such as textures and fonts, are looked up
+ *                  in the mounts before the current directory. Later mounts take precedence, so
+ *                  a directory mounted after an archive overrides its files for mods and during
+ *                  development. Mount and unmount from the main thread.
+ * \param[in]       path: Archive built with mvn_pak_build(), or a directory
+ * \return          true on success, false on failure
+ */
+bool mvn_vfs_mount(const char *path)
+{
+    if (path == NULL || path[0] == '\0') {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot mount: NULL or empty path");
+    }
+    if (SDL_strlen(path) >= MVN_VFS_PATH_SIZE) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot mount: path too long");
+    }
+    if (SDL_GetAtomicInt(&g_mount_count) >= MVN_VFS_MAX_MOUNTS) {
+        return mvn_set_error_code(
+            MVN_ERROR_INVALID_STATE, "Cannot mount '%s': too many mounts", path);
+    }
+
+    if (g_mount_lock == NULL) {
+        g_mount_lock = SDL_CreateRWLock();
+        if (g_mount_lock == NULL) {
+            return mvn_set_error_code(MVN_ERROR_SDL, "Failed to create lock: %s", SDL_GetError());
+        }
+    }
+
+    // The archive is opened before taking the lock, it may itself be read through a mount
+    mvn_vfs_archive_t *archive = NULL;
+    SDL_PathInfo       info;
+    if (!SDL_GetPathInfo(path, &info) || info.type != SDL_PATHTYPE_DIRECTORY) {
+        archive = open_archive(path);
+        if (archive == NULL) {
+            return false;
+        }
+    }
+
+    SDL_LockRWLockForWriting(g_mount_lock);
+    mvn_vfs_mount_t *mount = &g_mounts[SDL_GetAtomicInt(&g_mount_count)];
+    SDL_strlcpy(mount->path, path, sizeof(mount->path));
+    mount->archive = archive;
+
+    // Directories are joined with relative paths, drop trailing separators
+    size_t length = SDL_strlen(mount->path);
+    while (length > 1 && (mount->path[length - 1] == '/' || mount->path[length - 1] == '\\')) {
+        mount->path[--length] = '\0';
+    }
+    SDL_AddAtomicInt(&g_mount_count, 1);
+    SDL_UnlockRWLock(g_mount_lock);
+
+    mvn_log_info("Mounted %s '%s'", archive != NULL ? "archive" : "directory", path);
+    return true;
+}
+
+/**
+ * \brief           Unmount the most recent mount of a path
+ * \note            Files opened from an archive stay readable until they are released
+ * \param[in]       path: Path given to mvn_vfs_mount()
+ * \return          true on success, false if the path is not mounted
+ */
+bool mvn_vfs_unmount(const char *path)
+{
+    if (path == NULL || SDL_GetAtomicInt(&g_mount_count) == 0) {
+        return mvn_set_error_code(MVN_ERROR_NOT_FOUND, "Cannot unmount: not mounted");
+    }
+
+    char   name[MVN_VFS_PATH_SIZE];
+    size_t length = SDL_strlcpy(name, path, sizeof(name));
+    while (length > 1 && (name[length - 1] == '/' || name[length - 1] == '\\')) {
+        name[--length] = '\0';
+    }
+
+    mvn_vfs_archive_t *archive = NULL;
+    bool               found   = false;
+
+    SDL_LockRWLockForWriting(g_mount_lock);
+    int count = SDL_GetAtomicInt(&g_mount_count);
+    for (int i = count - 1; i >= 0 && !found; i--) {
+        if (SDL_strcmp(g_mounts[i].path, name) == 0) {
+            archive = g_mounts[i].archive;
+            found   = true;
+            SDL_memmove(&g_mounts[i],
+                        &g_mounts[i + 1],
+                        (size_t)(count - i - 1) * sizeof(g_mounts[0]));
+            SDL_SetAtomicInt(&g_mount_count, count - 1);
+        }
+    }
+    SDL_UnlockRWLock(g_mount_lock);
+
+    if (!found) {
+        return mvn_set_error_code(MVN_ERROR_NOT_FOUND, "Cannot unmount '%s': not mounted", path);
+    }
+    if (archive != NULL) {
+        release_archive(archive);
+    }
+    return true;
+}
+
+/**
+ * \brief           Unmount all archives and directories
+ */
+void mvn_vfs_unmount_all(void)
+{
+    if (g_mount_lock == NULL) {
+        return;
+    }
+
+    SDL_LockRWLockForWriting(g_mount_lock);
+    int count = SDL_GetAtomicInt(&g_mount_count);
+    SDL_SetAtomicInt(&g_mount_count, 0);
+    SDL_UnlockRWLock(g_mount_lock);
+
+    for (int i = 0; i < count; i++) {
+        if (g_mounts[i].archive != NULL) {
+            release_archive(g_mounts[i].archive);
+            g_mounts[i].archive = NULL;
+        }
+    }
+}
+
+/**
+ * \brief           Get the number of mounted archives and directories
+ * \return          Number of mounts
+ */
+int mvn_vfs_get_mount_count(void)
+{
+    return SDL_GetAtomicInt(&g_mount_count);
+}
+
+/**
+ * \brief           Find which mount provides a file
+ * \param[in]       path: Relative path of the file
+ * \param[out]      native: Receives the path on disk of the file, or of the archive holding it,
+ *                  may be NULL
+ * \param[in]       size: Size of native
+ * \param[out]      file_size: Receives the size of the file, may be NULL
+ * \param[out]      archive: Receives the archive holding the file with a reference taken, may be
+ *                  NULL
+ * \param[out]      entry: Receives the table of contents entry of the file, may be NULL
+ * \return          Where the file was found
+ */
+static mvn_vfs_source_t find_file(const char *path, char *native, size_t size, size_t *file_size,
+                                  mvn_vfs_archive_t **archive, const uint8_t **entry)
+{
+    if (path == NULL || SDL_GetAtomicInt(&g_mount_count) == 0) {
+        return MVN_VFS_SOURCE_NONE;
+    }
+
+    char   name[MVN_VFS_PATH_SIZE];
+    size_t length = normalize_path(path, name, sizeof(name));
+    if (length == 0) {
+        return MVN_VFS_SOURCE_NONE;
+    }
+
+    uint64_t         hash   = mvn_string_hash_bytes(name, length);
+    mvn_vfs_source_t source = MVN_VFS_SOURCE_NONE;
+    char             candidate[MVN_VFS_PATH_SIZE];
+    uint64_t         found_size = 0;
+
+    SDL_LockRWLockForReading(g_mount_lock);
+    for (int i = SDL_GetAtomicInt(&g_mount_count) - 1; i >= 0; i--) {
+        const mvn_vfs_mount_t *mount = &g_mounts[i];
+        if (mount->archive != NULL) {
+            const uint8_t *found = find_entry(mount->archive, name, length, hash);
+            if (found != NULL) {
+                SDL_strlcpy(candidate, mount->path, sizeof(candidate));
+                found_size = read_u64(found + PAK_ENTRY_SIZE_FIELD);
+                source     = MVN_VFS_SOURCE_ARCHIVE;
+                if (archive != NULL && entry != NULL) {
+                    SDL_AddAtomicInt(&mount->archive->refs, 1);
+                    *archive = mount->archive;
+                    *entry   = found;
+                }
+                break;
+            }
+            continue;
+        }
+
+        SDL_PathInfo info;
+        if ((size_t)SDL_snprintf(candidate, sizeof(candidate), "%s/%s", mount->path, name) <
+                sizeof(candidate) &&
+            SDL_GetPathInfo(candidate, &info) && info.type == SDL_PATHTYPE_FILE) {
+            found_size = info.size;
+            source     = MVN_VFS_SOURCE_DIRECTORY;
+            break;
+        }
+    }
+    SDL_UnlockRWLock(g_mount_lock);
+
+    if (source != MVN_VFS_SOURCE_NONE) {
+        if (native != NULL && size > 0) {
+            SDL_strlcpy(native, candidate, size);
+        }
+        if (file_size != NULL) {
+            *file_size = (size_t)found_size;
+        }
+    }
+    return source;
+}
+
+/**
+ * \brief           Open a view of a file found in an archive
+ * \param[in]       archive: Archive holding the file, the reference taken on it is released
+ *                  unless the view keeps it
+ * \param[in]       entry: Table of contents entry of the file
+ * \param[in]       path: Path of the file, for error messages
+ * \param[out]      view: Receives the view
+ * \return          true on success, false if the file is corrupt or memory runs out
+ */
+static bool map_entry(mvn_vfs_archive_t *archive, const uint8_t *entry, const char *path,
+                      mvn_file_view_t *view)
+{
+    const uint8_t *base   = archive->view.data;
+    const uint8_t *data   = base + read_u64(entry + PAK_ENTRY_OFFSET);
+    size_t         stored = (size_t)read_u64(entry + PAK_ENTRY_STORED_SIZE);
+    size_t         size   = (size_t)read_u64(entry + PAK_ENTRY_SIZE_FIELD);
+
+    if (read_u16(entry + PAK_ENTRY_COMPRESSION) == MVN_PAK_COMPRESSION_NONE) {
+        view->data    = data;
+        view->size    = size;
+        view->owner   = archive;
+        view->release = release_archive;
+        return true;
+    }
+
+    uint8_t *buffer = MVN_MALLOC(size > 0 ? size : 1);
+    bool     valid  = buffer != NULL && lz4_decompress(data, stored, buffer, size);
+    release_archive(archive);
+    if (buffer == NULL) {
+        return mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate '%s'", path);
+    }
+    if (!valid) {
+        MVN_FREE(buffer);
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Failed to decompress '%s'", path);
+    }
+
+    view->data = buffer;
+    view->size = size;
+    return true;
+}
+
+/**
+ * \brief           Find which mount provides a file
+ * \note            Returns MVN_VFS_SOURCE_NONE right away when nothing is mounted. Archive
+ *                  lookups are a binary search of the table of contents, directory lookups cost
+ *                  one path query each.
+ * \param[in]       path: Relative path of the file
+ * \param[out]      native: Receives the path on disk of the file, or of the archive holding it,
+ *                  may be NULL
+ * \param[in]       size: Size of native
+ * \param[out]      file_size: Receives the size of the file, may be NULL
+ * \return          Where the file was found
+ */
+mvn_vfs_source_t mvn_vfs_resolve(const char *path, char *native, size_t size, size_t *file_size)
+{
+    return find_file(path, native, size, file_size, NULL, NULL);
+}
+
+/**
+ * \brief           Open a view of a file stored in a mounted archive
+ * \note            Uncompressed files point into the mapped archive without copying, which stays
+ *                  open until the view is released. Compressed files are decompressed into a heap
+ *                  buffer. Use mvn_file_map() to also look in mounted directories and on disk.
+ * \param[in]       path: Relative path of the file
+ * \param[out]      view: Receives the view, release it with mvn_file_unmap()
+ * \return          true on success, false if no mounted archive has the file or it is corrupt
+ */
+bool mvn_vfs_map(const char *path, mvn_file_view_t *view)
+{
+    if (view == NULL) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot map file: NULL view");
+    }
+    SDL_zerop(view);
+
+    char   name[MVN_VFS_PATH_SIZE];
+    size_t length = path != NULL && SDL_GetAtomicInt(&g_mount_count) > 0
+                        ? normalize_path(path, name, sizeof(name))
+                        : 0;
+    if (length == 0) {
+        return mvn_set_error_code(
+            MVN_ERROR_NOT_FOUND, "'%s' is not in a mounted archive", path != NULL ? path : "");
+    }
+
+    uint64_t           hash    = mvn_string_hash_bytes(name, length);
+    mvn_vfs_archive_t *archive = NULL;
+    const uint8_t     *entry   = NULL;
+
+    SDL_LockRWLockForReading(g_mount_lock);
+    for (int i = SDL_GetAtomicInt(&g_mount_count) - 1; i >= 0 && entry == NULL; i--) {
+        if (g_mounts[i].archive != NULL) {
+            archive = g_mounts[i].archive;
+            entry   = find_entry(archive, name, length, hash);
+        }
+    }
+    if (entry != NULL) {
+        SDL_AddAtomicInt(&archive->refs, 1);
+    }
+    SDL_UnlockRWLock(g_mount_lock);
+
+    if (entry == NULL) {
+        return mvn_set_error_code(MVN_ERROR_NOT_FOUND, "'%s' is not in a mounted archive", path);
+    }
+    return map_entry(archive, entry, path, view);
+}
+
+/**
+ * \brief           Find which mount provides a file and open it if it is in an archive
+ * \note            Same as mvn_vfs_resolve() followed by mvn_vfs_map(), with a single lookup.
+ *                  The view is only filled for MVN_VFS_SOURCE_ARCHIVE.
+ * \param[in]       path: Relative path of the file
+ * \param[out]      native: Receives the path on disk of the file, or of the archive holding it,
+ *                  may be NULL
+ * \param[in]       size: Size of native
+ * \param[out]      view: Receives the view, release it with mvn_file_unmap()
+ * \param[out]      source: Receives where the file was found
+ * \return          false if the file is in a mounted archive but cannot be opened, true otherwise
+ */
+bool mvn_vfs_open(const char *path, char *native, size_t size, mvn_file_view_t *view,
+                  mvn_vfs_source_t *source)
+{
+    if (view == NULL || source == NULL) {
+        return mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot open file: NULL argument");
+    }
+    SDL_zerop(view);
+
+    mvn_vfs_archive_t *archive = NULL;
+    const uint8_t     *entry   = NULL;
+    *source                    = find_file(path, native, size, NULL, &archive, &entry);
+    if (*source != MVN_VFS_SOURCE_ARCHIVE) {
+        return true;
+    }
+    return map_entry(archive, entry, path, view);
+}
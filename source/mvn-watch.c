@@ -0,0 +1,644 @@
+/**
+ * \file            mvn-watch.c
+ * \brief           File watching for hot reloading assets in MVN game framework
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+// Needed for poll()
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#define MVN_ALLOC_TAG MVN_ALLOC_TAG_FILE
+
+#include "mvn/mvn-watch.h"
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-job.h"
+#include "mvn/mvn-logger.h"
+#include "mvn/mvn-text.h"
+#include "mvn/mvn-texture.h"
+#include "mvn/mvn-utils.h"
+#include "mvn/mvn-vfs.h"
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define MVN_WATCH_INOTIFY
+#endif
+
+/* Longest time the watcher thread sleeps before checking for work */
+#define WATCH_WAIT_MS 20
+
+/* Changes that mark a file in a watched directory as modified */
+#define WATCH_INOTIFY_MASK (IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB)
+
+/**
+ * \brief           What happens when a watched file changed
+ */
+typedef enum mvn_watch_kind_t {
+    MVN_WATCH_KIND_CALLBACK = 0, /*!< Call the user callback */
+    MVN_WATCH_KIND_TEXTURE,      /*!< Reload the pixels of a texture */
+    MVN_WATCH_KIND_FONT,         /*!< Replace the font in a font slot */
+} mvn_watch_kind_t;
+
+/**
+ * \brief           Watched file
+ */
+typedef struct mvn_watch_entry_t {
+    uint32_t         id;                        /*!< Identifier, 0 for a free slot */
+    mvn_watch_kind_t kind;                      /*!< What to do on a change */
+    mvn_watch_fn     callback;                  /*!< Callback of MVN_WATCH_KIND_CALLBACK */
+    void            *target;                    /*!< User data, texture or font slot */
+    float            font_size;                 /*!< Point size of MVN_WATCH_KIND_FONT */
+    int              wd;                        /*!< inotify watch of the directory, -1 if polled */
+    bool             pending;                   /*!< Changed, waiting for the quiet time */
+    bool             queued;                    /*!< Queued for the main thread */
+    uint64_t         changed_at;                /*!< Ticks of the last change */
+    SDL_Time         modify_time;               /*!< Modification time seen by the last poll */
+    Uint64           size;                      /*!< Size seen by the last poll */
+    char            *path;                      /*!< Path the file was watched with */
+    const char      *name;                      /*!< File name, points into native */
+    char             native[MVN_VFS_PATH_SIZE]; /*!< Path of the file on disk */
+} mvn_watch_entry_t;
+
+/* Watched files, a slot is free when its id is 0 */
+static mvn_watch_entry_t g_watches[MVN_WATCH_MAX_FILES];
+
+/* Number of watched files */
+static SDL_AtomicInt g_watch_count;
+
+/* Guards the watched files, created when the watcher starts */
+static SDL_Mutex *g_watch_lock = NULL;
+
+/* Thread collecting changes, running while g_watch_stop is 0 */
+static SDL_Thread   *g_watch_thread = NULL;
+static SDL_AtomicInt g_watch_stop;
+
+/* Identifier of the next watch, never reused so stale deliveries find nothing */
+static uint32_t g_next_id = 1;
+
+/* Polling settings, the interval is read by the watcher thread */
+static bool          g_force_polling = false;
+static SDL_AtomicInt g_poll_interval = { MVN_WATCH_DEFAULT_POLL_MS };
+
+#if defined(MVN_WATCH_INOTIFY)
+/* inotify instance of the watcher, -1 if it could not be created */
+static int g_inotify_fd = -1;
+#endif
+
+/**
+ * \brief           Find a watched file
+ * \note            Called with g_watch_lock held
+ * \param[in]       id: Identifier of the watch
+ * \return          Watched file, NULL if there is none with that identifier
+ */
+static mvn_watch_entry_t *find_watch(uint32_t id)
+{
+    for (int i = 0; i < MVN_WATCH_MAX_FILES; i++) {
+        if (g_watches[i].id == id) {
+            return &g_watches[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Mark a watched file as changed, restarting its quiet time
+ * \param[in]       entry: Watched file
+ * \param[in]       now: Current ticks
+ */
+static void mark_changed(mvn_watch_entry_t *entry, uint64_t now)
+{
+    entry->pending    = true;
+    entry->changed_at = now;
+}
+
+/**
+ * \brief           Check the files that are not watched by the operating system
+ * \note            Called with g_watch_lock held
+ * \param[in]       now: Current ticks
+ */
+static void poll_files(uint64_t now)
+{
+    for (int i = 0; i < MVN_WATCH_MAX_FILES; i++) {
+        mvn_watch_entry_t *entry = &g_watches[i];
+        if (entry->id == 0 || entry->wd >= 0) {
+            continue;
+        }
+
+        // A missing file reads as empty, so it is reported again once it reappears
+        SDL_PathInfo info;
+        if (!SDL_GetPathInfo(entry->native, &info)) {
+            SDL_zero(info);
+        }
+        if (info.modify_time != entry->modify_time || info.size != entry->size) {
+            entry->modify_time = info.modify_time;
+            entry->size        = info.size;
+            mark_changed(entry, now);
+        }
+    }
+}
+
+#if defined(MVN_WATCH_INOTIFY)
+/**
+ * \brief           Wait for inotify events and mark the files they concern
+ */
+static void read_events(void)
+{
+    struct pollfd descriptor = { g_inotify_fd, POLLIN, 0 };
+    if (poll(&descriptor, 1, WATCH_WAIT_MS) <= 0) {
+        return;
+    }
+
+    // Aligned for the events, the kernel pads every event to keep the next one aligned
+    union {
+        struct inotify_event event;
+        char                 bytes[4096];
+    } buffer;
+    ssize_t length = read(g_inotify_fd, buffer.bytes, sizeof(buffer.bytes));
+    if (length <= 0) {
+        return;
+    }
+
+    uint64_t now = SDL_GetTicks();
+    SDL_LockMutex(g_watch_lock);
+    for (ssize_t offset = 0; offset < length;) {
+        const struct inotify_event *event = (const struct inotify_event *)(buffer.bytes + offset);
+        offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+
+        for (int i = 0; i < MVN_WATCH_MAX_FILES; i++) {
+            mvn_watch_entry_t *entry = &g_watches[i];
+            if (entry->id == 0) {
+                continue;
+            }
+            // Events were dropped, so any file may have changed
+            if ((event->mask & IN_Q_OVERFLOW) != 0 ||
+                (entry->wd == event->wd && event->len > 0 &&
+                 SDL_strcmp(entry->name, event->name) == 0)) {
+                mark_changed(entry, now);
+            }
+        }
+    }
+    SDL_UnlockMutex(g_watch_lock);
+}
+
+/**
+ * \brief           Watch the directory of a file with inotify
+ * \param[in,out]   entry: Watched file, wd is set to -1 if it has to be polled
+ */
+static void add_inotify_watch(mvn_watch_entry_t *entry)
+{
+    entry->wd = -1;
+    if (g_force_polling || g_inotify_fd < 0) {
+        return;
+    }
+
+    // Editors replace files by renaming, which only the directory sees
+    char directory[MVN_VFS_PATH_SIZE];
+    if (entry->name == entry->native) {
+        SDL_strlcpy(directory, ".", sizeof(directory));
+    } else {
+        SDL_strlcpy(directory, entry->native, (size_t)(entry->name - entry->native));
+    }
+    if (directory[0] == '\0') {
+        SDL_strlcpy(directory, "/", sizeof(directory));
+    }
+
+    entry->wd = inotify_add_watch(g_inotify_fd, directory, WATCH_INOTIFY_MASK);
+    if (entry->wd < 0) {
+        mvn_log_debug("Polling %s, its directory cannot be watched", entry->native);
+    }
+}
+
+/**
+ * \brief           Stop watching the directory of a file once no other file needs it
+ * \note            Called with g_watch_lock held, after the entry was freed
+ * \param[in]       wd: inotify watch of the directory
+ */
+static void remove_inotify_watch(int wd)
+{
+    if (wd < 0) {
+        return;
+    }
+    for (int i = 0; i < MVN_WATCH_MAX_FILES; i++) {
+        if (g_watches[i].id != 0 && g_watches[i].wd == wd) {
+            return;
+        }
+    }
+    inotify_rm_watch(g_inotify_fd, wd);
+}
+#endif /* MVN_WATCH_INOTIFY */
+
+/**
+ * \brief           Apply a change on the main thread
+ * \param[in]       user_data: Identifier of the watch
+ */
+static void deliver_change(void *user_data)
+{
+    uint32_t id = (uint32_t)(uintptr_t)user_data;
+    if (g_watch_lock == NULL) {
+        return;
+    }
+
+    // Copy what is needed, the callback may unwatch the file
+    SDL_LockMutex(g_watch_lock);
+    mvn_watch_entry_t *entry = find_watch(id);
+    if (entry == NULL) {
+        SDL_UnlockMutex(g_watch_lock);
+        return;
+    }
+    mvn_watch_entry_t watch = *entry;
+    char              path[MVN_VFS_PATH_SIZE];
+    SDL_strlcpy(path, entry->path, sizeof(path));
+    entry->queued = false;
+    SDL_UnlockMutex(g_watch_lock);
+
+    switch (watch.kind) {
+        case MVN_WATCH_KIND_CALLBACK:
+            watch.callback(path, watch.target);
+            break;
+        case MVN_WATCH_KIND_TEXTURE:
+            if (mvn_reload_texture(watch.target, path)) {
+                mvn_log_info("Reloaded texture %s", path);
+            }
+            break;
+        case MVN_WATCH_KIND_FONT: {
+            // SDL_ttf cannot reload a font in place, so the slot gets a new font
+            TTF_Font **slot = watch.target;
+            TTF_Font  *font = mvn_load_font(path, watch.font_size);
+            if (font == NULL) {
+                break;
+            }
+            mvn_unload_font(*slot);
+            *slot = font;
+            mvn_log_info("Reloaded font %s", path);
+            break;
+        }
+    }
+}
+
+/**
+ * \brief           Queue the files whose quiet time ended for the main thread
+ * \note            Called with g_watch_lock held
+ * \param[in]       now: Current ticks
+ */
+static void queue_changes(uint64_t now)
+{
+    for (int i = 0; i < MVN_WATCH_MAX_FILES; i++) {
+        mvn_watch_entry_t *entry = &g_watches[i];
+        if (entry->id == 0 || !entry->pending || entry->queued ||
+            now - entry->changed_at < MVN_WATCH_COALESCE_MS) {
+            continue;
+        }
+
+        // Stays pending if the queue is not available, so it is tried again
+        if (mvn_job_run_on_main_thread(deliver_change, (void *)(uintptr_t)entry->id)) {
+            entry->pending = false;
+            entry->queued  = true;
+        }
+    }
+}
+
+/**
+ * \brief           Collect changes of the watched files until the watcher stops
+ * \param[in]       data: Unused
+ * \return          0
+ */
+static int watch_thread(void *data)
+{
+    (void)data;
+    uint64_t next_poll = 0;
+
+    while (SDL_GetAtomicInt(&g_watch_stop) == 0) {
+#if defined(MVN_WATCH_INOTIFY)
+        if (g_inotify_fd >= 0) {
+            read_events();
+        } else {
+            SDL_Delay(WATCH_WAIT_MS);
+        }
+#else
+        SDL_Delay(WATCH_WAIT_MS);
+#endif
+
+        uint64_t now = SDL_GetTicks();
+        SDL_LockMutex(g_watch_lock);
+        if (now >= next_poll) {
+            poll_files(now);
+            next_poll = now + (uint64_t)SDL_GetAtomicInt(&g_poll_interval);
+        }
+        queue_changes(now);
+        SDL_UnlockMutex(g_watch_lock);
+    }
+    return 0;
+}
+
+/**
+ * \brief           Start the watcher thread if it is not running
+ * \return          true on success, false on failure
+ */
+static bool start_watcher(void)
+{
+    if (g_watch_thread != NULL) {
+        return true;
+    }
+
+    g_watch_lock = SDL_CreateMutex();
+    if (g_watch_lock == NULL) {
+        return mvn_set_error_code(
+            MVN_ERROR_SDL, "Failed to create file watch lock: %s", SDL_GetError());
+    }
+
+#if defined(MVN_WATCH_INOTIFY)
+    g_inotify_fd = inotify_init();
+    if (g_inotify_fd < 0) {
+        mvn_log_warn("inotify is not available, watched files are polled");
+    }
+#endif
+
+    SDL_SetAtomicInt(&g_watch_stop, 0);
+    g_watch_thread = SDL_CreateThread(watch_thread, "mvn_watch", NULL);
+    if (g_watch_thread == NULL) {
+        mvn_set_error_code(
+            MVN_ERROR_SDL, "Failed to create file watch thread: %s", SDL_GetError());
+        mvn_watch_shutdown();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief           Start watching a file
+ * \param[in]       path: File to watch, resolved through mounted directories
+ * \param[in]       kind: What to do on a change
+ * \param[in]       callback: Callback of MVN_WATCH_KIND_CALLBACK
+ * \param[in]       target: User data, texture or font slot
+ * \param[in]       font_size: Point size of MVN_WATCH_KIND_FONT
+ * \return          Identifier of the watch, 0 on failure
+ */
+static uint32_t add_watch(const char      *path,
+                          mvn_watch_kind_t kind,
+                          mvn_watch_fn     callback,
+                          void            *target,
+                          float            font_size)
+{
+    size_t length = path != NULL ? SDL_strlen(path) : 0;
+    if (length == 0 || length >= MVN_VFS_PATH_SIZE) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Invalid path to watch");
+        return 0;
+    }
+
+    // Files of mounted directories are watched on disk, archives never change while mounted
+    char             native[MVN_VFS_PATH_SIZE];
+    mvn_vfs_source_t source = mvn_vfs_resolve(path, native, sizeof(native), NULL);
+    if (source == MVN_VFS_SOURCE_ARCHIVE) {
+        mvn_set_error_code(MVN_ERROR_UNSUPPORTED, "Cannot watch %s, it is in an archive", path);
+        return 0;
+    }
+    if (source == MVN_VFS_SOURCE_NONE) {
+        SDL_memcpy(native, path, length + 1);
+    }
+
+    char *copy = MVN_MALLOC(length + 1);
+    if (copy == NULL) {
+        mvn_set_error_code(MVN_ERROR_OUT_OF_MEMORY, "Failed to allocate watched path");
+        return 0;
+    }
+    SDL_memcpy(copy, path, length + 1);
+
+    if (!start_watcher()) {
+        MVN_FREE(copy);
+        return 0;
+    }
+
+    SDL_LockMutex(g_watch_lock);
+    mvn_watch_entry_t *entry = find_watch(0);
+    if (entry == NULL) {
+        SDL_UnlockMutex(g_watch_lock);
+        MVN_FREE(copy);
+        mvn_set_error_code(
+            MVN_ERROR_INVALID_STATE, "Cannot watch more than %d files", MVN_WATCH_MAX_FILES);
+        return 0;
+    }
+
+    SDL_zerop(entry);
+    entry->kind      = kind;
+    entry->callback  = callback;
+    entry->target    = target;
+    entry->font_size = font_size;
+    entry->path      = copy;
+    SDL_strlcpy(entry->native, native, sizeof(entry->native));
+    const char *slash = SDL_strrchr(entry->native, '/');
+    entry->name       = slash != NULL ? slash + 1 : entry->native;
+
+    // Polls compare against the state at the time the watch started
+    SDL_PathInfo info;
+    if (SDL_GetPathInfo(entry->native, &info)) {
+        entry->modify_time = info.modify_time;
+        entry->size        = info.size;
+    }
+
+#if defined(MVN_WATCH_INOTIFY)
+    add_inotify_watch(entry);
+#else
+    entry->wd = -1;
+#endif
+
+    entry->id = g_next_id++;
+    if (g_next_id == 0) {
+        g_next_id = 1;
+    }
+    uint32_t id = entry->id;
+    SDL_UnlockMutex(g_watch_lock);
+
+    SDL_AddAtomicInt(&g_watch_count, 1);
+    return id;
+}
+
+/**
+ * \brief           Watch a file for changes
+ * \note            Call from the main thread. Changes are collected on a background thread and
+ *                  reported once the file was quiet for MVN_WATCH_COALESCE_MS, so an editor
+ *                  saving in several steps causes a single callback. Callbacks run on the main
+ *                  thread from mvn_begin_drawing(). Files are watched with inotify on Linux and
+ *                  polled every MVN_WATCH_DEFAULT_POLL_MS elsewhere.
+ * \param[in]       path: File to watch, resolved through mounted directories
+ * \param[in]       callback: Called after the file changed
+ * \param[in]       user_data: User data passed to callback
+ * \return          Identifier of the watch, 0 on failure
+ */
+uint32_t mvn_watch_file(const char *path, mvn_watch_fn callback, void *user_data)
+{
+    if (callback == NULL) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Watch callback is NULL");
+        return 0;
+    }
+    return add_watch(path, MVN_WATCH_KIND_CALLBACK, callback, user_data, 0.0f);
+}
+
+/**
+ * \brief           Reload a texture whenever its image file changes
+ * \note            See mvn_watch_file(). The pixels are replaced in place by
+ *                  mvn_reload_texture(), so the texture pointer stays valid. Unwatch the file
+ *                  before unloading the texture.
+ * \param[in]       texture: Texture to reload
+ * \param[in]       fileName: Image file the texture was loaded from
+ * \return          Identifier of the watch, 0 on failure
+ */
+uint32_t mvn_watch_texture(mvn_texture_t *texture, const char *fileName)
+{
+    if (texture == NULL) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot watch a NULL texture");
+        return 0;
+    }
+    return add_watch(fileName, MVN_WATCH_KIND_TEXTURE, NULL, texture, 0.0f);
+}
+
+/**
+ * \brief           Reload a font whenever its file changes
+ * \note            See mvn_watch_file(). SDL_ttf fonts cannot be reloaded in place, so the
+ *                  font in the slot is replaced and the old one unloaded. Keep the font in the
+ *                  slot instead of copying the pointer, and unwatch the file before the slot
+ *                  goes away.
+ * \param[in,out]   font: Slot holding the font, updated after a reload
+ * \param[in]       fileName: Font file the font was loaded from
+ * \param[in]       size: Point size of the font
+ * \return          Identifier of the watch, 0 on failure
+ */
+uint32_t mvn_watch_font(TTF_Font **font, const char *fileName, float size)
+{
+    if (font == NULL) {
+        mvn_set_error_code(MVN_ERROR_INVALID_ARGUMENT, "Cannot watch a NULL font slot");
+        return 0;
+    }
+    return add_watch(fileName, MVN_WATCH_KIND_FONT, NULL, font, size);
+}
+
+/**
+ * \brief           Stop watching a file
+ * \note            Changes already queued for the main thread are dropped
+ * \param[in]       id: Identifier returned when the file was watched
+ * \return          true if the watch existed, false otherwise
+ */
+bool mvn_unwatch_file(uint32_t id)
+{
+    if (id == 0 || g_watch_lock == NULL) {
+        return false;
+    }
+
+    SDL_LockMutex(g_watch_lock);
+    mvn_watch_entry_t *entry = find_watch(id);
+    if (entry == NULL) {
+        SDL_UnlockMutex(g_watch_lock);
+        return false;
+    }
+
+    MVN_FREE(entry->path);
+    entry->path = NULL;
+    entry->id   = 0;
+#if defined(MVN_WATCH_INOTIFY)
+    remove_inotify_watch(entry->wd);
+#endif
+    SDL_UnlockMutex(g_watch_lock);
+
+    SDL_AddAtomicInt(&g_watch_count, -1);
+    return true;
+}
+
+/**
+ * \brief           Get the number of watched files
+ * \return          Number of watched files
+ */
+int mvn_get_watch_count(void)
+{
+    return SDL_GetAtomicInt(&g_watch_count);
+}
+
+/**
+ * \brief           Poll watched files instead of using the file watching of the system
+ * \note            Useful for network and container file systems that report no changes. The
+ *                  mode applies to files watched afterwards, the interval right away.
+ * \param[in]       polling: true to poll files watched from now on
+ * \param[in]       interval_ms: Time between polls, 0 for MVN_WATCH_DEFAULT_POLL_MS
+ */
+void mvn_watch_set_polling(bool polling, uint32_t interval_ms)
+{
+    g_force_polling = polling;
+    SDL_SetAtomicInt(&g_poll_interval,
+                     interval_ms > 0 ? (int)interval_ms : MVN_WATCH_DEFAULT_POLL_MS);
+}
+
+/**
+ * \brief           Check whether files watched from now on are polled
+ * \return          true if they are polled, false if the system reports their changes
+ */
+bool mvn_watch_is_polling(void)
+{
+#if defined(MVN_WATCH_INOTIFY)
+    return g_force_polling || (g_watch_thread != NULL && g_inotify_fd < 0);
+#else
+    return true;
+#endif
+}
+
+/**
+ * \brief           Stop the watcher and forget every watched file
+ * \note            Called by mvn_quit()
+ */
+void mvn_watch_shutdown(void)
+{
+    if (g_watch_thread != NULL) {
+        SDL_SetAtomicInt(&g_watch_stop, 1);
+        SDL_WaitThread(g_watch_thread, NULL);
+        g_watch_thread = NULL;
+    }
+
+#if defined(MVN_WATCH_INOTIFY)
+    if (g_inotify_fd >= 0) {
+        close(g_inotify_fd);
+        g_inotify_fd = -1;
+    }
+#endif
+
+    for (int i = 0; i < MVN_WATCH_MAX_FILES; i++) {
+        MVN_FREE(g_watches[i].path);
+    }
+    SDL_zeroa(g_watches);
+    SDL_SetAtomicInt(&g_watch_count, 0);
+
+    if (g_watch_lock != NULL) {
+        SDL_DestroyMutex(g_watch_lock);
+        g_watch_lock = NULL;
+    }
+}
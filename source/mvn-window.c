@@ -43,6 +43,146 @@
 /* External reference to the window created in mvn-core.c */
 extern mvn_window_t *g_window;
 
+/* Monitors whose bounds and mode are cached, others are queried from SDL */
+#define MVN_MAX_CACHED_MONITORS 8
+
+/**
+ * \brief           Cached bounds and mode of one monitor
+ */
+typedef struct mvn_monitor_state_t {
+    mvn_display_id_t id;           /*!< Display ID */
+    SDL_Rect         bounds;       /*!< Desktop area covered by the monitor */
+    int32_t          refresh_rate; /*!< Refresh rate of the current mode in Hz */
+} mvn_monitor_state_t;
+
+/**
+ * \brief           Window and monitor state cached between window and display events
+ * \note            Getters used by layout code read this instead of querying SDL. Window events
+ *                  refresh the window part and display events refresh everything.
+ */
+typedef struct mvn_window_state_t {
+    bool                valid;                             /*!< Window exists and state is loaded */
+    mvn_display_id_t    current_monitor;                   /*!< Monitor containing the window */
+    SDL_Point           position;                          /*!< Window position on the desktop */
+    SDL_Point           pixel_size;                        /*!< Window size in pixels */
+    SDL_Point           render_size;                       /*!< Renderer output size in pixels */
+    float               display_scale;                     /*!< Content scale of the window */
+    int32_t             monitor_count;                     /*!< Number of connected monitors */
+    mvn_monitor_state_t monitors[MVN_MAX_CACHED_MONITORS]; /*!< First connected monitors */
+} mvn_window_state_t;
+
+static mvn_window_state_t g_state;
+
+/**
+ * \brief           Reload the cached state of the window
+ */
+static void refresh_window_geometry(void)
+{
+    mvn_renderer_t *renderer = mvn_get_renderer();
+
+    g_state.current_monitor = SDL_GetDisplayForWindow(g_window);
+    g_state.display_scale   = SDL_GetWindowDisplayScale(g_window);
+    SDL_GetWindowPosition(g_window, &g_state.position.x, &g_state.position.y);
+    SDL_GetWindowSizeInPixels(g_window, &g_state.pixel_size.x, &g_state.pixel_size.y);
+
+    // The output of the window, independent of any render target that is set
+    if (renderer == NULL ||
+        !SDL_GetRenderOutputSize(renderer, &g_state.render_size.x, &g_state.render_size.y)) {
+        g_state.render_size = g_state.pixel_size;
+    }
+}
+
+/**
+ * \brief           Wait for a change requested from SDL and reload the cached window state
+ * \note            Called by the setters so the getters reflect them before the next event pump
+ */
+static void sync_window_geometry(void)
+{
+    if (!g_state.valid) {
+        return;
+    }
+    SDL_SyncWindow(g_window);
+    refresh_window_geometry();
+}
+
+/**
+ * \brief           Reload the cached bounds and modes of the connected monitors
+ */
+static void refresh_monitors(void)
+{
+    int            count    = 0;
+    SDL_DisplayID *displays = SDL_GetDisplays(&count);
+
+    SDL_zeroa(g_state.monitors);
+    g_state.monitor_count = displays != NULL ? count : 0;
+
+    for (int i = 0; i < g_state.monitor_count && i < MVN_MAX_CACHED_MONITORS; i++) {
+        mvn_monitor_state_t   *monitor = &g_state.monitors[i];
+        const SDL_DisplayMode *mode    = SDL_GetCurrentDisplayMode(displays[i]);
+
+        monitor->id = displays[i];
+        SDL_GetDisplayBounds(displays[i], &monitor->bounds);
+        monitor->refresh_rate = mode != NULL ? (int32_t)mode->refresh_rate : 0;
+    }
+    SDL_free(displays);
+}
+
+/**
+ * \brief           Find the cached state of a monitor
+ * \param[in]       monitor: Monitor ID
+ * \return          Cached state, NULL if the monitor is not cached
+ */
+static const mvn_monitor_state_t *find_monitor(mvn_display_id_t monitor)
+{
+    if (!g_state.valid || monitor == 0) {
+        return NULL;
+    }
+    for (int i = 0; i < MVN_MAX_CACHED_MONITORS; i++) {
+        if (g_state.monitors[i].id == monitor) {
+            return &g_state.monitors[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Reload the cached window and monitor state from SDL
+ * \note            Called by mvn_init() once the renderer exists and by mvn_quit() to drop the
+ *                  state. Afterwards window and display events keep the cache current.
+ */
+void mvn_refresh_window_state(void)
+{
+    SDL_zero(g_state);
+    if (g_window == NULL) {
+        return;
+    }
+
+    refresh_monitors();
+    refresh_window_geometry();
+    g_state.valid = true;
+}
+
+/**
+ * \brief           Update the cached window and monitor state from an event
+ * \note            Called for every event pumped by the input module
+ * \param[in]       event: Event to apply
+ */
+void mvn_window_handle_event(const SDL_Event *event)
+{
+    if (!g_state.valid) {
+        return;
+    }
+
+    if (event->type >= SDL_EVENT_DISPLAY_FIRST && event->type <= SDL_EVENT_DISPLAY_LAST) {
+        // A monitor change can move the window to another monitor or change its scale
+        refresh_monitors();
+        refresh_window_geometry();
+    } else if (event->type >= SDL_EVENT_WINDOW_FIRST && event->type <= SDL_EVENT_WINDOW_LAST &&
+               event->window.windowID == SDL_GetWindowID(g_window)) {
+        refresh_window_geometry();
+    }
+}
+
 /**
  * \brief           Get the SDL window
  * \return          Pointer to the SDL window, NULL if not initialized
@@ -72,6 +212,7 @@ bool mvn_toggle_fullscreen(void)
         return mvn_set_error("Failed to toggle fullscreen mode: %s", SDL_GetError());
     }
 
+    sync_window_geometry();
     return true;
 }
 
@@ -114,6 +255,7 @@ bool mvn_toggle_borderless_windowed(void)
         }
     }
 
+    sync_window_geometry();
     return true;
 }
 
@@ -188,8 +330,7 @@ mvn_display_id_t mvn_get_current_monitor(void)
         return 0;
     }
 
-    mvn_display_id_t displayID = SDL_GetDisplayForWindow(window);
-    return displayID;
+    return g_state.current_monitor;
 }
 
 /**
@@ -206,8 +347,11 @@ mvn_fpoint_t mvn_get_monitor_position(mvn_display_id_t monitor)
         return position;
     }
 
-    SDL_Rect bounds;
-    if (!SDL_GetDisplayBounds(monitor, &bounds)) {
+    const mvn_monitor_state_t *cached = find_monitor(monitor);
+    SDL_Rect                   bounds;
+    if (cached != NULL) {
+        bounds = cached->bounds;
+    } else if (!SDL_GetDisplayBounds(monitor, &bounds)) {
         mvn_set_error("Failed to get monitor position: %s", SDL_GetError());
         return position;
     }
@@ -230,6 +374,11 @@ int32_t mvn_get_monitor_width(mvn_display_id_t monitor)
         return 0;
     }
 
+    const mvn_monitor_state_t *cached = find_monitor(monitor);
+    if (cached != NULL) {
+        return cached->bounds.w;
+    }
+
     SDL_Rect bounds;
     if (!SDL_GetDisplayBounds(monitor, &bounds)) {
         mvn_set_error("Failed to get monitor width: %s", SDL_GetError());
@@ -250,6 +399,11 @@ int32_t mvn_get_monitor_height(mvn_display_id_t monitor)
         return 0;
     }
 
+    const mvn_monitor_state_t *cached = find_monitor(monitor);
+    if (cached != NULL) {
+        return cached->bounds.h;
+    }
+
     SDL_Rect bounds;
     if (!SDL_GetDisplayBounds(monitor, &bounds)) {
         mvn_set_error("Failed to get monitor height: %s", SDL_GetError());
@@ -316,7 +470,9 @@ void mvn_set_window_position(int32_t x, int32_t y)
     // The actual positioning depends on the window manager and may be constrained
     if (!SDL_SetWindowPosition(window, x, y)) {
         mvn_set_error("Failed to set window position: %s", SDL_GetError());
+        return;
     }
+    sync_window_geometry();
 }
 
 /**
@@ -355,7 +511,9 @@ void mvn_set_window_monitor(mvn_display_id_t monitor)
     // Position the window on the monitor
     if (!SDL_SetWindowPosition(window, x, y)) {
         mvn_set_error("Failed to set window position: %s", SDL_GetError());
+        return;
     }
+    sync_window_geometry();
 }
 
 /**
@@ -406,7 +564,7 @@ void mvn_set_window_max_size(int32_t width, int32_t height)
  * \brief           Set window dimensions
  * \param[in]       width: New width of the window
  * \param[in]       height: New height of the window
- * \note            This is an asynchronous request and may not take effect immediately
+ * \note            Waits for the window manager, which may constrain or ignore the request
  */
 void mvn_set_window_size(int32_t width, int32_t height)
 {
@@ -419,7 +577,9 @@ void mvn_set_window_size(int32_t width, int32_t height)
     // In SDL3, window size changes are asynchronous
     if (!SDL_SetWindowSize(window, width, height)) {
         mvn_set_error("Failed to set window size: %s", SDL_GetError());
+        return;
     }
+    sync_window_geometry();
 }
 
 /**
@@ -480,13 +640,7 @@ int32_t mvn_get_screen_width(void)
         return 0;
     }
 
-    SDL_Rect bounds;
-    if (!SDL_GetDisplayBounds(display, &bounds)) {
-        mvn_set_error("Failed to get display bounds: %s", SDL_GetError());
-        return 0;
-    }
-
-    return bounds.w;
+    return mvn_get_monitor_width(display);
 }
 
 /**
@@ -501,57 +655,37 @@ int32_t mvn_get_screen_height(void)
         return 0;
     }
 
-    SDL_Rect bounds;
-    if (!SDL_GetDisplayBounds(display, &bounds)) {
-        mvn_set_error("Failed to get display bounds: %s", SDL_GetError());
-        return 0;
-    }
-
-    return bounds.h;
+    return mvn_get_monitor_height(display);
 }
 
 /**
  * \brief           Get current render width
+ * \note            Size of the window output, independent of any render target that is set
  * \return          Width of the renderer in pixels (accounts for high DPI)
  */
 int32_t mvn_get_render_width(void)
 {
-    mvn_renderer_t *renderer = mvn_get_renderer();
-    if (renderer == NULL) {
+    if (!g_state.valid) {
         mvn_set_error("Cannot get render width: No renderer available");
         return 0;
     }
 
-    int width;
-    int height;
-    if (!SDL_GetCurrentRenderOutputSize(renderer, &width, &height)) {
-        mvn_set_error("Failed to get render output size: %s", SDL_GetError());
-        return 0;
-    }
-
-    return width;
+    return g_state.render_size.x;
 }
 
 /**
  * \brief           Get current render height
+ * \note            Size of the window output, independent of any render target that is set
  * \return          Height of the renderer in pixels (accounts for high DPI)
  */
 int32_t mvn_get_render_height(void)
 {
-    mvn_renderer_t *renderer = mvn_get_renderer();
-    if (renderer == NULL) {
+    if (!g_state.valid) {
         mvn_set_error("Cannot get render height: No renderer available");
         return 0;
     }
 
-    int width;
-    int height;
-    if (!SDL_GetCurrentRenderOutputSize(renderer, &width, &height)) {
-        mvn_set_error("Failed to get render output size: %s", SDL_GetError());
-        return 0;
-    }
-
-    return height;
+    return g_state.render_size.y;
 }
 
 /**
@@ -560,6 +694,10 @@ int32_t mvn_get_render_height(void)
  */
 int32_t mvn_get_monitor_count(void)
 {
+    if (g_state.valid) {
+        return g_state.monitor_count;
+    }
+
     int            count    = 0;
     SDL_DisplayID *displays = SDL_GetDisplays(&count);
 
@@ -568,7 +706,7 @@ int32_t mvn_get_monitor_count(void)
         return 0;
     }
 
-    MVN_FREE(displays);
+    SDL_free(displays);
     return count;
 }
 
@@ -584,6 +722,11 @@ int32_t mvn_get_monitor_refresh_rate(mvn_display_id_t monitor)
         return 0;
     }
 
+    const mvn_monitor_state_t *cached = find_monitor(monitor);
+    if (cached != NULL) {
+        return cached->refresh_rate;
+    }
+
     // Get the current display mode
     const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(monitor);
     if (mode == NULL) {
@@ -609,11 +752,8 @@ mvn_fpoint_t mvn_get_window_position(void)
         return position;
     }
 
-    int x;
-    int y;
-    SDL_GetWindowPosition(window, &x, &y);
-    position.x = (float)x;
-    position.y = (float)y;
+    position.x = (float)g_state.position.x;
+    position.y = (float)g_state.position.y;
 
     return position;
 }
@@ -633,9 +773,8 @@ mvn_fpoint_t mvn_get_window_scale_dpi(void)
     }
 
     // SDL3 provides a single scale factor that applies to both dimensions
-    float factor = SDL_GetWindowDisplayScale(window);
-    scale.x      = factor;
-    scale.y      = factor;
+    scale.x = g_state.display_scale;
+    scale.y = g_state.display_scale;
 
     return scale;
 }
@@ -730,20 +869,13 @@ bool mvn_is_cursor_on_screen(void)
         return false;
     }
 
-    int   window_w;
-    int   window_h;
     float mouse_x;
     float mouse_y;
 
-    // Get window size in pixels
-    if (SDL_GetWindowSizeInPixels(window, &window_w, &window_h)) {
-        mvn_set_error("Failed to get window size: %s", SDL_GetError());
-        return false;
-    }
-
     // Get mouse position
     SDL_GetMouseState(&mouse_x, &mouse_y);
 
     // Check if cursor is within window boundaries
-    return (mouse_x >= 0 && mouse_x < (float)window_w && mouse_y >= 0 && mouse_y < (float)window_h);
+    return (mouse_x >= 0 && mouse_x < (float)g_state.pixel_size.x && mouse_y >= 0 &&
+            mouse_y < (float)g_state.pixel_size.y);
 }
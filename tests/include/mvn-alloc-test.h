@@ -0,0 +1,14 @@
+#ifndef MVN_ALLOC_TEST_H
+#define MVN_ALLOC_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+int run_alloc_tests(int *passed, int *failed, int *total);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_ALLOC_TEST_H */
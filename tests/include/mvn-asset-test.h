@@ -0,0 +1,14 @@
+#ifndef MVN_ASSET_TEST_H
+#define MVN_ASSET_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+int run_asset_tests(int *passed, int *failed, int *total);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_ASSET_TEST_H */
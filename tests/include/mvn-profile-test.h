@@ -0,0 +1,14 @@
+#ifndef MVN_PROFILE_TEST_H
+#define MVN_PROFILE_TEST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+int run_profile_tests(int *passed, int *failed, int *total);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* MVN_PROFILE_TEST_H */
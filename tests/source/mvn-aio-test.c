@@ -0,0 +1,281 @@
+/**
+ * \file            mvn-aio-test.c
+ * \brief           Tests for MVN asynchronous file read functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-aio.h"
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-file.h"
+#include "mvn/mvn-job.h"
+#include "mvn/mvn-vfs.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define AIO_TEST_DIR "mvn_aio_test"
+
+/* Number of files read by each batch */
+#define AIO_TEST_FILE_COUNT 12
+
+/**
+ * \brief           Get the size of a test file
+ * \param[in]       index: Index of the file
+ * \return          Size in bytes, from empty up to several pages
+ */
+static size_t test_file_size(int index)
+{
+    return index == 0 ? 0 : (size_t)index * 7919u;
+}
+
+/**
+ * \brief           Get the byte at an offset of a test file
+ * \param[in]       index: Index of the file
+ * \param[in]       offset: Offset in the file
+ * \return          Byte value
+ */
+static uint8_t test_file_byte(int index, size_t offset)
+{
+    return (uint8_t)((offset * 31u + (size_t)index * 17u) >> 3);
+}
+
+/**
+ * \brief           Create the test files
+ * \param[out]      paths: Receives the path of each file
+ * \return          true on success, false on failure
+ */
+static bool create_test_files(char paths[AIO_TEST_FILE_COUNT][64])
+{
+    SDL_CreateDirectory(AIO_TEST_DIR);
+    for (int i = 0; i < AIO_TEST_FILE_COUNT; i++) {
+        SDL_snprintf(paths[i], 64, AIO_TEST_DIR "/file%d.bin", i);
+
+        size_t   size = test_file_size(i);
+        uint8_t *data = SDL_malloc(size + 1);
+        if (data == NULL) {
+            return false;
+        }
+        for (size_t offset = 0; offset < size; offset++) {
+            data[offset] = test_file_byte(i, offset);
+        }
+
+        SDL_IOStream *file    = SDL_IOFromFile(paths[i], "wb");
+        bool          written = file != NULL && SDL_WriteIO(file, data, size) == size;
+        SDL_free(data);
+        if (file == NULL || !SDL_CloseIO(file) || !written) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief           Remove the test files
+ * \param[in]       paths: Path of each file
+ */
+static void remove_test_files(char paths[AIO_TEST_FILE_COUNT][64])
+{
+    for (int i = 0; i < AIO_TEST_FILE_COUNT; i++) {
+        SDL_RemovePath(paths[i]);
+    }
+    SDL_RemovePath(AIO_TEST_DIR);
+}
+
+/**
+ * \brief           Read the test files as one batch and check their contents
+ * \param[in]       paths: Path of each file
+ * \return          1 on success, 0 on failure
+ */
+static int read_test_files(char paths[AIO_TEST_FILE_COUNT][64])
+{
+    const char     *files[AIO_TEST_FILE_COUNT + 1];
+    mvn_aio_read_t *reads[AIO_TEST_FILE_COUNT + 1];
+    for (int i = 0; i < AIO_TEST_FILE_COUNT; i++) {
+        files[i] = paths[i];
+    }
+    files[AIO_TEST_FILE_COUNT] = AIO_TEST_DIR "/missing.bin";
+
+    TEST_ASSERT(mvn_aio_read_batch(files, AIO_TEST_FILE_COUNT + 1, reads) ==
+                    AIO_TEST_FILE_COUNT + 1,
+                "Every file should get a handle");
+
+    for (int i = 0; i < AIO_TEST_FILE_COUNT; i++) {
+        mvn_file_view_t view;
+        TEST_ASSERT_FMT(mvn_aio_wait(reads[i], &view), "Failed to read %s", paths[i]);
+        TEST_ASSERT(mvn_aio_is_done(reads[i]), "Read should be done after waiting");
+        TEST_ASSERT_FMT(view.size == test_file_size(i),
+                        "%s: expected %zu bytes, got %zu",
+                        paths[i],
+                        test_file_size(i),
+                        view.size);
+
+        const uint8_t *data = view.data;
+        for (size_t offset = 0; offset < view.size; offset++) {
+            TEST_ASSERT_FMT(data[offset] == test_file_byte(i, offset),
+                            "%s: wrong byte at %zu",
+                            paths[i],
+                            offset);
+        }
+        TEST_ASSERT(data[view.size] == '\0', "Contents should be NUL terminated");
+
+        mvn_file_view_t again;
+        TEST_ASSERT(!mvn_aio_wait(reads[i], &again), "Contents can only be taken once");
+        TEST_ASSERT(again.data == NULL, "Second view should be empty");
+
+        mvn_file_unmap(&view);
+        mvn_aio_release(reads[i]);
+    }
+
+    mvn_aio_read_t *missing = reads[AIO_TEST_FILE_COUNT];
+    TEST_ASSERT(!mvn_aio_wait(missing, NULL), "Reading a missing file should fail");
+    TEST_ASSERT(strstr(mvn_get_error(), "missing.bin") != NULL, "Error should name the file");
+    mvn_aio_release(missing);
+
+    return 1;
+}
+
+/**
+ * \brief           Test reading a batch of files through io_uring where available
+ * \return          1 on success, 0 on failure
+ */
+static int test_aio_batch(void)
+{
+    char paths[AIO_TEST_FILE_COUNT][64];
+    TEST_ASSERT(create_test_files(paths), "Failed to create test files");
+
+    mvn_aio_set_uring_enabled(true);
+    int result = read_test_files(paths);
+
+    TEST_ASSERT(mvn_aio_read(NULL) == NULL, "NULL filename should fail");
+    TEST_ASSERT(!mvn_aio_wait(NULL, NULL), "Waiting for NULL should fail");
+
+    remove_test_files(paths);
+    return result;
+}
+
+/**
+ * \brief           Test reading a batch of files on the job system workers
+ * \return          1 on success, 0 on failure
+ */
+static int test_aio_job_fallback(void)
+{
+    char paths[AIO_TEST_FILE_COUNT][64];
+    TEST_ASSERT(create_test_files(paths), "Failed to create test files");
+
+    mvn_aio_set_uring_enabled(false);
+    TEST_ASSERT(!mvn_aio_is_using_uring(), "io_uring should be disabled");
+    int result = read_test_files(paths);
+
+    // Files found in a mounted directory are read from the resolved path
+    mvn_file_view_t view;
+    TEST_ASSERT(mvn_vfs_mount(AIO_TEST_DIR), "Failed to mount test directory");
+    mvn_aio_read_t *read = mvn_aio_read("file3.bin");
+    TEST_ASSERT(read != NULL && mvn_aio_wait(read, &view), "Failed to read mounted file");
+    TEST_ASSERT(view.size == test_file_size(3), "Mounted file size incorrect");
+    mvn_file_unmap(&view);
+    mvn_aio_release(read);
+    mvn_vfs_unmount_all();
+    mvn_aio_set_uring_enabled(true);
+
+    remove_test_files(paths);
+    return result;
+}
+
+/**
+ * \brief           State shared with chained_job
+ */
+typedef struct aio_chain_state_t {
+    mvn_aio_read_t *read;  /*!< Read the job was chained to */
+    SDL_AtomicInt   ready; /*!< Set if the contents were available when the job ran */
+} aio_chain_state_t;
+
+/**
+ * \brief           Check that the read of a job finished when the job runs
+ * \param[in]       user_data: aio_chain_state_t of the job
+ */
+static void chained_job(void *user_data)
+{
+    aio_chain_state_t *state = user_data;
+    mvn_file_view_t    view;
+    if (mvn_aio_is_done(state->read) && mvn_aio_wait(state->read, &view)) {
+        SDL_SetAtomicInt(&state->ready, view.size == test_file_size(3) ? 1 : 0);
+        mvn_file_unmap(&view);
+    }
+}
+
+/**
+ * \brief           Test starting a job once a read finished
+ * \return          1 on success, 0 on failure
+ */
+static int test_aio_chain_job(void)
+{
+    char paths[AIO_TEST_FILE_COUNT][64];
+    TEST_ASSERT(create_test_files(paths), "Failed to create test files");
+
+    aio_chain_state_t state = { mvn_aio_read(paths[3]), { 0 } };
+    TEST_ASSERT(state.read != NULL, "Failed to start read");
+
+    mvn_job_counter_t counter = { 0 };
+    TEST_ASSERT(
+        mvn_job_run_after(mvn_aio_get_counter(state.read), chained_job, &state, &counter),
+        "Failed to chain job");
+    mvn_job_wait(&counter);
+    TEST_ASSERT(SDL_GetAtomicInt(&state.ready) == 1, "Job should run after the read finished");
+
+    mvn_aio_release(state.read);
+    remove_test_files(paths);
+    return 1;
+}
+
+int run_aio_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== AIO TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    // The job system runs the fallback reads and the chained jobs
+    if (!mvn_job_system_init(2)) {
+        printf("ERROR: Failed to start the job system. Skipping aio tests.\n");
+        (*total_tests)++;
+        (*failed_tests)++;
+        return 0;
+    }
+
+    RUN_TEST(test_aio_batch);
+    RUN_TEST(test_aio_job_fallback);
+    RUN_TEST(test_aio_chain_job);
+
+    mvn_aio_shutdown();
+    mvn_job_system_shutdown();
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_aio_tests(&passed, &failed, &total);
+
+    printf("\n===== AIO TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
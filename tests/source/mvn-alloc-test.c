@@ -0,0 +1,225 @@
+/**
+ * \file            mvn-alloc-test.c
+ * \brief           Tests for MVN allocator and memory accounting functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-hashmap.h"
+#include "mvn/mvn-list.h"
+#include "mvn/mvn-string.h"
+#include "mvn/mvn-utils.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * \brief           Counters updated by the test allocator
+ */
+typedef struct test_allocator_context_t {
+    int mallocs;
+    int reallocs;
+    int frees;
+} test_allocator_context_t;
+
+static void *test_malloc(void *user_data, size_t size)
+{
+    ((test_allocator_context_t *)user_data)->mallocs++;
+    return SDL_malloc(size);
+}
+
+static void *test_realloc(void *user_data, void *ptr, size_t size)
+{
+    ((test_allocator_context_t *)user_data)->reallocs++;
+    return SDL_realloc(ptr, size);
+}
+
+static void test_free(void *user_data, void *ptr)
+{
+    ((test_allocator_context_t *)user_data)->frees++;
+    SDL_free(ptr);
+}
+
+/**
+ * \brief           Test per-tag statistics and the size histogram
+ * \return          1 on success, 0 on failure
+ */
+static int test_alloc_stats(void)
+{
+    mvn_alloc_stats_t before = mvn_get_alloc_stats(MVN_ALLOC_TAG_GENERAL);
+
+    void *small = MVN_MALLOC(10);
+    void *large = MVN_CALLOC(4, 100);
+    TEST_ASSERT(small != NULL && large != NULL, "Failed to allocate memory");
+    TEST_ASSERT(((uintptr_t)small % 16) == 0 && ((uintptr_t)large % 16) == 0,
+                "Allocations should be 16 byte aligned");
+    TEST_ASSERT(((unsigned char *)large)[399] == 0, "Calloc memory should be zeroed");
+
+    mvn_alloc_stats_t stats = mvn_get_alloc_stats(MVN_ALLOC_TAG_GENERAL);
+    TEST_ASSERT(stats.live_bytes == before.live_bytes + 410, "Live bytes incorrect");
+    TEST_ASSERT(stats.live_count == before.live_count + 2, "Live count incorrect");
+    TEST_ASSERT(stats.allocation_count == before.allocation_count + 2, "Allocation count wrong");
+    TEST_ASSERT(stats.histogram[0] == before.histogram[0] + 1, "10 bytes should be in bucket 0");
+    TEST_ASSERT(stats.histogram[5] == before.histogram[5] + 1, "400 bytes should be in bucket 5");
+
+    large = MVN_REALLOC(large, 1000);
+    TEST_ASSERT(large != NULL, "Failed to grow allocation");
+    stats = mvn_get_alloc_stats(MVN_ALLOC_TAG_GENERAL);
+    TEST_ASSERT(stats.live_bytes == before.live_bytes + 1010, "Realloc should update live bytes");
+    TEST_ASSERT(stats.live_count == before.live_count + 2, "Realloc should not change live count");
+    TEST_ASSERT(((unsigned char *)large)[0] == 0, "Realloc should preserve contents");
+
+    MVN_FREE(small);
+    MVN_FREE(large);
+    MVN_FREE(NULL);
+
+    stats = mvn_get_alloc_stats(MVN_ALLOC_TAG_GENERAL);
+    TEST_ASSERT(stats.live_bytes == before.live_bytes, "All bytes should be released");
+    TEST_ASSERT(stats.live_count == before.live_count, "All allocations should be released");
+    TEST_ASSERT(stats.peak_bytes >= before.live_bytes + 1010, "Peak should keep the high mark");
+
+    mvn_alloc_stats_t invalid = mvn_get_alloc_stats(MVN_ALLOC_TAG_COUNT);
+    TEST_ASSERT(invalid.allocation_count == 0, "Invalid tag should return empty stats");
+    TEST_ASSERT(strcmp(mvn_get_alloc_tag_name(MVN_ALLOC_TAG_STRING), "string") == 0,
+                "Tag name incorrect");
+
+    return 1;
+}
+
+/**
+ * \brief           Test that containers account memory to their own tags
+ * \return          1 on success, 0 on failure
+ */
+static int test_alloc_container_tags(void)
+{
+    mvn_alloc_stats_t list_before   = mvn_get_alloc_stats(MVN_ALLOC_TAG_LIST);
+    mvn_alloc_stats_t string_before = mvn_get_alloc_stats(MVN_ALLOC_TAG_STRING);
+    mvn_alloc_stats_t hmap_before   = mvn_get_alloc_stats(MVN_ALLOC_TAG_HASHMAP);
+
+    mvn_list_t   *list  = mvn_list_init(sizeof(int), 4);
+    mvn_string_t *str   = mvn_string_from_cstr("tracked");
+    mvn_hmap_t   *hmap  = mvn_hmap_init(sizeof(int), 8);
+    int           value = 7;
+    TEST_ASSERT(list != NULL && str != NULL && hmap != NULL, "Failed to create containers");
+    TEST_ASSERT(mvn_hmap_set(hmap, "key", &value), "Failed to set hashmap value");
+
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_LIST).live_count > list_before.live_count,
+                "List memory should be accounted to the list tag");
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_STRING).live_count > string_before.live_count,
+                "String memory should be accounted to the string tag");
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_HASHMAP).live_count > hmap_before.live_count,
+                "Hashmap memory should be accounted to the hashmap tag");
+
+    mvn_list_free(list);
+    mvn_string_free(str);
+    mvn_hmap_free(hmap);
+
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_LIST).live_bytes == list_before.live_bytes,
+                "List memory should be released");
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_STRING).live_bytes == string_before.live_bytes,
+                "String memory should be released");
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_HASHMAP).live_bytes == hmap_before.live_bytes,
+                "Hashmap memory should be released");
+
+    return 1;
+}
+
+/**
+ * \brief           Test accounting of memory owned by SDL
+ * \return          1 on success, 0 on failure
+ */
+static int test_alloc_track(void)
+{
+    mvn_alloc_stats_t before = mvn_get_alloc_stats(MVN_ALLOC_TAG_TEXTURE);
+
+    mvn_alloc_track(MVN_ALLOC_TAG_TEXTURE, 4096);
+    mvn_alloc_stats_t stats = mvn_get_alloc_stats(MVN_ALLOC_TAG_TEXTURE);
+    TEST_ASSERT(stats.live_bytes == before.live_bytes + 4096, "Tracked bytes not accounted");
+    TEST_ASSERT(stats.live_count == before.live_count + 1, "Tracked count not accounted");
+    TEST_ASSERT(mvn_alloc_report_leaks() >= 1, "Tracked memory should be reported as alive");
+
+    mvn_alloc_untrack(MVN_ALLOC_TAG_TEXTURE, 4096);
+    stats = mvn_get_alloc_stats(MVN_ALLOC_TAG_TEXTURE);
+    TEST_ASSERT(stats.live_bytes == before.live_bytes, "Untracked bytes not released");
+
+    /* Untracking more than was tracked must not underflow */
+    mvn_alloc_untrack(MVN_ALLOC_TAG_TEXTURE, 1);
+    stats = mvn_get_alloc_stats(MVN_ALLOC_TAG_TEXTURE);
+    TEST_ASSERT(stats.live_bytes == before.live_bytes, "Untrack should saturate at zero");
+
+    return 1;
+}
+
+/**
+ * \brief           Test installing a custom allocator
+ * \return          1 on success, 0 on failure
+ */
+static int test_alloc_custom_allocator(void)
+{
+    test_allocator_context_t context   = { 0, 0, 0 };
+    mvn_allocator_t          allocator = { test_malloc, test_realloc, test_free, &context };
+
+    TEST_ASSERT(mvn_alloc_report_leaks() == 0, "No allocations should be alive");
+    TEST_ASSERT(mvn_set_allocator(&allocator), "Failed to install allocator");
+    TEST_ASSERT(mvn_get_allocator().user_data == &context, "Allocator context not stored");
+
+    mvn_string_t *str = mvn_string_from_cstr("custom");
+    TEST_ASSERT(str != NULL, "Failed to allocate with custom allocator");
+    TEST_ASSERT(mvn_string_append(str, " allocator with growth"), "Failed to append");
+    TEST_ASSERT(context.mallocs > 0 && context.reallocs > 0, "Custom allocator was not used");
+
+    TEST_ASSERT(!mvn_set_allocator(NULL), "Allocator must not change with live allocations");
+    mvn_string_free(str);
+    TEST_ASSERT(context.frees == context.mallocs, "Every allocation should be freed");
+
+    mvn_allocator_t incomplete = { test_malloc, NULL, test_free, &context };
+    TEST_ASSERT(!mvn_set_allocator(&incomplete), "Incomplete allocator should be rejected");
+
+    TEST_ASSERT(mvn_set_allocator(NULL), "Failed to restore default allocator");
+    TEST_ASSERT(mvn_get_allocator().user_data == NULL, "Default allocator has no context");
+
+    return 1;
+}
+
+int run_alloc_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== ALLOC TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_alloc_stats);
+    RUN_TEST(test_alloc_container_tags);
+    RUN_TEST(test_alloc_track);
+    RUN_TEST(test_alloc_custom_allocator);
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_alloc_tests(&passed, &failed, &total);
+
+    printf("\n===== ALLOC TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
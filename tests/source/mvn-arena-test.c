@@ -0,0 +1,324 @@
+/**
+ * \file            mvn-arena-test.c
+ * \brief           Tests for MVN arena allocator functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-arena.h"
+#include "mvn/mvn-list.h"
+#include "mvn/mvn-string.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * \brief           Test arena initialization, allocation and alignment
+ * \return          1 on success, 0 on failure
+ */
+static int test_arena_alloc(void)
+{
+    mvn_arena_t *arena = mvn_arena_init(0);
+    TEST_ASSERT(arena != NULL, "Failed to initialize arena");
+
+    mvn_arena_stats_t stats = mvn_arena_get_stats(arena);
+    TEST_ASSERT(stats.block_count == 0 && stats.reserved_bytes == 0,
+                "Arena should not reserve memory before the first allocation");
+
+    char *bytes = mvn_arena_alloc(arena, 3);
+    TEST_ASSERT(bytes != NULL, "Failed to allocate from arena");
+    SDL_memcpy(bytes, "ab", 3);
+
+    double *number = MVN_ARENA_NEW(arena, double);
+    TEST_ASSERT(number != NULL, "Failed to allocate typed object");
+    TEST_ASSERT(((uintptr_t)number % 16) == 0, "Default allocations should be 16 byte aligned");
+    *number = 1.5;
+
+    void *aligned = mvn_arena_alloc_aligned(arena, 10, 64);
+    TEST_ASSERT(aligned != NULL && ((uintptr_t)aligned % 64) == 0,
+                "Aligned allocation should honour the alignment");
+    TEST_ASSERT(mvn_arena_alloc_aligned(arena, 10, 3) == NULL,
+                "Non power of two alignment should fail");
+    TEST_ASSERT(strcmp(bytes, "ab") == 0 && *number == 1.5, "Earlier allocations were clobbered");
+
+    stats = mvn_arena_get_stats(arena);
+    TEST_ASSERT(stats.allocation_count == 3, "Allocation count incorrect");
+    TEST_ASSERT(stats.allocated_bytes == 3 + sizeof(double) + 10, "Allocated bytes incorrect");
+    TEST_ASSERT(stats.heap_allocations == 1, "All allocations should share one block");
+
+    TEST_ASSERT(mvn_arena_alloc(NULL, 8) == NULL, "Allocating from NULL arena should fail");
+    mvn_arena_free(arena);
+    mvn_arena_free(NULL);
+
+    return 1;
+}
+
+/**
+ * \brief           Test block chaining, oversized allocations and reset consolidation
+ * \return          1 on success, 0 on failure
+ */
+static int test_arena_blocks(void)
+{
+    mvn_arena_t *arena = mvn_arena_init(256);
+    TEST_ASSERT(arena != NULL, "Failed to initialize arena");
+
+    int *values[32];
+    for (int i = 0; i < 32; i++) {
+        values[i] = mvn_arena_alloc(arena, 32);
+        TEST_ASSERT(values[i] != NULL, "Failed to allocate across blocks");
+        *values[i] = i;
+    }
+    for (int i = 0; i < 32; i++) {
+        TEST_ASSERT(*values[i] == i, "Values in earlier blocks should be preserved");
+    }
+
+    char *large = mvn_arena_alloc(arena, 4096);
+    TEST_ASSERT(large != NULL, "Allocation larger than the block size should succeed");
+    SDL_memset(large, 0x5A, 4096);
+
+    mvn_arena_stats_t stats = mvn_arena_get_stats(arena);
+    TEST_ASSERT(stats.block_count > 1, "Arena should have chained additional blocks");
+    TEST_ASSERT(stats.peak_used_bytes >= 32 * 32 + 4096, "Peak usage incorrect");
+
+    // A reset merges the spilled blocks so the next frame fits in a single block
+    size_t heap_before = stats.heap_allocations;
+    mvn_arena_reset(arena);
+    stats = mvn_arena_get_stats(arena);
+    TEST_ASSERT(stats.used_bytes == 0 && stats.reset_count == 1, "Reset should release usage");
+
+    for (int i = 0; i < 32; i++) {
+        TEST_ASSERT(mvn_arena_alloc(arena, 32) != NULL, "Allocation after reset failed");
+    }
+    TEST_ASSERT(mvn_arena_alloc(arena, 4096) != NULL, "Large allocation after reset failed");
+    stats = mvn_arena_get_stats(arena);
+    TEST_ASSERT(stats.block_count == 1, "Same workload should fit in one block after reset");
+    TEST_ASSERT(stats.heap_allocations == heap_before + 1, "Only one new block expected");
+
+    // Steady state: further frames do not touch the general allocator
+    mvn_arena_reset(arena);
+    TEST_ASSERT(mvn_arena_alloc(arena, 1024) != NULL, "Allocation after reset failed");
+    TEST_ASSERT(mvn_arena_get_stats(arena).heap_allocations == heap_before + 1,
+                "Steady state allocations should reuse the block");
+
+    mvn_arena_free(arena);
+    return 1;
+}
+
+/**
+ * \brief           Test scope markers
+ * \return          1 on success, 0 on failure
+ */
+static int test_arena_markers(void)
+{
+    mvn_arena_t *arena = mvn_arena_init(128);
+    TEST_ASSERT(arena != NULL, "Failed to initialize arena");
+
+    mvn_arena_marker_t start = mvn_arena_mark(arena);
+    char              *keep  = mvn_arena_alloc(arena, 16);
+    TEST_ASSERT(keep != NULL, "Allocation failed");
+    SDL_memcpy(keep, "persistent", 11);
+    size_t used_outer = mvn_arena_get_stats(arena).used_bytes;
+
+    // Scratch allocations inside a scope, spanning several blocks
+    mvn_arena_marker_t scope   = mvn_arena_mark(arena);
+    void              *scratch = mvn_arena_alloc(arena, 48);
+    TEST_ASSERT(scratch != NULL, "Scratch allocation failed");
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT(mvn_arena_alloc(arena, 100) != NULL, "Scratch allocation failed");
+    }
+    size_t blocks = mvn_arena_get_stats(arena).block_count;
+
+    mvn_arena_rewind(arena, scope);
+    TEST_ASSERT(mvn_arena_get_stats(arena).used_bytes == used_outer,
+                "Rewind should restore used bytes");
+    TEST_ASSERT(strcmp(keep, "persistent") == 0, "Rewind should keep earlier allocations");
+    TEST_ASSERT(mvn_arena_alloc(arena, 48) == scratch, "Rewound memory should be reused");
+
+    // Rewound blocks are reused instead of allocating new ones
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT(mvn_arena_alloc(arena, 100) != NULL, "Allocation after rewind failed");
+    }
+    TEST_ASSERT(mvn_arena_get_stats(arena).block_count == blocks,
+                "Rewound blocks should be reused");
+
+    mvn_arena_rewind(arena, start);
+    TEST_ASSERT(mvn_arena_get_stats(arena).used_bytes == 0, "Rewind to start should empty arena");
+    TEST_ASSERT(mvn_arena_alloc(arena, 16) == keep, "Memory should be reused from the start");
+
+    mvn_arena_free(arena);
+    return 1;
+}
+
+/**
+ * \brief           Test in-place and copying reallocation
+ * \return          1 on success, 0 on failure
+ */
+static int test_arena_realloc(void)
+{
+    mvn_arena_t *arena = mvn_arena_init(1024);
+    TEST_ASSERT(arena != NULL, "Failed to initialize arena");
+
+    char *first = mvn_arena_realloc(arena, NULL, 0, 8);
+    TEST_ASSERT(first != NULL, "Realloc of NULL should allocate");
+    SDL_memcpy(first, "1234567", 8);
+
+    char *grown = mvn_arena_realloc(arena, first, 8, 64);
+    TEST_ASSERT(grown == first, "Last allocation should grow in place");
+    TEST_ASSERT(strcmp(grown, "1234567") == 0, "Grown data should be preserved");
+
+    char *other = mvn_arena_alloc(arena, 8);
+    TEST_ASSERT(other != NULL, "Allocation failed");
+
+    char *moved = mvn_arena_realloc(arena, grown, 64, 128);
+    TEST_ASSERT(moved != NULL && moved != grown, "Older allocation should be copied");
+    TEST_ASSERT(strcmp(moved, "1234567") == 0, "Copied data should be preserved");
+
+    char *beyond = mvn_arena_realloc(arena, moved, 128, 4096);
+    TEST_ASSERT(beyond != NULL && strcmp(beyond, "1234567") == 0,
+                "Growth beyond the block should copy into a new block");
+
+    mvn_arena_free(arena);
+    return 1;
+}
+
+/**
+ * \brief           Test arena backed strings, string builders and lists
+ * \return          1 on success, 0 on failure
+ */
+static int test_arena_containers(void)
+{
+    mvn_arena_t *arena = mvn_arena_init(0);
+    TEST_ASSERT(arena != NULL, "Failed to initialize arena");
+
+    mvn_string_t *str = mvn_string_from_cstr_arena(arena, "frame");
+    TEST_ASSERT(str != NULL && str->arena == arena, "Failed to create arena string");
+    for (int i = 0; i < 20; i++) {
+        TEST_ASSERT(mvn_string_append(str, "_text"), "Failed to grow arena string");
+    }
+    TEST_ASSERT(mvn_string_length(str) == 5 + 20 * 5, "Arena string length incorrect");
+    TEST_ASSERT(mvn_string_starts_with(str, "frame_text_text"), "Arena string data incorrect");
+
+    mvn_string_t *empty = mvn_string_init_arena(arena, 0);
+    TEST_ASSERT(empty != NULL && mvn_string_length(empty) == 0, "Empty arena string failed");
+
+    mvn_list_t *list = mvn_list_init_arena(arena, sizeof(int), 2);
+    TEST_ASSERT(list != NULL && list->arena == arena, "Failed to create arena list");
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT(mvn_list_push(list, &i), "Failed to grow arena list");
+    }
+    TEST_ASSERT(*(int *)mvn_list_get(list, 99) == 99, "Arena list data incorrect");
+
+    mvn_strbuf_t *buf = mvn_strbuf_init_arena(arena, 8);
+    TEST_ASSERT(buf != NULL && buf->arena == arena, "Failed to create arena string builder");
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT(mvn_strbuf_appendf(buf, "[%d]", i), "Failed to grow arena string builder");
+    }
+    mvn_string_t *built = mvn_strbuf_finish(buf);
+    TEST_ASSERT(built != NULL && built->arena == arena, "Finished string should stay in arena");
+    TEST_ASSERT(strcmp(mvn_string_to_cstr(built), "[0][1][2][3][4][5][6][7][8][9]") == 0,
+                "Arena string builder data incorrect");
+
+    // Everything above came out of the arena's first block
+    mvn_arena_stats_t stats = mvn_arena_get_stats(arena);
+    TEST_ASSERT(stats.heap_allocations == 1, "Containers should not hit the general allocator");
+
+    // Freeing arena containers is a no-op, the arena reclaims them
+    mvn_string_free(str);
+    mvn_string_free(empty);
+    mvn_string_free(built);
+    mvn_list_free(list);
+
+    TEST_ASSERT(mvn_string_init_arena(NULL, 0) == NULL, "NULL arena string should fail");
+    TEST_ASSERT(mvn_list_init_arena(NULL, sizeof(int), 0) == NULL, "NULL arena list should fail");
+    TEST_ASSERT(mvn_strbuf_init_arena(NULL, 0) == NULL, "NULL arena builder should fail");
+
+    mvn_arena_free(arena);
+    return 1;
+}
+
+/**
+ * \brief           Thread entry point that reports its thread arena
+ * \param[in]       data: Pointer receiving the arena of the thread
+ * \return          0 on success
+ */
+static int SDLCALL thread_arena_worker(void *data)
+{
+    mvn_arena_t *arena = mvn_get_thread_arena();
+    if (arena != NULL) {
+        (void)mvn_arena_alloc(arena, 64);
+    }
+    *(mvn_arena_t **)data = arena;
+    return 0;
+}
+
+/**
+ * \brief           Test per-thread arenas
+ * \return          1 on success, 0 on failure
+ */
+static int test_thread_arena(void)
+{
+    mvn_arena_t *arena = mvn_get_thread_arena();
+    TEST_ASSERT(arena != NULL, "Failed to get thread arena");
+    TEST_ASSERT(mvn_get_thread_arena() == arena, "Thread arena should be reused");
+
+    mvn_arena_t *worker_arena = NULL;
+    SDL_Thread  *thread = SDL_CreateThread(thread_arena_worker, "arena_worker", &worker_arena);
+    TEST_ASSERT(thread != NULL, "Failed to create thread");
+    SDL_WaitThread(thread, NULL);
+
+    TEST_ASSERT(worker_arena != NULL, "Worker thread should get an arena");
+    TEST_ASSERT(worker_arena != arena, "Each thread should get its own arena");
+
+    return 1;
+}
+
+/**
+ * \brief           Run all arena tests
+ * \param[out] passed_tests Pointer to the number of passed tests
+ * \param[out] failed_tests Pointer to the number of failed tests
+ * \param[out] total_tests Pointer to the total number of tests
+ * \return          Number of passed tests
+ */
+int run_arena_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== ARENA TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_arena_alloc);
+    RUN_TEST(test_arena_blocks);
+    RUN_TEST(test_arena_markers);
+    RUN_TEST(test_arena_realloc);
+    RUN_TEST(test_arena_containers);
+    RUN_TEST(test_thread_arena);
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_arena_tests(&passed, &failed, &total);
+
+    printf("\n===== ARENA TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
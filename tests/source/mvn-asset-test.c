@@ -0,0 +1,200 @@
+/**
+ * \file            mvn-asset-test.c
+ * \brief           Tests for MVN asynchronous asset loading functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-asset.h"
+#include "mvn/mvn-core.h"
+#include "mvn/mvn-job.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+/* Frames rendered at most while waiting for a load */
+#define ASSET_TEST_MAX_FRAMES 500
+
+/**
+ * \brief           Build the path of a test asset
+ * \param[out]      buffer: Buffer receiving the path
+ * \param[in]       size: Size of buffer
+ * \param[in]       name: File name in the test asset directory
+ */
+static void asset_path(char *buffer, size_t size, const char *name)
+{
+    SDL_snprintf(buffer, size, "%s/%s", ASSET_DIR, name);
+}
+
+/**
+ * \brief           Render frames until an asset is done or the frame limit is reached
+ * \param[in]       asset: Handle to wait for
+ * \return          Final state of the asset
+ */
+static mvn_asset_state_t wait_for_asset(mvn_asset_t *asset)
+{
+    for (int i = 0; i < ASSET_TEST_MAX_FRAMES && !mvn_asset_is_done(asset); i++) {
+        mvn_begin_drawing();
+        mvn_end_drawing();
+    }
+    return mvn_asset_get_state(asset);
+}
+
+/**
+ * \brief           Test loading fonts on the workers
+ * \return          1 on success, 0 on failure
+ */
+static int test_asset_font_async(void)
+{
+    char path[256];
+    asset_path(path, sizeof(path), "test-font.ttf");
+
+    mvn_asset_t *asset   = mvn_load_font_async(path, 16.0f);
+    mvn_asset_t *missing = mvn_load_font_async("missing-font.ttf", 16.0f);
+    TEST_ASSERT(asset != NULL && missing != NULL, "Failed to request font loads");
+
+    TEST_ASSERT(wait_for_asset(asset) == MVN_ASSET_READY, "Font should load");
+    TEST_ASSERT(wait_for_asset(missing) == MVN_ASSET_FAILED, "Missing font should fail");
+    TEST_ASSERT(mvn_asset_get_texture(asset) == NULL, "Font handle has no texture");
+
+    TTF_Font *font = mvn_asset_get_font(asset);
+    TEST_ASSERT(font != NULL, "Loaded font should be available");
+    TEST_ASSERT(mvn_asset_get_font(asset) == font, "Font should stay available");
+    TEST_ASSERT(!mvn_asset_cancel(asset), "Finished loads cannot be cancelled");
+
+    mvn_asset_release(asset);
+    mvn_asset_release(missing);
+    mvn_unload_font(font);
+
+    TEST_ASSERT(mvn_get_pending_asset_count() == 0, "No loads should be pending");
+    TEST_ASSERT(mvn_get_asset_load_progress() == 1.0f, "Progress should be complete");
+    return 1;
+}
+
+/**
+ * \brief           Test decoding textures on the workers and uploading them on the main thread
+ * \return          1 on success, 0 on failure
+ */
+static int test_asset_texture_async(void)
+{
+    char path[256];
+    asset_path(path, sizeof(path), "char-1.png");
+
+    mvn_asset_t *asset = mvn_load_texture_async(path);
+    TEST_ASSERT(asset != NULL, "Failed to request texture load");
+
+    // Textures are only created by the frame loop
+    SDL_Delay(50);
+    TEST_ASSERT(mvn_asset_get_texture(asset) == NULL, "Texture needs a frame to upload");
+
+    TEST_ASSERT(wait_for_asset(asset) == MVN_ASSET_READY, "Texture should load");
+    mvn_texture_t *texture = mvn_asset_get_texture(asset);
+    TEST_ASSERT(texture != NULL && texture->w > 0 && texture->h > 0, "Texture should be valid");
+    mvn_asset_release(asset);
+    mvn_unload_texture(texture);
+
+    // A cancelled load never creates its texture
+    asset = mvn_load_texture_async(path);
+    TEST_ASSERT(mvn_asset_cancel(asset), "Pending load should be cancellable");
+    TEST_ASSERT(wait_for_asset(asset) == MVN_ASSET_CANCELLED, "Load should be cancelled");
+    TEST_ASSERT(mvn_asset_get_texture(asset) == NULL, "Cancelled load has no texture");
+    mvn_asset_release(asset);
+
+    return 1;
+}
+
+/**
+ * \brief           Test spreading texture uploads over frames
+ * \return          1 on success, 0 on failure
+ */
+static int test_asset_upload_budget(void)
+{
+    char         path[256];
+    mvn_asset_t *assets[3];
+    asset_path(path, sizeof(path), "char-1.png");
+
+    for (int i = 0; i < 3; i++) {
+        assets[i] = mvn_load_texture_async(path);
+        TEST_ASSERT(assets[i] != NULL, "Failed to request texture load");
+    }
+    TEST_ASSERT(mvn_get_pending_asset_count() == 3, "Three loads should be pending");
+
+    // Wait until every image is decoded and only the uploads are left
+    for (int i = 0; i < 3; i++) {
+        for (int wait = 0; wait < 500 && mvn_asset_get_state(assets[i]) != MVN_ASSET_UPLOADING;
+             wait++) {
+            SDL_Delay(1);
+        }
+        TEST_ASSERT(mvn_asset_get_state(assets[i]) == MVN_ASSET_UPLOADING, "Decode too slow");
+    }
+    TEST_ASSERT(mvn_get_asset_load_progress() == 0.0f, "Nothing should be finished yet");
+
+    // With no budget every frame still makes progress with one upload
+    mvn_set_asset_upload_budget(0.0);
+    TEST_ASSERT(mvn_process_asset_uploads() == 1, "One upload per frame expected");
+    TEST_ASSERT(mvn_get_pending_asset_count() == 2, "Two loads should be left");
+    float progress = mvn_get_asset_load_progress();
+    TEST_ASSERT(progress > 0.33f && progress < 0.34f, "A third of the batch should be done");
+
+    mvn_set_asset_upload_budget(1.0);
+    TEST_ASSERT(mvn_process_asset_uploads() == 2, "The remaining uploads fit the budget");
+    TEST_ASSERT(mvn_get_asset_load_progress() == 1.0f, "Batch should be complete");
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT(mvn_asset_get_state(assets[i]) == MVN_ASSET_READY, "Texture should be ready");
+        mvn_asset_release(assets[i]); // Frees the texture that was never taken
+    }
+
+    mvn_set_asset_upload_budget(0.002);
+    return 1;
+}
+
+int run_asset_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== ASSET TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    // Textures need a renderer, headless rendering works on CI runners too
+    if (!mvn_init_headless(64, 64)) {
+        printf("ERROR: Failed to initialize MVN for asset tests. Skipping asset tests.\n");
+        (*total_tests)++;
+        (*failed_tests)++;
+        return 0;
+    }
+
+    RUN_TEST(test_asset_font_async);
+    RUN_TEST(test_asset_texture_async);
+    RUN_TEST(test_asset_upload_budget);
+
+    mvn_quit();
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_asset_tests(&passed, &failed, &total);
+
+    printf("\n===== ASSET TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -126,6 +126,184 @@ static int test_core_timing(void)
     return 1; // Success
 }
 
+/**
+ * \brief           Count fixed updates run through mvn_run_fixed_updates
+ * \param[in]       fixed_delta: Time simulated by the update
+ * \param[in]       user_data: Pointer to the update counter
+ */
+static void count_fixed_update(float fixed_delta, void *user_data)
+{
+    (void)fixed_delta;
+    (*(int *)user_data)++;
+}
+
+/**
+ * \brief           Test fixed update configuration without a running frame loop
+ * \return          1 on success, 0 on failure
+ */
+static int test_core_fixed_update_config(void)
+{
+    TEST_ASSERT(!mvn_set_fixed_update_rate(0.0), "Zero update rate should be rejected");
+    TEST_ASSERT(!mvn_set_fixed_update_rate(-30.0), "Negative update rate should be rejected");
+    TEST_ASSERT(mvn_set_fixed_update_rate(50.0), "Failed to set fixed update rate");
+    TEST_ASSERT(SDL_fabs(mvn_get_fixed_update_rate() - 50.0) < 0.001, "Update rate not stored");
+    TEST_ASSERT(SDL_fabs(mvn_get_fixed_frame_time() - 0.02f) < 0.0001f, "Fixed step incorrect");
+
+    TEST_ASSERT(!mvn_fixed_update(), "No update should be due before any frame time passed");
+    TEST_ASSERT(mvn_get_fixed_alpha() >= 0.0f && mvn_get_fixed_alpha() < 1.0f,
+                "Alpha should be within [0, 1)");
+    TEST_ASSERT(mvn_run_fixed_updates(NULL, NULL) == -1, "NULL callback should be rejected");
+
+    mvn_set_fixed_update_rate(60.0);
+    return 1;
+}
+
+/**
+ * \brief           Test fixed updates driven by the frame loop
+ * \return          1 on success, 0 on failure
+ */
+static int test_core_fixed_update(void)
+{
+    if (!mvn_init(10, 10, "Fixed Update Test", MVN_WINDOW_HIDDEN)) {
+        TEST_ASSERT(false, "mvn_init failed for fixed update test");
+        return 0;
+    }
+
+    // Render at 120 FPS while simulating at 60 Hz for half a second
+    mvn_set_target_fps(120);
+    mvn_set_fixed_update_rate(60.0);
+
+    int      polled      = 0;
+    int      called      = 0;
+    int      idle_frames = 0;
+    uint64_t loop_end    = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() / 2;
+    while (SDL_GetPerformanceCounter() < loop_end) {
+        mvn_begin_drawing();
+        int frame_updates = 0;
+        while (mvn_fixed_update()) {
+            frame_updates++;
+        }
+        polled += frame_updates;
+        idle_frames += (frame_updates == 0);
+
+        float alpha = mvn_get_fixed_alpha();
+        TEST_ASSERT(alpha >= 0.0f && alpha < 1.0f, "Alpha should be within [0, 1)");
+        mvn_end_drawing();
+    }
+
+    TEST_ASSERT(polled > 20 && polled < 40, "Expected ~30 fixed updates in half a second");
+    TEST_ASSERT(idle_frames > 0, "Frames faster than the update rate should skip updates");
+    TEST_ASSERT(mvn_get_fixed_tick() == (uint64_t)polled, "Fixed tick count mismatch");
+
+    // A long stall must not trigger more updates than the clamp allows
+    // (64 Hz keeps the step exact in binary so the clamp divides evenly)
+    mvn_set_fixed_update_rate(64.0);
+    mvn_set_max_fixed_updates(3);
+    SDL_Delay(200);
+    mvn_begin_drawing();
+    TEST_ASSERT(mvn_run_fixed_updates(count_fixed_update, &called) == 3,
+                "Fixed updates should be clamped after a stall");
+    TEST_ASSERT(called == 3, "Callback should run once per fixed update");
+    mvn_end_drawing();
+
+    mvn_set_max_fixed_updates(8);
+    mvn_set_fixed_update_rate(60.0);
+    mvn_quit();
+    return 1;
+}
+
+/**
+ * \brief           Test frame statistics configuration without a running frame loop
+ * \return          1 on success, 0 on failure
+ */
+static int test_core_frame_stats_config(void)
+{
+    mvn_frame_sample_t samples[4];
+
+    TEST_ASSERT(!mvn_set_hitch_threshold(0.0f), "Zero hitch threshold should be rejected");
+    TEST_ASSERT(mvn_set_hitch_threshold(0.05f), "Failed to set hitch threshold");
+    TEST_ASSERT(mvn_get_frame_stats().sample_count == 0, "No frames should be recorded yet");
+    TEST_ASSERT(mvn_get_frame_history(samples, 4) == 0, "History should be empty");
+    TEST_ASSERT(mvn_get_frame_history(NULL, 4) == 0, "NULL history buffer should be rejected");
+
+    mvn_set_hitch_threshold(1.0f / 30.0f);
+    return 1;
+}
+
+/**
+ * \brief           Test frame statistics recorded by the frame loop
+ * \return          1 on success, 0 on failure
+ */
+static int test_core_frame_stats(void)
+{
+    if (!mvn_init(10, 10, "Frame Stats Test", MVN_WINDOW_HIDDEN)) {
+        TEST_ASSERT(false, "mvn_init failed for frame stats test");
+        return 0;
+    }
+
+    mvn_set_target_fps(200);
+    for (int i = 0; i < 40; i++) {
+        mvn_begin_drawing();
+        if (i == 20) {
+            SDL_Delay(60); // Simulate a hitch
+        }
+        mvn_end_drawing();
+    }
+
+    mvn_frame_stats_t stats = mvn_get_frame_stats();
+    TEST_ASSERT(stats.sample_count == 40, "Every frame should be recorded");
+    TEST_ASSERT(stats.total.min <= stats.total.p50 && stats.total.p50 <= stats.total.p95 &&
+                    stats.total.p95 <= stats.total.p99 && stats.total.p99 <= stats.total.max,
+                "Percentiles should be ordered");
+    TEST_ASSERT(stats.total.avg >= stats.total.min && stats.total.avg <= stats.total.max,
+                "Average should be within the range");
+    TEST_ASSERT(stats.total.max >= 0.06f, "The hitch frame should be the longest frame");
+    TEST_ASSERT(stats.hitch_count >= 1 && stats.recent_hitch_count >= 1, "Hitch not counted");
+    TEST_ASSERT(stats.wait.avg > 0.0f, "Frames should wait for the target frame rate");
+
+    mvn_frame_sample_t samples[8];
+    TEST_ASSERT(mvn_get_frame_history(samples, 8) == 8, "History should fill the buffer");
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT(samples[i].cpu + samples[i].present + samples[i].wait <=
+                        samples[i].total + 0.0001f,
+                    "Frame phases should add up to the frame time");
+    }
+
+    mvn_quit();
+    return 1;
+}
+
+/**
+ * \brief           Test deferring audio and text startup to their first use
+ * \return          1 on success, 0 on failure
+ */
+static int test_core_lazy_init(void)
+{
+    mvn_set_init_flags(MVN_INIT_LAZY);
+    bool initialized = mvn_init_headless(16, 16);
+    mvn_set_init_flags(MVN_INIT_DEFAULT);
+    TEST_ASSERT(initialized, "Headless initialization failed");
+
+    TEST_ASSERT(TTF_WasInit() == 0, "SDL_ttf should not be started yet");
+    TEST_ASSERT(!SDL_WasInit(SDL_INIT_AUDIO), "Audio should not be started yet");
+
+    TEST_ASSERT(mvn_get_text_engine() != NULL, "Text engine should be created on first use");
+    TEST_ASSERT(TTF_WasInit() > 0, "SDL_ttf should be started with the text engine");
+    TEST_ASSERT(mvn_get_text_engine() == mvn_get_text_engine(), "Text engine should be reused");
+
+    // The dummy audio driver is always available
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    TEST_ASSERT(mvn_init_audio(), "Failed to start audio on demand");
+    TEST_ASSERT(SDL_WasInit(SDL_INIT_AUDIO), "Audio should be running");
+    TEST_ASSERT(mvn_init_audio(), "Starting audio twice should succeed");
+
+    mvn_quit();
+    SDL_ResetHint(SDL_HINT_AUDIO_DRIVER);
+
+    TEST_ASSERT(mvn_get_text_engine() == NULL, "Text engine needs a renderer");
+    return 1;
+}
+
 /**
  * \brief           Run all core tests
  * \param[out] passed_tests Pointer to the number of passed tests
@@ -142,10 +320,15 @@ int run_core_tests(int *passed_tests, int *failed_tests, int *total_tests)
 
     RUN_TEST(test_engine_version);
     RUN_TEST(test_colors);
+    RUN_TEST(test_core_fixed_update_config);
+    RUN_TEST(test_core_frame_stats_config);
+    RUN_TEST(test_core_lazy_init);
 #if defined(MVN_TEST_CI)
     printf("Skipping core timing tests in CI mode.\n");
 #else
     RUN_TEST(test_core_timing);
+    RUN_TEST(test_core_fixed_update);
+    RUN_TEST(test_core_frame_stats);
 #endif
 
     // Calculate how many tests were run
@@ -35,6 +35,7 @@
 
 #include "mvn-test-utils.h"
 #include "mvn/mvn-error.h"
+#include "mvn/mvn-logger.h"
 
 #include <SDL3/SDL.h>
 #include <stdio.h>
@@ -104,6 +105,111 @@ static bool test_error_return_values(void)
     return true;
 }
 
+/**
+ * \brief           Log output function counting the messages it receives
+ * \param[in]       userdata: Counter to increment (int)
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       message: Log message
+ */
+static void
+count_log_output(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    (void)category; /* Unused */
+    (void)priority; /* Unused */
+    (void)message;  /* Unused */
+
+    (*(int *)userdata)++;
+}
+
+/**
+ * \brief           Test that setting an error does not log it at error level
+ * \return          true if test passes, false otherwise
+ */
+static bool test_error_not_logged(void)
+{
+    printf("Testing that errors are not logged...\n");
+
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    int                   count = 0;
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetLogOutputFunction(count_log_output, &count);
+    mvn_logger_set_level(MVN_LOG_CATEGORY_ERROR, MVN_LOG_ERROR);
+
+    for (int i = 0; i < 100; i++) {
+        mvn_set_error("Error in a frame loop %d", i);
+    }
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+
+    TEST_ASSERT(count == 0, "Errors should only be logged at debug level");
+    TEST_ASSERT(SDL_strcmp(mvn_get_error(), "Error in a frame loop 99") == 0,
+                "Last error should still be stored");
+
+    printf("PASS: Errors are not logged at error level\n");
+    return true;
+}
+
+/**
+ * \brief           Test error codes and that arguments are kept until the message is read
+ * \return          true if test passes, false otherwise
+ */
+static bool test_error_codes(void)
+{
+    printf("Testing error codes...\n");
+
+    char name[16] = "texture";
+    mvn_set_error_code(MVN_ERROR_NOT_FOUND, "Asset '%s' (%d, %.1f) not found", name, -3, 2.5);
+    TEST_ASSERT(mvn_get_error_code() == MVN_ERROR_NOT_FOUND, "Error code not stored");
+
+    // The message is formatted when read, from a copy of the arguments
+    SDL_strlcpy(name, "changed", sizeof(name));
+    TEST_ASSERT(SDL_strcmp(mvn_get_error(), "Asset 'texture' (-3, 2.5) not found") == 0,
+                "Message should be formatted from the arguments at the time of the error");
+    TEST_ASSERT(mvn_get_error() == mvn_get_error(), "Message buffer should be reused");
+
+    mvn_set_error("Plain error");
+    TEST_ASSERT(mvn_get_error_code() == MVN_ERROR_UNKNOWN, "mvn_set_error should set unknown");
+    TEST_ASSERT(SDL_strcmp(mvn_get_error_code_name(MVN_ERROR_NOT_FOUND), "not found") == 0,
+                "Error code name incorrect");
+
+    mvn_clear_error();
+    TEST_ASSERT(mvn_get_error_code() == MVN_ERROR_NONE, "Clearing should reset the code");
+
+    printf("PASS: Error codes working correctly\n");
+    return true;
+}
+
+/**
+ * \brief           Test the history of recent errors
+ * \return          true if test passes, false otherwise
+ */
+static bool test_error_history(void)
+{
+    printf("Testing error history...\n");
+
+    char message[MVN_ERROR_MESSAGE_SIZE];
+    for (int i = 0; i < MVN_ERROR_HISTORY_SIZE + 3; i++) {
+        mvn_set_error_code(MVN_ERROR_IO, "History error %d", i);
+    }
+    mvn_clear_error();
+
+    TEST_ASSERT(mvn_get_error_history_count() == MVN_ERROR_HISTORY_SIZE,
+                "History should keep MVN_ERROR_HISTORY_SIZE errors");
+    TEST_ASSERT(mvn_get_recent_error(0, message, sizeof(message)) == MVN_ERROR_IO,
+                "Newest error code incorrect");
+    TEST_ASSERT(SDL_strcmp(message, "History error 10") == 0, "Newest error message incorrect");
+    mvn_get_recent_error(MVN_ERROR_HISTORY_SIZE - 1, message, sizeof(message));
+    TEST_ASSERT(SDL_strcmp(message, "History error 3") == 0, "Oldest error message incorrect");
+    TEST_ASSERT(mvn_get_recent_error(MVN_ERROR_HISTORY_SIZE, message, sizeof(message)) ==
+                        MVN_ERROR_NONE &&
+                    message[0] == '\0',
+                "Out of range index should return no error");
+
+    printf("PASS: Error history working correctly\n");
+    return true;
+}
+
 /**
  * \brief           Run all error tests
  * \param[out]      passed_tests: Pointer to passed tests counter
@@ -114,11 +220,14 @@ void run_error_tests(int *passed_tests, int *failed_tests, int *total_tests)
 {
     printf("\n===== RUNNING ERROR TESTS =====\n");
 
-    *total_tests += 3; // Update this if you add more tests
+    *total_tests += 6; // Update this if you add more tests
 
     RUN_TEST(test_basic_error);
     RUN_TEST(test_error_formatting);
     RUN_TEST(test_error_return_values);
+    RUN_TEST(test_error_not_logged);
+    RUN_TEST(test_error_codes);
+    RUN_TEST(test_error_history);
 
     printf("\n");
 }
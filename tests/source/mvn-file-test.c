@@ -11,6 +11,8 @@
  * Author:          Jake Larson
  */
 #include "mvn-test-utils.h"
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-error.h"
 #include "mvn/mvn-file.h"
 #include "mvn/mvn-logger.h"
 #include "mvn/mvn-string.h"
@@ -198,6 +200,183 @@ static int test_get_file_mod_time(void)
     return 1;
 }
 
+/**
+ * \brief           Test mapping, streaming and loading whole files
+ * \return          1 on success, 0 on failure
+ */
+static int test_file_map_and_load(void)
+{
+    const char *content = "mapped file\ncontents";
+    size_t      length  = SDL_strlen(content);
+
+    SDL_IOStream *file = SDL_IOFromFile(TEMP_FILE_NAME, "wb");
+    TEST_ASSERT(file != NULL, "Failed to create temp file");
+    TEST_ASSERT(SDL_WriteIO(file, content, length) == length, "Failed to write temp file");
+    SDL_CloseIO(file);
+
+    mvn_file_view_t view;
+    TEST_ASSERT(mvn_file_map(TEMP_FILE_NAME, &view), "Failed to map file");
+    TEST_ASSERT(view.size == length && SDL_memcmp(view.data, content, length) == 0,
+                "Mapped contents do not match");
+#if defined(__linux__)
+    TEST_ASSERT(view.mapped, "Regular files should be memory mapped on Linux");
+#endif
+    mvn_file_unmap(&view);
+    TEST_ASSERT(view.data == NULL && view.size == 0, "Unmap should reset the view");
+
+    SDL_IOStream *stream = mvn_file_open_io(TEMP_FILE_NAME);
+    char          buffer[8];
+    TEST_ASSERT(stream != NULL, "Failed to open file stream");
+    TEST_ASSERT(SDL_GetIOSize(stream) == (int64_t)length, "Stream size incorrect");
+    TEST_ASSERT(SDL_SeekIO(stream, 7, SDL_IO_SEEK_SET) == 7, "Failed to seek stream");
+    TEST_ASSERT(SDL_ReadIO(stream, buffer, 4) == 4 && SDL_memcmp(buffer, "file", 4) == 0,
+                "Stream read incorrect");
+    TEST_ASSERT(SDL_SeekIO(stream, -3, SDL_IO_SEEK_END) == (int64_t)length - 3,
+                "Failed to seek from the end");
+    TEST_ASSERT(SDL_ReadIO(stream, buffer, sizeof(buffer)) == 3, "Read should stop at the end");
+    TEST_ASSERT(SDL_SeekIO(stream, 1, SDL_IO_SEEK_END) == -1, "Seek past the end should fail");
+    SDL_CloseIO(stream);
+
+    size_t size = 0;
+    void  *data = mvn_load_file_data(TEMP_FILE_NAME, &size);
+    TEST_ASSERT(data != NULL && size == length && SDL_memcmp(data, content, length) == 0,
+                "Loaded data does not match");
+    mvn_unload_file_data(data);
+
+    char *text = mvn_load_file_text(TEMP_FILE_NAME);
+    TEST_ASSERT(text != NULL && SDL_strcmp(text, content) == 0, "Loaded text does not match");
+    mvn_unload_file_text(text);
+
+    // Empty files cannot be mapped and are read instead
+    file = SDL_IOFromFile(TEMP_FILE_NAME, "wb");
+    TEST_ASSERT(file != NULL, "Failed to truncate temp file");
+    SDL_CloseIO(file);
+    TEST_ASSERT(mvn_file_map(TEMP_FILE_NAME, &view), "Failed to map empty file");
+    TEST_ASSERT(view.data != NULL && view.size == 0 && !view.mapped, "Empty view incorrect");
+    mvn_file_unmap(&view);
+
+    TEST_ASSERT(!mvn_file_map("non_existent_path_file", &view), "Mapping a missing file");
+    TEST_ASSERT(mvn_load_file_data("non_existent_path_file", &size) == NULL && size == 0,
+                "Loading a missing file should fail");
+    TEST_ASSERT(mvn_file_open_io("non_existent_path_file") == NULL,
+                "Streaming a missing file should fail");
+
+    (void)SDL_RemovePath(TEMP_FILE_NAME);
+    return 1;
+}
+
+/**
+ * \brief           Check that a view holds the expected characters
+ * \param[in]       view: View to check
+ * \param[in]       expected: Expected characters
+ * \return          true if they match, false otherwise
+ */
+static bool view_equals(mvn_path_view_t view, const char *expected)
+{
+    return view.length == SDL_strlen(expected) && SDL_memcmp(view.data, expected, view.length) == 0;
+}
+
+/**
+ * \brief           Test path views and that they match the allocating helpers
+ * \return          1 on success, 0 on failure
+ */
+static int test_path_views(void)
+{
+    const char *path = "assets/sprites.v2/player.png";
+
+    mvn_alloc_stats_t before = mvn_get_alloc_stats(MVN_ALLOC_TAG_STRING);
+    TEST_ASSERT(view_equals(mvn_get_file_extension_view(path), ".png"), "Extension view wrong");
+    TEST_ASSERT(view_equals(mvn_get_file_name_view(path), "player.png"), "Name view wrong");
+    TEST_ASSERT(view_equals(mvn_get_file_name_without_ext_view(path), "player"),
+                "Name without extension view wrong");
+    TEST_ASSERT(view_equals(mvn_get_directory_path_view(path), "assets/sprites.v2"),
+                "Directory view wrong");
+    TEST_ASSERT(view_equals(mvn_get_parent_directory_path_view("assets/sprites.v2/"), "assets"),
+                "Parent view wrong");
+    TEST_ASSERT(mvn_is_file_extension(path, ".PNG"), "Extension check should ignore case");
+    TEST_ASSERT(!mvn_is_file_extension("assets/sprites.v2/player", ".v2/player"),
+                "Dot in a directory is not an extension");
+    TEST_ASSERT(mvn_get_alloc_stats(MVN_ALLOC_TAG_STRING).allocation_count ==
+                    before.allocation_count,
+                "Views and extension checks should not allocate");
+
+    TEST_ASSERT(view_equals(mvn_get_file_extension_view(".hidden"), ""), "Dot file has no ext");
+    TEST_ASSERT(view_equals(mvn_get_file_name_view("dir\\file.txt"), "file.txt"),
+                "Backslash should separate");
+    TEST_ASSERT(view_equals(mvn_get_directory_path_view("file.txt"), "."), "No directory is .");
+    TEST_ASSERT(view_equals(mvn_get_directory_path_view("/file.txt"), ""), "Root file directory");
+    TEST_ASSERT(view_equals(mvn_get_parent_directory_path_view("///"), "/"), "Root parent");
+    TEST_ASSERT(view_equals(mvn_get_parent_directory_path_view("/usr"), "/"), "Top level parent");
+    TEST_ASSERT(view_equals(mvn_get_parent_directory_path_view("dir"), "."), "Relative parent");
+    TEST_ASSERT(mvn_get_file_name_view(NULL).length == 0, "NULL path should give an empty view");
+
+    // The allocating helpers return copies of the views
+    const char *paths[] = {"assets/player.png", "/file", "name", "a/b/", ".config", "a.b/c"};
+    for (size_t i = 0; i < SDL_arraysize(paths); i++) {
+        mvn_string_t *name   = mvn_get_file_name_without_ext(paths[i]);
+        mvn_string_t *parent = mvn_get_parent_directory_path(paths[i]);
+        TEST_ASSERT_FMT(view_equals(mvn_get_file_name_without_ext_view(paths[i]), name->data),
+                        "Name copy differs for %s",
+                        paths[i]);
+        TEST_ASSERT_FMT(view_equals(mvn_get_parent_directory_path_view(paths[i]), parent->data),
+                        "Parent copy differs for %s",
+                        paths[i]);
+        mvn_string_free(name);
+        mvn_string_free(parent);
+    }
+
+    return 1;
+}
+
+/**
+ * \brief           Test normalizing and joining paths into buffers
+ * \return          1 on success, 0 on failure
+ */
+static int test_path_normalize_join(void)
+{
+    const char *cases[][2] = {
+        {"a/./b//c/", "a/b/c"},
+        {"a\\b\\..\\c", "a/c"},
+        {"../../a/..", "../.."},
+        {"/../a/./b/..", "/a"},
+        {"a/..", "."},
+        {"", "."},
+        {"//", "/"},
+    };
+    char buffer[64];
+    for (size_t i = 0; i < SDL_arraysize(cases); i++) {
+        size_t length = mvn_normalize_path(cases[i][0], buffer, sizeof(buffer));
+        TEST_ASSERT_FMT(length == SDL_strlen(cases[i][1]) && SDL_strcmp(buffer, cases[i][1]) == 0,
+                        "Normalizing '%s' gave '%s'",
+                        cases[i][0],
+                        buffer);
+    }
+
+    // In place
+    SDL_strlcpy(buffer, "x/./y/../z", sizeof(buffer));
+    TEST_ASSERT(mvn_normalize_path(buffer, buffer, sizeof(buffer)) == 3, "In place length wrong");
+    TEST_ASSERT(SDL_strcmp(buffer, "x/z") == 0, "In place normalize wrong");
+
+    TEST_ASSERT(mvn_join_path("assets/fonts/", "../sprites/a.png", buffer, sizeof(buffer)) == 20,
+                "Join length wrong");
+    TEST_ASSERT(SDL_strcmp(buffer, "assets/sprites/a.png") == 0, "Join wrong");
+    TEST_ASSERT(mvn_join_path("assets", "/abs/b", buffer, sizeof(buffer)) > 0 &&
+                    SDL_strcmp(buffer, "/abs/b") == 0,
+                "Absolute name should replace the directory");
+    SDL_strlcpy(buffer, "/base", sizeof(buffer));
+    TEST_ASSERT(mvn_join_path(buffer, "c", buffer, sizeof(buffer)) > 0 &&
+                    SDL_strcmp(buffer, "/base/c") == 0,
+                "Joining into the directory buffer failed");
+
+    char small[4];
+    TEST_ASSERT(mvn_normalize_path("abcd", small, sizeof(small)) == 0, "Overflow should fail");
+    TEST_ASSERT(mvn_get_error_code() == MVN_ERROR_INVALID_ARGUMENT, "Overflow error code wrong");
+    TEST_ASSERT(mvn_normalize_path("abc", small, sizeof(small)) == 3, "Exact fit should succeed");
+    TEST_ASSERT(mvn_join_path(NULL, "a", buffer, sizeof(buffer)) == 0, "NULL should fail");
+
+    return 1;
+}
+
 /**
  * \brief           Run all file tests
  * \param[out] passed_tests Pointer to the number of passed tests
@@ -214,6 +393,9 @@ int run_file_tests(int *passed_tests, int *failed_tests, int *total_tests)
 
     RUN_TEST(test_get_application_directory);
     RUN_TEST(test_is_path_file_directory);
+    RUN_TEST(test_file_map_and_load);
+    RUN_TEST(test_path_views);
+    RUN_TEST(test_path_normalize_join);
 #if defined(MVN_TEST_CI)
     printf("Skipping test_get_file_mod_time tests in CI mode.\n");
 #else
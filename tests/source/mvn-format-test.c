@@ -0,0 +1,190 @@
+/**
+ * \file            mvn-format-test.c
+ * \brief           Tests for MVN deferred formatting functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-format.h"
+
+#include <SDL3/SDL.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * \brief           Pack arguments and format them later, like a deferred message
+ * \param[out]      out: Receives the text formatted from the packed arguments
+ * \param[in]       size: Size of out
+ * \param[in]       capacity: Bytes available for the packed arguments
+ * \param[out]      expected: Receives the text formatted directly with SDL_vsnprintf
+ * \param[in]       fmt: Format string
+ * \param[in]       ...: Arguments for the format string
+ * \return          true if the arguments could be packed and unpacked
+ */
+static bool round_trip(
+    char *out, size_t size, size_t capacity, char *expected, const char *fmt, ...)
+{
+    uint8_t types[MVN_FORMAT_MAX_ARGS];
+    uint8_t packed[512];
+    int     count = mvn_format_parse(fmt, types);
+    if (count < 0 || capacity > sizeof(packed)) {
+        return false;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    SDL_vsnprintf(expected, size, fmt, args);
+    va_end(args);
+
+    va_start(args, fmt);
+    size_t packed_size = mvn_format_pack(types, count, packed, capacity, args);
+    va_end(args);
+
+    const uint8_t *cursor = packed;
+    return mvn_format_unpack(out, size, fmt, &cursor, packed + packed_size) &&
+           cursor == packed + packed_size;
+}
+
+/**
+ * \brief           Test that packed arguments format like printf
+ * \return          1 on success, 0 on failure
+ */
+static int test_format_round_trip(void)
+{
+    char out[256];
+    char expected[256];
+
+    TEST_ASSERT(round_trip(out,
+                           sizeof(out),
+                           512,
+                           expected,
+                           "%d %i %u %5ld|%-5lld|%zu %hhd %hu %x %#o %c %%",
+                           -42,
+                           7,
+                           4000000000u,
+                           -7L,
+                           1LL << 40,
+                           (size_t)123,
+                           300,
+                           70000,
+                           0xbeef,
+                           8,
+                           'Z'),
+                "Failed to round trip integers");
+    TEST_ASSERT_FMT(strcmp(out, expected) == 0, "Integers: '%s' != '%s'", out, expected);
+
+    TEST_ASSERT(round_trip(out,
+                           sizeof(out),
+                           512,
+                           expected,
+                           "%.2f %8.3e %g %+.0f %*d %-*.*f|",
+                           3.14159,
+                           12345.678,
+                           0.5,
+                           2.5,
+                           6,
+                           42,
+                           8,
+                           2,
+                           1.005),
+                "Failed to round trip floating point values");
+    TEST_ASSERT_FMT(strcmp(out, expected) == 0, "Floats: '%s' != '%s'", out, expected);
+
+    TEST_ASSERT(round_trip(out,
+                           sizeof(out),
+                           512,
+                           expected,
+                           "%s|%-6s|%.3s|%8s|%.*s|%s|%p",
+                           "text",
+                           "pad",
+                           "truncated",
+                           "right",
+                           2,
+                           "star",
+                           "",
+                           (void *)&out),
+                "Failed to round trip strings and pointers");
+    TEST_ASSERT_FMT(strcmp(out, expected) == 0, "Strings: '%s' != '%s'", out, expected);
+
+    return 1;
+}
+
+/**
+ * \brief           Test formats that cannot be packed and truncation
+ * \return          1 on success, 0 on failure
+ */
+static int test_format_limits(void)
+{
+    uint8_t types[MVN_FORMAT_MAX_ARGS];
+    char    out[16];
+    char    expected[256];
+
+    TEST_ASSERT(mvn_format_parse("no arguments 100%%", types) == 0, "Literal format has no args");
+    TEST_ASSERT(mvn_format_parse("%d%n", types) == -1, "%n should not be packable");
+    TEST_ASSERT(mvn_format_parse("%ls", types) == -1, "Wide strings should not be packable");
+    TEST_ASSERT(mvn_format_parse("%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d", types) ==
+                    -1,
+                "Too many arguments should not be packable");
+    TEST_ASSERT(mvn_format_parse("%*.*d", types) == 3 && types[0] == MVN_FORMAT_ARG_INT &&
+                    types[2] == MVN_FORMAT_ARG_INT,
+                "Star width and precision should read ints");
+    TEST_ASSERT(mvn_format_parse("trailing %", types) == -1, "Incomplete spec is not packable");
+
+    // Output is truncated like snprintf
+    TEST_ASSERT(round_trip(out, sizeof(out), 512, expected, "%s and more", "a long string"),
+                "Failed to round trip a truncated message");
+    TEST_ASSERT_FMT(strcmp(out, "a long string a") == 0, "Truncated output was '%s'", out);
+
+    // Strings are cut to fit the packing capacity, later arguments keep their room
+    TEST_ASSERT(round_trip(out, sizeof(out), 14, expected, "%s%d", "abcdefghijkl", 5),
+                "Failed to round trip a string cut to fit");
+    TEST_ASSERT_FMT(strcmp(out, "abcd5") == 0, "Cut string output was '%s'", out);
+
+    // Arguments that do not match the format are rejected
+    uint8_t        packed[4] = { 0 };
+    const uint8_t *cursor    = packed;
+    TEST_ASSERT(!mvn_format_unpack(out, sizeof(out), "%d", &cursor, packed + sizeof(packed)),
+                "Truncated arguments should fail to unpack");
+
+    return 1;
+}
+
+int run_format_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== FORMAT TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_format_round_trip);
+    RUN_TEST(test_format_limits);
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_format_tests(&passed, &failed, &total);
+
+    printf("\n===== FORMAT TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -362,6 +362,61 @@ static int test_hashmap_edge_cases(void)
     return 1;
 }
 
+/**
+ * \brief           Test string keyed entry points
+ * \return          1 on success, 0 on failure
+ */
+static int test_hashmap_string_keys(void)
+{
+    mvn_hmap_t *hmap = MVN_HMAP_INIT(int, 4);
+    TEST_ASSERT(hmap != NULL, "Failed to initialize hashmap");
+
+    mvn_string_t *player = mvn_string_from_cstr("player");
+    mvn_string_t *enemy  = mvn_string_from_cstr("enemy");
+    TEST_ASSERT(player != NULL && enemy != NULL, "Failed to create key strings");
+
+    int value = 1;
+    TEST_ASSERT(mvn_hmap_set_string(hmap, player, &value), "Failed to set with string key");
+    value = 2;
+    TEST_ASSERT(mvn_hmap_set_string(hmap, enemy, &value), "Failed to set with string key");
+    TEST_ASSERT(player->hash_valid, "Key hash should be cached after use");
+
+    // String and C string entry points address the same entries
+    int *retrieved = MVN_HMAP_GET(int, hmap, "player");
+    TEST_ASSERT(retrieved != NULL && *retrieved == 1, "C string lookup of string key failed");
+    MVN_HMAP_SET(hmap, "enemy", int, 3);
+    retrieved = (int *)mvn_hmap_get_string(hmap, enemy);
+    TEST_ASSERT(retrieved != NULL && *retrieved == 3, "String lookup of C string key failed");
+
+    // Keys keep working across resizes, which reuse the stored hashes
+    char name[32];
+    for (int i = 0; i < 64; i++) {
+        SDL_snprintf(name, sizeof(name), "entity_%d", i);
+        MVN_HMAP_SET(hmap, name, int, i);
+    }
+    retrieved = (int *)mvn_hmap_get_string(hmap, player);
+    TEST_ASSERT(retrieved != NULL && *retrieved == 1, "String key lost after resize");
+
+    // Mutating a key invalidates its cached hash
+    TEST_ASSERT(mvn_string_append(player, "_two"), "Failed to append to key");
+    TEST_ASSERT(!player->hash_valid, "Append should invalidate the cached hash");
+    TEST_ASSERT(mvn_hmap_get_string(hmap, player) == NULL, "Mutated key should not be found");
+
+    TEST_ASSERT(mvn_hmap_delete_string(hmap, enemy), "Failed to delete with string key");
+    TEST_ASSERT(MVN_HMAP_GET(int, hmap, "enemy") == NULL, "Deleted key should return NULL");
+    TEST_ASSERT(!mvn_hmap_delete_string(hmap, enemy), "Deleting twice should fail");
+
+    TEST_ASSERT(!mvn_hmap_set_string(hmap, NULL, &value), "Setting NULL string key should fail");
+    TEST_ASSERT(mvn_hmap_get_string(hmap, NULL) == NULL, "Getting NULL string key should fail");
+    TEST_ASSERT(!mvn_hmap_delete_string(NULL, player), "Deleting from NULL hashmap should fail");
+
+    mvn_string_free(player);
+    mvn_string_free(enemy);
+    mvn_hmap_free(hmap);
+
+    return 1;
+}
+
 /**
  * \brief           Run all hashmap tests
  * \param[out] passed_tests Pointer to the number of passed tests
@@ -383,6 +438,7 @@ int run_hashmap_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_hashmap_keys_values);
     RUN_TEST(test_hashmap_complex_types);
     RUN_TEST(test_hashmap_edge_cases);
+    RUN_TEST(test_hashmap_string_keys);
 
     // Calculate how many tests were run
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
@@ -0,0 +1,269 @@
+/**
+ * \file            mvn-input-test.c
+ * \brief           Tests for MVN buffered input functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-input.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+/**
+ * \brief           Queue a keyboard event
+ * \param[in]       scancode: Physical key
+ * \param[in]       key: Key code
+ * \param[in]       down: true for a key press, false for a release
+ * \param[in]       repeat: true for a key repeat
+ */
+static void push_key(SDL_Scancode scancode, SDL_Keycode key, bool down, bool repeat)
+{
+    SDL_Event event;
+    SDL_zero(event);
+    event.type         = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+    event.key.scancode = scancode;
+    event.key.key      = key;
+    event.key.down     = down;
+    event.key.repeat   = repeat;
+    SDL_PushEvent(&event);
+}
+
+/**
+ * \brief           Queue a mouse button event
+ * \param[in]       button: Button, one of SDL_BUTTON_*
+ * \param[in]       down: true for a press, false for a release
+ */
+static void push_mouse_button(uint8_t button, bool down)
+{
+    SDL_Event event;
+    SDL_zero(event);
+    event.type          = down ? SDL_EVENT_MOUSE_BUTTON_DOWN : SDL_EVENT_MOUSE_BUTTON_UP;
+    event.button.button = button;
+    event.button.down   = down;
+    event.button.x      = 10.0f;
+    event.button.y      = 20.0f;
+    SDL_PushEvent(&event);
+}
+
+/**
+ * \brief           Test key edges across input frames
+ * \return          1 on success, 0 on failure
+ */
+static int test_input_key_edges(void)
+{
+    push_key(SDL_SCANCODE_A, 'a', true, false);
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_key_down(SDL_SCANCODE_A), "Key should be down");
+    TEST_ASSERT(mvn_is_key_pressed(SDL_SCANCODE_A), "Key should be pressed this frame");
+    TEST_ASSERT(!mvn_is_key_released(SDL_SCANCODE_A), "Key should not be released");
+
+    // Repeats neither press again nor release
+    push_key(SDL_SCANCODE_A, 'a', true, true);
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_key_down(SDL_SCANCODE_A), "Key should stay down");
+    TEST_ASSERT(!mvn_is_key_pressed(SDL_SCANCODE_A), "Repeat should not count as a press");
+
+    push_key(SDL_SCANCODE_A, 'a', false, false);
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_key_up(SDL_SCANCODE_A), "Key should be up");
+    TEST_ASSERT(mvn_is_key_released(SDL_SCANCODE_A), "Key should be released this frame");
+
+    mvn_update_input();
+    TEST_ASSERT(!mvn_is_key_released(SDL_SCANCODE_A), "Release should last one frame");
+
+    // A tap within one frame reports both edges
+    push_key(SDL_SCANCODE_SPACE, ' ', true, false);
+    push_key(SDL_SCANCODE_SPACE, ' ', false, false);
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_key_pressed(SDL_SCANCODE_SPACE), "Tap should be pressed");
+    TEST_ASSERT(mvn_is_key_released(SDL_SCANCODE_SPACE), "Tap should be released");
+    TEST_ASSERT(!mvn_is_key_down(SDL_SCANCODE_SPACE), "Tap should end up");
+
+    // Late sampling updates held keys right away and reports edges in the next frame
+    push_key(SDL_SCANCODE_A, 'a', true, false);
+    mvn_sample_input();
+    TEST_ASSERT(mvn_is_key_down(SDL_SCANCODE_A), "Sampled key should be down right away");
+    TEST_ASSERT(!mvn_is_key_pressed(SDL_SCANCODE_A), "Sampled press should wait for next frame");
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_key_pressed(SDL_SCANCODE_A), "Sampled press should count next frame");
+    mvn_update_input();
+    TEST_ASSERT(!mvn_is_key_pressed(SDL_SCANCODE_A), "Sampled press should last one frame");
+
+    TEST_ASSERT(!mvn_is_key_down(SDL_SCANCODE_COUNT), "Invalid key should not be down");
+    mvn_input_shutdown();
+    TEST_ASSERT(!mvn_is_key_down(SDL_SCANCODE_A), "Shutdown should reset keys");
+    return 1;
+}
+
+/**
+ * \brief           Test mouse buttons, motion and scrolling
+ * \return          1 on success, 0 on failure
+ */
+static int test_input_mouse(void)
+{
+    SDL_Event event;
+    SDL_zero(event);
+    event.type        = SDL_EVENT_MOUSE_MOTION;
+    event.motion.x    = 5.0f;
+    event.motion.y    = 6.0f;
+    event.motion.xrel = 2.0f;
+    event.motion.yrel = -1.0f;
+    SDL_PushEvent(&event);
+    event.motion.x    = 8.0f;
+    event.motion.y    = 4.0f;
+    event.motion.xrel = 3.0f;
+    event.motion.yrel = -2.0f;
+    SDL_PushEvent(&event);
+
+    SDL_zero(event);
+    event.type    = SDL_EVENT_MOUSE_WHEEL;
+    event.wheel.y = 1.0f;
+    SDL_PushEvent(&event);
+    SDL_PushEvent(&event);
+
+    push_mouse_button(SDL_BUTTON_LEFT, true);
+    mvn_update_input();
+
+    mvn_fpoint_t delta = mvn_get_mouse_delta();
+    TEST_ASSERT(delta.x == 5.0f && delta.y == -3.0f, "Motion should accumulate over the frame");
+    TEST_ASSERT(mvn_get_mouse_wheel().y == 2.0f, "Scrolling should accumulate over the frame");
+    TEST_ASSERT(mvn_get_mouse_position().x == 10.0f, "Button event should update the position");
+    TEST_ASSERT(mvn_is_mouse_button_pressed(SDL_BUTTON_LEFT), "Button should be pressed");
+    TEST_ASSERT(mvn_is_mouse_button_down(SDL_BUTTON_LEFT), "Button should be down");
+
+    push_mouse_button(SDL_BUTTON_LEFT, false);
+    mvn_update_input();
+    TEST_ASSERT(mvn_get_mouse_delta().x == 0.0f, "Motion should reset each frame");
+    TEST_ASSERT(mvn_get_mouse_wheel().y == 0.0f, "Scrolling should reset each frame");
+    TEST_ASSERT(mvn_is_mouse_button_released(SDL_BUTTON_LEFT), "Button should be released");
+    TEST_ASSERT(!mvn_is_mouse_button_down(MVN_MOUSE_BUTTON_COUNT), "Invalid button is never down");
+
+    mvn_input_shutdown();
+    return 1;
+}
+
+/**
+ * \brief           Test buffering typed characters
+ * \return          1 on success, 0 on failure
+ */
+static int test_input_text_ring(void)
+{
+    SDL_Event event;
+    SDL_zero(event);
+    event.type      = SDL_EVENT_TEXT_INPUT;
+    event.text.text = "a\xc3\xa9";
+    SDL_PushEvent(&event);
+    mvn_update_input();
+
+    TEST_ASSERT(mvn_get_char_pressed() == 'a', "First character should be 'a'");
+    TEST_ASSERT(mvn_get_char_pressed() == 0xE9, "UTF-8 should decode to U+00E9");
+    TEST_ASSERT(mvn_get_char_pressed() == 0, "Ring should be empty");
+
+    // Characters beyond the ring size are dropped, not overwritten
+    event.text.text = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+    SDL_PushEvent(&event);
+    mvn_update_input();
+    int count = 0;
+    while (mvn_get_char_pressed() != 0) {
+        count++;
+    }
+    TEST_ASSERT(count == MVN_TEXT_INPUT_RING_SIZE, "Ring should keep the first characters");
+
+    mvn_input_shutdown();
+    return 1;
+}
+
+/**
+ * \brief           Test quit requests and unavailable gamepads
+ * \return          1 on success, 0 on failure
+ */
+static int test_input_quit(void)
+{
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = SDL_EVENT_QUIT;
+    SDL_PushEvent(&event);
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_quit_requested(), "Quit event should request closing");
+
+    mvn_update_input();
+    TEST_ASSERT(!mvn_is_quit_requested(), "Quit request should last one frame");
+
+    // ESC closes, and the events around it are still applied
+    push_key(SDL_SCANCODE_ESCAPE, SDLK_ESCAPE, true, false);
+    push_key(SDL_SCANCODE_A, 'a', true, false);
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_quit_requested(), "ESC should request closing");
+    TEST_ASSERT(mvn_is_key_pressed(SDL_SCANCODE_A), "Events after ESC should not be discarded");
+
+    // A press and a quit sampled after the game's update reach the next frame
+    mvn_update_input();
+    push_key(SDL_SCANCODE_SPACE, ' ', true, false);
+    push_key(SDL_SCANCODE_SPACE, ' ', false, false);
+    SDL_PushEvent(&event);
+    mvn_sample_input();
+    TEST_ASSERT(!mvn_is_quit_requested(), "Sampled quit should wait for the next frame");
+    mvn_update_input();
+    TEST_ASSERT(mvn_is_quit_requested(), "Sampled quit should not be lost");
+    TEST_ASSERT(mvn_is_key_pressed(SDL_SCANCODE_SPACE) && mvn_is_key_released(SDL_SCANCODE_SPACE),
+                "Sampled tap should not be lost");
+    mvn_update_input();
+    TEST_ASSERT(!mvn_is_quit_requested(), "Sampled quit should last one frame");
+
+    TEST_ASSERT(!mvn_is_gamepad_available(0), "No gamepad should be connected");
+    TEST_ASSERT(!mvn_is_gamepad_available(MVN_MAX_GAMEPADS), "Invalid gamepad index");
+    TEST_ASSERT(!mvn_is_gamepad_button_down(0, SDL_GAMEPAD_BUTTON_SOUTH), "No gamepad buttons");
+    TEST_ASSERT(mvn_get_gamepad_axis(0, SDL_GAMEPAD_AXIS_LEFTX) == 0.0f, "No gamepad axes");
+
+    mvn_input_shutdown();
+    return 1;
+}
+
+int run_input_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== INPUT TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_input_key_edges);
+    RUN_TEST(test_input_mouse);
+    RUN_TEST(test_input_text_ring);
+    RUN_TEST(test_input_quit);
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    // Events only, no window is needed to feed the input state
+    if (!SDL_Init(SDL_INIT_EVENTS | SDL_INIT_GAMEPAD)) {
+        printf("Failed to initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    run_input_tests(&passed, &failed, &total);
+    SDL_Quit();
+
+    printf("\n===== INPUT TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,357 @@
+/**
+ * \file            mvn-job-test.c
+ * \brief           Tests for MVN job system functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-job.h"
+#include "mvn/mvn-list.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+/* Workers started by the tests, independent of the machine */
+#define JOB_TEST_WORKERS 4
+
+/**
+ * \brief           State shared by the dependency test stages
+ */
+typedef struct job_stage_data_t {
+    int           values[64]; /*!< Written by the first stage */
+    SDL_AtomicInt sum;        /*!< Written by the second stage */
+    SDL_AtomicInt order_ok;   /*!< Cleared if a stage saw unfinished input */
+} job_stage_data_t;
+
+/**
+ * \brief           Data of one first stage job
+ */
+typedef struct job_stage_item_t {
+    job_stage_data_t *data;  /*!< Shared state */
+    int               index; /*!< Value written by the job */
+} job_stage_item_t;
+
+static void increment_job(void *user_data)
+{
+    SDL_AddAtomicInt((SDL_AtomicInt *)user_data, 1);
+}
+
+static void write_value_job(void *user_data)
+{
+    job_stage_item_t *item = (job_stage_item_t *)user_data;
+    SDL_Delay(item->index % 4 == 0 ? 1 : 0);
+    item->data->values[item->index] = item->index + 1;
+}
+
+static void sum_values_job(void *user_data)
+{
+    job_stage_data_t *data = (job_stage_data_t *)user_data;
+    for (int i = 0; i < 64; i++) {
+        if (data->values[i] != i + 1) {
+            SDL_SetAtomicInt(&data->order_ok, 0);
+        }
+        SDL_AddAtomicInt(&data->sum, data->values[i]);
+    }
+}
+
+static void check_sum_job(void *user_data)
+{
+    job_stage_data_t *data = (job_stage_data_t *)user_data;
+    if (SDL_GetAtomicInt(&data->sum) != 64 * 65 / 2) {
+        SDL_SetAtomicInt(&data->order_ok, 0);
+    }
+}
+
+static void wait_for_flag_job(void *user_data)
+{
+    while (SDL_GetAtomicInt((SDL_AtomicInt *)user_data) == 0) {
+        SDL_Delay(1);
+    }
+}
+
+/**
+ * \brief           Work done outside the job system, finished by a thread
+ */
+typedef struct job_external_t {
+    mvn_job_counter_t counter;  /*!< Holds the external work */
+    SDL_AtomicInt     finished; /*!< Set before the work is released */
+    SDL_AtomicInt     seen;     /*!< Set by the chained job if the work had finished */
+} job_external_t;
+
+static int finish_external_thread(void *data)
+{
+    job_external_t *external = (job_external_t *)data;
+    SDL_Delay(20);
+    SDL_SetAtomicInt(&external->finished, 1);
+    mvn_job_counter_done(&external->counter);
+    return 0;
+}
+
+static void check_external_job(void *user_data)
+{
+    job_external_t *external = (job_external_t *)user_data;
+    SDL_SetAtomicInt(&external->seen, SDL_GetAtomicInt(&external->finished));
+}
+
+/**
+ * \brief           State of a job that is still running when the job system shuts down
+ */
+typedef struct job_late_t {
+    SDL_AtomicInt started; /*!< Set once a worker runs the job */
+    SDL_AtomicInt value;   /*!< Incremented by the job chained on it */
+} job_late_t;
+
+static void late_job(void *user_data)
+{
+    SDL_SetAtomicInt(&((job_late_t *)user_data)->started, 1);
+    SDL_Delay(20);
+}
+
+static void nested_job(void *user_data)
+{
+    // Waiting inside a job runs other jobs instead of blocking the worker
+    mvn_job_counter_t counter = { 0 };
+    for (int i = 0; i < 16; i++) {
+        mvn_job_run(increment_job, user_data, &counter);
+    }
+    mvn_job_wait(&counter);
+}
+
+static void square_range(mvn_list_t *list, size_t start, size_t end, void *user_data)
+{
+    SDL_AddAtomicInt((SDL_AtomicInt *)user_data, 1);
+    for (size_t i = start; i < end; i++) {
+        int *value = MVN_LIST_GET(int, list, i);
+        *value     = *value * *value;
+    }
+}
+
+static void record_thread_call(void *user_data)
+{
+    *(bool *)user_data = mvn_job_is_main_thread();
+}
+
+static void queue_main_thread_job(void *user_data)
+{
+    mvn_job_run_on_main_thread(record_thread_call, user_data);
+}
+
+/**
+ * \brief           Test running many jobs and waiting on their counter
+ * \return          1 on success, 0 on failure
+ */
+static int test_job_counter(void)
+{
+    TEST_ASSERT(mvn_job_get_worker_count() == JOB_TEST_WORKERS, "Unexpected worker count");
+    TEST_ASSERT(mvn_job_is_main_thread(), "Test thread should be the main thread");
+
+    SDL_AtomicInt     value   = { 0 };
+    mvn_job_counter_t counter = { 0 };
+    for (int i = 0; i < 10000; i++) {
+        TEST_ASSERT(mvn_job_run(increment_job, &value, &counter), "Failed to submit job");
+    }
+    mvn_job_wait(&counter);
+
+    TEST_ASSERT(SDL_GetAtomicInt(&value) == 10000, "Every job should run once");
+    TEST_ASSERT(mvn_job_is_done(&counter), "Counter should be done after waiting");
+    TEST_ASSERT(!mvn_job_run(NULL, NULL, &counter), "NULL job function should be rejected");
+
+    // Jobs that wait on their own jobs
+    SDL_SetAtomicInt(&value, 0);
+    for (int i = 0; i < 32; i++) {
+        mvn_job_run(nested_job, &value, &counter);
+    }
+    mvn_job_wait(&counter);
+    TEST_ASSERT(SDL_GetAtomicInt(&value) == 32 * 16, "Nested jobs should all run");
+
+    return 1;
+}
+
+/**
+ * \brief           Test chaining jobs through counters
+ * \return          1 on success, 0 on failure
+ */
+static int test_job_dependencies(void)
+{
+    job_stage_data_t data;
+    job_stage_item_t items[64];
+    SDL_zero(data);
+    SDL_SetAtomicInt(&data.order_ok, 1);
+
+    mvn_job_counter_t written = { 0 };
+    mvn_job_counter_t summed  = { 0 };
+    mvn_job_counter_t checked = { 0 };
+
+    // Hold the first stage open so the later stages are queued before it can finish
+    SDL_AtomicInt release = { 0 };
+    mvn_job_run(wait_for_flag_job, &release, &written);
+    TEST_ASSERT(mvn_job_run_after(&written, sum_values_job, &data, &summed), "Failed to chain");
+    TEST_ASSERT(mvn_job_run_after(&summed, check_sum_job, &data, &checked), "Failed to chain");
+    TEST_ASSERT(!mvn_job_is_done(&summed), "Chained stage should wait for its dependency");
+
+    for (int i = 0; i < 64; i++) {
+        items[i].data  = &data;
+        items[i].index = i;
+        mvn_job_run(write_value_job, &items[i], &written);
+    }
+    SDL_SetAtomicInt(&release, 1);
+
+    mvn_job_wait(&checked);
+    TEST_ASSERT(mvn_job_is_done(&written) && mvn_job_is_done(&summed), "Stages should be done");
+    TEST_ASSERT(SDL_GetAtomicInt(&data.sum) == 64 * 65 / 2, "Sum stage ran too early");
+    TEST_ASSERT(SDL_GetAtomicInt(&data.order_ok) == 1, "Stages ran out of order");
+
+    // A finished dependency starts the job right away
+    SDL_AtomicInt value = { 0 };
+    mvn_job_run_after(&checked, increment_job, &value, &summed);
+    mvn_job_wait(&summed);
+    TEST_ASSERT(SDL_GetAtomicInt(&value) == 1, "Job with finished dependency should run");
+
+    return 1;
+}
+
+/**
+ * \brief           Test processing a list in parallel ranges
+ * \return          1 on success, 0 on failure
+ */
+static int test_parallel_for(void)
+{
+    mvn_list_t   *list   = mvn_list_init(sizeof(int), 10000);
+    SDL_AtomicInt ranges = { 0 };
+    TEST_ASSERT(list != NULL, "Failed to create list");
+
+    for (int i = 0; i < 10000; i++) {
+        mvn_list_push(list, &i);
+    }
+
+    TEST_ASSERT(mvn_parallel_for(list, 0, square_range, &ranges), "Parallel for failed");
+    for (int i = 0; i < 10000; i++) {
+        if (*MVN_LIST_GET(int, list, i) != i * i) {
+            TEST_ASSERT(false, "Every item should be processed exactly once");
+        }
+    }
+    TEST_ASSERT(SDL_GetAtomicInt(&ranges) == (JOB_TEST_WORKERS + 1) * 4, "Unexpected range count");
+
+    // Uneven ranges cover the tail of the list
+    SDL_SetAtomicInt(&ranges, 0);
+    list->length = 10;
+    TEST_ASSERT(mvn_parallel_for(list, 3, square_range, &ranges), "Parallel for failed");
+    TEST_ASSERT(SDL_GetAtomicInt(&ranges) == 4, "Ten items in ranges of three need four ranges");
+    TEST_ASSERT(*MVN_LIST_GET(int, list, 9) == 81 * 81, "Last item should be processed");
+
+    list->length = 0;
+    TEST_ASSERT(mvn_parallel_for(list, 0, square_range, &ranges), "Empty list should succeed");
+    TEST_ASSERT(!mvn_parallel_for(NULL, 0, square_range, &ranges), "NULL list should fail");
+
+    mvn_list_free(list);
+    return 1;
+}
+
+/**
+ * \brief           Test handing work from jobs to the main thread
+ * \return          1 on success, 0 on failure
+ */
+static int test_job_main_thread_queue(void)
+{
+    bool              on_main = false;
+    mvn_job_counter_t counter = { 0 };
+
+    mvn_job_run(queue_main_thread_job, &on_main, &counter);
+    mvn_job_wait(&counter);
+
+    TEST_ASSERT(mvn_job_run_main_thread_queue() >= 1, "Queued call should run");
+    TEST_ASSERT(on_main, "Queued call should run on the main thread");
+    TEST_ASSERT(mvn_job_run_main_thread_queue() == 0, "Queue should be empty");
+    TEST_ASSERT(!mvn_job_run_on_main_thread(NULL, NULL), "NULL function should be rejected");
+
+    return 1;
+}
+
+/**
+ * \brief           Test that shutdown finishes jobs in flight and that jobs then run inline
+ * \return          1 on success, 0 on failure
+ */
+static int test_job_inline(void)
+{
+    // Shutting down finishes jobs that running jobs start, such as chained jobs
+    job_late_t        late    = { 0 };
+    mvn_job_counter_t counter = { 0 };
+    TEST_ASSERT(mvn_job_run(late_job, &late, &counter), "Failed to submit late job");
+    while (SDL_GetAtomicInt(&late.started) == 0) {
+        SDL_Delay(1);
+    }
+    TEST_ASSERT(mvn_job_run_after(&counter, increment_job, &late.value, NULL),
+                "Failed to chain job");
+    mvn_job_system_shutdown();
+    TEST_ASSERT(SDL_GetAtomicInt(&late.value) == 1, "Job started during shutdown was dropped");
+    TEST_ASSERT(mvn_job_get_worker_count() == 0, "Workers should be stopped");
+
+    SDL_AtomicInt value = { 0 };
+    SDL_zero(counter);
+    TEST_ASSERT(mvn_job_run(increment_job, &value, &counter), "Inline job failed");
+    TEST_ASSERT(SDL_GetAtomicInt(&value) == 1, "Job should run before mvn_job_run returns");
+    TEST_ASSERT(mvn_job_is_done(&counter), "Inline jobs should not hold the counter");
+    TEST_ASSERT(!mvn_job_run_on_main_thread(increment_job, &value), "Main queue needs the system");
+
+    // Inline jobs still wait for work held outside the job system
+    job_external_t external;
+    SDL_zero(external);
+    mvn_job_counter_add(&external.counter);
+    SDL_Thread *thread = SDL_CreateThread(finish_external_thread, "job_external", &external);
+    TEST_ASSERT(thread != NULL, "Failed to create thread");
+    TEST_ASSERT(mvn_job_run_after(&external.counter, check_external_job, &external, NULL),
+                "Inline chained job failed");
+    SDL_WaitThread(thread, NULL);
+    TEST_ASSERT(SDL_GetAtomicInt(&external.seen) == 1, "Chained job ran before its dependency");
+
+    return 1;
+}
+
+int run_job_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== JOB TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    if (!mvn_job_system_init(JOB_TEST_WORKERS)) {
+        printf("ERROR: Failed to start the job system. Skipping job tests.\n");
+        (*total_tests)++;
+        (*failed_tests)++;
+        return 0;
+    }
+
+    RUN_TEST(test_job_counter);
+    RUN_TEST(test_job_dependencies);
+    RUN_TEST(test_parallel_for);
+    RUN_TEST(test_job_main_thread_queue);
+    RUN_TEST(test_job_inline);
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_job_tests(&passed, &failed, &total);
+
+    printf("\n===== JOB TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
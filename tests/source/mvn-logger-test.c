@@ -33,6 +33,7 @@
 
 #include "mvn-test-utils.h"
 #include "mvn/mvn-logger.h"
+#include "mvn/mvn-string.h"
 
 #include <SDL3/SDL.h>
 #include <stdio.h>
@@ -390,6 +391,497 @@ static bool test_debug_vs_release_config(void)
     return debug_result && release_result;
 }
 
+/* Messages logged by each thread in the asynchronous logging test */
+#define ASYNC_MESSAGES_PER_THREAD 500
+
+/* Threads logging at the same time in the asynchronous logging test */
+#define ASYNC_THREAD_COUNT 4
+
+/**
+ * \brief           Log output function counting the messages it receives
+ * \param[in]       userdata: Counter to increment (SDL_AtomicInt)
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       message: Log message
+ */
+static void
+count_log_output(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    (void)category; /* Unused */
+    (void)priority; /* Unused */
+
+    if (SDL_strstr(message, "async message") != NULL) {
+        SDL_AddAtomicInt((SDL_AtomicInt *)userdata, 1);
+    }
+}
+
+/**
+ * \brief           Log messages from a worker thread
+ * \param[in]       data: Unused
+ * \return          0
+ */
+static int async_log_worker(void *data)
+{
+    (void)data;
+    for (int i = 0; i < ASYNC_MESSAGES_PER_THREAD; i++) {
+        mvn_log_info("async message %d", i);
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test that the blocking writer thread delivers every message
+ * \return          true if test passes, false otherwise
+ */
+static bool test_async_logging(void)
+{
+    printf("Testing asynchronous logging...\n");
+
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    SDL_AtomicInt         count;
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetAtomicInt(&count, 0);
+    SDL_SetLogOutputFunction(count_log_output, &count);
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+
+    /* A small buffer makes the producers wait for the writer */
+    if (!mvn_logger_start_async(16, MVN_LOG_OVERFLOW_BLOCK) || !mvn_logger_is_async()) {
+        printf("FAIL: Could not start asynchronous logging\n");
+        SDL_SetLogOutputFunction(original_fn, original_userdata);
+        return false;
+    }
+
+    SDL_Thread *threads[ASYNC_THREAD_COUNT];
+    for (int i = 0; i < ASYNC_THREAD_COUNT; i++) {
+        threads[i] = SDL_CreateThread(async_log_worker, "async_log_worker", NULL);
+    }
+    for (int i = 0; i < ASYNC_THREAD_COUNT; i++) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    mvn_log_debug("async message below the level");
+    mvn_logger_flush();
+    int  flushed = SDL_GetAtomicInt(&count);
+    bool result  = true;
+    if (flushed != ASYNC_THREAD_COUNT * ASYNC_MESSAGES_PER_THREAD) {
+        printf("FAIL: Expected %d messages after flush, got %d\n",
+               ASYNC_THREAD_COUNT * ASYNC_MESSAGES_PER_THREAD,
+               flushed);
+        result = false;
+    }
+
+    /* Stopping writes queued messages and returns to synchronous output */
+    mvn_log_info("async message before stop");
+    mvn_logger_stop_async();
+    mvn_log_info("async message after stop");
+    if (mvn_logger_is_async() || SDL_GetAtomicInt(&count) != flushed + 2) {
+        printf("FAIL: Messages around stopping were not written\n");
+        result = false;
+    }
+
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+
+    if (result) {
+        printf("PASS: Asynchronous logging delivered every message\n");
+    }
+    return result;
+}
+
+/**
+ * \brief           Test that a full buffer drops and counts messages
+ * \return          true if test passes, false otherwise
+ */
+static bool test_async_overflow_drop(void)
+{
+    printf("Testing asynchronous logging overflow...\n");
+
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    SDL_AtomicInt         count;
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetAtomicInt(&count, 0);
+    SDL_SetLogOutputFunction(count_log_output, &count);
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+
+    uint32_t dropped_before = mvn_logger_get_dropped_count();
+    if (!mvn_logger_start_async(4, MVN_LOG_OVERFLOW_DROP)) {
+        printf("FAIL: Could not start asynchronous logging\n");
+        SDL_SetLogOutputFunction(original_fn, original_userdata);
+        return false;
+    }
+
+    for (int i = 0; i < 2000; i++) {
+        mvn_log_info("async message %d", i);
+    }
+    mvn_logger_stop_async();
+
+    /* Every message is either written or counted as dropped */
+    int  written = SDL_GetAtomicInt(&count);
+    int  dropped = (int)(mvn_logger_get_dropped_count() - dropped_before);
+    bool result  = written + dropped == 2000 && written > 0;
+    if (!result) {
+        printf("FAIL: %d written and %d dropped of 2000 messages\n", written, dropped);
+    }
+
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+
+    if (result) {
+        printf("PASS: Overflow dropped %d messages and wrote %d\n", dropped, written);
+    }
+    return result;
+}
+
+/**
+ * \brief           Log output function appending messages to a string builder
+ * \param[in]       userdata: String builder (mvn_strbuf_t)
+ * \param[in]       category: Log category
+ * \param[in]       priority: Log priority
+ * \param[in]       message: Log message
+ */
+static void
+collect_log_output(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    (void)category; /* Unused */
+    (void)priority; /* Unused */
+
+    mvn_strbuf_appendf((mvn_strbuf_t *)userdata, "%s\n", message);
+}
+
+/**
+ * \brief           Test writing messages to a log file
+ * \return          true if test passes, false otherwise
+ */
+static bool test_log_file_sink(void)
+{
+    printf("Testing log file sink...\n");
+
+    const char           *path = "mvn-logger-test.log";
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    mvn_strbuf_t         *output = mvn_strbuf_init(0);
+    char                  long_text[400];
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetLogOutputFunction(collect_log_output, output);
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+
+    for (size_t i = 0; i < sizeof(long_text) - 1; i++) {
+        long_text[i] = (char)('a' + i % 26);
+    }
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    if (!mvn_logger_set_file(path)) {
+        printf("FAIL: Could not open log file\n");
+        SDL_SetLogOutputFunction(original_fn, original_userdata);
+        mvn_strbuf_free(output);
+        return false;
+    }
+    mvn_log_warn("File message written synchronously");
+    mvn_log_info("sync %s end", long_text);
+    mvn_logger_start_async(0, MVN_LOG_OVERFLOW_BLOCK);
+    mvn_log_error("File message written by the writer");
+    mvn_log_info("async %s end", long_text);
+    mvn_logger_flush();
+
+    // Long messages reach both the console and the file in full
+    size_t size     = 0;
+    char  *contents = SDL_LoadFile(path, &size);
+    bool   result   = contents != NULL &&
+                  SDL_strstr(contents, "[WARN] File message written synchronously") != NULL &&
+                  SDL_strstr(contents, "[ERROR] File message written by the writer") != NULL;
+    if (!result) {
+        printf("FAIL: Log file is missing messages\n");
+    }
+
+    const char *prefixes[] = {"sync ", "async "};
+    for (size_t i = 0; i < SDL_arraysize(prefixes) && result; i++) {
+        mvn_strbuf_t *line = mvn_strbuf_init(0);
+        mvn_strbuf_appendf(line, "%s%s end\n", prefixes[i], long_text);
+        result = SDL_strstr(contents, mvn_strbuf_to_cstr(line)) != NULL &&
+                 SDL_strstr(mvn_strbuf_to_cstr(output), mvn_strbuf_to_cstr(line)) != NULL;
+        if (!result) {
+            printf("FAIL: Long %smessage was truncated\n", prefixes[i]);
+        }
+        mvn_strbuf_free(line);
+    }
+    SDL_free(contents);
+
+    mvn_logger_shutdown();
+    SDL_RemovePath(path);
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+    mvn_strbuf_free(output);
+
+    if (result) {
+        printf("PASS: Log file sink working correctly\n");
+    }
+    return result;
+}
+
+/**
+ * \brief           Log binary messages from a worker thread
+ * \param[in]       data: Unused
+ * \return          0
+ */
+static int binary_log_worker(void *data)
+{
+    (void)data;
+    for (int i = 0; i < 100; i++) {
+        mvn_log(MVN_LOG_CATEGORY_DEFAULT, MVN_LOG_INFO, "worker %d of %s", i, "binary");
+    }
+    return 0;
+}
+
+/**
+ * \brief           Decode callback collecting lines into a string builder
+ * \param[in]       line: Decoded line
+ * \param[in]       user_data: String builder (mvn_strbuf_t)
+ */
+static void collect_decoded_line(const char *line, void *user_data)
+{
+    mvn_strbuf_appendf((mvn_strbuf_t *)user_data, "%s\n", line);
+}
+
+/**
+ * \brief           Test recording binary messages and decoding them back to text
+ * \return          true if test passes, false otherwise
+ */
+static bool test_binary_logging(void)
+{
+    printf("Testing binary logging...\n");
+
+    const char *path = "mvn-logger-test.mvnlog";
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+
+    if (!mvn_logger_start_binary(path) || !mvn_logger_is_binary()) {
+        printf("FAIL: Could not start binary logging\n");
+        return false;
+    }
+
+    SDL_Thread *thread = SDL_CreateThread(binary_log_worker, "binary_log_worker", NULL);
+    mvn_log(MVN_LOG_CATEGORY_DEFAULT,
+            MVN_LOG_WARN,
+            "ints %d %u %ld %lld %zu %hhd %x %c",
+            -42,
+            4000000000u,
+            -7L,
+            1LL << 40,
+            (size_t)123,
+            300,
+            0xbeef,
+            'Z');
+    mvn_log(MVN_LOG_CATEGORY_DEFAULT,
+            MVN_LOG_ERROR,
+            "floats %.2f %8.3e %s|%-6s|%.3s %*d%% %p",
+            3.14159,
+            12345.678,
+            "text",
+            "pad",
+            "truncated",
+            5,
+            42,
+            (void *)NULL);
+    mvn_log(MVN_LOG_CATEGORY_DEFAULT, MVN_LOG_DEBUG, "filtered binary message");
+    SDL_WaitThread(thread, NULL);
+    mvn_logger_stop_binary();
+
+    mvn_strbuf_t *decoded = mvn_strbuf_init(0);
+    bool          result  = mvn_logger_decode_binary(path, collect_decoded_line, decoded);
+    const char   *text    = mvn_strbuf_to_cstr(decoded);
+
+    char expected[256];
+    SDL_snprintf(expected,
+                 sizeof(expected),
+                 "[ERROR] floats 3.14 1.235e+04 text|pad   |tru    42%% %p",
+                 (void *)NULL);
+    if (!result ||
+        SDL_strstr(text, "[WARN] ints -42 4000000000 -7 1099511627776 123 44 beef Z\n") == NULL) {
+        printf("FAIL: Integer arguments were not decoded: %s\n", text);
+        result = false;
+    } else if (SDL_strstr(text, expected) == NULL) {
+        printf("FAIL: Floating point and string arguments were not decoded: %s\n", text);
+        result = false;
+    } else if (SDL_strstr(text, "[INFO] worker 99 of binary\n") == NULL ||
+               SDL_strstr(text, "filtered") != NULL) {
+        printf("FAIL: Worker or filtered messages decoded incorrectly\n");
+        result = false;
+    }
+    mvn_strbuf_free(decoded);
+    SDL_RemovePath(path);
+
+    if (result) {
+        printf("PASS: Binary log decoded correctly\n");
+    }
+    return result;
+}
+
+/**
+ * \brief           Test the per call site rate limit
+ * \return          true if test passes, false otherwise
+ */
+static bool test_rate_limit(void)
+{
+    printf("Testing log rate limiting...\n");
+
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    mvn_strbuf_t         *output = mvn_strbuf_init(0);
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetLogOutputFunction(collect_log_output, output);
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+    mvn_logger_set_rate_limit(MVN_LOG_WARN, 3, 60000);
+
+    uint32_t suppressed_before = mvn_logger_get_suppressed_count();
+    for (int i = 0; i < 10; i++) {
+        mvn_log_warn("rate limited %d", i);
+        mvn_log_info("not rate limited %d", i);
+    }
+    uint32_t suppressed = mvn_logger_get_suppressed_count() - suppressed_before;
+    bool     result     = suppressed == 7 &&
+                  SDL_strstr(mvn_strbuf_to_cstr(output), "rate limited 2\n") != NULL &&
+                  SDL_strstr(mvn_strbuf_to_cstr(output), "\nrate limited 3\n") == NULL &&
+                  SDL_strstr(mvn_strbuf_to_cstr(output), "not rate limited 9\n") != NULL;
+    if (!result) {
+        printf("FAIL: %u messages suppressed, output:\n%s", suppressed, mvn_strbuf_to_cstr(output));
+    }
+
+    // The next interval starts with a report of what was suppressed
+    mvn_logger_set_rate_limit(MVN_LOG_WARN, 3, 1);
+    SDL_Delay(2);
+    mvn_strbuf_reset(output);
+    mvn_log_warn("rate limited %d", 10);
+    if (result && SDL_strstr(mvn_strbuf_to_cstr(output),
+                             "Suppressed 7 more messages like \"rate limited %d\"") == NULL) {
+        printf("FAIL: Suppressed messages were not reported: %s\n", mvn_strbuf_to_cstr(output));
+        result = false;
+    }
+
+    mvn_logger_set_rate_limit(
+        MVN_LOG_WARN, MVN_LOG_RATE_LIMIT_BURST, MVN_LOG_RATE_LIMIT_INTERVAL_MS);
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+    mvn_strbuf_free(output);
+
+    if (result) {
+        printf("PASS: Rate limiting working correctly\n");
+    }
+    return result;
+}
+
+/**
+ * \brief           Test collapsing of identical consecutive messages
+ * \return          true if test passes, false otherwise
+ */
+static bool test_repeat_collapse(void)
+{
+    printf("Testing collapsing of repeated messages...\n");
+
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    mvn_strbuf_t         *output = mvn_strbuf_init(0);
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetLogOutputFunction(collect_log_output, output);
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+
+    uint32_t collapsed_before = mvn_logger_get_collapsed_count();
+    for (int i = 0; i < 5; i++) {
+        mvn_log_error("Failed to draw text: %s", "no font");
+    }
+    mvn_log_error("A different failure");
+    mvn_log_error("A different failure");
+    mvn_logger_flush();
+
+    const char *expected = "Failed to draw text: no font\n"
+                           "Last message repeated 4 times\n"
+                           "A different failure\n"
+                           "Last message repeated 1 times\n";
+    uint32_t    collapsed = mvn_logger_get_collapsed_count() - collapsed_before;
+    bool        result    = collapsed == 5 && SDL_strcmp(mvn_strbuf_to_cstr(output), expected) == 0;
+    if (!result) {
+        printf("FAIL: %u messages collapsed, output:\n%s", collapsed, mvn_strbuf_to_cstr(output));
+    }
+
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+    mvn_strbuf_free(output);
+
+    if (result) {
+        printf("PASS: Repeated messages collapsed correctly\n");
+    }
+    return result;
+}
+
+/**
+ * \brief           Test that long flood controlled messages are not truncated
+ * \return          true if test passes, false otherwise
+ */
+static bool test_long_message(void)
+{
+    printf("Testing long flood controlled messages...\n");
+
+    SDL_LogOutputFunction original_fn;
+    void                 *original_userdata;
+    mvn_strbuf_t         *output = mvn_strbuf_init(0);
+    char                  long_text[320];
+    SDL_GetLogOutputFunction(&original_fn, &original_userdata);
+    SDL_SetLogOutputFunction(collect_log_output, output);
+    mvn_logger_set_all_levels(MVN_LOG_INFO);
+
+    for (size_t i = 0; i < sizeof(long_text) - 1; i++) {
+        long_text[i] = (char)('a' + i % 26);
+    }
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    // Once with collapsing, once without, synchronously, with a file sink and asynchronously
+    const char *path    = "mvn-logger-long-test.log";
+    const char *sinks[] = {"console", "file", "async"};
+    char        line[sizeof(long_text) + 16];
+    bool        result = true;
+    for (size_t sink = 0; sink < SDL_arraysize(sinks) && result; sink++) {
+        if (sink == 1 && !mvn_logger_set_file(path)) {
+            printf("FAIL: Could not open log file\n");
+            result = false;
+            break;
+        }
+        if (sink == 2) {
+            mvn_logger_start_async(0, MVN_LOG_OVERFLOW_BLOCK);
+        }
+
+        // The sink name keeps the message from collapsing into the one of the previous sink
+        SDL_snprintf(line, sizeof(line), "%s %s end\n", sinks[sink], long_text);
+        for (int collapse = 1; collapse >= 0 && result; collapse--) {
+            mvn_logger_set_collapse_repeats(collapse != 0);
+            mvn_strbuf_reset(output);
+            mvn_log_error("%s %s end", sinks[sink], long_text);
+            mvn_logger_flush();
+
+            result = SDL_strcmp(mvn_strbuf_to_cstr(output), line) == 0;
+            if (!result) {
+                printf("FAIL: Long message changed on the %s with collapsing %s: %s\n",
+                       sinks[sink],
+                       collapse ? "enabled" : "disabled",
+                       mvn_strbuf_to_cstr(output));
+            }
+        }
+
+        char *contents = sink > 0 && result ? SDL_LoadFile(path, NULL) : NULL;
+        if (sink > 0 && result && (contents == NULL || SDL_strstr(contents, line) == NULL)) {
+            printf("FAIL: Long message truncated in the log file by the %s\n", sinks[sink]);
+            result = false;
+        }
+        SDL_free(contents);
+    }
+
+    mvn_logger_shutdown();
+    SDL_RemovePath(path);
+
+    mvn_logger_set_collapse_repeats(true);
+    SDL_SetLogOutputFunction(original_fn, original_userdata);
+    mvn_strbuf_free(output);
+
+    if (result) {
+        printf("PASS: Long messages logged in full\n");
+    }
+    return result;
+}
+
 /**
  * \brief           Run all logger tests
  * \param[out] passed_tests Pointer to the number of passed tests
@@ -410,6 +902,13 @@ int run_logger_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_category_logging);
     RUN_TEST(test_debug_vs_release_config);
     RUN_TEST(test_logger_set_levels);
+    RUN_TEST(test_async_logging);
+    RUN_TEST(test_async_overflow_drop);
+    RUN_TEST(test_log_file_sink);
+    RUN_TEST(test_binary_logging);
+    RUN_TEST(test_rate_limit);
+    RUN_TEST(test_repeat_collapse);
+    RUN_TEST(test_long_message);
 
     // Calculate how many tests were run
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
@@ -0,0 +1,223 @@
+/**
+ * \file            mvn-profile-test.c
+ * \brief           Tests for MVN profiler functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-alloc.h"
+#include "mvn/mvn-profile.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROFILE_TEST_FILE "mvn-profile-test.json"
+
+#if defined(MVN_PROFILE_ENABLED)
+
+/**
+ * \brief           Count occurrences of a substring
+ * \param[in]       haystack: String to search
+ * \param[in]       needle: Substring to count
+ * \return          Number of non-overlapping occurrences
+ */
+static int count_occurrences(const char *haystack, const char *needle)
+{
+    int    count  = 0;
+    size_t length = strlen(needle);
+    for (const char *p = strstr(haystack, needle); p != NULL; p = strstr(p + length, needle)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * \brief           Record zones on a worker thread
+ * \param[in]       data: Unused
+ * \return          0
+ */
+static int profile_worker(void *data)
+{
+    (void)data;
+    for (int i = 0; i < 10; i++) {
+        MVN_PROFILE_ZONE("worker")
+        {
+            SDL_Delay(1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test recording nested zones and exporting them as trace JSON
+ * \return          1 on success, 0 on failure
+ */
+static int test_profile_export(void)
+{
+    MVN_PROFILE_BEGIN("outer");
+    MVN_PROFILE_ZONE("inner \"quoted\"")
+    {
+        SDL_Delay(2);
+    }
+    MVN_PROFILE_END();
+
+    // Unbalanced ends are ignored
+    MVN_PROFILE_END();
+
+    SDL_Thread *thread = SDL_CreateThread(profile_worker, "profile_worker", NULL);
+    TEST_ASSERT(thread != NULL, "Failed to create worker thread");
+    SDL_WaitThread(thread, NULL);
+
+    // Paused zones are not recorded
+    mvn_profile_set_enabled(false);
+    MVN_PROFILE_ZONE("paused") {}
+    mvn_profile_set_enabled(true);
+
+    TEST_ASSERT(mvn_profile_export(PROFILE_TEST_FILE), "Failed to export profile");
+
+    size_t size = 0;
+    char  *json = SDL_LoadFile(PROFILE_TEST_FILE, &size);
+    TEST_ASSERT(json != NULL && size > 0, "Failed to read exported profile");
+    TEST_ASSERT(strncmp(json, "{\"displayTimeUnit\"", 18) == 0, "Unexpected trace header");
+    TEST_ASSERT(count_occurrences(json, "\"ph\":\"X\"") == 12, "Expected 12 complete events");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"outer\"") == 1, "Outer zone missing");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"inner \\\"quoted\\\"\"") == 1,
+                "Inner zone name should be escaped");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"worker\"") == 10, "Worker zones missing");
+    TEST_ASSERT(strstr(json, "paused") == NULL, "Paused zone should not be recorded");
+    SDL_free(json);
+
+    mvn_profile_shutdown();
+    SDL_RemovePath(PROFILE_TEST_FILE);
+    return 1;
+}
+
+/**
+ * \brief           Test exporting the profile on shutdown
+ * \return          1 on success, 0 on failure
+ */
+static int test_profile_export_on_quit(void)
+{
+    TEST_ASSERT(mvn_profile_set_export_on_quit(PROFILE_TEST_FILE), "Failed to set export path");
+    MVN_PROFILE_ZONE("shutdown zone") {}
+    mvn_profile_shutdown();
+
+    size_t size = 0;
+    char  *json = SDL_LoadFile(PROFILE_TEST_FILE, &size);
+    TEST_ASSERT(json != NULL, "Profile should be exported on shutdown");
+    TEST_ASSERT(strstr(json, "\"name\":\"shutdown zone\"") != NULL, "Zone missing from export");
+    SDL_free(json);
+    SDL_RemovePath(PROFILE_TEST_FILE);
+
+    // Shutdown released the recorded zones
+    TEST_ASSERT(mvn_profile_export(PROFILE_TEST_FILE), "Failed to export empty profile");
+    json = SDL_LoadFile(PROFILE_TEST_FILE, &size);
+    TEST_ASSERT(json != NULL && strstr(json, "\"ph\"") == NULL, "Profile should be empty");
+    SDL_free(json);
+    SDL_RemovePath(PROFILE_TEST_FILE);
+    return 1;
+}
+
+/**
+ * \brief           Test that threads that exit leave their ring to the next thread
+ * \return          1 on success, 0 on failure
+ */
+static int test_profile_thread_rings(void)
+{
+    SDL_Thread *thread = SDL_CreateThread(profile_worker, "profile_worker", NULL);
+    TEST_ASSERT(thread != NULL, "Failed to create worker thread");
+    SDL_WaitThread(thread, NULL);
+
+    // Short-lived threads one after another reuse the ring of the previous one
+    mvn_alloc_stats_t before = mvn_get_alloc_stats(MVN_ALLOC_TAG_GENERAL);
+    for (int i = 0; i < 8; i++) {
+        thread = SDL_CreateThread(profile_worker, "profile_worker", NULL);
+        TEST_ASSERT(thread != NULL, "Failed to create worker thread");
+        SDL_WaitThread(thread, NULL);
+    }
+    mvn_alloc_stats_t after = mvn_get_alloc_stats(MVN_ALLOC_TAG_GENERAL);
+    TEST_ASSERT_FMT(after.live_count == before.live_count,
+                    "Exited threads should not keep rings, %zu more allocations",
+                    after.live_count - before.live_count);
+
+    // The ring of the last thread still holds its zones
+    TEST_ASSERT(mvn_profile_export(PROFILE_TEST_FILE), "Failed to export profile");
+    size_t size = 0;
+    char  *json = SDL_LoadFile(PROFILE_TEST_FILE, &size);
+    TEST_ASSERT(json != NULL, "Failed to read exported profile");
+    TEST_ASSERT(count_occurrences(json, "\"name\":\"worker\"") == 10, "Expected one thread");
+    SDL_free(json);
+
+    mvn_profile_shutdown();
+    SDL_RemovePath(PROFILE_TEST_FILE);
+    return 1;
+}
+
+#else
+
+/**
+ * \brief           Test that the profiler compiles out
+ * \return          1 on success, 0 on failure
+ */
+static int test_profile_disabled(void)
+{
+    int value = 0;
+
+    MVN_PROFILE_BEGIN("disabled");
+    MVN_PROFILE_ZONE("disabled zone")
+    {
+        value++;
+    }
+    MVN_PROFILE_END();
+
+    TEST_ASSERT(value == 1, "Zone body should run once when the profiler is compiled out");
+    TEST_ASSERT(!mvn_profile_export(PROFILE_TEST_FILE), "Export should fail when compiled out");
+    return 1;
+}
+
+#endif /* MVN_PROFILE_ENABLED */
+
+int run_profile_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== PROFILE TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+#if defined(MVN_PROFILE_ENABLED)
+    RUN_TEST(test_profile_export);
+    RUN_TEST(test_profile_export_on_quit);
+    RUN_TEST(test_profile_thread_rings);
+#else
+    RUN_TEST(test_profile_disabled);
+#endif
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_profile_tests(&passed, &failed, &total);
+
+    printf("\n===== PROFILE TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
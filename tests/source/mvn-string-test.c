@@ -563,6 +563,102 @@ static int test_string_trimming(void)
     return 1;
 }
 
+/**
+ * \brief           Test in-place case conversion and trimming
+ * \return          1 on success, 0 on failure
+ */
+static int test_string_inplace(void)
+{
+    // Long enough to cover full blocks and a scalar tail, with UTF-8 bytes that must survive
+    mvn_string_t *str = mvn_string_from_cstr("Caf\xC3\xA9 MIXED case Text @[`{ 0123456789 Z");
+    TEST_ASSERT(str != NULL, "Failed to create string");
+    char *data = str->data;
+
+    TEST_ASSERT(mvn_string_to_lowercase_inplace(str), "to_lower_inplace failed");
+    TEST_ASSERT(strcmp(mvn_string_to_cstr(str),
+                       "caf\xC3\xA9 mixed case text @[`{ 0123456789 z") == 0,
+                "to_lower_inplace content incorrect");
+    TEST_ASSERT(str->data == data, "to_lower_inplace should not reallocate");
+
+    TEST_ASSERT(mvn_string_to_uppercase_inplace(str), "to_upper_inplace failed");
+    TEST_ASSERT(strcmp(mvn_string_to_cstr(str),
+                       "CAF\xC3\xA9 MIXED CASE TEXT @[`{ 0123456789 Z") == 0,
+                "to_upper_inplace content incorrect");
+    mvn_string_free(str);
+
+    TEST_ASSERT(!mvn_string_to_lowercase_inplace(NULL), "to_lower_inplace NULL should fail");
+    TEST_ASSERT(!mvn_string_to_uppercase_inplace(NULL), "to_upper_inplace NULL should fail");
+
+    // Whitespace runs longer than one block on both sides
+    str = mvn_string_from_cstr(" \t\n\v\f\r                  padded value\t \r\n                 ");
+    TEST_ASSERT(str != NULL, "Failed to create string");
+    data = str->data;
+    TEST_ASSERT(mvn_string_trim_inplace(str), "trim_inplace failed");
+    TEST_ASSERT(strcmp(mvn_string_to_cstr(str), "padded value") == 0,
+                "trim_inplace content incorrect");
+    TEST_ASSERT(mvn_string_length(str) == 12, "trim_inplace length incorrect");
+    TEST_ASSERT(str->data == data, "trim_inplace should not reallocate");
+
+    mvn_string_t *long_trim = mvn_string_from_cstr("                    x                    ");
+    mvn_string_t *trimmed   = mvn_string_trim(long_trim);
+    TEST_ASSERT(trimmed != NULL && strcmp(mvn_string_to_cstr(trimmed), "x") == 0,
+                "trim across blocks incorrect");
+    mvn_string_free(trimmed);
+    mvn_string_free(long_trim);
+
+    mvn_string_clear(str);
+    TEST_ASSERT(mvn_string_append(str, "                                "), "Append failed");
+    TEST_ASSERT(mvn_string_trim_inplace(str), "trim_inplace whitespace only failed");
+    TEST_ASSERT(mvn_string_length(str) == 0 && strcmp(mvn_string_to_cstr(str), "") == 0,
+                "trim_inplace whitespace only should produce empty string");
+    mvn_string_free(str);
+
+    TEST_ASSERT(!mvn_string_trim_inplace(NULL), "trim_inplace NULL should fail");
+
+    return 1;
+}
+
+/**
+ * \brief           Test UTF-8 validation and codepoint counting
+ * \return          1 on success, 0 on failure
+ */
+static int test_string_utf8(void)
+{
+    // 2, 3 and 4 byte sequences placed after an ASCII run longer than one block
+    mvn_string_t *str =
+        mvn_string_from_cstr("plain ascii prefix \xC3\xA9 \xE2\x82\xAC \xF0\x9F\x8E\xAE end");
+    TEST_ASSERT(str != NULL, "Failed to create string");
+    TEST_ASSERT(mvn_string_is_valid_utf8(str), "Valid UTF-8 rejected");
+    TEST_ASSERT(mvn_string_utf8_length(str) == 28, "UTF-8 length incorrect");
+    mvn_string_free(str);
+
+    mvn_string_t *empty = mvn_string_from_cstr("");
+    TEST_ASSERT(mvn_string_is_valid_utf8(empty), "Empty string should be valid UTF-8");
+    TEST_ASSERT(mvn_string_utf8_length(empty) == 0, "Empty string UTF-8 length should be 0");
+    mvn_string_free(empty);
+
+    static const char *const invalid[] = {
+        "stray continuation \x80",
+        "truncated sequence \xE2\x82",
+        "overlong encoding \xC0\xAF",
+        "overlong three byte \xE0\x80\xAF",
+        "utf-16 surrogate \xED\xA0\x80",
+        "above max codepoint \xF4\x90\x80\x80",
+        "invalid lead \xFF",
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        mvn_string_t *bad = mvn_string_from_cstr(invalid[i]);
+        TEST_ASSERT(bad != NULL, "Failed to create string");
+        TEST_ASSERT(!mvn_string_is_valid_utf8(bad), "Invalid UTF-8 accepted");
+        mvn_string_free(bad);
+    }
+
+    TEST_ASSERT(!mvn_string_is_valid_utf8(NULL), "Validating NULL should fail");
+    TEST_ASSERT(mvn_string_utf8_length(NULL) == 0, "UTF-8 length of NULL should be 0");
+
+    return 1;
+}
+
 /**
  * \brief           Test string substring
  * \return          1 on success, 0 on failure
@@ -687,6 +783,153 @@ static int test_string_compare(void)
     return 1;
 }
 
+/**
+ * \brief           Test cached hashing and hash assisted comparison
+ * \return          1 on success, 0 on failure
+ */
+static int test_string_hash(void)
+{
+    mvn_string_t *str1 = mvn_string_from_cstr("texture_atlas");
+    mvn_string_t *str2 = mvn_string_from_cstr("texture_atlas");
+    TEST_ASSERT(str1 != NULL && str2 != NULL, "Failed to create strings");
+
+    TEST_ASSERT(!str1->hash_valid, "Hash should be computed lazily");
+    uint64_t hash = mvn_string_hash(str1);
+    TEST_ASSERT(str1->hash_valid && str1->hash == hash, "Hash should be cached");
+    TEST_ASSERT(hash == mvn_string_hash(str2), "Equal strings should hash equally");
+    TEST_ASSERT(hash == mvn_string_hash_bytes("texture_atlas", 13),
+                "String hash should match hash of its bytes");
+    TEST_ASSERT(mvn_string_compare(str1, str2), "Equal strings with cached hashes should match");
+
+    // Strings of equal length are told apart by their cached hashes
+    mvn_string_t *str3 = mvn_string_from_cstr("texture_atlaz");
+    TEST_ASSERT(str3 != NULL && mvn_string_hash(str3) != hash, "Failed to hash third string");
+    TEST_ASSERT(!mvn_string_compare(str1, str3), "Different hashes should not match");
+    mvn_string_free(str3);
+
+    // Every mutation invalidates the cache
+    TEST_ASSERT(mvn_string_append(str2, "_2"), "Append failed");
+    TEST_ASSERT(!str2->hash_valid, "Append should invalidate hash");
+    TEST_ASSERT(mvn_string_hash(str2) != hash, "Different strings should hash differently");
+    TEST_ASSERT(!mvn_string_compare(str1, str2), "Different strings should not match");
+
+    TEST_ASSERT(mvn_string_to_uppercase_inplace(str2), "Uppercase failed");
+    TEST_ASSERT(!str2->hash_valid, "In-place case conversion should invalidate hash");
+    mvn_string_hash(str2);
+    mvn_string_clear(str2);
+    TEST_ASSERT(!str2->hash_valid, "Clear should invalidate hash");
+    TEST_ASSERT(mvn_string_hash(str2) == mvn_string_hash_bytes("", 0),
+                "Cleared string should hash as empty");
+
+    TEST_ASSERT(mvn_string_hash(NULL) == 0, "Hash of NULL should be 0");
+
+    mvn_string_free(str1);
+    mvn_string_free(str2);
+    return 1;
+}
+
+/**
+ * \brief           Test string builder appends and growth
+ * \return          1 on success, 0 on failure
+ */
+static int test_strbuf_append(void)
+{
+    mvn_strbuf_t *buf = mvn_strbuf_init(4);
+    TEST_ASSERT(buf != NULL, "Failed to initialize string builder");
+    TEST_ASSERT(mvn_strbuf_length(buf) == 0, "New builder should be empty");
+    TEST_ASSERT(strcmp(mvn_strbuf_to_cstr(buf), "") == 0, "New builder data should be empty");
+
+    TEST_ASSERT(mvn_strbuf_append(buf, "Hello"), "Failed to append C string");
+    TEST_ASSERT(mvn_strbuf_append_char(buf, ','), "Failed to append character");
+    TEST_ASSERT(mvn_strbuf_append_n(buf, " World!!!", 6), "Failed to append bytes");
+    TEST_ASSERT(strcmp(mvn_strbuf_to_cstr(buf), "Hello, World") == 0, "Builder data incorrect");
+    TEST_ASSERT(mvn_strbuf_length(buf) == 12, "Builder length incorrect");
+    TEST_ASSERT(buf->capacity >= 13, "Builder should have grown past its initial capacity");
+
+    mvn_string_t *str = mvn_string_from_cstr("!");
+    TEST_ASSERT(mvn_strbuf_append_string(buf, str), "Failed to append mvn_string_t");
+    TEST_ASSERT(strcmp(mvn_strbuf_to_cstr(buf), "Hello, World!") == 0, "Builder data incorrect");
+    mvn_string_free(str);
+
+    // Invalid arguments
+    TEST_ASSERT(!mvn_strbuf_append(buf, NULL), "Appending NULL should fail");
+    TEST_ASSERT(!mvn_strbuf_append(NULL, "x"), "Appending to NULL builder should fail");
+    TEST_ASSERT(mvn_strbuf_length(buf) == 13, "Failed appends should not change the builder");
+
+    mvn_strbuf_free(buf);
+    mvn_strbuf_free(NULL); // Should not crash
+
+    return 1;
+}
+
+/**
+ * \brief           Test string builder formatted appends
+ * \return          1 on success, 0 on failure
+ */
+static int test_strbuf_appendf(void)
+{
+    mvn_strbuf_t *buf = mvn_strbuf_init(0);
+    TEST_ASSERT(buf != NULL, "Failed to initialize string builder");
+
+    TEST_ASSERT(mvn_strbuf_appendf(buf, "fps=%d", 60), "Failed to append formatted text");
+    TEST_ASSERT(mvn_strbuf_appendf(buf, " dt=%.2f %s", 0.5, "ms"), "Failed to append formatted");
+    TEST_ASSERT(strcmp(mvn_strbuf_to_cstr(buf), "fps=60 dt=0.50 ms") == 0,
+                "Formatted data incorrect");
+
+    // Formatting output larger than the remaining capacity must grow and retry
+    char long_text[1024];
+    SDL_memset(long_text, 'a', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    size_t before = mvn_strbuf_length(buf);
+    TEST_ASSERT(mvn_strbuf_appendf(buf, "[%s]", long_text), "Failed to append long text");
+    TEST_ASSERT(mvn_strbuf_length(buf) == before + 1025, "Long formatted length incorrect");
+    TEST_ASSERT(buf->data[before] == '[' && buf->data[before + 1024] == ']',
+                "Long formatted data incorrect");
+    TEST_ASSERT(buf->data[mvn_strbuf_length(buf)] == '\0', "Builder should stay null terminated");
+
+    mvn_strbuf_free(buf);
+
+    return 1;
+}
+
+/**
+ * \brief           Test string builder reset, reserve and finish
+ * \return          1 on success, 0 on failure
+ */
+static int test_strbuf_reset_finish(void)
+{
+    mvn_strbuf_t *buf = mvn_strbuf_init(0);
+    TEST_ASSERT(buf != NULL, "Failed to initialize string builder");
+
+    TEST_ASSERT(mvn_strbuf_reserve(buf, 500), "Failed to reserve capacity");
+    TEST_ASSERT(buf->capacity >= 501, "Reserve should guarantee room for the terminator");
+
+    TEST_ASSERT(mvn_strbuf_append(buf, "temporary"), "Failed to append");
+    size_t capacity = buf->capacity;
+    char  *data     = buf->data;
+    mvn_strbuf_reset(buf);
+    TEST_ASSERT(mvn_strbuf_length(buf) == 0, "Reset should clear the length");
+    TEST_ASSERT(strcmp(mvn_strbuf_to_cstr(buf), "") == 0, "Reset should clear the data");
+    TEST_ASSERT(buf->capacity == capacity && buf->data == data, "Reset should keep the buffer");
+
+    TEST_ASSERT(mvn_strbuf_appendf(buf, "%s-%d", "item", 7), "Failed to append formatted");
+    mvn_string_t *str = mvn_strbuf_finish(buf);
+    TEST_ASSERT(str != NULL, "Failed to finish builder");
+    TEST_ASSERT(str->data == data, "Finish should hand over the buffer without copying");
+    TEST_ASSERT(mvn_string_length(str) == 6, "Finished string length incorrect");
+    TEST_ASSERT(strcmp(mvn_string_to_cstr(str), "item-7") == 0, "Finished string data incorrect");
+
+    // The finished string is a regular string and can keep growing
+    TEST_ASSERT(mvn_string_append(str, "!"), "Failed to append to finished string");
+    TEST_ASSERT(strcmp(mvn_string_to_cstr(str), "item-7!") == 0, "Appended data incorrect");
+    mvn_string_free(str);
+
+    TEST_ASSERT(mvn_strbuf_finish(NULL) == NULL, "Finishing NULL builder should fail");
+
+    return 1;
+}
+
 /**
  * \brief           Run all string tests
  * \param[out] passed_tests Pointer to the number of passed tests
@@ -712,9 +955,15 @@ int run_string_tests(int *passed_tests, int *failed_tests, int *total_tests)
     RUN_TEST(test_string_split);
     RUN_TEST(test_string_case_conversion);
     RUN_TEST(test_string_trimming);
+    RUN_TEST(test_string_inplace);
+    RUN_TEST(test_string_utf8);
     RUN_TEST(test_string_substring);
     RUN_TEST(test_string_compare);
+    RUN_TEST(test_string_hash);
     RUN_TEST(test_string_edge_cases);
+    RUN_TEST(test_strbuf_append);
+    RUN_TEST(test_strbuf_appendf);
+    RUN_TEST(test_strbuf_reset_finish);
 
     // Calculate how many tests were run
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
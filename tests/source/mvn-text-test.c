@@ -259,15 +259,18 @@ int run_text_tests(int *passed_tests, int *failed_tests, int *total_tests)
 
     printf("\n===== TEXT TESTS =====\n\n");
 
-#if defined(MVN_TEST_CI)
-    printf("Skipping text tests in CI mode.\n");
-#else
     int passed_before = *passed_tests;
     int failed_before = *failed_tests;
 
     // Initialize SDL and TTF for these tests
     // A minimal window is needed for renderer/text engine context
-    if (!mvn_init(100, 100, "Text Test", MVN_WINDOW_HIDDEN)) {
+#if defined(MVN_TEST_CI)
+    // CI runners have no display, so render offscreen
+    bool initialized = mvn_init_headless(100, 100);
+#else
+    bool initialized = mvn_init(100, 100, "Text Test", MVN_WINDOW_HIDDEN);
+#endif
+    if (!initialized) {
         printf("ERROR: Failed to initialize MVN for text tests. Skipping text tests.\n");
         // Increment total for the category attempt, but mark all as failed implicitly
         (*total_tests)++;
@@ -291,7 +294,6 @@ int run_text_tests(int *passed_tests, int *failed_tests, int *total_tests)
 
     // Return number of passed tests from this suite
     return *passed_tests - passed_before;
-#endif // MVN_TEST_CI
 }
 
 int main(void)
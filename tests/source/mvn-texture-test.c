@@ -12,6 +12,7 @@
  */
 
 #include "mvn-test-utils.h"
+#include "mvn/mvn-core.h"
 #include "mvn/mvn-texture.h"
 
 #include <stdio.h>
@@ -59,6 +60,44 @@ static int test_image_load(void)
     return result;
 }
 
+/**
+ * \brief           Test rendering headless and reading the frame back
+ * \return          1 on success, 0 on failure
+ */
+static int test_screen_readback(void)
+{
+    char texture_path[256];
+    SDL_snprintf(texture_path, sizeof(texture_path), "%s/%s", ASSET_DIR, "char-1.png");
+
+    TEST_ASSERT(mvn_init_headless(64, 32), "Headless initialization failed");
+    TEST_ASSERT(mvn_is_headless(), "Framework should report headless mode");
+
+    mvn_texture_t *texture = mvn_load_texture(mvn_get_renderer(), texture_path);
+    TEST_ASSERT(texture != NULL, "Failed to load texture in headless mode");
+
+    mvn_begin_drawing();
+    mvn_clear_background(MVN_STRUCT(mvn_color_t, {.r = 255, .g = 0, .b = 0, .a = 255}));
+    mvn_draw_texture(texture, 32, 0, MVN_WHITE);
+
+    mvn_image_t *frame = mvn_load_image_from_screen(mvn_get_renderer());
+    mvn_end_drawing();
+
+    TEST_ASSERT(frame != NULL, "Failed to read back frame");
+    TEST_ASSERT(frame->w == 64 && frame->h == 32, "Frame size should match the render target");
+
+    // The left half is only covered by the clear color
+    const uint8_t *pixel = (const uint8_t *)frame->pixels;
+    TEST_ASSERT(pixel[0] == 255 && pixel[1] == 0 && pixel[2] == 0 && pixel[3] == 255,
+                "Frame should contain the clear color");
+
+    mvn_unload_image(frame);
+    mvn_unload_texture(texture);
+    mvn_quit();
+
+    TEST_ASSERT(!mvn_is_headless(), "Headless mode should end with mvn_quit");
+    return 1;
+}
+
 /**
  * \brief           Run all texture tests
  * \return          Number of tests that passed
@@ -71,6 +110,7 @@ int run_texture_tests(int *passed_tests, int *failed_tests, int *total_tests)
     int failed_before = *failed_tests;
 
     RUN_TEST(test_image_load);
+    RUN_TEST(test_screen_readback);
 
     // Calculate how many tests were run
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
@@ -0,0 +1,267 @@
+/**
+ * \file            mvn-vfs-test.c
+ * \brief           Tests for MVN archive and virtual file system functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-file.h"
+#include "mvn/mvn-vfs.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define VFS_SOURCE_DIR   "mvn_vfs_test_source"
+#define VFS_OVERLAY_DIR  "mvn_vfs_test_overlay"
+#define VFS_ARCHIVE_PATH "mvn_vfs_test" MVN_PAK_EXTENSION
+
+/* Size of the compressible test file */
+#define VFS_LARGE_SIZE 20000
+
+/**
+ * \brief           Write a file
+ * \param[in]       path: Path of the file
+ * \param[in]       data: Contents
+ * \param[in]       size: Size of the contents
+ * \return          true on success, false on failure
+ */
+static bool write_file(const char *path, const void *data, size_t size)
+{
+    SDL_IOStream *file = SDL_IOFromFile(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = SDL_WriteIO(file, data, size) == size;
+    return SDL_CloseIO(file) && written;
+}
+
+/**
+ * \brief           Fill a buffer with random runs and long repeats, exercising every LZ4 length
+ * \param[out]      data: Buffer to fill
+ * \param[in]       size: Size of the buffer
+ */
+static void fill_large_file(uint8_t *data, size_t size)
+{
+    uint32_t state = 12345;
+    for (size_t i = 0; i < size; i++) {
+        state = state * 1103515245u + 12345u;
+        if ((i / 1000) % 3 == 0) {
+            data[i] = (uint8_t)(state >> 16);
+        } else if ((i / 1000) % 3 == 1) {
+            data[i] = "repeated text "[i % 14];
+        } else {
+            data[i] = 'x';
+        }
+    }
+}
+
+/**
+ * \brief           Create the directories packed and mounted by the tests
+ * \param[out]      large: Receives the contents of the large file
+ * \return          true on success, false on failure
+ */
+static bool create_test_files(uint8_t *large)
+{
+    fill_large_file(large, VFS_LARGE_SIZE);
+    SDL_CreateDirectory(VFS_SOURCE_DIR);
+    SDL_CreateDirectory(VFS_SOURCE_DIR "/sub");
+    SDL_CreateDirectory(VFS_OVERLAY_DIR);
+    return write_file(VFS_SOURCE_DIR "/a.txt", "archived a", 10) &&
+           write_file(VFS_SOURCE_DIR "/empty.txt", "", 0) &&
+           write_file(VFS_SOURCE_DIR "/sub/large.bin", large, VFS_LARGE_SIZE) &&
+           write_file(VFS_OVERLAY_DIR "/a.txt", "overlay a", 9);
+}
+
+/**
+ * \brief           Remove the files created by the tests
+ */
+static void remove_test_files(void)
+{
+    SDL_RemovePath(VFS_SOURCE_DIR "/a.txt");
+    SDL_RemovePath(VFS_SOURCE_DIR "/empty.txt");
+    SDL_RemovePath(VFS_SOURCE_DIR "/sub/large.bin");
+    SDL_RemovePath(VFS_SOURCE_DIR "/sub");
+    SDL_RemovePath(VFS_SOURCE_DIR);
+    SDL_RemovePath(VFS_OVERLAY_DIR "/a.txt");
+    SDL_RemovePath(VFS_OVERLAY_DIR);
+    SDL_RemovePath(VFS_ARCHIVE_PATH);
+}
+
+/**
+ * \brief           Test building an archive and reading its files through the mount
+ * \return          1 on success, 0 on failure
+ */
+static int test_vfs_archive(void)
+{
+    static uint8_t large[VFS_LARGE_SIZE];
+    TEST_ASSERT(create_test_files(large), "Failed to create test files");
+    TEST_ASSERT(mvn_pak_build(VFS_SOURCE_DIR, VFS_ARCHIVE_PATH, false), "Failed to build archive");
+    TEST_ASSERT(!mvn_file_exists("a.txt"), "Nothing should be found before mounting");
+
+    TEST_ASSERT(mvn_vfs_mount(VFS_ARCHIVE_PATH), "Failed to mount archive");
+    TEST_ASSERT(mvn_vfs_get_mount_count() == 1, "Mount count incorrect");
+    TEST_ASSERT(mvn_file_exists("a.txt") && mvn_is_path_file("./sub//large.bin"),
+                "Archived files should exist");
+    TEST_ASSERT(mvn_get_file_length("sub\\large.bin") == VFS_LARGE_SIZE, "Archived length wrong");
+    TEST_ASSERT(mvn_vfs_resolve("empty.txt", NULL, 0, NULL) == MVN_VFS_SOURCE_ARCHIVE,
+                "Empty file should be archived");
+    TEST_ASSERT(mvn_vfs_resolve("missing.txt", NULL, 0, NULL) == MVN_VFS_SOURCE_NONE,
+                "Missing file should not resolve");
+    TEST_ASSERT(mvn_vfs_resolve("../a.txt", NULL, 0, NULL) == MVN_VFS_SOURCE_NONE,
+                "Paths leaving the mount should not resolve");
+    TEST_ASSERT(mvn_vfs_resolve("sub/../a.txt", NULL, 0, NULL) == MVN_VFS_SOURCE_ARCHIVE,
+                "Paths are normalized like mvn_normalize_path");
+
+    char native[MVN_VFS_PATH_SIZE];
+    TEST_ASSERT(mvn_vfs_resolve("a.txt", native, sizeof(native), NULL) == MVN_VFS_SOURCE_ARCHIVE &&
+                    strcmp(native, VFS_ARCHIVE_PATH) == 0,
+                "Resolve should report the archive");
+
+    // Uncompressed files are read straight from the mapped archive
+    mvn_file_view_t view;
+    TEST_ASSERT(mvn_file_map("sub/large.bin", &view), "Failed to map archived file");
+    TEST_ASSERT(view.owner != NULL && view.size == VFS_LARGE_SIZE,
+                "View should point into the archive");
+    TEST_ASSERT(((uintptr_t)view.data % MVN_PAK_ALIGNMENT) == 0, "Payload should be aligned");
+    TEST_ASSERT(memcmp(view.data, large, VFS_LARGE_SIZE) == 0, "Archived contents incorrect");
+
+    char *text = mvn_load_file_text("a.txt");
+    TEST_ASSERT(text != NULL && strcmp(text, "archived a") == 0, "Archived text incorrect");
+    mvn_unload_file_text(text);
+
+    // The view keeps the archive open after unmounting
+    TEST_ASSERT(mvn_vfs_unmount(VFS_ARCHIVE_PATH), "Failed to unmount archive");
+    TEST_ASSERT(!mvn_file_exists("a.txt"), "Unmounted files should not exist");
+    TEST_ASSERT(memcmp(view.data, large, VFS_LARGE_SIZE) == 0, "View should outlive the mount");
+    mvn_file_unmap(&view);
+
+    TEST_ASSERT(!mvn_vfs_unmount(VFS_ARCHIVE_PATH), "Unmounting twice should fail");
+    return 1;
+}
+
+/**
+ * \brief           Test LZ4 compressed archives
+ * \return          1 on success, 0 on failure
+ */
+static int test_vfs_compression(void)
+{
+    static uint8_t large[VFS_LARGE_SIZE];
+    fill_large_file(large, VFS_LARGE_SIZE);
+
+    TEST_ASSERT(mvn_pak_build(VFS_SOURCE_DIR, VFS_ARCHIVE_PATH, true), "Failed to build archive");
+    TEST_ASSERT(mvn_get_file_length(VFS_ARCHIVE_PATH) < VFS_LARGE_SIZE,
+                "Compressed archive should be smaller than its files");
+    TEST_ASSERT(mvn_vfs_mount(VFS_ARCHIVE_PATH), "Failed to mount compressed archive");
+
+    mvn_file_view_t view;
+    TEST_ASSERT(mvn_file_map("sub/large.bin", &view), "Failed to map compressed file");
+    TEST_ASSERT(view.owner == NULL && view.size == VFS_LARGE_SIZE,
+                "Compressed files should be decompressed into their own buffer");
+    TEST_ASSERT(memcmp(view.data, large, VFS_LARGE_SIZE) == 0, "Decompressed contents incorrect");
+    mvn_file_unmap(&view);
+
+    // Files that do not get smaller are stored as is
+    TEST_ASSERT(mvn_file_map("a.txt", &view), "Failed to map small file");
+    TEST_ASSERT(view.owner != NULL && view.size == 10, "Small file should not be compressed");
+    mvn_file_unmap(&view);
+
+    size_t size = 1;
+    void  *data = mvn_load_file_data("empty.txt", &size);
+    TEST_ASSERT(data != NULL && size == 0, "Empty archived file incorrect");
+    mvn_unload_file_data(data);
+
+    mvn_vfs_unmount_all();
+    TEST_ASSERT(mvn_vfs_get_mount_count() == 0, "All mounts should be removed");
+    return 1;
+}
+
+/**
+ * \brief           Test directory overlays and invalid archives
+ * \return          1 on success, 0 on failure
+ */
+static int test_vfs_overlay(void)
+{
+    TEST_ASSERT(mvn_vfs_mount(VFS_ARCHIVE_PATH), "Failed to mount archive");
+    TEST_ASSERT(mvn_vfs_mount(VFS_OVERLAY_DIR "/"), "Failed to mount overlay directory");
+
+    char *text = mvn_load_file_text("a.txt");
+    TEST_ASSERT(text != NULL && strcmp(text, "overlay a") == 0, "Overlay should take precedence");
+    mvn_unload_file_text(text);
+    TEST_ASSERT(mvn_vfs_resolve("a.txt", NULL, 0, NULL) == MVN_VFS_SOURCE_DIRECTORY,
+                "Overlay should resolve to the directory");
+    TEST_ASSERT(mvn_get_file_length("a.txt") == 9, "Overlay length incorrect");
+    TEST_ASSERT(mvn_get_file_length("sub/large.bin") == VFS_LARGE_SIZE,
+                "Files missing from the overlay should come from the archive");
+
+    char             native[MVN_VFS_PATH_SIZE];
+    mvn_vfs_source_t source = MVN_VFS_SOURCE_NONE;
+    mvn_file_view_t  view;
+    TEST_ASSERT(mvn_vfs_open("a.txt", native, sizeof(native), &view, &source) &&
+                    source == MVN_VFS_SOURCE_DIRECTORY && view.data == NULL,
+                "Open should only map archived files");
+    TEST_ASSERT(mvn_vfs_open("sub/large.bin", native, sizeof(native), &view, &source) &&
+                    source == MVN_VFS_SOURCE_ARCHIVE && view.size == VFS_LARGE_SIZE &&
+                    strcmp(native, VFS_ARCHIVE_PATH) == 0,
+                "Open should map archived files");
+    mvn_file_unmap(&view);
+    TEST_ASSERT(mvn_vfs_open("missing.txt", NULL, 0, &view, &source) &&
+                    source == MVN_VFS_SOURCE_NONE,
+                "Missing files should not be found");
+
+    TEST_ASSERT(mvn_vfs_unmount(VFS_OVERLAY_DIR), "Failed to unmount overlay");
+    text = mvn_load_file_text("a.txt");
+    TEST_ASSERT(text != NULL && strcmp(text, "archived a") == 0, "Archive should be visible again");
+    mvn_unload_file_text(text);
+    mvn_vfs_unmount_all();
+
+    // Anything that is not a valid archive is rejected
+    TEST_ASSERT(write_file(VFS_ARCHIVE_PATH, "MVNPAK\1\0garbage", 15), "Failed to write file");
+    TEST_ASSERT(!mvn_vfs_mount(VFS_ARCHIVE_PATH), "Truncated archive should not mount");
+    TEST_ASSERT(!mvn_vfs_mount("non_existent_archive" MVN_PAK_EXTENSION),
+                "Missing archive should not mount");
+    TEST_ASSERT(mvn_vfs_get_mount_count() == 0, "Failed mounts should not be added");
+
+    remove_test_files();
+    return 1;
+}
+
+int run_vfs_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== VFS TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    RUN_TEST(test_vfs_archive);
+    RUN_TEST(test_vfs_compression);
+    RUN_TEST(test_vfs_overlay);
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_vfs_tests(&passed, &failed, &total);
+
+    printf("\n===== VFS TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
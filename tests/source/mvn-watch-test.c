@@ -0,0 +1,204 @@
+/**
+ * \file            mvn-watch-test.c
+ * \brief           Tests for MVN file watching functionality
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn-test-utils.h"
+#include "mvn/mvn-job.h"
+#include "mvn/mvn-watch.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define WATCH_TEST_DIR  "mvn_watch_test"
+#define WATCH_TEST_FILE WATCH_TEST_DIR "/watched.txt"
+
+/* Longest wait for a change to be reported */
+#define WATCH_TEST_TIMEOUT_MS 3000
+
+/**
+ * \brief           Changes reported to watch_callback
+ */
+typedef struct watch_test_state_t {
+    int  calls;
+    char path[256];
+} watch_test_state_t;
+
+/**
+ * \brief           Record a reported change
+ * \param[in]       path: Path of the changed file
+ * \param[in]       user_data: watch_test_state_t to update
+ */
+static void watch_callback(const char *path, void *user_data)
+{
+    watch_test_state_t *state = user_data;
+    state->calls++;
+    SDL_strlcpy(state->path, path, sizeof(state->path));
+}
+
+/**
+ * \brief           Write a file
+ * \param[in]       path: Path of the file
+ * \param[in]       text: Contents
+ * \return          true on success, false on failure
+ */
+static bool write_file(const char *path, const char *text)
+{
+    SDL_IOStream *file = SDL_IOFromFile(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    size_t length  = strlen(text);
+    bool   written = SDL_WriteIO(file, text, length) == length;
+    return SDL_CloseIO(file) && written;
+}
+
+/**
+ * \brief           Run the main thread queue like mvn_begin_drawing() does
+ * \param[in]       state: Reported changes
+ * \param[in]       calls: Stop once this many changes were reported
+ * \param[in]       timeout_ms: Longest time to wait
+ */
+static void pump_main_thread(const watch_test_state_t *state, int calls, uint64_t timeout_ms)
+{
+    uint64_t end = SDL_GetTicks() + timeout_ms;
+    while (state->calls < calls && SDL_GetTicks() < end) {
+        mvn_job_run_main_thread_queue();
+        SDL_Delay(5);
+    }
+}
+
+/**
+ * \brief           Test that a burst of writes is reported once, on the main thread
+ * \return          1 on success, 0 on failure
+ */
+static int test_watch_coalesce(void)
+{
+    watch_test_state_t state = { 0 };
+    TEST_ASSERT(write_file(WATCH_TEST_FILE, "first"), "Failed to create watched file");
+
+    uint32_t id = mvn_watch_file(WATCH_TEST_FILE, watch_callback, &state);
+    TEST_ASSERT(id != 0, "Failed to watch file");
+    TEST_ASSERT(mvn_get_watch_count() == 1, "Watch count should be 1");
+    TEST_ASSERT(mvn_watch_file(NULL, watch_callback, &state) == 0, "NULL path should fail");
+    TEST_ASSERT(mvn_watch_file(WATCH_TEST_FILE, NULL, NULL) == 0, "NULL callback should fail");
+
+    // Like an editor saving in steps, every write restarts the quiet time
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT(write_file(WATCH_TEST_FILE, i % 2 == 0 ? "second" : "second!"),
+                    "Failed to write watched file");
+        SDL_Delay(MVN_WATCH_COALESCE_MS / 5);
+    }
+
+    pump_main_thread(&state, 1, WATCH_TEST_TIMEOUT_MS);
+    TEST_ASSERT(state.calls == 1, "Change should be reported");
+    TEST_ASSERT(strcmp(state.path, WATCH_TEST_FILE) == 0, "Callback should get the watched path");
+
+    pump_main_thread(&state, 2, MVN_WATCH_COALESCE_MS * 3);
+    TEST_ASSERT_FMT(state.calls == 1, "Burst should be reported once, got %d calls", state.calls);
+
+    TEST_ASSERT(mvn_unwatch_file(id), "Failed to unwatch file");
+    TEST_ASSERT(!mvn_unwatch_file(id), "Second unwatch should fail");
+    TEST_ASSERT(mvn_get_watch_count() == 0, "Watch count should be 0");
+
+    // Changes after unwatching are not reported
+    TEST_ASSERT(write_file(WATCH_TEST_FILE, "third"), "Failed to write watched file");
+    pump_main_thread(&state, 2, MVN_WATCH_COALESCE_MS * 3);
+    TEST_ASSERT(state.calls == 1, "Unwatched file should not be reported");
+
+    mvn_watch_shutdown();
+    return 1;
+}
+
+/**
+ * \brief           Test the polling fallback
+ * \return          1 on success, 0 on failure
+ */
+static int test_watch_polling(void)
+{
+    watch_test_state_t first  = { 0 };
+    watch_test_state_t second = { 0 };
+    TEST_ASSERT(write_file(WATCH_TEST_FILE, "polled"), "Failed to create watched file");
+
+    mvn_watch_set_polling(true, 20);
+    TEST_ASSERT(mvn_watch_is_polling(), "Watcher should poll");
+    uint32_t id = mvn_watch_file(WATCH_TEST_FILE, watch_callback, &first);
+    TEST_ASSERT(id != 0, "Failed to watch file");
+    TEST_ASSERT(mvn_watch_file(WATCH_TEST_FILE, watch_callback, &second) != 0,
+                "Failed to watch file twice");
+
+    // Polling compares the size too, so a change within the same timestamp is seen
+    TEST_ASSERT(write_file(WATCH_TEST_FILE, "polled again"), "Failed to write watched file");
+    pump_main_thread(&first, 1, WATCH_TEST_TIMEOUT_MS);
+    pump_main_thread(&second, 1, WATCH_TEST_TIMEOUT_MS);
+    TEST_ASSERT(first.calls == 1 && second.calls == 1, "Both watches should report the change");
+
+    // Removed files are reported when they come back
+    TEST_ASSERT(SDL_RemovePath(WATCH_TEST_FILE), "Failed to remove watched file");
+    pump_main_thread(&first, 2, WATCH_TEST_TIMEOUT_MS);
+    TEST_ASSERT(write_file(WATCH_TEST_FILE, "back"), "Failed to recreate watched file");
+    pump_main_thread(&first, 3, WATCH_TEST_TIMEOUT_MS);
+    TEST_ASSERT_FMT(first.calls == 3, "Expected 3 reported changes, got %d", first.calls);
+
+    // Shutting down drops the watches and changes still queued
+    mvn_watch_shutdown();
+    TEST_ASSERT(mvn_get_watch_count() == 0, "Shutdown should drop every watch");
+    TEST_ASSERT(!mvn_unwatch_file(id), "Watch should be gone after shutdown");
+
+    mvn_watch_set_polling(false, 0);
+    return 1;
+}
+
+int run_watch_tests(int *passed_tests, int *failed_tests, int *total_tests)
+{
+    printf("\n===== WATCH TESTS =====\n\n");
+
+    int passed_before = *passed_tests;
+    int failed_before = *failed_tests;
+
+    // Changes are delivered through the main thread queue of the job system
+    if (!mvn_job_system_init(1)) {
+        printf("ERROR: Failed to start the job system. Skipping watch tests.\n");
+        (*total_tests)++;
+        (*failed_tests)++;
+        return 0;
+    }
+    SDL_CreateDirectory(WATCH_TEST_DIR);
+
+    RUN_TEST(test_watch_coalesce);
+    RUN_TEST(test_watch_polling);
+
+    SDL_RemovePath(WATCH_TEST_FILE);
+    SDL_RemovePath(WATCH_TEST_DIR);
+    mvn_job_system_shutdown();
+
+    // Calculate how many tests were run
+    int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
+    (*total_tests) += tests_run;
+
+    // Return number of passed tests from this suite
+    return *passed_tests - passed_before;
+}
+
+int main(void)
+{
+    int passed = 0;
+    int failed = 0;
+    int total  = 0;
+
+    run_watch_tests(&passed, &failed, &total);
+
+    printf("\n===== WATCH TEST SUMMARY =====\n");
+    print_test_summary(total, passed, failed);
+
+    return (failed > 0) ? 1 : 0;
+}
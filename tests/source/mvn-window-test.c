@@ -13,7 +13,9 @@
 
 #include "mvn-test-utils.h"
 #include "mvn/mvn-core.h"
+#include "mvn/mvn-input.h"
 #include "mvn/mvn-types.h"
+#include "mvn/mvn-window.h"
 
 #include <SDL3/SDL.h>
 
@@ -160,6 +162,95 @@ static int test_monitor_functions(void)
     return 1;
 }
 
+/**
+ * \brief           Compare the cached window state with SDL
+ * \return          1 if the cache matches SDL, 0 otherwise
+ */
+static int check_window_state_cache(void)
+{
+    mvn_window_t *window  = mvn_get_window();
+    SDL_DisplayID display = SDL_GetDisplayForWindow(window);
+    SDL_Rect      bounds;
+    int           x;
+    int           y;
+    int           width;
+    int           height;
+
+    SDL_GetWindowPosition(window, &x, &y);
+    mvn_fpoint_t position = mvn_get_window_position();
+    TEST_ASSERT_FMT(position.x == (float)x && position.y == (float)y,
+                    "Cached position %.0f,%.0f should be %d,%d",
+                    position.x,
+                    position.y,
+                    x,
+                    y);
+
+    TEST_ASSERT(SDL_GetRenderOutputSize(mvn_get_renderer(), &width, &height),
+                "Failed to query render output size");
+    TEST_ASSERT_FMT(mvn_get_render_width() == width && mvn_get_render_height() == height,
+                    "Cached render size %dx%d should be %dx%d",
+                    mvn_get_render_width(),
+                    mvn_get_render_height(),
+                    width,
+                    height);
+
+    TEST_ASSERT(mvn_get_current_monitor() == display, "Cached monitor should match SDL");
+    TEST_ASSERT(mvn_get_window_scale_dpi().x == SDL_GetWindowDisplayScale(window),
+                "Cached scale should match SDL");
+    if (display != 0 && SDL_GetDisplayBounds(display, &bounds)) {
+        TEST_ASSERT(mvn_get_screen_width() == bounds.w && mvn_get_screen_height() == bounds.h,
+                    "Cached screen size should match SDL");
+    }
+    return 1;
+}
+
+/**
+ * \brief           Test that the cached window state follows resize and move events
+ * \return          1 on success, 0 on failure
+ */
+static int test_window_state_cache(void)
+{
+#if defined(MVN_TEST_CI)
+    // CI runners have no display, so render offscreen
+    bool initialized = mvn_init_headless(320, 240);
+#else
+    bool initialized =
+        mvn_init(320, 240, "Window State Test", MVN_WINDOW_HIDDEN | MVN_WINDOW_RESIZABLE);
+#endif
+    TEST_ASSERT(initialized, "Failed to initialize MVN for window state test");
+    TEST_ASSERT(check_window_state_cache(), "Cache should be loaded by initialization");
+
+    static const int sizes[][2] = {
+        { 400, 300 },
+        { 640, 360 },
+        { 200, 500 },
+    };
+    for (size_t i = 0; i < SDL_arraysize(sizes); i++) {
+        mvn_set_window_size(sizes[i][0], sizes[i][1]);
+        mvn_set_window_position(20 + (int)i * 10, 30 + (int)i * 10);
+
+        // The setters refresh the cache, the getters do not wait for the event pump
+        TEST_ASSERT_FMT(check_window_state_cache(), "Cache out of date after resize %zu", i);
+        mvn_update_input();
+        TEST_ASSERT_FMT(check_window_state_cache(), "Cache out of date after events %zu", i);
+    }
+
+    // A stray event refreshes from SDL instead of trusting the event data
+    SDL_Event event;
+    SDL_zero(event);
+    event.type            = SDL_EVENT_WINDOW_RESIZED;
+    event.window.windowID = SDL_GetWindowID(mvn_get_window());
+    event.window.data1    = 1;
+    event.window.data2    = 1;
+    SDL_PushEvent(&event);
+    mvn_update_input();
+    TEST_ASSERT(check_window_state_cache(), "Cache should not take sizes from event data");
+
+    mvn_quit();
+    TEST_ASSERT(mvn_get_render_width() == 0, "Cache should be dropped by mvn_quit");
+    return 1;
+}
+
 /**
  * \brief           Run all window tests
  * \param[out] passed_tests Pointer to the number of passed tests
@@ -170,16 +261,20 @@ static int test_monitor_functions(void)
 int run_window_tests(int *passed_tests, int *failed_tests, int *total_tests)
 {
     printf("\n===== WINDOW TESTS =====\n\n");
-#if defined(MVN_TEST_CI)
-    printf("Skipping window tests in CI mode.\n");
-#else
+
     int passed_before = *passed_tests;
     int failed_before = *failed_tests;
 
+    RUN_TEST(test_window_state_cache);
+
+#if defined(MVN_TEST_CI)
+    printf("Skipping windowed tests in CI mode.\n");
+#else
     RUN_TEST(test_window_creation);
     RUN_TEST(test_window_position);
     RUN_TEST(test_window_size);
     RUN_TEST(test_monitor_functions);
+#endif // MVN_TEST_CI
 
     // Calculate how many tests were run
     int tests_run = (*passed_tests - passed_before) + (*failed_tests - failed_before);
@@ -187,7 +282,6 @@ int run_window_tests(int *passed_tests, int *failed_tests, int *total_tests)
 
     // Return number of passed tests from this suite
     return *passed_tests - passed_before;
-#endif // MVN_TEST_CI
 }
 
 int main(void)
@@ -0,0 +1,79 @@
+/**
+ * \file            log-decode.c
+ * \brief           Command line tool turning binary log files back into text
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+
+#include "mvn/mvn.h" // IWYU pragma: keep
+
+#include <stdio.h>
+
+/**
+ * \brief           Write a decoded line to the output file
+ * \param[in]       line: Decoded line
+ * \param[in]       user_data: Output file (FILE)
+ */
+static void write_line(const char *line, void *user_data)
+{
+    fprintf((FILE *)user_data, "%s\n", line);
+}
+
+/**
+ * \brief           Main application entry point
+ * \param[in]       argc: Number of arguments
+ * \param[in]       argv: Binary log to read, then the text file to write or nothing for stdout
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <binary log> [output file]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *output = stdout;
+    if (argc == 3) {
+        output = fopen(argv[2], "w");
+        if (output == NULL) {
+            fprintf(stderr, "Failed to open %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    bool result = mvn_logger_decode_binary(argv[1], write_line, output);
+    if (!result) {
+        fprintf(stderr, "%s\n", mvn_get_error());
+    }
+
+    if (output != stdout) {
+        fclose(output);
+    }
+    return result ? 0 : 1;
+}
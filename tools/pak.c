@@ -0,0 +1,60 @@
+/**
+ * \file            pak.c
+ * \brief           Command line tool packing a directory of assets into an archive
+ */
+
+/*
+ * Copyright (c) 2025 Jake Larson
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of MVN library.
+ *
+ * Author:          Jake Larson
+ */
+
+#include "mvn/mvn-error.h"
+#include "mvn/mvn-vfs.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * \brief           Main application entry point
+ * \param[in]       argc: Number of arguments
+ * \param[in]       argv: Optional --lz4, then the directory to pack and the archive to write
+ */
+int main(int argc, char *argv[])
+{
+    bool compress = argc > 1 && strcmp(argv[1], "--lz4") == 0;
+    int  first    = compress ? 2 : 1;
+
+    if (argc - first != 2) {
+        fprintf(stderr, "Usage: %s [--lz4] <directory> <output%s>\n", argv[0], MVN_PAK_EXTENSION);
+        return 2;
+    }
+
+    if (!mvn_pak_build(argv[first], argv[first + 1], compress)) {
+        fprintf(stderr, "%s\n", mvn_get_error());
+        return 1;
+    }
+    return 0;
+}